@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/imagefilter/filter_blur.h"
+#include "gfx_utils/graphic_log.h"
+#if defined(ARM_NEON_OPT)
+#include "graphic_neon_utils.h"
+#elif defined(X86_SSE2_OPT)
+#include <emmintrin.h>
+#endif
+
+namespace OHOS {
+#if defined(GRAPHIC_ENABLE_BLUR_EFFECT_FLAG) && GRAPHIC_ENABLE_BLUR_EFFECT_FLAG
+namespace {
+/* The blurred channels, the fourth one of every pixel is kept. */
+constexpr int32_t BLUR_CHANNELS = 3;
+/* Counts up to 2^20 are divided by a multiplication, the products stay within 64 bits. */
+constexpr uint32_t MAX_MAGIC_COUNT = 1 << 20;
+/* A rounded sum is less than 256 times the count it is divided by. */
+constexpr uint32_t SUM_BITS_OVER_COUNT = 8;
+#if defined(ARM_NEON_OPT) || defined(X86_SSE2_OPT)
+constexpr uint32_t LANES_PER_VECTOR = 16;
+#endif
+
+/*
+ * Divides by a constant count with a multiplication, floor(n * magic >> shift) is n / count for
+ * all n below 256 * count as 256 * count * count is at most 2 ^ shift.
+ */
+struct CountDivider {
+    uint32_t count;
+    uint64_t magic;
+    uint32_t shift;
+
+    explicit CountDivider(uint32_t divisor) : count(divisor), magic(0), shift(0)
+    {
+        if (divisor == 0 || divisor > MAX_MAGIC_COUNT) {
+            return;
+        }
+        uint32_t countBits = 0;
+        while ((1u << countBits) < divisor) {
+            countBits++;
+        }
+        shift = SUM_BITS_OVER_COUNT + countBits + countBits;
+        magic = ((1ull << shift) + divisor - 1) / divisor;
+    }
+
+    uint32_t Divide(uint32_t value) const
+    {
+        return (magic != 0) ? static_cast<uint32_t>((value * magic) >> shift) : value / count;
+    }
+};
+
+/* sums += added - removed over all lanes, either row may be nullptr. */
+template <class Sum>
+void SlideColumns(Sum* sums, const uint8_t* added, const uint8_t* removed, uint32_t lanes)
+{
+    if (added != nullptr) {
+        for (uint32_t i = 0; i < lanes; i++) {
+            sums[i] += added[i];
+        }
+    }
+    if (removed != nullptr) {
+        for (uint32_t i = 0; i < lanes; i++) {
+            sums[i] -= removed[i];
+        }
+    }
+}
+
+/* The 16 bit sums wrap in between, but every sum of a window fits in them. */
+template <>
+void SlideColumns<uint16_t>(uint16_t* sums, const uint8_t* added, const uint8_t* removed, uint32_t lanes)
+{
+    uint32_t i = 0;
+#if defined(ARM_NEON_OPT) || defined(X86_SSE2_OPT)
+    static const uint8_t NO_PIXELS[LANES_PER_VECTOR] = {0};
+    const uint32_t addedStep = (added != nullptr) ? LANES_PER_VECTOR : 0;
+    const uint32_t removedStep = (removed != nullptr) ? LANES_PER_VECTOR : 0;
+    const uint8_t* addedLanes = (added != nullptr) ? added : NO_PIXELS;
+    const uint8_t* removedLanes = (removed != nullptr) ? removed : NO_PIXELS;
+    for (; i + LANES_PER_VECTOR <= lanes; i += LANES_PER_VECTOR) {
+#if defined(ARM_NEON_OPT)
+        uint8x16_t plus = vld1q_u8(addedLanes);
+        uint8x16_t minus = vld1q_u8(removedLanes);
+        uint16x8_t low = vld1q_u16(sums + i);
+        uint16x8_t high = vld1q_u16(sums + i + NEON_STEP_8);
+        low = vsubw_u8(vaddw_u8(low, vget_low_u8(plus)), vget_low_u8(minus));
+        high = vsubw_u8(vaddw_u8(high, vget_high_u8(plus)), vget_high_u8(minus));
+        vst1q_u16(sums + i, low);
+        vst1q_u16(sums + i + NEON_STEP_8, high);
+#else
+        const __m128i zero = _mm_setzero_si128();
+        __m128i plus = _mm_loadu_si128(reinterpret_cast<const __m128i*>(addedLanes));
+        __m128i minus = _mm_loadu_si128(reinterpret_cast<const __m128i*>(removedLanes));
+        __m128i* target = reinterpret_cast<__m128i*>(sums + i);
+        __m128i low = _mm_add_epi16(_mm_loadu_si128(target), _mm_unpacklo_epi8(plus, zero));
+        __m128i high = _mm_add_epi16(_mm_loadu_si128(target + 1), _mm_unpackhi_epi8(plus, zero));
+        _mm_storeu_si128(target, _mm_sub_epi16(low, _mm_unpacklo_epi8(minus, zero)));
+        _mm_storeu_si128(target + 1, _mm_sub_epi16(high, _mm_unpackhi_epi8(minus, zero)));
+#endif
+        addedLanes += addedStep;
+        removedLanes += removedStep;
+    }
+#endif
+    for (; i < lanes; i++) {
+        uint32_t sum = sums[i] + ((added != nullptr) ? added[i] : 0) - ((removed != nullptr) ? removed[i] : 0);
+        sums[i] = static_cast<uint16_t>(sum);
+    }
+}
+} // namespace
+
+Filterblur::~Filterblur()
+{
+    if (ring_ != nullptr) {
+        free(ring_);
+    }
+    if (sums_ != nullptr) {
+        free(sums_);
+    }
+}
+
+bool Filterblur::Reserve(uint32_t ringSize, uint32_t sumsSize)
+{
+    if (ringSize > ringSize_) {
+        if (ring_ != nullptr) {
+            free(ring_);
+        }
+        ring_ = static_cast<uint8_t*>(malloc(ringSize));
+        ringSize_ = (ring_ != nullptr) ? ringSize : 0;
+    }
+    if (sumsSize > sumsSize_) {
+        if (sums_ != nullptr) {
+            free(sums_);
+        }
+        sums_ = static_cast<uint8_t*>(malloc(sumsSize));
+        sumsSize_ = (sums_ != nullptr) ? sumsSize : 0;
+    }
+    return (ringSize == 0 || ring_ != nullptr) && sums_ != nullptr;
+}
+
+void Filterblur::BoxBlurRgba(uint8_t* pixels, int32_t width, int32_t height, int32_t stride, uint16_t radius)
+{
+    if (pixels == nullptr || width <= 0 || height <= 0 || radius < 1) {
+        return;
+    }
+    // A box reaching over the whole image in both directions is cut to it anyway
+    int32_t clamped = MATH_MIN(static_cast<int32_t>(radius), MATH_MAX(width, height) - 1);
+    if (clamped <= MAX_SUM16_RADIUS) {
+        BlurRgba<uint16_t>(pixels, width, height, stride, clamped);
+    } else {
+        BlurRgba<uint32_t>(pixels, width, height, stride, clamped);
+    }
+}
+
+template <class Sum>
+void Filterblur::BlurRgba(uint8_t* pixels, int32_t width, int32_t height, int32_t stride, int32_t radius)
+{
+    const uint32_t lanes = static_cast<uint32_t>(width) * FOUR_TIMES;
+    // The rows the window has left are needed, unless it never leaves a row
+    const int32_t ringRows = (radius < height - 1) ? radius + 1 : 0;
+    if (!Reserve(ringRows * lanes, lanes * sizeof(Sum))) {
+        GRAPHIC_LOGE("Filterblur::BoxBlur the buffers can not be allocated\n");
+        return;
+    }
+    Sum* sums = reinterpret_cast<Sum*>(sums_);
+    if (memset_s(sums, sumsSize_, 0, lanes * sizeof(Sum)) != EOK) {
+        GRAPHIC_LOGE("Filterblur::BoxBlur memset_s failed\n");
+        return;
+    }
+    for (int32_t y = 0; y < MATH_MIN(radius + 1, height); y++) {
+        SlideColumns(sums, pixels + y * stride, nullptr, lanes);
+    }
+    for (int32_t y = 0; y < height; y++) {
+        uint8_t* row = pixels + y * stride;
+        uint8_t* slot = (ringRows > 0) ? ring_ + (y % ringRows) * lanes : nullptr;
+        if (y > 0) {
+            // The row y - radius - 1 left the window, it was kept in the slot row y is kept in
+            const uint8_t* added = (y + radius < height) ? pixels + (y + radius) * stride : nullptr;
+            const uint8_t* removed = (y > radius) ? slot : nullptr;
+            SlideColumns(sums, added, removed, lanes);
+        }
+        if (slot != nullptr && memcpy_s(slot, lanes, row, lanes) != EOK) {
+            GRAPHIC_LOGE("Filterblur::BoxBlur memcpy_s failed\n");
+            return;
+        }
+        uint32_t rows = static_cast<uint32_t>(MATH_MIN(y + radius + 1, height) - MATH_MAX(y - radius, 0));
+        BlurRow(row, sums, width, radius, rows);
+    }
+}
+
+template <class Sum>
+void Filterblur::BlurRow(uint8_t* row, const Sum* sums, int32_t width, int32_t radius, uint32_t rows)
+{
+    uint32_t windowSums[BLUR_CHANNELS] = {0};
+    for (int32_t x = 0; x < MATH_MIN(radius + 1, width); x++) {
+        for (int32_t c = 0; c < BLUR_CHANNELS; c++) {
+            windowSums[c] += sums[x * FOUR_TIMES + c];
+        }
+    }
+    // The count of all boxes which are not cut at the left or right edge
+    const CountDivider inner(static_cast<uint32_t>(MATH_MIN(2 * radius + 1, width)) * rows);
+    for (int32_t x = 0; x < width; x++) {
+        if (x > 0) {
+            int32_t added = x + radius;
+            int32_t removed = x - radius - 1;
+            for (int32_t c = 0; c < BLUR_CHANNELS; c++) {
+                windowSums[c] += (added < width) ? sums[added * FOUR_TIMES + c] : 0;
+                windowSums[c] -= (removed >= 0) ? sums[removed * FOUR_TIMES + c] : 0;
+            }
+        }
+        uint32_t count = static_cast<uint32_t>(MATH_MIN(x + radius + 1, width) - MATH_MAX(x - radius, 0)) * rows;
+        uint8_t* pixel = row + x * FOUR_TIMES;
+        if (count == inner.count) {
+            for (int32_t c = 0; c < BLUR_CHANNELS; c++) {
+                pixel[c] = static_cast<uint8_t>(inner.Divide(windowSums[c] + (count >> 1)));
+            }
+        } else {
+            for (int32_t c = 0; c < BLUR_CHANNELS; c++) {
+                pixel[c] = static_cast<uint8_t>((windowSums[c] + (count >> 1)) / count);
+            }
+        }
+    }
+}
+#endif
+} // namespace OHOS
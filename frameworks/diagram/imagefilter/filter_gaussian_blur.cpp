@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/imagefilter/filter_gaussian_blur.h"
+#include "gfx_utils/graphic_log.h"
+#include "securec.h"
+#if defined(ARM_NEON_OPT)
+#include "graphic_neon_utils.h"
+#elif defined(X86_SSE2_OPT)
+#include <emmintrin.h>
+#endif
+#if defined(ARM_NEON_OPT) || defined(X86_SSE2_OPT)
+#include <cstring>
+#endif
+
+namespace OHOS {
+#if defined(GRAPHIC_ENABLE_BLUR_EFFECT_FLAG) && GRAPHIC_ENABLE_BLUR_EFFECT_FLAG
+namespace {
+/* The quotient of a box sum is the high 16 bits of its product, shifted by BoxPass::shift. */
+constexpr uint32_t PRODUCT_SHIFT = 16;
+/* A rounded box sum is less than 256 times the box size. */
+constexpr uint32_t SUM_BITS_OVER_SIZE = 8;
+#if defined(ARM_NEON_OPT) || defined(X86_SSE2_OPT)
+/* The channels of a pixel, which are the lanes of a row. */
+constexpr int32_t PIXEL_LANES = 4;
+
+/* A pixel of a row may be unaligned, it is copied through a local, which compiles to one load or store. */
+inline uint32_t ReadPixel(const uint8_t* pixel)
+{
+    uint32_t value;
+    std::memcpy(&value, pixel, sizeof(value));
+    return value;
+}
+
+inline void WritePixel(uint8_t* pixel, uint32_t value)
+{
+    std::memcpy(pixel, &value, sizeof(value));
+}
+#endif
+
+/*
+ * A box of 2 * radius + 1 steps. Up to MAX_VECTOR_RADIUS the rounded mean (sum + half) / size is
+ * (sum + half) * magic >> (16 + shift), as the rounded sum is below 256 * size and
+ * 256 * size * size is at most 2 ^ (16 + shift).
+ */
+struct BoxPass {
+    int32_t radius;
+    uint32_t size;
+    uint32_t half;
+    uint32_t magic;
+    uint32_t shift;
+
+    explicit BoxPass(int32_t boxRadius = 0)
+        : radius(boxRadius), size(2 * boxRadius + 1), half(boxRadius), magic(0), shift(0)
+    {
+        if (radius < 1 || radius > FilterGaussianBlur::MAX_VECTOR_RADIUS) {
+            return;
+        }
+        while ((1u << (PRODUCT_SHIFT + shift)) < ((size * size) << SUM_BITS_OVER_SIZE)) {
+            shift++;
+        }
+        magic = ((1u << (PRODUCT_SHIFT + shift)) + size - 1) / size;
+    }
+
+    uint8_t Mean(uint32_t sum) const
+    {
+        if (magic != 0) {
+            return static_cast<uint8_t>(((sum + half) * magic) >> (PRODUCT_SHIFT + shift));
+        }
+        return static_cast<uint8_t>((sum + half) / size);
+    }
+};
+
+/* Box blurs count steps of lanes bytes, the steps are srcStep and dstStep bytes apart. */
+void BoxLanes(const uint8_t* src, int32_t srcStep, uint8_t* dst, int32_t dstStep, int32_t count, int32_t lanes,
+              const BoxPass& pass)
+{
+    const int32_t last = count - 1;
+    // The box of the first step reaches inside steps beyond it, the last step repeats after them
+    const int32_t inside = MATH_MIN(pass.radius, last);
+    for (int32_t lane = 0; lane < lanes; lane++) {
+        const uint8_t* in = src + lane;
+        uint8_t* out = dst + lane;
+        uint32_t sum = (pass.radius + 1) * in[0] + (pass.radius - inside) * in[last * srcStep];
+        for (int32_t i = 1; i <= inside; i++) {
+            sum += in[i * srcStep];
+        }
+        for (int32_t i = 0; i < count; i++) {
+            out[i * dstStep] = pass.Mean(sum);
+            sum += in[MATH_MIN(i + pass.radius + 1, last) * srcStep];
+            sum -= in[MATH_MAX(i - pass.radius, 0) * srcStep];
+        }
+    }
+}
+
+#if defined(ARM_NEON_OPT)
+inline uint16x8_t MeanLanes(uint16x8_t sums, uint16x8_t half, uint16x4_t magic, int32x4_t shift)
+{
+    sums = vaddq_u16(sums, half);
+    uint32x4_t low = vshlq_u32(vmull_u16(vget_low_u16(sums), magic), shift);
+    uint32x4_t high = vshlq_u32(vmull_u16(vget_high_u16(sums), magic), shift);
+    return vcombine_u16(vmovn_u32(low), vmovn_u32(high));
+}
+
+inline uint8x8_t LoadPixel(const uint8_t* pixel)
+{
+    return vreinterpret_u8_u32(vdup_n_u32(ReadPixel(pixel)));
+}
+
+/* BoxLanes over 16 lanes of a strip, which are summed in 2 vectors. */
+void BoxStrip(const uint8_t* src, int32_t srcStep, uint8_t* dst, int32_t dstStep, int32_t count,
+              const BoxPass& pass)
+{
+    const uint16x8_t half = vdupq_n_u16(static_cast<uint16_t>(pass.half));
+    const uint16x4_t magic = vdup_n_u16(static_cast<uint16_t>(pass.magic));
+    const int32x4_t shift = vdupq_n_s32(-static_cast<int32_t>(PRODUCT_SHIFT + pass.shift));
+    const int32_t last = count - 1;
+    uint8x16_t first = vld1q_u8(src);
+    uint16x8_t low = vmulq_n_u16(vmovl_u8(vget_low_u8(first)), static_cast<uint16_t>(pass.radius + 1));
+    uint16x8_t high = vmulq_n_u16(vmovl_u8(vget_high_u8(first)), static_cast<uint16_t>(pass.radius + 1));
+    for (int32_t i = 1; i <= pass.radius; i++) {
+        uint8x16_t row = vld1q_u8(src + MATH_MIN(i, last) * srcStep);
+        low = vaddw_u8(low, vget_low_u8(row));
+        high = vaddw_u8(high, vget_high_u8(row));
+    }
+    for (int32_t i = 0; i < count; i++) {
+        uint8x8_t meanLow = vqmovn_u16(MeanLanes(low, half, magic, shift));
+        uint8x8_t meanHigh = vqmovn_u16(MeanLanes(high, half, magic, shift));
+        vst1q_u8(dst + i * dstStep, vcombine_u8(meanLow, meanHigh));
+        uint8x16_t plus = vld1q_u8(src + MATH_MIN(i + pass.radius + 1, last) * srcStep);
+        uint8x16_t minus = vld1q_u8(src + MATH_MAX(i - pass.radius, 0) * srcStep);
+        low = vsubw_u8(vaddw_u8(low, vget_low_u8(plus)), vget_low_u8(minus));
+        high = vsubw_u8(vaddw_u8(high, vget_high_u8(plus)), vget_high_u8(minus));
+    }
+}
+
+/* BoxLanes over the 4 channels of the pixels of a row, which are summed in one vector. */
+void BoxPixels(const uint8_t* src, uint8_t* dst, int32_t count, const BoxPass& pass)
+{
+    const uint16x8_t half = vdupq_n_u16(static_cast<uint16_t>(pass.half));
+    const uint16x4_t magic = vdup_n_u16(static_cast<uint16_t>(pass.magic));
+    const int32x4_t shift = vdupq_n_s32(-static_cast<int32_t>(PRODUCT_SHIFT + pass.shift));
+    const int32_t last = count - 1;
+    uint16x8_t sum = vmulq_n_u16(vmovl_u8(LoadPixel(src)), static_cast<uint16_t>(pass.radius + 1));
+    for (int32_t i = 1; i <= pass.radius; i++) {
+        sum = vaddw_u8(sum, LoadPixel(src + MATH_MIN(i, last) * PIXEL_LANES));
+    }
+    for (int32_t i = 0; i < count; i++) {
+        uint8x8_t mean = vqmovn_u16(MeanLanes(sum, half, magic, shift));
+        WritePixel(dst + i * PIXEL_LANES, vget_lane_u32(vreinterpret_u32_u8(mean), 0));
+        uint8x8_t plus = LoadPixel(src + MATH_MIN(i + pass.radius + 1, last) * PIXEL_LANES);
+        uint8x8_t minus = LoadPixel(src + MATH_MAX(i - pass.radius, 0) * PIXEL_LANES);
+        sum = vsubw_u8(vaddw_u8(sum, plus), minus);
+    }
+}
+#elif defined(X86_SSE2_OPT)
+inline __m128i MeanLanes(__m128i sums, __m128i half, __m128i magic, __m128i shift)
+{
+    return _mm_srl_epi16(_mm_mulhi_epu16(_mm_add_epi16(sums, half), magic), shift);
+}
+
+inline __m128i LoadPixel(const uint8_t* pixel)
+{
+    return _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int32_t>(ReadPixel(pixel))), _mm_setzero_si128());
+}
+
+/* BoxLanes over 16 lanes of a strip, which are summed in 2 vectors. */
+void BoxStrip(const uint8_t* src, int32_t srcStep, uint8_t* dst, int32_t dstStep, int32_t count,
+              const BoxPass& pass)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i half = _mm_set1_epi16(static_cast<int16_t>(pass.half));
+    const __m128i magic = _mm_set1_epi16(static_cast<int16_t>(pass.magic));
+    const __m128i shift = _mm_cvtsi32_si128(static_cast<int32_t>(pass.shift));
+    const __m128i times = _mm_set1_epi16(static_cast<int16_t>(pass.radius + 1));
+    const int32_t last = count - 1;
+    __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    __m128i low = _mm_mullo_epi16(_mm_unpacklo_epi8(first, zero), times);
+    __m128i high = _mm_mullo_epi16(_mm_unpackhi_epi8(first, zero), times);
+    for (int32_t i = 1; i <= pass.radius; i++) {
+        __m128i row = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + MATH_MIN(i, last) * srcStep));
+        low = _mm_add_epi16(low, _mm_unpacklo_epi8(row, zero));
+        high = _mm_add_epi16(high, _mm_unpackhi_epi8(row, zero));
+    }
+    for (int32_t i = 0; i < count; i++) {
+        __m128i mean = _mm_packus_epi16(MeanLanes(low, half, magic, shift), MeanLanes(high, half, magic, shift));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * dstStep), mean);
+        const uint8_t* added = src + MATH_MIN(i + pass.radius + 1, last) * srcStep;
+        const uint8_t* removed = src + MATH_MAX(i - pass.radius, 0) * srcStep;
+        __m128i plus = _mm_loadu_si128(reinterpret_cast<const __m128i*>(added));
+        __m128i minus = _mm_loadu_si128(reinterpret_cast<const __m128i*>(removed));
+        low = _mm_sub_epi16(_mm_add_epi16(low, _mm_unpacklo_epi8(plus, zero)), _mm_unpacklo_epi8(minus, zero));
+        high = _mm_sub_epi16(_mm_add_epi16(high, _mm_unpackhi_epi8(plus, zero)), _mm_unpackhi_epi8(minus, zero));
+    }
+}
+
+/* BoxLanes over the 4 channels of the pixels of a row, which are summed in one vector. */
+void BoxPixels(const uint8_t* src, uint8_t* dst, int32_t count, const BoxPass& pass)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i half = _mm_set1_epi16(static_cast<int16_t>(pass.half));
+    const __m128i magic = _mm_set1_epi16(static_cast<int16_t>(pass.magic));
+    const __m128i shift = _mm_cvtsi32_si128(static_cast<int32_t>(pass.shift));
+    const int32_t last = count - 1;
+    __m128i sum = _mm_mullo_epi16(LoadPixel(src), _mm_set1_epi16(static_cast<int16_t>(pass.radius + 1)));
+    for (int32_t i = 1; i <= pass.radius; i++) {
+        sum = _mm_add_epi16(sum, LoadPixel(src + MATH_MIN(i, last) * PIXEL_LANES));
+    }
+    for (int32_t i = 0; i < count; i++) {
+        __m128i mean = _mm_packus_epi16(MeanLanes(sum, half, magic, shift), zero);
+        WritePixel(dst + i * PIXEL_LANES, static_cast<uint32_t>(_mm_cvtsi128_si32(mean)));
+        __m128i plus = LoadPixel(src + MATH_MIN(i + pass.radius + 1, last) * PIXEL_LANES);
+        __m128i minus = LoadPixel(src + MATH_MAX(i - pass.radius, 0) * PIXEL_LANES);
+        sum = _mm_sub_epi16(_mm_add_epi16(sum, plus), minus);
+    }
+}
+#endif
+
+void BoxLine(const uint8_t* src, int32_t srcStep, uint8_t* dst, int32_t dstStep, int32_t count, int32_t lanes,
+             const BoxPass& pass)
+{
+#if defined(ARM_NEON_OPT) || defined(X86_SSE2_OPT)
+    if (pass.magic != 0) {
+        if (lanes == FilterGaussianBlur::STRIP_LANES) {
+            BoxStrip(src, srcStep, dst, dstStep, count, pass);
+            return;
+        }
+        if (lanes == PIXEL_LANES && srcStep == PIXEL_LANES && dstStep == PIXEL_LANES) {
+            BoxPixels(src, dst, count, pass);
+            return;
+        }
+    }
+#endif
+    BoxLanes(src, srcStep, dst, dstStep, count, lanes, pass);
+}
+
+/* All passes over a line of count steps, through the 2 scratch lines of count * lanes bytes. */
+void BlurLine(uint8_t* line, int32_t step, int32_t count, int32_t lanes, const BoxPass* passes, int32_t passCount,
+              uint8_t* const scratch[2])
+{
+    const uint8_t* src = line;
+    int32_t srcStep = step;
+    for (int32_t j = 0; j < passCount; j++) {
+        // A pass can not write the line it reads, only the last one of several writes the line back
+        bool back = (j > 0) && (j == passCount - 1);
+        uint8_t* dst = back ? line : scratch[j % 2];
+        int32_t dstStep = back ? step : lanes;
+        BoxLine(src, srcStep, dst, dstStep, count, lanes, passes[j]);
+        src = dst;
+        srcStep = dstStep;
+    }
+    if (passCount != 1) {
+        return;
+    }
+    if (step == lanes) {
+        if (memcpy_s(line, count * lanes, scratch[0], count * lanes) != EOK) {
+            GRAPHIC_LOGE("FilterGaussianBlur::Blur memcpy_s failed\n");
+        }
+        return;
+    }
+    for (int32_t i = 0; i < count; i++) {
+        if (memcpy_s(line + i * step, lanes, scratch[0] + i * lanes, lanes) != EOK) {
+            GRAPHIC_LOGE("FilterGaussianBlur::Blur memcpy_s failed\n");
+            return;
+        }
+    }
+}
+} // namespace
+
+FilterGaussianBlur::~FilterGaussianBlur()
+{
+    if (scratch_ != nullptr) {
+        free(scratch_);
+    }
+}
+
+bool FilterGaussianBlur::Reserve(uint32_t size)
+{
+    if (size > scratchSize_) {
+        if (scratch_ != nullptr) {
+            free(scratch_);
+        }
+        scratch_ = static_cast<uint8_t*>(malloc(size));
+        scratchSize_ = (scratch_ != nullptr) ? size : 0;
+    }
+    return scratch_ != nullptr;
+}
+
+void FilterGaussianBlur::GetBoxRadii(uint16_t radius, uint16_t boxRadii[BOX_PASSES])
+{
+    if (radius == 0) {
+        for (int32_t i = 0; i < BOX_PASSES; i++) {
+            boxRadii[i] = 0;
+        }
+        return;
+    }
+    // The ideal box size sqrt(12 * variance / 3 + 1) is sqrt(radius * radius + 1), the boxes are
+    // of the odd size at or below radius and of the next odd size
+    const int64_t lowerSize = (radius % 2 != 0) ? radius : radius - 1;
+    const int64_t variance12 = 3 * static_cast<int64_t>(radius) * radius;
+    // The count of lower boxes which brings the sum of the variances (size * size - 1) / 12 the closest
+    const int64_t excess = BOX_PASSES * (lowerSize * lowerSize + 4 * lowerSize + 3) - variance12;
+    const int64_t perBox = 4 * lowerSize + 4;
+    int64_t lowerCount = (excess + perBox / 2) / perBox;
+    lowerCount = MATH_MIN(MATH_MAX(lowerCount, static_cast<int64_t>(0)), static_cast<int64_t>(BOX_PASSES));
+    for (int32_t i = 0; i < BOX_PASSES; i++) {
+        int64_t size = (i < lowerCount) ? lowerSize : lowerSize + 2;
+        boxRadii[i] = static_cast<uint16_t>((size - 1) / 2);
+    }
+}
+
+void FilterGaussianBlur::BlurRgba(uint8_t* pixels, int32_t width, int32_t height, int32_t stride, uint16_t radius)
+{
+    if (pixels == nullptr || width <= 0 || height <= 0 || stride < width * FOUR_TIMES) {
+        return;
+    }
+    Blur(pixels, width, height, stride, FOUR_TIMES, radius);
+}
+
+void FilterGaussianBlur::BlurA8(uint8_t* pixels, int32_t width, int32_t height, int32_t stride, uint16_t radius)
+{
+    if (pixels == nullptr || width <= 0 || height <= 0 || stride < width) {
+        return;
+    }
+    Blur(pixels, width, height, stride, 1, radius);
+}
+
+void FilterGaussianBlur::Blur(uint8_t* pixels, int32_t width, int32_t height, int32_t stride, int32_t channels,
+                              uint16_t radius)
+{
+    uint16_t boxRadii[BOX_PASSES];
+    GetBoxRadii(radius, boxRadii);
+    BoxPass passes[BOX_PASSES];
+    int32_t passCount = 0;
+    for (int32_t i = 0; i < BOX_PASSES; i++) {
+        if (boxRadii[i] > 0) {
+            passes[passCount++] = BoxPass(boxRadii[i]);
+        }
+    }
+    if (passCount == 0) {
+        return;
+    }
+    const int32_t rowLanes = width * channels;
+    const uint32_t lineSize = static_cast<uint32_t>(MATH_MAX(rowLanes, height * STRIP_LANES));
+    if (!Reserve(lineSize * 2)) { // 2: the lines passes alternate between
+        GRAPHIC_LOGE("FilterGaussianBlur::Blur the scratch can not be allocated\n");
+        return;
+    }
+    uint8_t* const scratch[2] = {scratch_, scratch_ + lineSize}; // 2: the lines passes alternate between
+    for (int32_t y = 0; y < height; y++) {
+        BlurLine(pixels + y * stride, channels, width, channels, passes, passCount, scratch);
+    }
+    for (int32_t x = 0; x < rowLanes; x += STRIP_LANES) {
+        BlurLine(pixels + x, stride, height, MATH_MIN(STRIP_LANES, rowLanes - x), passes, passCount, scratch);
+    }
+}
+#endif
+} // namespace OHOS
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/imagefilter/filter_shadow.h"
+
+namespace OHOS {
+#if defined(GRAPHIC_ENABLE_SHADOW_EFFECT_FLAG) && GRAPHIC_ENABLE_SHADOW_EFFECT_FLAG && \
+    defined(GRAPHIC_ENABLE_BLUR_EFFECT_FLAG) && GRAPHIC_ENABLE_BLUR_EFFECT_FLAG
+int32_t FilterShadow::GetMargin(uint16_t radius)
+{
+    uint16_t boxRadii[FilterGaussianBlur::BOX_PASSES];
+    FilterGaussianBlur::GetBoxRadii(radius, boxRadii);
+    int32_t margin = 0;
+    for (int32_t i = 0; i < FilterGaussianBlur::BOX_PASSES; i++) {
+        margin += boxRadii[i];
+    }
+    return margin;
+}
+
+void FilterShadow::Blur(uint16_t radius)
+{
+    // The margin keeps the edges of the mask clear, so that the repeated edges of the blur are 0
+    blur_.BlurA8(mask_.GetRow(0), mask_.GetWidth(), mask_.GetHeight(), mask_.GetStride(), radius);
+}
+
+void FilterShadow::Composite(FillSolidColor& fill, const ColorType& color, int32_t offsetX, int32_t offsetY)
+{
+    if (color.alpha == 0) {
+        return;
+    }
+    fill.SetColor(Rgba8T(color.red, color.green, color.blue, color.alpha));
+    const int32_t width = mask_.GetWidth();
+    const int32_t left = originX_ + offsetX;
+    for (int32_t y = 0; y < mask_.GetHeight(); y++) {
+        const uint8_t* covers = mask_.GetRow(y);
+        int32_t start = 0;
+        while (start < width) {
+            while (start < width && covers[start] == 0) {
+                start++;
+            }
+            int32_t end = start;
+            while (end < width && covers[end] != 0) {
+                end++;
+            }
+            if (end > start) {
+                fill.BlendSolidHspan(left + start, originY_ + offsetY + y, end - start, covers + start);
+            }
+            start = end;
+        }
+    }
+}
+#endif
+} // namespace OHOS
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterized_path_cache.h"
+#include "gfx_utils/graphic_log.h"
+
+namespace OHOS {
+namespace {
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+constexpr uint32_t AFFINE_SIZE = 6;
+constexpr uint32_t RECT_BOUNDS = 4;
+} // namespace
+
+RasterizedPathCache::RasterizedPathCache(uint32_t byteBudget)
+    : head_(nullptr),
+      tail_(nullptr),
+      current_(nullptr),
+      passThrough_(nullptr),
+      byteBudget_(byteBudget),
+      stats_()
+{
+    for (uint32_t i = 0; i < HASH_BUCKETS; i++) {
+        buckets_[i] = nullptr;
+    }
+}
+
+RasterizedPathCache::~RasterizedPathCache()
+{
+    Clear();
+}
+
+void RasterizedPathCache::StartKey(const RasterizerScanlineAntialias& rasterizer, const TransAffine& transform,
+                                   CacheKey& key)
+{
+    key.pathHash = FNV_OFFSET_BASIS;
+    key.numVertices = 0;
+    const float* data = transform.GetData();
+    for (uint32_t i = 0; i < AFFINE_SIZE; i++) {
+        key.matrix[i] = data[i];
+    }
+    key.clipping = rasterizer.GetClipBox(key.clipX1, key.clipY1, key.clipX2, key.clipY2);
+    if (!key.clipping) {
+        key.clipX1 = 0;
+        key.clipY1 = 0;
+        key.clipX2 = 0;
+        key.clipY2 = 0;
+    }
+    const Rect32* rects = nullptr;
+    key.numRegionRects = rasterizer.GetClipRegion(rects);
+    key.regionHash = FNV_OFFSET_BASIS;
+    for (uint32_t i = 0; i < key.numRegionRects; i++) {
+        int32_t bounds[RECT_BOUNDS];
+        GetBounds(rects[i], bounds);
+        HashBytes(key.regionHash, bounds, sizeof(bounds));
+    }
+    rasterizer.GetScanlineWindow(key.windowMinY, key.windowMaxY);
+    key.fillingRule = rasterizer.GetFillingRule();
+}
+
+void RasterizedPathCache::GetBounds(const Rect32& rect, int32_t* bounds)
+{
+    int32_t i = 0;
+    bounds[i++] = rect.GetLeft();
+    bounds[i++] = rect.GetTop();
+    bounds[i++] = rect.GetRight();
+    bounds[i++] = rect.GetBottom();
+}
+
+void RasterizedPathCache::HashBytes(uint64_t& hash, const void* data, uint32_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (uint32_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+}
+
+void RasterizedPathCache::HashVertex(CacheKey& key, float x, float y, uint32_t cmd)
+{
+    HashBytes(key.pathHash, &x, sizeof(x));
+    HashBytes(key.pathHash, &y, sizeof(y));
+    HashBytes(key.pathHash, &cmd, sizeof(cmd));
+    key.numVertices++;
+}
+
+bool RasterizedPathCache::SameKey(const CacheKey& a, const CacheKey& b)
+{
+    if (a.pathHash != b.pathHash || a.numVertices != b.numVertices || a.fillingRule != b.fillingRule ||
+        a.regionHash != b.regionHash || a.numRegionRects != b.numRegionRects ||
+        a.clipping != b.clipping || a.clipX1 != b.clipX1 || a.clipY1 != b.clipY1 || a.clipX2 != b.clipX2 ||
+        a.clipY2 != b.clipY2 || a.windowMinY != b.windowMinY || a.windowMaxY != b.windowMaxY) {
+        return false;
+    }
+    for (uint32_t i = 0; i < AFFINE_SIZE; i++) {
+        if (a.matrix[i] != b.matrix[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t RasterizedPathCache::BucketOf(const CacheKey& key)
+{
+    uint64_t hash = key.pathHash;
+    HashBytes(hash, key.matrix, sizeof(key.matrix));
+    return static_cast<uint32_t>(hash % HASH_BUCKETS);
+}
+
+RasterizedPathCache::CacheEntry* RasterizedPathCache::FindEntry(const RasterizerScanlineAntialias& rasterizer,
+                                                                const CacheKey& key, CacheEntry* entry) const
+{
+    entry = (entry == nullptr) ? buckets_[BucketOf(key)] : entry->nextInBucket;
+    const Rect32* rects = nullptr;
+    rasterizer.GetClipRegion(rects);
+    for (; entry != nullptr; entry = entry->nextInBucket) {
+        if (!SameKey(entry->key, key)) {
+            continue;
+        }
+        bool sameRegion = true;
+        for (uint32_t i = 0; sameRegion && i < key.numRegionRects; i++) {
+            int32_t bounds[RECT_BOUNDS];
+            GetBounds(rects[i], bounds);
+            for (uint32_t j = 0; j < RECT_BOUNDS; j++) {
+                sameRegion = sameRegion && entry->region[i * RECT_BOUNDS + j] == bounds[j];
+            }
+        }
+        if (sameRegion) {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+void RasterizedPathCache::Select(CacheEntry* entry)
+{
+    stats_.hits++;
+    ReleaseCurrent();
+    // Move to the front of the recently used list
+    if (entry != head_) {
+        Unlink(entry);
+        Insert(entry);
+    }
+    current_ = entry;
+}
+
+RasterizedPathCache::CacheEntry* RasterizedPathCache::Store(RasterizerScanlineAntialias& rasterizer,
+                                                            const CacheKey& key)
+{
+    stats_.misses++;
+    ReleaseCurrent();
+    CacheEntry* entry = scratch_.Record(rasterizer) ? CreateEntry(rasterizer, key) : nullptr;
+    if (entry == nullptr) {
+        GRAPHIC_LOGE("RasterizedPathCache::Store scanline storage fail\n");
+        passThrough_ = &rasterizer;
+        return nullptr;
+    }
+    uint32_t entryBytes = entry->dataSize + sizeof(CacheEntry);
+    if (entryBytes > byteBudget_) {
+        // Replayed once and released by the next AddPath
+        stats_.rejections++;
+    } else {
+        Evict(byteBudget_ - entryBytes);
+        entry->cached = true;
+        Insert(entry);
+        uint32_t bucket = BucketOf(entry->key);
+        entry->nextInBucket = buckets_[bucket];
+        buckets_[bucket] = entry;
+        stats_.entries++;
+        stats_.bytes += entryBytes;
+    }
+    current_ = entry;
+    return entry;
+}
+
+RasterizedPathCache::CacheEntry* RasterizedPathCache::CreateEntry(const RasterizerScanlineAntialias& rasterizer,
+                                                                  const CacheKey& key)
+{
+    CacheEntry* entry = new CacheEntry();
+    if (entry == nullptr) {
+        return nullptr;
+    }
+    uint32_t regionSize = key.numRegionRects * RECT_BOUNDS;
+    entry->vertices = (key.numVertices > 0) ? GeometryArrayAllocator<CacheVertex>::Allocate(key.numVertices) : nullptr;
+    entry->region = (regionSize > 0) ? GeometryArrayAllocator<int32_t>::Allocate(regionSize) : nullptr;
+    entry->key = key;
+    if ((key.numVertices > 0 && entry->vertices == nullptr) || (regionSize > 0 && entry->region == nullptr) ||
+        !entry->storage.CopyFrom(scratch_)) {
+        DeleteEntry(entry);
+        return nullptr;
+    }
+    const Rect32* rects = nullptr;
+    rasterizer.GetClipRegion(rects);
+    for (uint32_t i = 0; i < key.numRegionRects; i++) {
+        GetBounds(rects[i], entry->region + i * RECT_BOUNDS);
+    }
+    entry->dataSize = entry->storage.GetSerializedSize() + key.numVertices * sizeof(CacheVertex) +
+                      regionSize * sizeof(int32_t);
+    entry->prev = nullptr;
+    entry->next = nullptr;
+    entry->nextInBucket = nullptr;
+    entry->cached = false;
+    return entry;
+}
+
+void RasterizedPathCache::Insert(CacheEntry* entry)
+{
+    entry->prev = nullptr;
+    entry->next = head_;
+    if (head_ != nullptr) {
+        head_->prev = entry;
+    }
+    head_ = entry;
+    if (tail_ == nullptr) {
+        tail_ = entry;
+    }
+}
+
+void RasterizedPathCache::Unlink(CacheEntry* entry)
+{
+    if (entry->prev != nullptr) {
+        entry->prev->next = entry->next;
+    } else {
+        head_ = entry->next;
+    }
+    if (entry->next != nullptr) {
+        entry->next->prev = entry->prev;
+    } else {
+        tail_ = entry->prev;
+    }
+    entry->prev = nullptr;
+    entry->next = nullptr;
+}
+
+/**
+ * @brief Drop the least recently used entries until at most byteBudget bytes are cached.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizedPathCache::Evict(uint32_t byteBudget)
+{
+    while (tail_ != nullptr && stats_.bytes > byteBudget) {
+        CacheEntry* entry = tail_;
+        Unlink(entry);
+        CacheEntry** link = &buckets_[BucketOf(entry->key)];
+        while (*link != entry) {
+            link = &(*link)->nextInBucket;
+        }
+        *link = entry->nextInBucket;
+        stats_.entries--;
+        stats_.bytes -= entry->dataSize + sizeof(CacheEntry);
+        stats_.evictions++;
+        if (current_ == entry) {
+            current_ = nullptr;
+        }
+        DeleteEntry(entry);
+    }
+}
+
+void RasterizedPathCache::ReleaseCurrent()
+{
+    if (current_ != nullptr && !current_->cached) {
+        DeleteEntry(current_);
+    }
+    current_ = nullptr;
+    passThrough_ = nullptr;
+}
+
+void RasterizedPathCache::DeleteEntry(CacheEntry* entry)
+{
+    if (entry->vertices != nullptr) {
+        GeometryArrayAllocator<CacheVertex>::Deallocate(entry->vertices, entry->key.numVertices);
+    }
+    if (entry->region != nullptr) {
+        GeometryArrayAllocator<int32_t>::Deallocate(entry->region, entry->key.numRegionRects * RECT_BOUNDS);
+    }
+    delete entry;
+}
+
+void RasterizedPathCache::SetByteBudget(uint32_t byteBudget)
+{
+    byteBudget_ = byteBudget;
+    Evict(byteBudget_);
+}
+
+void RasterizedPathCache::Clear()
+{
+    ReleaseCurrent();
+    uint32_t evictions = stats_.evictions;
+    Evict(0);
+    stats_.evictions = evictions;
+}
+
+bool RasterizedPathCache::RewindScanlines()
+{
+    if (passThrough_ != nullptr) {
+        return passThrough_->RewindScanlines();
+    }
+    return current_ != nullptr && current_->storage.RewindScanlines();
+}
+
+template <class Scanline>
+bool RasterizedPathCache::SweepScanline(Scanline& sl)
+{
+    if (passThrough_ != nullptr) {
+        return passThrough_->SweepScanline(sl);
+    }
+    return current_ != nullptr && current_->storage.SweepScanline(sl);
+}
+
+template bool RasterizedPathCache::SweepScanline<GeometryScanline>(GeometryScanline& sl);
+template bool RasterizedPathCache::SweepScanline<GeometryScanlinePacked>(GeometryScanlinePacked& sl);
+} // namespace OHOS
@@ -18,41 +18,57 @@
 #include "securec.h"
 
 namespace OHOS {
-RasterizerCellsAntiAlias::~RasterizerCellsAntiAlias()
+template <class Cell>
+RasterizerCells<Cell>::~RasterizerCells()
 {
-    if (numBlocks_) {
-        CellBuildAntiAlias** ptr = cells_ + numBlocks_ - 1;
-        while (numBlocks_--) {
-            GeometryArrayAllocator<CellBuildAntiAlias>::Deallocate(*ptr, CELL_BLOCK_SIZE);
-            ptr--;
-        }
-        GeometryArrayAllocator<CellBuildAntiAlias*>::Deallocate(cells_, maxBlocks_);
-        GeometryArrayAllocator<CellBuildAntiAlias*>::Deallocate(sortedCells_, numCells_ + CELLS_SIZE);
-        GeometryArrayAllocator<SortedYLevel>::Deallocate(sortedY_, maxY_ - minY_ + 1 + CELLS_SIZE);
-    }
+    while (numBlocks_) {
+        GeometryArrayAllocator<Cell>::Deallocate(cells_[--numBlocks_], CELL_BLOCK_SIZE);
+    }
+    GeometryArrayAllocator<Cell*>::Deallocate(cells_, maxBlocks_);
+    GeometryArrayAllocator<Cell*>::Deallocate(sortedCells_, sortedCellsCapacity_);
+    GeometryArrayAllocator<SortedYLevel>::Deallocate(sortedY_, sortedYCapacity_);
+    GeometryArrayAllocator<Cell>::Deallocate(sortedCellValues_, sortedCellValuesCapacity_);
+    GeometryArrayAllocator<Cell>::Deallocate(radixRow_, radixRowCapacity_);
 }
 
 /**
- * @brief RasterizerCellsAntiAlias Class constructor
+ * @brief RasterizerCells Class constructor
  * initialization numBlocks_,maxBlocks_,currBlock_ Other attributes
  * @since 1.0
  * @version 1.0
  */
-RasterizerCellsAntiAlias::RasterizerCellsAntiAlias(uint32_t cellBlockLimit)
+template <class Cell>
+RasterizerCells<Cell>::RasterizerCells(uint32_t cellBlockLimit)
     : numBlocks_(0),
       maxBlocks_(0),
       currBlock_(0),
       numCells_(0),
+      droppedCells_(0),
       cellBlockLimit_(cellBlockLimit),
+      reservedBlocks_(0),
       cells_(0),
       currCellPtr_(0),
       sortedCells_(nullptr),
+      sortedCellsCapacity_(0),
       sortedY_(nullptr),
+      sortedYCapacity_(0),
+      sortedCellValues_(nullptr),
+      sortedCellValuesCapacity_(0),
+      radixRow_(nullptr),
+      radixRowCapacity_(0),
+      dense_(nullptr),
+      memoryBytes_(0),
+      peakMemoryBytes_(0),
+      sortMode_(Cell::DEFAULT_SORT_BY_VALUE ? CELL_SORT_RADIX : CELL_SORT_QUICK),
       minX_(INT32_MAX),
       minY_(INT32_MAX),
       maxX_(INT32_MIN),
       maxY_(INT32_MIN),
-      sorted_(false)
+      windowMinY_(INT32_MIN),
+      windowMaxY_(INT32_MAX),
+      sorted_(false),
+      sortedByValue_(false),
+      retainCapacity_(true)
 {
     styleCell_.Initial();
     currCell_.Initial();
@@ -63,17 +79,97 @@ RasterizerCellsAntiAlias::RasterizerCellsAntiAlias(uint32_t cellBlockLimit)
  * @since 1.0
  * @version 1.0
  */
-void RasterizerCellsAntiAlias::Reset()
+template <class Cell>
+void RasterizerCells<Cell>::Reset()
 {
     numCells_ = 0;
+    droppedCells_ = 0;
     currBlock_ = 0;
     currCell_.Initial();
     styleCell_.Initial();
     sorted_ = false;
+    sortedByValue_ = false;
+    dense_ = nullptr;
     minX_ = INT32_MAX;
     minY_ = INT32_MAX;
     maxX_ = INT32_MIN;
     maxY_ = INT32_MIN;
+    if (!retainCapacity_) {
+        ShrinkToFit();
+    }
+}
+
+/**
+ * @brief Make sure buffer holds at least size elements, the capacity grows geometrically
+ * and the old content is dropped.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Cell>
+template <class T>
+bool RasterizerCells<Cell>::ReserveSortBuffer(T*& buffer, uint32_t& capacity, uint32_t size)
+{
+    if (size <= capacity && buffer != nullptr) {
+        return true;
+    }
+    uint32_t newCapacity = capacity << 1;
+    if (newCapacity < size) {
+        newCapacity = size;
+    }
+    ReleaseSortBuffer(buffer, capacity);
+    buffer = GeometryArrayAllocator<T>::Allocate(newCapacity);
+    if (buffer == nullptr) {
+        GRAPHIC_LOGE("RasterizerCells::ReserveSortBuffer allocate fail\n");
+        return false;
+    }
+    capacity = newCapacity;
+    memoryBytes_ += capacity * sizeof(T);
+    if (memoryBytes_ > peakMemoryBytes_) {
+        peakMemoryBytes_ = memoryBytes_;
+    }
+    return true;
+}
+
+template <class Cell>
+template <class T>
+void RasterizerCells<Cell>::ReleaseSortBuffer(T*& buffer, uint32_t& capacity)
+{
+    if (buffer != nullptr) {
+        GeometryArrayAllocator<T>::Deallocate(buffer, capacity);
+        memoryBytes_ -= capacity * sizeof(T);
+        buffer = nullptr;
+    }
+    capacity = 0;
+}
+
+/**
+ * @brief Release the cell blocks and sort buffers that the current cells do not use.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Cell>
+void RasterizerCells<Cell>::ShrinkToFit()
+{
+    while (numBlocks_ > currBlock_) {
+        GeometryArrayAllocator<Cell>::Deallocate(cells_[--numBlocks_], CELL_BLOCK_SIZE);
+        memoryBytes_ -= CELL_BLOCK_SIZE * sizeof(Cell);
+    }
+    if (numBlocks_ == 0 && cells_ != nullptr) {
+        GeometryArrayAllocator<Cell*>::Deallocate(cells_, maxBlocks_);
+        memoryBytes_ -= maxBlocks_ * sizeof(Cell*);
+        cells_ = nullptr;
+        maxBlocks_ = 0;
+    }
+    if (!sorted_ || sortedByValue_) {
+        ReleaseSortBuffer(sortedCells_, sortedCellsCapacity_);
+    }
+    if (!sorted_ || !sortedByValue_) {
+        ReleaseSortBuffer(sortedCellValues_, sortedCellValuesCapacity_);
+    }
+    ReleaseSortBuffer(radixRow_, radixRowCapacity_);
+    if (!sorted_) {
+        ReleaseSortBuffer(sortedY_, sortedYCapacity_);
+    }
 }
 
 /**
@@ -81,17 +177,27 @@ void RasterizerCellsAntiAlias::Reset()
  * @since 1.0
  * @version 1.0
  */
-void RasterizerCellsAntiAlias::AddCurrentCell()
+template <class Cell>
+void RasterizerCells<Cell>::AddCurrentCell()
 {
     bool areaCoverFlags = currCell_.area | currCell_.cover;
-    if (areaCoverFlags) {
+    if (areaCoverFlags && currCell_.y >= windowMinY_ && currCell_.y <= windowMaxY_) {
+        if (dense_ != nullptr) {
+            if (dense_->AddCell(currCell_.x, currCell_.y, currCell_.cover, currCell_.area)) {
+                ++numCells_;
+            } else {
+                ++droppedCells_;
+            }
+            return;
+        }
         // Reach CELL_BLOCK_MASK After the number of mask, re allocate memory
         if ((numCells_ & CELL_BLOCK_MASK) == 0) {
-            // Exceeds the memory block size limit. The default is 1024 limit
-            if (numBlocks_ >= cellBlockLimit_) {
+            // Exceeds the memory block size limit less the reserved blocks. The default is 1024 limit,
+            // retained blocks beyond currBlock_ are reused before the limit applies
+            if (currBlock_ + reservedBlocks_ >= cellBlockLimit_ || !AllocateBlock()) {
+                ++droppedCells_;
                 return;
             }
-            AllocateBlock();
         }
         *currCellPtr_++ = currCell_;
         ++numCells_;
@@ -103,7 +209,8 @@ void RasterizerCellsAntiAlias::AddCurrentCell()
  * @since 1.0
  * @version 1.0
  */
-inline void RasterizerCellsAntiAlias::SetCurrentCell(int32_t x, int32_t y)
+template <class Cell>
+inline void RasterizerCells<Cell>::SetCurrentCell(int32_t x, int32_t y)
 {
     if (currCell_.NotEqual(x, y, styleCell_)) {
         AddCurrentCell();
@@ -115,7 +222,8 @@ inline void RasterizerCellsAntiAlias::SetCurrentCell(int32_t x, int32_t y)
     }
 }
 
-void RasterizerCellsAntiAlias::OutLineLegal(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+template <class Cell>
+void RasterizerCells<Cell>::OutLineLegal(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
 {
     /**
      * outline range
@@ -153,7 +261,8 @@ void RasterizerCellsAntiAlias::OutLineLegal(int32_t x1, int32_t y1, int32_t x2,
  * @since 1.0
  * @version 1.0
  */
-void RasterizerCellsAntiAlias::RenderHorizonline(
+template <class Cell>
+void RasterizerCells<Cell>::RenderHorizonline(
     int32_t ey, int32_t x1, int32_t polySubpixelMaskY1, int32_t x2, int32_t polySubpixelMaskY2)
 {
     /**
@@ -240,7 +349,8 @@ void RasterizerCellsAntiAlias::RenderHorizonline(
     currCell_.area += (submaskFlagsX2 + POLY_SUBPIXEL_SCALE - first) * delta;
 }
 
-inline void RasterizerCellsAntiAlias::SetStyle(const CellBuildAntiAlias& styleCell)
+template <class Cell>
+inline void RasterizerCells<Cell>::SetStyle(const CellBuildAntiAlias& styleCell)
 {
     styleCell_.Style(styleCell);
 }
@@ -251,7 +361,8 @@ inline void RasterizerCellsAntiAlias::SetStyle(const CellBuildAntiAlias& styleCe
  * @since 1.0
  * @version 1.0
  */
-void RasterizerCellsAntiAlias::LineOperate(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+template <class Cell>
+void RasterizerCells<Cell>::LineOperate(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
 {
     int64_t dx = static_cast<int64_t>(x2) - static_cast<int64_t>(x1);
     /**
@@ -284,6 +395,10 @@ void RasterizerCellsAntiAlias::LineOperate(int32_t x1, int32_t y1, int32_t x2, i
     int64_t deltaxMask;
 
     OutLineLegal(ex1, ey1, ex2, ey2);
+    // Lines entirely above or below the Y window only touch cells that AddCurrentCell drops
+    if ((ey1 < windowMinY_ && ey2 < windowMinY_) || (ey1 > windowMaxY_ && ey2 > windowMaxY_)) {
+        return;
+    }
     SetCurrentCell(ex1, ey1);
 
     /**
@@ -331,7 +446,8 @@ void RasterizerCellsAntiAlias::LineOperate(int32_t x1, int32_t y1, int32_t x2, i
     RenderHorizonline(ey1, xFrom, POLY_SUBPIXEL_SCALE - first, x2, submaskFlagsY2);
 }
 
-void RasterizerCellsAntiAlias::RenderVerticalLine(int32_t& x1, int32_t& ex1, int64_t& dy, int32_t& first,
+template <class Cell>
+void RasterizerCells<Cell>::RenderVerticalLine(int32_t& x1, int32_t& ex1, int64_t& dy, int32_t& first,
                                                   int32_t& increase, int32_t& xFrom, int32_t& submaskFlagsY1,
                                                   int32_t& submaskFlagsY2, int32_t& ey1, int32_t& ey2, int32_t& delta)
 {
@@ -371,7 +487,8 @@ void RasterizerCellsAntiAlias::RenderVerticalLine(int32_t& x1, int32_t& ex1, int
     currCell_.area += twoFx * delta;
 }
 
-void RasterizerCellsAntiAlias::RenderObliqueLine(int64_t& dx, int64_t& dy, int32_t& first,
+template <class Cell>
+void RasterizerCells<Cell>::RenderObliqueLine(int64_t& dx, int64_t& dy, int32_t& first,
                                                  int32_t& increase, int32_t& xFrom, int64_t& deltaxMask,
                                                  int32_t& ey1, int32_t& ey2, int32_t& delta)
 {
@@ -392,51 +509,84 @@ void RasterizerCellsAntiAlias::RenderObliqueLine(int64_t& dx, int64_t& dy, int32
             delta++;
         }
         int32_t xTo = xFrom + delta;
-        RenderHorizonline(ey1, xFrom, POLY_SUBPIXEL_SCALE - first, xTo, first);
+        if (ey1 >= windowMinY_ && ey1 <= windowMaxY_) {
+            RenderHorizonline(ey1, xFrom, POLY_SUBPIXEL_SCALE - first, xTo, first);
+        }
         xFrom = xTo;
         ey1 += increase;
         SetCurrentCell(xFrom >> POLY_SUBPIXEL_SHIFT, ey1);
     }
 }
 
+template <class Cell>
+bool RasterizerCells<Cell>::ReserveMemory(uint32_t bytes)
+{
+    uint32_t blockBytes = CELL_BLOCK_SIZE * sizeof(Cell);
+    uint32_t numBlocks = bytes / blockBytes + ((bytes % blockBytes != 0) ? 1 : 0);
+    if (numBlocks > cellBlockLimit_ || currBlock_ > cellBlockLimit_ - numBlocks) {
+        return false;
+    }
+    reservedBlocks_ = numBlocks;
+    while (numBlocks_ > currBlock_ && numBlocks_ > cellBlockLimit_ - reservedBlocks_) {
+        GeometryArrayAllocator<Cell>::Deallocate(cells_[--numBlocks_], CELL_BLOCK_SIZE);
+        memoryBytes_ -= blockBytes;
+    }
+    return true;
+}
+
 /**
  * @brief Allocate array space for cells during rasterization.
+ * @return false if the block can not be allocated, currCellPtr_ must not be written then.
  * @since 1.0
  * @version 1.0
  */
-void RasterizerCellsAntiAlias::AllocateBlock()
+template <class Cell>
+bool RasterizerCells<Cell>::AllocateBlock()
 {
     if (currBlock_ >= numBlocks_) {
         if (numBlocks_ >= maxBlocks_) {
-            CellBuildAntiAlias** newCells =
-                GeometryArrayAllocator<CellBuildAntiAlias*>::Allocate(maxBlocks_ +
-                                                            CELL_BLOCK_POOL);
+            uint32_t newMaxBlocks = maxBlocks_ +
+                ((maxBlocks_ > CELL_BLOCK_POOL) ? maxBlocks_ : static_cast<uint32_t>(CELL_BLOCK_POOL));
+            Cell** newCells = GeometryArrayAllocator<Cell*>::Allocate(newMaxBlocks);
             if (newCells == nullptr) {
-                return;
+                return false;
             }
             if (cells_) {
-                if (memcpy_s(newCells, maxBlocks_ * sizeof(CellBuildAntiAlias*),
-                             cells_, maxBlocks_ * sizeof(CellBuildAntiAlias*)) != EOK) {
-                    GRAPHIC_LOGE("RasterizerCellsAntiAlias::AllocateBlock memcpy_s fail\n");
-                    return;
+                if (memcpy_s(newCells, newMaxBlocks * sizeof(Cell*),
+                             cells_, maxBlocks_ * sizeof(Cell*)) != EOK) {
+                    GRAPHIC_LOGE("RasterizerCells::AllocateBlock memcpy_s fail\n");
+                    GeometryArrayAllocator<Cell*>::Deallocate(newCells, newMaxBlocks);
+                    return false;
                 }
-                GeometryArrayAllocator<CellBuildAntiAlias*>::Deallocate(cells_, maxBlocks_);
+                GeometryArrayAllocator<Cell*>::Deallocate(cells_, maxBlocks_);
             }
+            memoryBytes_ += (newMaxBlocks - maxBlocks_) * sizeof(Cell*);
             cells_ = newCells;
-            maxBlocks_ += CELL_BLOCK_POOL;
+            maxBlocks_ = newMaxBlocks;
+        }
+        Cell* block = GeometryArrayAllocator<Cell>::Allocate(CELL_BLOCK_SIZE);
+        if (block == nullptr) {
+            return false;
+        }
+        cells_[numBlocks_++] = block;
+        memoryBytes_ += CELL_BLOCK_SIZE * sizeof(Cell);
+        if (memoryBytes_ > peakMemoryBytes_) {
+            peakMemoryBytes_ = memoryBytes_;
         }
-        cells_[numBlocks_++] = GeometryArrayAllocator<CellBuildAntiAlias>::Allocate(CELL_BLOCK_SIZE);
     }
 
     currCellPtr_ = cells_[currBlock_++];
+    return true;
 }
+
 /**
  * @brief In the rasterization process, all cells are rasterized according to
  * Sort from left to right and from top to bottom.
  * @since 1.0
  * @version 1.0
  */
-void RasterizerCellsAntiAlias::SortAllCells()
+template <class Cell>
+void RasterizerCells<Cell>::SortAllCells()
 {
     if (sorted_) {
         return; // Perform sort only the first time.
@@ -450,20 +600,27 @@ void RasterizerCellsAntiAlias::SortAllCells()
     if (numCells_ == 0) {
         return;
     }
+    minY_ = MATH_MAX(minY_, windowMinY_);
+    maxY_ = MATH_MIN(maxY_, windowMaxY_);
+    if (dense_) {
+        // The dense rows are already in order, GetDenseRow reads them
+        sorted_ = true;
+        return;
+    }
 
-    // Allocate the array of cell pointers
-    sortedCells_ = GeometryArrayAllocator<CellBuildAntiAlias*>::Allocate(numCells_ + CELLS_SIZE);
-
-    // Allocate and zero the Y array
+    // Reuse and zero the Y array, the lookups allow CELLS_SIZE + 1 entries past the last row
     int32_t sortedYSize = maxY_ - minY_ + 1;
-    sortedY_ = GeometryArrayAllocator<SortedYLevel>::Allocate(sortedYSize + CELLS_SIZE);
-    if (memset_s(sortedY_, sizeof(SortedYLevel) * sortedYSize, 0, sizeof(SortedYLevel) * sortedYSize) != EOK) {
+    uint32_t sortedYLevels = sortedYSize + CELLS_SIZE + 1;
+    if (!ReserveSortBuffer(sortedY_, sortedYCapacity_, sortedYLevels)) {
+        return;
+    }
+    if (memset_s(sortedY_, sizeof(SortedYLevel) * sortedYCapacity_, 0, sizeof(SortedYLevel) * sortedYLevels) != EOK) {
         GRAPHIC_LOGE("CleanData fail");
     }
 
     // Create the Y-histogram (count the numbers of cells for each Y)
-    CellBuildAntiAlias** blockPtr = cells_;
-    CellBuildAntiAlias* cellPtr = nullptr;
+    Cell** blockPtr = cells_;
+    Cell* cellPtr = nullptr;
     uint32_t nb = numCells_;
     uint32_t i = 0;
     while (nb) {
@@ -482,10 +639,25 @@ void RasterizerCellsAntiAlias::SortAllCells()
 
     // Convert the Y-histogram into the array of starting indexes
     uint32_t start = 0;
+    uint32_t maxRowCells = 0;
     for (i = 0; i < sortedYSize; i++) {
         uint32_t v = sortedY_[i].start;
         sortedY_[i].start = start;
         start += v;
+        if (v > maxRowCells) {
+            maxRowCells = v;
+        }
+    }
+
+    if (sortMode_ == CELL_SORT_RADIX && SortCellsRadix(maxRowCells)) {
+        sortedByValue_ = true;
+        sorted_ = true;
+        return;
+    }
+
+    // Reuse the array of cell pointers
+    if (!ReserveSortBuffer(sortedCells_, sortedCellsCapacity_, numCells_ + CELLS_SIZE)) {
+        return;
     }
 
     // Fill the cell pointer array sorted by Y
@@ -513,7 +685,107 @@ void RasterizerCellsAntiAlias::SortAllCells()
     sorted_ = true;
 }
 
-void QsortCellsSweep(CellBuildAntiAlias*** base, CellBuildAntiAlias*** iIndex, CellBuildAntiAlias*** jIndex)
+/**
+ * @brief Sort the cells by value: a stable scatter into the Y buckets of sortedY_,
+ * then every row is sorted on its row-relative X.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Cell>
+bool RasterizerCells<Cell>::SortCellsRadix(uint32_t maxRowCells)
+{
+    if (!ReserveSortBuffer(sortedCellValues_, sortedCellValuesCapacity_, numCells_ + CELLS_SIZE) ||
+        (maxRowCells > RADIX_ROW_THRESHOLD && !ReserveSortBuffer(radixRow_, radixRowCapacity_, maxRowCells))) {
+        GRAPHIC_LOGE("RasterizerCells::SortCellsRadix fall back to quicksort\n");
+        ReleaseSortBuffer(sortedCellValues_, sortedCellValuesCapacity_);
+        ReleaseSortBuffer(radixRow_, radixRowCapacity_);
+        return false;
+    }
+
+    // The Y-histogram already holds the starting indexes, copy the cells from their blocks into the rows
+    uint32_t nb = numCells_;
+    for (Cell** blockPtr = cells_; nb; blockPtr++) {
+        uint32_t i = (nb > CELL_BLOCK_SIZE) ? uint32_t(CELL_BLOCK_SIZE) : nb;
+        nb -= i;
+        const Cell* cellPtr = *blockPtr;
+        while (i--) {
+            SortedYLevel& currY = sortedY_[cellPtr->y - minY_];
+            sortedCellValues_[currY.start + currY.num] = *cellPtr++;
+            ++currY.num;
+        }
+    }
+
+    uint32_t sortedYSize = static_cast<uint32_t>(maxY_ - minY_ + 1);
+    for (uint32_t y = 0; y < sortedYSize; y++) {
+        const SortedYLevel& currY = sortedY_[y];
+        Cell* row = sortedCellValues_ + currY.start;
+        if (currY.num > RADIX_ROW_THRESHOLD) {
+            SortRowRadix(row, currY.num);
+            continue;
+        }
+        // Short rows are insertion sorted in place
+        for (uint32_t i = 1; i < currY.num; i++) {
+            Cell cell = row[i];
+            uint32_t j = i;
+            for (; j > 0 && cell.x < row[j - 1].x; j--) {
+                row[j] = row[j - 1];
+            }
+            row[j] = cell;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Stable counting passes over the digits of the row-relative X, least significant first.
+ * The key is relative to the smallest X of the row, the cells of an edge may reach one pixel past minX_.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Cell>
+void RasterizerCells<Cell>::SortRowRadix(Cell* row, uint32_t num)
+{
+    int32_t rowMinX = row[0].x;
+    int32_t rowMaxX = row[0].x;
+    for (uint32_t i = 1; i < num; i++) {
+        rowMinX = MATH_MIN(rowMinX, static_cast<int32_t>(row[i].x));
+        rowMaxX = MATH_MAX(rowMaxX, static_cast<int32_t>(row[i].x));
+    }
+    uint32_t width = GetRadixKey(rowMaxX, rowMinX);
+    uint32_t passes = 1;
+    while (passes < RADIX_MAX_PASSES && (width >> (RADIX_SHIFT * passes)) != 0) {
+        passes++;
+    }
+
+    Cell* src = row;
+    Cell* dst = radixRow_;
+    uint32_t count[RADIX_SIZE];
+    for (uint32_t pass = 0; pass < passes; pass++) {
+        uint32_t shift = RADIX_SHIFT * pass;
+        if (memset_s(count, sizeof(count), 0, sizeof(count)) != EOK) {
+            GRAPHIC_LOGE("RasterizerCells::SortRowRadix memset_s fail\n");
+        }
+        for (uint32_t i = 0; i < num; i++) {
+            count[(GetRadixKey(src[i].x, rowMinX) >> shift) & RADIX_MASK]++;
+        }
+        uint32_t start = 0;
+        for (uint32_t digit = 0; digit < RADIX_SIZE; digit++) {
+            uint32_t v = count[digit];
+            count[digit] = start;
+            start += v;
+        }
+        for (uint32_t i = 0; i < num; i++) {
+            dst[count[(GetRadixKey(src[i].x, rowMinX) >> shift) & RADIX_MASK]++] = src[i];
+        }
+        SwapCells(&src, &dst);
+    }
+    if (src != row && memcpy_s(row, num * sizeof(Cell), src, num * sizeof(Cell)) != EOK) {
+        GRAPHIC_LOGE("RasterizerCells::SortRowRadix memcpy_s fail\n");
+    }
+}
+
+template <class Cell>
+void QsortCellsSweep(Cell*** base, Cell*** iIndex, Cell*** jIndex)
 {
     /**
      * Sorting guarantees the value of * i < = * the value of base < = * the value of j
@@ -546,14 +818,15 @@ void QsortCellsSweep(CellBuildAntiAlias*** base, CellBuildAntiAlias*** iIndex, C
     }
 }
 
-void QsortCells(CellBuildAntiAlias** start, uint32_t num)
+template <class Cell>
+void QsortCells(Cell** start, uint32_t num)
 {
     const int32_t QSORT_THRESHOLD = 9;
     const int32_t stackSize = 80;
-    CellBuildAntiAlias** stack[stackSize];
-    CellBuildAntiAlias*** top;
-    CellBuildAntiAlias** limit;
-    CellBuildAntiAlias** base;
+    Cell** stack[stackSize];
+    Cell*** top;
+    Cell** limit;
+    Cell** base;
 
     limit = start + num;
     base = start;
@@ -562,14 +835,14 @@ void QsortCells(CellBuildAntiAlias** start, uint32_t num)
     while (true) {
         int32_t len = int32_t(limit - base);
 
-        CellBuildAntiAlias** iIndex;
-        CellBuildAntiAlias** jIndex;
+        Cell** iIndex;
+        Cell** jIndex;
 
         if (len > QSORT_THRESHOLD) {
             /**
              * First exchange base + len / 2 as the pivot
              */
-            CellBuildAntiAlias** pivot = base + len / TWO_TIMES;
+            Cell** pivot = base + len / TWO_TIMES;
             SwapCells(base, pivot);
 
             iIndex = base + 1;
@@ -605,8 +878,8 @@ void QsortCells(CellBuildAntiAlias** start, uint32_t num)
     }
 }
 
-void QsortCellsFor(CellBuildAntiAlias*** iIndex, CellBuildAntiAlias*** jIndex,
-                   CellBuildAntiAlias*** limit, CellBuildAntiAlias*** base)
+template <class Cell>
+void QsortCellsFor(Cell*** iIndex, Cell*** jIndex, Cell*** limit, Cell*** base)
 {
     for (; *iIndex < *limit; (*iIndex)++) {
         for (; (*jIndex)[1]->x < (**jIndex)->x; (*jIndex)--) {
@@ -618,4 +891,7 @@ void QsortCellsFor(CellBuildAntiAlias*** iIndex, CellBuildAntiAlias*** jIndex,
         *jIndex = *iIndex;
     }
 }
+
+template class RasterizerCells<CellBuildAntiAlias>;
+template class RasterizerCells<CellPackedAntiAlias>;
 } // namespace OHOS
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_dense_coverage.h"
+#include "gfx_utils/graphic_log.h"
+#include "securec.h"
+#if defined(ARM_NEON_OPT)
+#include "graphic_neon_utils.h"
+#elif defined(X86_SSE2_OPT)
+#include <emmintrin.h>
+#endif
+
+namespace OHOS {
+#ifdef X86_SSE2_OPT
+namespace {
+constexpr uint32_t SSE2_STEP_4 = 4;
+} // namespace
+#endif
+
+RasterizerDenseCoverage::RasterizerDenseCoverage()
+    : cells_(nullptr),
+      cellsCapacity_(0),
+      rows_(nullptr),
+      rowsCapacity_(0),
+      minX_(0),
+      minY_(0),
+      width_(0),
+      height_(0),
+      memoryBytes_(0),
+      peakMemoryBytes_(0),
+      retainCapacity_(true),
+      active_(false)
+{
+}
+
+RasterizerDenseCoverage::~RasterizerDenseCoverage()
+{
+    Release(cells_, cellsCapacity_);
+    Release(rows_, rowsCapacity_);
+}
+
+/**
+ * @brief Make sure buffer holds at least size elements, the capacity grows geometrically
+ * and the old content is dropped.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class T>
+bool RasterizerDenseCoverage::Reserve(T*& buffer, uint32_t& capacity, uint32_t size)
+{
+    if (size <= capacity && buffer != nullptr) {
+        return true;
+    }
+    uint32_t newCapacity = capacity << 1;
+    if (newCapacity < size) {
+        newCapacity = size;
+    }
+    Release(buffer, capacity);
+    buffer = GeometryArrayAllocator<T>::Allocate(newCapacity);
+    if (buffer == nullptr) {
+        GRAPHIC_LOGE("RasterizerDenseCoverage::Reserve allocate fail\n");
+        return false;
+    }
+    capacity = newCapacity;
+    memoryBytes_ += capacity * sizeof(T);
+    if (memoryBytes_ > peakMemoryBytes_) {
+        peakMemoryBytes_ = memoryBytes_;
+    }
+    return true;
+}
+
+template <class T>
+void RasterizerDenseCoverage::Release(T*& buffer, uint32_t& capacity)
+{
+    if (buffer != nullptr) {
+        GeometryArrayAllocator<T>::Deallocate(buffer, capacity);
+        memoryBytes_ -= capacity * sizeof(T);
+        buffer = nullptr;
+    }
+    capacity = 0;
+}
+
+bool RasterizerDenseCoverage::SetBounds(int32_t minX, int32_t minY, int32_t maxX, int32_t maxY)
+{
+    Reset();
+    if (maxX < minX || maxY < minY) {
+        return false;
+    }
+    uint32_t width = static_cast<uint32_t>(maxX - minX + 1);
+    uint32_t height = static_cast<uint32_t>(maxY - minY + 1);
+    if (!Reserve(cells_, cellsCapacity_, width * height) || !Reserve(rows_, rowsCapacity_, height)) {
+        return false;
+    }
+    if (memset_s(cells_, cellsCapacity_ * sizeof(DenseCell), 0, width * height * sizeof(DenseCell)) != EOK) {
+        GRAPHIC_LOGE("RasterizerDenseCoverage::SetBounds memset_s fail\n");
+        return false;
+    }
+    for (uint32_t row = 0; row < height; row++) {
+        rows_[row].minX = INT32_MAX;
+        rows_[row].maxX = INT32_MIN;
+    }
+    minX_ = minX;
+    minY_ = minY;
+    width_ = static_cast<int32_t>(width);
+    height_ = static_cast<int32_t>(height);
+    active_ = true;
+    return true;
+}
+
+void RasterizerDenseCoverage::Reset()
+{
+    active_ = false;
+    width_ = 0;
+    height_ = 0;
+    if (!retainCapacity_) {
+        ShrinkToFit();
+    }
+}
+
+void RasterizerDenseCoverage::ShrinkToFit()
+{
+    if (!active_) {
+        Release(cells_, cellsCapacity_);
+        Release(rows_, rowsCapacity_);
+    }
+}
+
+/**
+ * @brief The vector paths load 4 pixels, prefix sum their covers in 2 shifted adds
+ * and carry the last lane into the next 4 pixels.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerDenseCoverage::PrefixSum(const DenseCell* cells, uint32_t num, int32_t& cover, int32_t* areas)
+{
+    uint32_t i = 0;
+#if defined(ARM_NEON_OPT)
+    const int32x4_t zero = vdupq_n_s32(0);
+    for (; i + NEON_STEP_4 <= num; i += NEON_STEP_4) {
+        // val[0] holds the covers and val[1] the areas of 4 pixels
+        int32x4x2_t pixels = vld2q_s32(reinterpret_cast<const int32_t*>(cells + i));
+        int32x4_t covers = vaddq_s32(pixels.val[0], vextq_s32(zero, pixels.val[0], 3)); // 3: shift in 1 lane
+        covers = vaddq_s32(covers, vextq_s32(zero, covers, 2)); // 2: shift in 2 lanes
+        covers = vaddq_s32(covers, vdupq_n_s32(cover));
+        cover = vgetq_lane_s32(covers, 3); // 3: last lane
+        vst1q_s32(areas + i, vsubq_s32(vshlq_n_s32(covers, POLY_SUBPIXEL_SHIFT + 1), pixels.val[1]));
+    }
+#elif defined(X86_SSE2_OPT)
+    for (; i + SSE2_STEP_4 <= num; i += SSE2_STEP_4) {
+        // Pixels 0 and 1, then 2 and 3, each as cover and area
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells + i));
+        __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells + i + 2)); // 2: pixels 2 and 3
+        // Deinterleave into the covers and the areas of the 4 pixels
+        __m128i lowSwapped = _mm_shuffle_epi32(low, _MM_SHUFFLE(3, 1, 2, 0));
+        __m128i highSwapped = _mm_shuffle_epi32(high, _MM_SHUFFLE(3, 1, 2, 0));
+        __m128i covers = _mm_unpacklo_epi64(lowSwapped, highSwapped);
+        __m128i pixelAreas = _mm_unpackhi_epi64(lowSwapped, highSwapped);
+        covers = _mm_add_epi32(covers, _mm_slli_si128(covers, 4)); // 4: shift in 1 lane
+        covers = _mm_add_epi32(covers, _mm_slli_si128(covers, 8)); // 8: shift in 2 lanes
+        covers = _mm_add_epi32(covers, _mm_set1_epi32(cover));
+        cover = _mm_cvtsi128_si32(_mm_shuffle_epi32(covers, _MM_SHUFFLE(3, 3, 3, 3)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(areas + i),
+                         _mm_sub_epi32(_mm_slli_epi32(covers, POLY_SUBPIXEL_SHIFT + 1), pixelAreas));
+    }
+#endif
+    for (; i < num; i++) {
+        cover += cells[i].cover;
+        areas[i] = (cover << (POLY_SUBPIXEL_SHIFT + 1)) - cells[i].area;
+    }
+}
+} // namespace OHOS
@@ -14,8 +14,34 @@
  */
 
 #include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/graphic_log.h"
+#include "securec.h"
+#if defined(ARM_NEON_OPT)
+#include "graphic_neon_utils.h"
+#elif defined(X86_SSE2_OPT)
+#include <emmintrin.h>
+#endif
 
 namespace OHOS {
+namespace {
+#ifdef X86_SSE2_OPT
+constexpr uint32_t SSE2_STEP_4 = 4;
+constexpr uint32_t SSE2_STEP_8 = 8;
+#endif
+
+template <class Cell>
+inline const Cell* CellAt(const Cell* const* cells)
+{
+    return *cells;
+}
+
+template <class Cell>
+inline const Cell* CellAt(const Cell* cells)
+{
+    return cells;
+}
+} // namespace
+
 /**
  * @brief Scan line that gets a y value from rasterizer stage
  * And iterate the cell array of the current scan line to obtain area->cover，
@@ -26,50 +52,41 @@ namespace OHOS {
  * @since 1.0
  * @version 1.0
  */
-bool RasterizerScanlineAntialias::SweepScanline(GeometryScanline& sl)
+template <class Scanline>
+bool RasterizerScanlineAntialias::SweepScanline(Scanline& sl)
 {
     while (true) {
-        if (scanY_ > outline_.GetMaxY()) {
-            return false;
+        bool shape = (shapes_.GetShape() != RasterizerShapeFastPath::SHAPE_PATH);
+        if (scanY_ > (shape ? GetMaxY() : outline_.GetMaxY())) {
+            if (!tiled_ || !NextTile()) {
+                return false;
+            }
+            continue;
+        }
+        if (clipper_.GetRegionClipping() && !clipper_.RegionCrosses(scanY_)) {
+            ++scanY_;
+            continue;
         }
         sl.ResetSpans();
-        uint32_t numCells = outline_.GetScanlineNumCells(scanY_);
-        const CellBuildAntiAlias * const *cells = outline_.GetScanlineCells(scanY_);
-        int32_t cover = 0;
-
-        while (numCells) {
-            const CellBuildAntiAlias* curCell = *cells;
-            if (curCell == nullptr) {
-                GRAPHIC_LOGE("Text: RasterizerScanlineAntialias::SweepScanline can not new curCell");
-                return true;
-            }
-            int32_t x = curCell->x;
-            int32_t area = curCell->area;
-            uint32_t alpha;
-
-            cover += curCell->cover;
-            // accumulate all cells with the same X
-            while (--numCells && (curCell = *++cells) && (curCell != nullptr) && (curCell->x == x)) {
-                area += curCell->area;
-                cover += curCell->cover;
-            }
-            if (area) {
-                // Span interval from area to  (cover << (POLY_SUBPIXEL_SHIFT + 1))
-                // Cover can be understood as a delta mask with an area of 1
-                alpha = CalculateAlpha((cover << (POLY_SUBPIXEL_SHIFT + 1)) - area);
-                if (alpha) {
-                    sl.AddCell(x, alpha);
-                }
-                x++;
+        if (shape) {
+            shapes_.SweepScanline(sl, scanY_, *this);
+        } else if (outline_.GetDense()) {
+            SweepDense(sl);
+        } else {
+            uint32_t numCells = outline_.GetScanlineNumCells(scanY_);
+            bool swept;
+            if (outline_.GetSortedByValue()) {
+                swept = SweepCells(sl, outline_.GetScanlineSortedCells(scanY_), numCells);
+            } else {
+                swept = SweepCells(sl, outline_.GetScanlineCells(scanY_), numCells);
             }
-            if (numCells && (curCell != nullptr) && curCell->x > x) {
-                // At this time, area is 0, that is, 0 to cover << (POLY_SUBPIXEL_SHIFT + 1)
-                alpha = CalculateAlpha(cover << (POLY_SUBPIXEL_SHIFT + 1));
-                if (alpha) {
-                    sl.AddSpan(x, curCell->x - x, alpha);
-                }
+            if (!swept) {
+                return true;
             }
         }
+        if (clipper_.GetRegionClipping()) {
+            clipper_.ClipScanline(scanY_, sl);
+        }
 
         if (sl.NumSpans()) {
             break;
@@ -82,6 +99,194 @@ bool RasterizerScanlineAntialias::SweepScanline(GeometryScanline& sl)
     return true;
 }
 
+/**
+ * @brief Accumulate the cells of one scanline into spans of sl,
+ * cells are either addressed through the sorted pointer array or stored sorted by value.
+ * The cells with the same X are merged into runs first, then the alpha of the cell and of
+ * the span that follows it is calculated for SWEEP_CHUNK runs at a time.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline, class CellIterator>
+bool RasterizerScanlineAntialias::SweepCells(Scanline& sl, CellIterator cells, uint32_t numCells)
+{
+    SweepRun runs[SWEEP_CHUNK];
+    int32_t areas[SWEEP_CHUNK * SWEEP_AREAS];
+    uint32_t numRuns = 0;
+    int32_t cover = 0;
+    bool swept = true;
+    while (numCells) {
+        const RasterizerOutline::CellType* curCell = CellAt(cells);
+        if (curCell == nullptr) {
+            GRAPHIC_LOGE("Text: RasterizerScanlineAntialias::SweepScanline can not new curCell");
+            swept = false;
+            break;
+        }
+        int32_t x = curCell->x;
+        int32_t area = curCell->area;
+
+        cover += curCell->cover;
+        // accumulate all cells with the same X
+        while (--numCells && (curCell = CellAt(++cells)) && (curCell != nullptr) && (curCell->x == x)) {
+            area += curCell->area;
+            cover += curCell->cover;
+        }
+        SweepRun& run = runs[numRuns];
+        run.x = x;
+        run.nextX = (numCells && (curCell != nullptr)) ? curCell->x : x;
+        run.hasArea = (area != 0);
+        // Span interval from area to  (cover << (POLY_SUBPIXEL_SHIFT + 1))
+        // Cover can be understood as a delta mask with an area of 1
+        areas[numRuns * SWEEP_AREAS] = (cover << (POLY_SUBPIXEL_SHIFT + 1)) - area;
+        // The span after the cell has area 0, that is, 0 to cover << (POLY_SUBPIXEL_SHIFT + 1)
+        areas[numRuns * SWEEP_AREAS + 1] = cover << (POLY_SUBPIXEL_SHIFT + 1);
+        if (++numRuns == SWEEP_CHUNK) {
+            AddRuns(sl, runs, areas, numRuns);
+            numRuns = 0;
+        }
+    }
+    if (numRuns > 0) {
+        AddRuns(sl, runs, areas, numRuns);
+    }
+    return swept;
+}
+
+template <class Scanline>
+void RasterizerScanlineAntialias::AddRuns(Scanline& sl, const SweepRun* runs,
+                                          const int32_t* areas, uint32_t numRuns) const
+{
+    uint8_t alpha[SWEEP_CHUNK * SWEEP_AREAS];
+    CalculateAlphas(areas, numRuns * SWEEP_AREAS, alpha);
+    for (uint32_t i = 0; i < numRuns; i++) {
+        const SweepRun& run = runs[i];
+        int32_t x = run.x;
+        if (run.hasArea) {
+            if (alpha[i * SWEEP_AREAS]) {
+                sl.AddCell(x, alpha[i * SWEEP_AREAS]);
+            }
+            x++;
+        }
+        if (run.nextX > x && alpha[i * SWEEP_AREAS + 1]) {
+            sl.AddSpan(x, run.nextX - x, alpha[i * SWEEP_AREAS + 1]);
+        }
+    }
+}
+
+/**
+ * @brief Sweep one row of the dense coverage buffer. Like SweepCells, the last touched pixel
+ * only gets an alpha when it has area, and pixels with alpha 0 are left out of the spans.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline>
+void RasterizerScanlineAntialias::SweepDense(Scanline& sl)
+{
+    int32_t x = 0;
+    const RasterizerDenseCoverage::DenseCell* cells = nullptr;
+    uint32_t numCells = dense_.GetRow(scanY_, x, cells);
+    int32_t cover = 0;
+    int32_t areas[DENSE_CHUNK];
+    uint8_t alpha[DENSE_CHUNK];
+    while (numCells) {
+        uint32_t num = MATH_MIN(numCells, static_cast<uint32_t>(DENSE_CHUNK));
+        RasterizerDenseCoverage::PrefixSum(cells, num, cover, areas);
+        CalculateAlphas(areas, num, alpha);
+        if (num == numCells && cells[num - 1].area == 0) {
+            alpha[num - 1] = 0;
+        }
+        AddDenseRuns(sl, cells, alpha, num, x);
+        cells += num;
+        x += static_cast<int32_t>(num);
+        numCells -= num;
+    }
+}
+
+/**
+ * @brief A pixel without area has the alpha of the span after a cell, the pixels no cell touched
+ * after it keep that alpha and are added as one span. Pixels with area are added as cells.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline>
+void RasterizerScanlineAntialias::AddDenseRuns(Scanline& sl, const RasterizerDenseCoverage::DenseCell* cells,
+                                               const uint8_t* alpha, uint32_t num, int32_t x) const
+{
+    uint32_t start = 0;
+    while (start < num) {
+        if (alpha[start] == 0) {
+            start++;
+            continue;
+        }
+        uint32_t end = start + 1;
+        if (cells[start].area == 0) {
+            while (end < num && cells[end].area == 0 && cells[end].cover == 0 && alpha[end] != 0) {
+                end++;
+            }
+            sl.AddSpan(x + static_cast<int32_t>(start), end - start, alpha[start]);
+        } else {
+            while (end < num && cells[end].area != 0 && alpha[end] != 0) {
+                end++;
+            }
+            sl.AddCells(x + static_cast<int32_t>(start), end - start, alpha + start);
+        }
+        start = end;
+    }
+}
+
+/**
+ * @brief CalculateAlpha for num areas. The vector paths leave out the gammar_ lookup,
+ * which is the identity table.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerScanlineAntialias::CalculateAlphas(const int32_t* areas, uint32_t num, uint8_t* alpha) const
+{
+    uint32_t i = 0;
+    const int32_t shift = POLY_SUBPIXEL_SHIFT * 2 + 1 - AA_SHIFT;
+    bool evenOdd = (fillingRule_ == FILL_EVEN_ODD);
+#if defined(ARM_NEON_OPT)
+    for (; i + NEON_STEP_8 <= num; i += NEON_STEP_8) {
+        int32x4_t low = vabsq_s32(vshrq_n_s32(vld1q_s32(areas + i), shift));
+        int32x4_t high = vabsq_s32(vshrq_n_s32(vld1q_s32(areas + i + NEON_STEP_4), shift));
+        if (evenOdd) {
+            low = vandq_s32(low, vdupq_n_s32(AA_MASK2));
+            high = vandq_s32(high, vdupq_n_s32(AA_MASK2));
+            low = vminq_s32(low, vsubq_s32(vdupq_n_s32(AA_SCALE2), low));
+            high = vminq_s32(high, vsubq_s32(vdupq_n_s32(AA_SCALE2), high));
+        }
+        // The covers are not negative, saturating to 8 bits clamps them to AA_MASK
+        int16x8_t covers = vcombine_s16(vqmovn_s32(low), vqmovn_s32(high));
+        vst1_u8(alpha + i, vqmovun_s16(covers));
+    }
+#elif defined(X86_SSE2_OPT)
+    const __m128i mask2 = _mm_set1_epi32(AA_MASK2);
+    const __m128i scale = _mm_set1_epi32(AA_SCALE);
+    const __m128i scale2 = _mm_set1_epi32(AA_SCALE2);
+    for (; i + SSE2_STEP_8 <= num; i += SSE2_STEP_8) {
+        __m128i cover[2]; // 2: two vectors of 4 covers
+        for (uint32_t half = 0; half < 2; half++) { // 2: two vectors of 4 covers
+            __m128i value = _mm_srai_epi32(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(areas + i + half * SSE2_STEP_4)), shift);
+            __m128i sign = _mm_srai_epi32(value, 31); // 31: sign bit
+            value = _mm_sub_epi32(_mm_xor_si128(value, sign), sign);
+            if (evenOdd) {
+                value = _mm_and_si128(value, mask2);
+                __m128i fold = _mm_cmpgt_epi32(value, scale);
+                value = _mm_or_si128(_mm_and_si128(fold, _mm_sub_epi32(scale2, value)),
+                                     _mm_andnot_si128(fold, value));
+            }
+            cover[half] = value;
+        }
+        // The covers are not negative, saturating to 8 bits clamps them to AA_MASK
+        __m128i covers = _mm_packs_epi32(cover[0], cover[1]);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(alpha + i), _mm_packus_epi16(covers, covers));
+    }
+#endif
+    for (; i < num; i++) {
+        alpha[i] = static_cast<uint8_t>(CalculateAlpha(areas[i]));
+    }
+}
+
 /**
  * @brief Convert area cover to gamma cover value to calculate alpha.
  * @since 1.0
@@ -106,68 +311,115 @@ uint32_t RasterizerScanlineAntialias::CalculateAlpha(int32_t area) const
     return gammar_[cover];
 }
 
+RasterizerScanlineAntialias::~RasterizerScanlineAntialias()
+{
+    if (records_ != nullptr) {
+        GeometryArrayAllocator<PathRecord>::Deallocate(records_, recordsCapacity_);
+        records_ = nullptr;
+    }
+}
+
 void RasterizerScanlineAntialias::Reset()
 {
     outline_.Reset();
+    outline_.SetYWindow(windowMinY_, windowMaxY_);
+    dense_.Reset();
     status_ = STATUS_INITIAL;
+    numRecords_ = 0;
+    recordFailed_ = false;
+    tiled_ = false;
+    tileHeight_ = 0;
+    tileBaseHeight_ = 0;
+    shapes_.Reset();
+    shapeRewound_ = false;
+    deferred_ = (denseAreaLimit_ > 0) || shapes_.GetEnabled();
+    recordMinX_ = INT32_MAX;
+    recordMinY_ = INT32_MAX;
+    recordMaxX_ = INT32_MIN;
+    recordMaxY_ = INT32_MIN;
 }
 
 void RasterizerScanlineAntialias::ClipBox(float x1, float y1, float x2, float y2)
 {
     Reset();
-    clipper_.ClipBox(RasterDepictInt::UpScale(x1), RasterDepictInt::UpScale(y1),
-                     RasterDepictInt::UpScale(x2), RasterDepictInt::UpScale(y2));
+    clipX1_ = RasterDepictInt::UpScale(x1);
+    clipY1_ = RasterDepictInt::UpScale(y1);
+    clipX2_ = RasterDepictInt::UpScale(x2);
+    clipY2_ = RasterDepictInt::UpScale(y2);
+    clipping_ = true;
+    clipper_.ClipBox(clipX1_, clipY1_, clipX2_, clipY2_);
+    shapes_.ClipBox(clipX1_, clipY1_, clipX2_, clipY2_);
+}
+
+bool RasterizerScanlineAntialias::ClipRegion(const Rect32* rects, uint32_t numRects)
+{
+    Reset();
+    bool stored = clipper_.ClipRegion(rects, numRects);
+    const Rect32& box = clipper_.GetClipBox();
+    clipX1_ = box.GetLeft();
+    clipY1_ = box.GetTop();
+    clipX2_ = box.GetRight();
+    clipY2_ = box.GetBottom();
+    clipping_ = true;
+    shapes_.ClipBox(clipX1_, clipY1_, clipX2_, clipY2_);
+    return stored;
 }
 
 void RasterizerScanlineAntialias::ResetClipping()
 {
     Reset();
+    clipping_ = false;
     clipper_.ResetClipping();
+    shapes_.ResetClipping();
 }
 
 void RasterizerScanlineAntialias::ClosePolygon()
 {
     if (status_ == STATUS_LINE_TO) {
-        clipper_.LineTo(outline_, startX_, startY_);
+        ClipperLineTo(startX_, startY_);
         status_ = STATUS_CLOSED;
     }
 }
 
 void RasterizerScanlineAntialias::MoveTo(int32_t x, int32_t y)
 {
-    if (outline_.GetSorted()) {
+    if (outline_.GetSorted() || shapeRewound_) {
         Reset();
     }
+    FlushRoundedRect();
     if (autoClose_) {
         ClosePolygon();
     }
-    clipper_.MoveTo(startX_ = RasterDepictInt::DownScale(x),
-                    startY_ = RasterDepictInt::DownScale(y));
+    ClipperMoveTo(startX_ = RasterDepictInt::DownScale(x),
+                  startY_ = RasterDepictInt::DownScale(y));
     status_ = STATUS_MOVE_TO;
 }
 
 void RasterizerScanlineAntialias::LineTo(int32_t x, int32_t y)
 {
-    clipper_.LineTo(outline_, RasterDepictInt::DownScale(x), RasterDepictInt::DownScale(y));
+    FlushRoundedRect();
+    ClipperLineTo(RasterDepictInt::DownScale(x), RasterDepictInt::DownScale(y));
     status_ = STATUS_LINE_TO;
 }
 
 void RasterizerScanlineAntialias::MoveToByfloat(float x, float y)
 {
-    if (outline_.GetSorted()) {
+    if (outline_.GetSorted() || shapeRewound_) {
         Reset();
     }
+    FlushRoundedRect();
     if (autoClose_) {
         ClosePolygon();
     }
-    clipper_.MoveTo(startX_ = RasterDepictInt::UpScale(x),
-                    startY_ = RasterDepictInt::UpScale(y));
+    ClipperMoveTo(startX_ = RasterDepictInt::UpScale(x),
+                  startY_ = RasterDepictInt::UpScale(y));
     status_ = STATUS_MOVE_TO;
 }
 
 void RasterizerScanlineAntialias::LineToByfloat(float x, float y)
 {
-    clipper_.LineTo(outline_, RasterDepictInt::UpScale(x), RasterDepictInt::UpScale(y));
+    FlushRoundedRect();
+    ClipperLineTo(RasterDepictInt::UpScale(x), RasterDepictInt::UpScale(y));
     status_ = STATUS_LINE_TO;
 }
 
@@ -182,11 +434,82 @@ void RasterizerScanlineAntialias::AddVertex(float x, float y, uint32_t cmd)
     }
 }
 
+/**
+ * @brief A rounded rectangle kept by the shape fast path is pending until RewindScanlines,
+ * anything added after it turns it into its outline first.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerScanlineAntialias::AddRoundedRect(float x1, float y1, float x2, float y2, float radius)
+{
+    if (outline_.GetSorted() || shapeRewound_) {
+        Reset();
+    }
+    FlushRoundedRect();
+    if (autoClose_) {
+        ClosePolygon();
+    }
+    bool first = (status_ == STATUS_INITIAL);
+    if (shapes_.SetRoundedRect(RasterDepictInt::UpScale(x1), RasterDepictInt::UpScale(y1),
+                               RasterDepictInt::UpScale(x2), RasterDepictInt::UpScale(y2),
+                               RasterDepictInt::UpScale(radius), first)) {
+        return;
+    }
+    AddRoundedPolygon();
+}
+
+void RasterizerScanlineAntialias::FlushRoundedRect()
+{
+    if (shapes_.TakePending()) {
+        AddRoundedPolygon();
+    }
+}
+
+/**
+ * @brief The outline runs clockwise from the top edge, each corner is a quarter arc
+ * of CornerSegments segments around its center.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerScanlineAntialias::AddRoundedPolygon()
+{
+    int32_t x1;
+    int32_t y1;
+    int32_t x2;
+    int32_t y2;
+    shapes_.GetBounds(x1, y1, x2, y2);
+    int32_t radius = shapes_.GetRadius();
+    startX_ = x1 + radius;
+    startY_ = y1;
+    ClipperMoveTo(startX_, startY_);
+    if (radius == 0) {
+        ClipperLineTo(x2, y1);
+        ClipperLineTo(x2, y2);
+        ClipperLineTo(x1, y2);
+        ClipperLineTo(x1, y1);
+    } else {
+        const int32_t numCorners = RasterizerShapeFastPath::CORNER_COUNT;
+        const int32_t centerX[numCorners] = {x2 - radius, x2 - radius, x1 + radius, x1 + radius};
+        const int32_t centerY[numCorners] = {y1 + radius, y2 - radius, y2 - radius, y1 + radius};
+        int32_t segments = RasterizerShapeFastPath::CornerSegments(radius);
+        for (int32_t corner = 0; corner < numCorners; corner++) {
+            for (int32_t index = 0; index <= segments; index++) {
+                int32_t x;
+                int32_t y;
+                RasterizerShapeFastPath::CornerPoint(corner, radius, index, x, y);
+                ClipperLineTo(centerX[corner] + x, centerY[corner] + y);
+            }
+        }
+    }
+    status_ = STATUS_CLOSED;
+}
+
 void RasterizerScanlineAntialias::Sort()
 {
     if (autoClose_) {
         ClosePolygon();
     }
+    ResolveDeferred();
     outline_.SortAllCells();
 }
 
@@ -195,11 +518,275 @@ bool RasterizerScanlineAntialias::RewindScanlines()
     if (autoClose_) {
         ClosePolygon();
     }
+    if (tiled_) {
+        tileMinY_ = pathMinY_;
+        tileHeight_ = tileBaseHeight_;
+        return NextTile();
+    }
+    ResolveDeferred();
+    if (shapes_.GetShape() != RasterizerShapeFastPath::SHAPE_PATH) {
+        shapeRewound_ = true;
+        scanY_ = GetMinY();
+        return !shapes_.IsEmpty() && (scanY_ <= GetMaxY());
+    }
+    bool firstSort = !outline_.GetSorted();
     outline_.SortAllCells();
+    if (outline_.GetDroppedCells() > 0 && autoTiling_ && !recordFailed_) {
+        return StartTiling();
+    }
+    if (firstSort) {
+        tilingStats_.droppedCells += outline_.GetDroppedCells();
+    }
     if (outline_.GetTotalCells() == 0) {
         return false;
     }
     scanY_ = outline_.GetMinY();
     return true;
 }
+
+/**
+ * @brief While the path is deferred the clipper operations are only recorded,
+ * once it no longer fits the dense area limit they are replayed into cells.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerScanlineAntialias::ClipperMoveTo(int32_t x, int32_t y)
+{
+    if (AddRecord(x, y, true) && deferred_) {
+        return;
+    }
+    FlushRecords();
+    clipper_.MoveTo(x, y);
+}
+
+void RasterizerScanlineAntialias::ClipperLineTo(int32_t x, int32_t y)
+{
+    bool recorded = AddRecord(x, y, false);
+    if (deferred_) {
+        bool rectFits = shapes_.GetEnabled() && (numRecords_ <= RasterizerShapeFastPath::RECT_MAX_RECORDS);
+        if (recorded && (DenseFits() || rectFits)) {
+            return;
+        }
+        FlushRecords();
+        if (recorded) {
+            return;
+        }
+    }
+    clipper_.LineTo(outline_, x, y);
+}
+
+void RasterizerScanlineAntialias::FlushRecords()
+{
+    if (deferred_) {
+        deferred_ = false;
+        ReplayRecords();
+    }
+}
+
+/**
+ * @brief Rectangles are recognized before the dense buffer is considered, a path that was
+ * only still deferred to recognize a rectangle goes to cells.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerScanlineAntialias::ResolveDeferred()
+{
+    if (shapes_.TakePending()) {
+        if (shapes_.StartRoundedRect(fillingRule_)) {
+            deferred_ = false;
+            return;
+        }
+        AddRoundedPolygon();
+    }
+    if (deferred_) {
+        deferred_ = false;
+        if (!recordFailed_ && shapes_.DetectRect(records_, numRecords_)) {
+            return;
+        }
+        if (!DenseFits() || !StartDense()) {
+            ReplayRecords();
+        }
+    }
+}
+
+/**
+ * @brief The clipper keeps the edges it clips within their own rows, so an edge outside the rows
+ * adds no cells, the edge after it is started with a move to its end instead.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerScanlineAntialias::ReplayRecords(int32_t minY, int32_t maxY)
+{
+    int32_t lastX = 0;
+    int32_t lastY = 0;
+    bool skipped = false;
+    for (uint32_t i = 0; i < numRecords_; i++) {
+        const PathRecord& record = records_[i];
+        if (record.moveTo) {
+            clipper_.MoveTo(record.x, record.y);
+            skipped = false;
+        } else if ((MATH_MAX(lastY, record.y) >> POLY_SUBPIXEL_SHIFT) < minY ||
+                   (MATH_MIN(lastY, record.y) >> POLY_SUBPIXEL_SHIFT) > maxY) {
+            skipped = true;
+        } else {
+            if (skipped) {
+                clipper_.MoveTo(lastX, lastY);
+                skipped = false;
+            }
+            clipper_.LineTo(outline_, record.x, record.y);
+        }
+        lastX = record.x;
+        lastY = record.y;
+    }
+}
+
+bool RasterizerScanlineAntialias::DenseFits() const
+{
+    int64_t width = (recordMaxX_ >> POLY_SUBPIXEL_SHIFT) - (recordMinX_ >> POLY_SUBPIXEL_SHIFT) + 1;
+    int64_t height = (recordMaxY_ >> POLY_SUBPIXEL_SHIFT) - (recordMinY_ >> POLY_SUBPIXEL_SHIFT) + 1;
+    return width * height <= static_cast<int64_t>(denseAreaLimit_);
+}
+
+/**
+ * @brief The clipper moves the points outside the clip box onto its edges,
+ * so the cells lie in the bounding box of the recorded points clamped to the clip box.
+ * A pixel of margin is kept left and right for the cells of steep edges.
+ * @since 1.0
+ * @version 1.0
+ */
+bool RasterizerScanlineAntialias::StartDense()
+{
+    if (numRecords_ == 0) {
+        return true;
+    }
+    int32_t minX = recordMinX_;
+    int32_t minY = recordMinY_;
+    int32_t maxX = recordMaxX_;
+    int32_t maxY = recordMaxY_;
+    if (clipping_) {
+        minX = MATH_MIN(MATH_MAX(minX, clipX1_), clipX2_);
+        maxX = MATH_MIN(MATH_MAX(maxX, clipX1_), clipX2_);
+        minY = MATH_MIN(MATH_MAX(minY, clipY1_), clipY2_);
+        maxY = MATH_MIN(MATH_MAX(maxY, clipY1_), clipY2_);
+    }
+    if (!dense_.SetBounds((minX >> POLY_SUBPIXEL_SHIFT) - 1, minY >> POLY_SUBPIXEL_SHIFT,
+                          (maxX >> POLY_SUBPIXEL_SHIFT) + 1, maxY >> POLY_SUBPIXEL_SHIFT)) {
+        return false;
+    }
+    outline_.SetDenseCoverage(&dense_);
+    ReplayRecords();
+    return true;
+}
+
+/**
+ * @brief Append a clipper operation to the path record, a path that is not completely recorded
+ * can not be tiled nor deferred. The record capacity is reserved from the cell block limit,
+ * so the record grows only into cell blocks that no cell uses.
+ * @since 1.0
+ * @version 1.0
+ */
+bool RasterizerScanlineAntialias::AddRecord(int32_t x, int32_t y, bool moveTo)
+{
+    if ((!autoTiling_ && !deferred_) || recordFailed_ || (numRecords_ == 0 && !moveTo)) {
+        recordFailed_ = true;
+        return false;
+    }
+    if (numRecords_ >= recordsCapacity_) {
+        uint32_t newCapacity = MATH_MAX(recordsCapacity_ << 1, static_cast<uint32_t>(RECORD_BLOCK_SIZE));
+        if (!outline_.ReserveMemory(newCapacity * sizeof(PathRecord))) {
+            recordFailed_ = true;
+            return false;
+        }
+        PathRecord* newRecords = GeometryArrayAllocator<PathRecord>::Allocate(newCapacity);
+        if (newRecords == nullptr) {
+            outline_.ReserveMemory(recordsCapacity_ * sizeof(PathRecord));
+            recordFailed_ = true;
+            return false;
+        }
+        if (records_ != nullptr) {
+            if (memcpy_s(newRecords, newCapacity * sizeof(PathRecord),
+                         records_, numRecords_ * sizeof(PathRecord)) != EOK) {
+                GRAPHIC_LOGE("RasterizerScanlineAntialias::AddRecord memcpy_s fail\n");
+                GeometryArrayAllocator<PathRecord>::Deallocate(newRecords, newCapacity);
+                outline_.ReserveMemory(recordsCapacity_ * sizeof(PathRecord));
+                recordFailed_ = true;
+                return false;
+            }
+            GeometryArrayAllocator<PathRecord>::Deallocate(records_, recordsCapacity_);
+        }
+        records_ = newRecords;
+        recordsCapacity_ = newCapacity;
+    }
+    PathRecord& record = records_[numRecords_++];
+    record.x = x;
+    record.y = y;
+    record.moveTo = moveTo;
+    if (deferred_) {
+        recordMinX_ = MATH_MIN(recordMinX_, x);
+        recordMinY_ = MATH_MIN(recordMinY_, y);
+        recordMaxX_ = MATH_MAX(recordMaxX_, x);
+        recordMaxY_ = MATH_MAX(recordMaxY_, y);
+    }
+    return true;
+}
+
+/**
+ * @brief The tile height is chosen so that evenly distributed cells fit the cell block limit,
+ * NextTile halves it when the cells of a tile are denser.
+ * @since 1.0
+ * @version 1.0
+ */
+bool RasterizerScanlineAntialias::StartTiling()
+{
+    uint32_t capacity = outline_.GetCellCapacity();
+    if (capacity == 0) {
+        tilingStats_.droppedCells += outline_.GetDroppedCells();
+        return outline_.GetTotalCells() > 0;
+    }
+    // The tiles only replay their own edges, the X range of the scanlines is the one of the whole path
+    pathMinX_ = outline_.GetMinX();
+    pathMaxX_ = outline_.GetMaxX();
+    pathMinY_ = MATH_MAX(outline_.GetMinY(), windowMinY_);
+    pathMaxY_ = MATH_MIN(outline_.GetMaxY(), windowMaxY_);
+    uint32_t totalCells = outline_.GetTotalCells() + outline_.GetDroppedCells();
+    uint32_t numTiles = totalCells / capacity + 1;
+    uint32_t numRows = static_cast<uint32_t>(pathMaxY_ - pathMinY_ + 1);
+    tileBaseHeight_ = static_cast<int32_t>(MATH_MAX((numRows + numTiles - 1) / numTiles, 1u));
+    tileHeight_ = tileBaseHeight_;
+    tileMinY_ = pathMinY_;
+    tiled_ = true;
+    tilingStats_.tiledPaths++;
+    return NextTile();
+}
+
+bool RasterizerScanlineAntialias::NextTile()
+{
+    while (tileMinY_ <= pathMaxY_) {
+        int32_t tileMaxY = MATH_MIN(tileMinY_ + tileHeight_ - 1, pathMaxY_);
+        outline_.Reset();
+        outline_.SetYWindow(tileMinY_, tileMaxY);
+        ReplayRecords(tileMinY_, tileMaxY);
+        outline_.SortAllCells();
+        uint32_t droppedCells = outline_.GetDroppedCells();
+        if (droppedCells > 0 && tileHeight_ > 1) {
+            tileHeight_ = (tileHeight_ + 1) >> 1;
+            tilingStats_.tileRetries++;
+            continue;
+        }
+        tilingStats_.droppedCells += droppedCells;
+        tilingStats_.tilePasses++;
+        tileMinY_ = tileMaxY + 1;
+        if (droppedCells == 0) {
+            tileHeight_ = MATH_MIN(tileHeight_ << 1, tileBaseHeight_);
+        }
+        if (outline_.GetTotalCells() > 0) {
+            scanY_ = outline_.GetMinY();
+            return true;
+        }
+    }
+    return false;
+}
+
+template bool RasterizerScanlineAntialias::SweepScanline<GeometryScanline>(GeometryScanline& sl);
+template bool RasterizerScanlineAntialias::SweepScanline<GeometryScanlinePacked>(GeometryScanlinePacked& sl);
 } // namespace OHOS
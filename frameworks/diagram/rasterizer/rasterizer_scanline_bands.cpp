@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_bands.h"
+#include "gfx_utils/graphic_log.h"
+#include "hal_cpu.h"
+
+namespace OHOS {
+RasterizerScanlineBands::RasterizerScanlineBands(uint32_t maxBands, uint32_t cellBlockLimit)
+    : maxBands_(maxBands),
+      numBands_(0),
+      currBand_(0),
+      clipX1_(0),
+      clipY1_(0),
+      clipX2_(0),
+      clipY2_(0),
+      vertexMinY_(INT32_MAX),
+      vertexMaxY_(INT32_MIN),
+      minY_(0),
+      maxY_(-1),
+      clipping_(false),
+      regionClipping_(false),
+      rewound_(false)
+{
+    if (maxBands_ == 0) {
+        maxBands_ = HalGetCpuCoreNum();
+    }
+    maxBands_ = MATH_MAX(1, MATH_MIN(maxBands_, static_cast<uint32_t>(MAX_BANDS)));
+    for (uint32_t i = 0; i < MAX_BANDS; i++) {
+        bands_[i] = nullptr;
+    }
+    for (uint32_t i = 0; i < maxBands_; i++) {
+        bands_[i] = new Band(cellBlockLimit);
+        bands_[i]->owner = this;
+    }
+}
+
+RasterizerScanlineBands::~RasterizerScanlineBands()
+{
+    WaitBands();
+    for (uint32_t i = 0; i < maxBands_; i++) {
+        Band* band = bands_[i];
+        if (band->thread != nullptr) {
+            band->quit = true;
+            band->start.Notify();
+            band->done.Wait();
+        }
+        delete band;
+    }
+}
+
+#ifdef _WIN32
+DWORD WINAPI RasterizerScanlineBands::BandWorker(LPVOID arg)
+#else
+void* RasterizerScanlineBands::BandWorker(void* arg)
+#endif
+{
+    Band* band = static_cast<Band*>(arg);
+    while (band->start.Wait() && !band->quit) {
+        band->owner->RasterizeBand(*band, true);
+        band->done.Notify();
+    }
+    band->done.Notify();
+    return 0;
+}
+
+bool RasterizerScanlineBands::StartWorker(Band& band)
+{
+    if (band.thread == nullptr) {
+        ThreadAttr attr = {"RasterizerBand", BAND_STACK_SIZE, 0, 0, 0};
+        band.thread = ThreadCreate(BandWorker, &band, &attr);
+        if (band.thread == nullptr) {
+            return false;
+        }
+    }
+    band.pending = true;
+    band.start.Notify();
+    return true;
+}
+
+void RasterizerScanlineBands::WaitBands()
+{
+    for (uint32_t i = 1; i < numBands_; i++) {
+        Band* band = bands_[i];
+        if (band->pending) {
+            band->done.Wait();
+            band->pending = false;
+        }
+    }
+}
+
+void RasterizerScanlineBands::Reset()
+{
+    WaitBands();
+    vertices_.RemoveAll();
+    vertexMinY_ = INT32_MAX;
+    vertexMaxY_ = INT32_MIN;
+    numBands_ = 0;
+    rewound_ = false;
+}
+
+void RasterizerScanlineBands::ClipBox(float x1, float y1, float x2, float y2)
+{
+    Reset();
+    clipX1_ = x1;
+    clipY1_ = y1;
+    clipX2_ = x2;
+    clipY2_ = y2;
+    clipping_ = true;
+    regionClipping_ = false;
+}
+
+/**
+ * @brief The region is kept by the clipper of every band, the clip box is its bounding box
+ * so that the bands are split over the rows of the region only.
+ * @since 1.0
+ * @version 1.0
+ */
+bool RasterizerScanlineBands::ClipRegion(const Rect32* rects, uint32_t numRects)
+{
+    Reset();
+    bool stored = true;
+    for (uint32_t i = 0; i < maxBands_; i++) {
+        stored = bands_[i]->rasterizer.ClipRegion(rects, numRects) && stored;
+    }
+    int32_t x1;
+    int32_t y1;
+    int32_t x2;
+    int32_t y2;
+    bands_[0]->rasterizer.GetClipBox(x1, y1, x2, y2);
+    clipX1_ = static_cast<float>(x1) / POLY_SUBPIXEL_SCALE;
+    clipY1_ = static_cast<float>(y1) / POLY_SUBPIXEL_SCALE;
+    clipX2_ = static_cast<float>(x2) / POLY_SUBPIXEL_SCALE;
+    clipY2_ = static_cast<float>(y2) / POLY_SUBPIXEL_SCALE;
+    clipping_ = true;
+    regionClipping_ = stored;
+    return stored;
+}
+
+void RasterizerScanlineBands::ResetClipping()
+{
+    Reset();
+    clipping_ = false;
+    regionClipping_ = false;
+}
+
+void RasterizerScanlineBands::AddVertex(float x, float y, uint32_t cmd)
+{
+    if (rewound_) {
+        Reset();
+    }
+    vertices_.AddVertex(x, y, cmd);
+    if (IsVertex(cmd)) {
+        int32_t subpixelY = RasterDepictInt::UpScale(y);
+        vertexMinY_ = MATH_MIN(vertexMinY_, subpixelY);
+        vertexMaxY_ = MATH_MAX(vertexMaxY_, subpixelY);
+    }
+}
+
+/**
+ * @brief Split the rows of the path into bands and start rasterizing them,
+ * the first band is rasterized on the calling thread.
+ * @since 1.0
+ * @version 1.0
+ */
+bool RasterizerScanlineBands::RewindScanlines()
+{
+    WaitBands();
+    rewound_ = true;
+    numBands_ = 0;
+    currBand_ = 0;
+    if (vertexMinY_ > vertexMaxY_) {
+        return false;
+    }
+    minY_ = vertexMinY_ >> POLY_SUBPIXEL_SHIFT;
+    maxY_ = vertexMaxY_ >> POLY_SUBPIXEL_SHIFT;
+    if (clipping_) {
+        int32_t clipMinY = RasterDepictInt::UpScale(MATH_MIN(clipY1_, clipY2_)) >> POLY_SUBPIXEL_SHIFT;
+        int32_t clipMaxY = RasterDepictInt::UpScale(MATH_MAX(clipY1_, clipY2_)) >> POLY_SUBPIXEL_SHIFT;
+        minY_ = MATH_MAX(minY_, clipMinY);
+        maxY_ = MATH_MIN(maxY_, clipMaxY);
+    }
+    if (minY_ > maxY_) {
+        return false;
+    }
+
+    uint32_t rows = static_cast<uint32_t>(maxY_ - minY_) + 1;
+    numBands_ = MATH_MAX(1, MATH_MIN(maxBands_, rows / MIN_BAND_HEIGHT));
+    uint32_t bandHeight = (rows + numBands_ - 1) / numBands_;
+    int32_t bandMinY = minY_;
+    for (uint32_t i = 0; i < numBands_; i++) {
+        Band& band = *bands_[i];
+        band.minY = bandMinY;
+        band.maxY = (i == numBands_ - 1) ? maxY_ : (bandMinY + static_cast<int32_t>(bandHeight) - 1);
+        bandMinY = band.maxY + 1;
+        if (i > 0 && !StartWorker(band)) {
+            // No thread on this platform, the band is swept right away
+            RasterizeBand(band, true);
+        }
+    }
+
+    Band& first = *bands_[0];
+    RasterizeBand(first, false);
+    if (first.rasterizer.GetMinX() > first.rasterizer.GetMaxX()) {
+        WaitBands();
+        numBands_ = 0;
+        return false;
+    }
+    return true;
+}
+
+void RasterizerScanlineBands::RasterizeBand(Band& band, bool store)
+{
+    RasterizerScanlineAntialias& rasterizer = band.rasterizer;
+    if (regionClipping_) {
+        // Reset keeps the region set by ClipRegion
+        rasterizer.Reset();
+    } else if (clipping_) {
+        rasterizer.ClipBox(clipX1_, clipY1_, clipX2_, clipY2_);
+    } else {
+        rasterizer.ResetClipping();
+    }
+    rasterizer.SetScanlineWindow(band.minY, band.maxY);
+    float x;
+    float y;
+    for (uint32_t i = 0; i < vertices_.GetTotalVertices(); i++) {
+        uint32_t cmd = vertices_.GenerateVertex(i, &x, &y);
+        rasterizer.AddVertex(x, y, cmd);
+    }
+    band.active = rasterizer.RewindScanlines();
+    band.storage.Reset();
+    band.stored = store;
+    band.failed = false;
+    if (!store || !band.active) {
+        return;
+    }
+    band.scanline.Reset(rasterizer.GetMinX(), rasterizer.GetMaxX());
+    while (rasterizer.SweepScanline(band.scanline)) {
+        if (!band.storage.AddScanline(band.scanline)) {
+            GRAPHIC_LOGE("RasterizerScanlineBands::RasterizeBand band at row %d is rasterized again\n", band.minY);
+            band.storage.Reset();
+            band.stored = false;
+            band.failed = true;
+            return;
+        }
+    }
+}
+
+template <class Scanline>
+bool RasterizerScanlineBands::SweepScanline(Scanline& sl)
+{
+    while (currBand_ < numBands_) {
+        Band& band = *bands_[currBand_];
+        if (band.pending) {
+            band.done.Wait();
+            band.pending = false;
+        }
+        if (band.failed) {
+            RasterizeBand(band, false);
+        }
+        if (band.stored ? band.storage.SweepScanline(sl) : (band.active && band.rasterizer.SweepScanline(sl))) {
+            return true;
+        }
+        ++currBand_;
+    }
+    return false;
+}
+
+template bool RasterizerScanlineBands::SweepScanline<GeometryScanline>(GeometryScanline& sl);
+template bool RasterizerScanlineBands::SweepScanline<GeometryScanlinePacked>(GeometryScanlinePacked& sl);
+} // namespace OHOS
@@ -14,8 +14,103 @@
  */
 
 #include "gfx_utils/diagram/rasterizer/rasterizer_scanline_clip.h"
+#include "gfx_utils/graphic_log.h"
 
 namespace OHOS {
+RasterizerScanlineClip::~RasterizerScanlineClip()
+{
+    if (region_ != nullptr) {
+        GeometryArrayAllocator<Rect32>::Deallocate(region_, regionCapacity_);
+        GeometryArrayAllocator<int32_t>::Deallocate(regionClipX_, regionCapacity_ * 2); // 2: start and end
+    }
+}
+
+/**
+ * @brief The rectangles are copied sorted by top, ClipScanline stops at the first one below the scanline.
+ * @since 1.0
+ * @version 1.0
+ */
+bool RasterizerScanlineClip::ClipRegion(const Rect32* rects, uint32_t numRects)
+{
+    if (numRects > regionCapacity_) {
+        if (region_ != nullptr) {
+            GeometryArrayAllocator<Rect32>::Deallocate(region_, regionCapacity_);
+            GeometryArrayAllocator<int32_t>::Deallocate(regionClipX_, regionCapacity_ * 2); // 2: start and end
+        }
+        regionCapacity_ = 0;
+        region_ = GeometryArrayAllocator<Rect32>::Allocate(numRects);
+        regionClipX_ = GeometryArrayAllocator<int32_t>::Allocate(numRects * 2); // 2: start and end
+        if (region_ == nullptr || regionClipX_ == nullptr) {
+            GRAPHIC_LOGE("RasterizerScanlineClip::ClipRegion Allocate fail\n");
+            GeometryArrayAllocator<Rect32>::Deallocate(region_, numRects);
+            GeometryArrayAllocator<int32_t>::Deallocate(regionClipX_, numRects * 2); // 2: start and end
+            region_ = nullptr;
+            regionClipX_ = nullptr;
+        } else {
+            regionCapacity_ = numRects;
+        }
+    }
+    Rect32 bounds(0, 0, -1, -1);
+    numRegionRects_ = 0;
+    for (uint32_t i = 0; i < numRects; i++) {
+        Rect32 rect = rects[i];
+        rect.Normalize();
+        if (i == 0) {
+            bounds = rect;
+        } else {
+            bounds.Join(bounds, rect);
+        }
+        if (region_ == nullptr) {
+            continue;
+        }
+        uint32_t j = numRegionRects_++;
+        for (; j > 0 && region_[j - 1].GetTop() > rect.GetTop(); j--) {
+            region_[j] = region_[j - 1];
+        }
+        region_[j] = rect;
+    }
+    ClipBox(bounds.GetLeft() << POLY_SUBPIXEL_SHIFT, bounds.GetTop() << POLY_SUBPIXEL_SHIFT,
+            (bounds.GetRight() + 1) << POLY_SUBPIXEL_SHIFT, (bounds.GetBottom() + 1) << POLY_SUBPIXEL_SHIFT);
+    regionClipping_ = (region_ != nullptr) || (numRects == 0);
+    return regionClipping_;
+}
+
+/**
+ * @brief The ranges of the rectangles crossing the scanline are sorted by left and merged.
+ * @since 1.0
+ * @version 1.0
+ */
+uint32_t RasterizerScanlineClip::MergeRegionRanges(int32_t y)
+{
+    uint32_t numClips = 0;
+    for (uint32_t i = 0; i < numRegionRects_ && region_[i].GetTop() <= y; i++) {
+        const Rect32& rect = region_[i];
+        if (rect.GetBottom() < y) {
+            continue;
+        }
+        uint32_t j = numClips++;
+        for (; j > 0 && regionClipX_[(j - 1) * 2] > rect.GetLeft(); j--) { // 2: start and end
+            regionClipX_[j * 2] = regionClipX_[(j - 1) * 2]; // 2: start and end
+            regionClipX_[j * 2 + 1] = regionClipX_[(j - 1) * 2 + 1]; // 2: start and end
+        }
+        regionClipX_[j * 2] = rect.GetLeft(); // 2: start and end
+        regionClipX_[j * 2 + 1] = rect.GetRight() + 1; // 2: start and end
+    }
+    uint32_t numMerged = 0;
+    for (uint32_t i = 0; i < numClips; i++) {
+        int32_t start = regionClipX_[i * 2]; // 2: start and end
+        int32_t end = regionClipX_[i * 2 + 1]; // 2: start and end
+        if (numMerged > 0 && start <= regionClipX_[numMerged * 2 - 1]) { // 2: start and end
+            regionClipX_[numMerged * 2 - 1] = MATH_MAX(regionClipX_[numMerged * 2 - 1], end); // 2: start and end
+            continue;
+        }
+        regionClipX_[numMerged * 2] = start; // 2: start and end
+        regionClipX_[numMerged * 2 + 1] = end; // 2: start and end
+        numMerged++;
+    }
+    return numMerged;
+}
+
 /**
  * @brief In the RASTERIZER process,Judge the mark according to the last clipping range
  * And the cutting range judgment flag this time,
@@ -23,7 +118,8 @@ namespace OHOS {
  * @since 1.0
  * @version 1.0
  */
-void RasterizerScanlineClip::LineClipY(RasterizerCellsAntiAlias& ras,
+template <class Cells>
+void RasterizerScanlineClip::LineClipY(Cells& ras,
                                        int32_t x1, int32_t y1,
                                        int32_t x2, int32_t y2,
                                        uint32_t clipFlagsOne, uint32_t clipFlagsTwo) const
@@ -102,7 +198,8 @@ void RasterizerScanlineClip::LineClipY(RasterizerCellsAntiAlias& ras,
  * @since 1.0
  * @version 1.0
  */
-void RasterizerScanlineClip::LineTo(RasterizerCellsAntiAlias& rasterLine, int32_t x2, int32_t y2)
+template <class Cells>
+void RasterizerScanlineClip::LineTo(Cells& rasterLine, int32_t x2, int32_t y2)
 {
     if (clipping_) {
         uint32_t cFlagsLineToPoint = ClippingFlags(x2, y2, clipBox_);
@@ -228,4 +325,7 @@ void RasterizerScanlineClip::LineTo(RasterizerCellsAntiAlias& rasterLine, int32_
     x1_ = x2;
     y1_ = y2;
 }
+
+template void RasterizerScanlineClip::LineTo(RasterizerCellsAntiAlias& rasterLine, int32_t x2, int32_t y2);
+template void RasterizerScanlineClip::LineTo(RasterizerCellsAntiAliasPacked& rasterLine, int32_t x2, int32_t y2);
 } // namespace OHOS
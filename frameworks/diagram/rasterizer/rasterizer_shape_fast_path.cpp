@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_shape_fast_path.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/graphic_log.h"
+#include "gfx_utils/graphic_math.h"
+#include "securec.h"
+
+namespace OHOS {
+RasterizerShapeFastPath::RasterizerShapeFastPath()
+    : shape_(SHAPE_PATH),
+      x1_(0),
+      y1_(0),
+      x2_(0),
+      y2_(0),
+      radius_(0),
+      clipX1_(0),
+      clipY1_(0),
+      clipX2_(0),
+      clipY2_(0),
+      cornerMasks_(nullptr),
+      cornerMasksCapacity_(0),
+      cornerRadius_(0),
+      clipping_(false),
+      enabled_(false),
+      pending_(false)
+{
+}
+
+RasterizerShapeFastPath::~RasterizerShapeFastPath()
+{
+    if (cornerMasks_ != nullptr) {
+        GeometryArrayAllocator<uint8_t>::Deallocate(cornerMasks_, cornerMasksCapacity_);
+        cornerMasks_ = nullptr;
+    }
+}
+
+/**
+ * @brief Only a rounded rectangle that is added alone, lies inside the clip box and whose corners
+ * fit the corner masks is kept pending.
+ * @since 1.0
+ * @version 1.0
+ */
+bool RasterizerShapeFastPath::SetRoundedRect(int32_t x1, int32_t y1, int32_t x2, int32_t y2,
+                                             int32_t radius, bool first)
+{
+    x1_ = MATH_MIN(x1, x2);
+    y1_ = MATH_MIN(y1, y2);
+    x2_ = MATH_MAX(x1, x2);
+    y2_ = MATH_MAX(y1, y2);
+    int32_t maxRadius = MATH_MIN(x2_ - x1_, y2_ - y1_) >> 1;
+    radius_ = MATH_MIN(MATH_MAX(radius, 0), maxRadius);
+
+    bool aligned = ((x1_ | y1_ | x2_ | y2_ | radius_) & POLY_SUBPIXEL_MASK) == 0;
+    bool inside = !clipping_ || (x1_ >= clipX1_ && y1_ >= clipY1_ && x2_ <= clipX2_ && y2_ <= clipY2_);
+    pending_ = enabled_ && first && aligned && inside && radius_ > 0 &&
+               (radius_ >> POLY_SUBPIXEL_SHIFT) <= CORNER_MAX_RADIUS;
+    return pending_;
+}
+
+bool RasterizerShapeFastPath::StartRoundedRect(FillingRule fillingRule)
+{
+    if (!BuildCornerMasks(fillingRule)) {
+        return false;
+    }
+    shape_ = SHAPE_ROUNDED_RECT;
+    return true;
+}
+
+bool RasterizerShapeFastPath::DetectRect(const RasterizerPathRecord* records, uint32_t numRecords)
+{
+    const uint32_t numCorners = 4;
+    int32_t pointX[numCorners + 1];
+    int32_t pointY[numCorners + 1];
+    uint32_t numPoints = 0;
+    if (!enabled_ || numRecords > RECT_MAX_RECORDS) {
+        return false;
+    }
+    for (uint32_t i = 0; i < numRecords; i++) {
+        const RasterizerPathRecord& record = records[i];
+        if (record.moveTo != (i == 0)) {
+            return false;
+        }
+        if (numPoints > 0 && record.x == pointX[numPoints - 1] && record.y == pointY[numPoints - 1]) {
+            continue;
+        }
+        if (numPoints > numCorners) {
+            return false;
+        }
+        pointX[numPoints] = record.x;
+        pointY[numPoints] = record.y;
+        numPoints++;
+    }
+    if (numPoints != numCorners + 1 || pointX[numCorners] != pointX[0] || pointY[numCorners] != pointY[0]) {
+        return false;
+    }
+    bool horizontal = (pointY[0] == pointY[1]);
+    for (uint32_t i = 0; i < numCorners; i++) {
+        bool flatY = (pointY[i] == pointY[i + 1]);
+        bool flatX = (pointX[i] == pointX[i + 1]);
+        if (flatY == flatX || flatY != horizontal) {
+            return false;
+        }
+        horizontal = !horizontal;
+    }
+    // Points 0 and 2 are opposite corners
+    x1_ = MATH_MIN(pointX[0], pointX[2]); // 2: opposite corner
+    y1_ = MATH_MIN(pointY[0], pointY[2]); // 2: opposite corner
+    x2_ = MATH_MAX(pointX[0], pointX[2]); // 2: opposite corner
+    y2_ = MATH_MAX(pointY[0], pointY[2]); // 2: opposite corner
+    if (clipping_) {
+        x1_ = MATH_MAX(x1_, clipX1_);
+        y1_ = MATH_MAX(y1_, clipY1_);
+        x2_ = MATH_MAX(MATH_MIN(x2_, clipX2_), x1_);
+        y2_ = MATH_MAX(MATH_MIN(y2_, clipY2_), y1_);
+    }
+    shape_ = SHAPE_RECT;
+    return true;
+}
+
+template <class Scanline>
+void RasterizerShapeFastPath::SweepScanline(Scanline& sl, int32_t y,
+                                            const RasterizerScanlineAntialias& rasterizer) const
+{
+    if (shape_ == SHAPE_RECT) {
+        SweepRect(sl, y, rasterizer);
+    } else if (shape_ == SHAPE_ROUNDED_RECT) {
+        SweepRoundedRect(sl, y, rasterizer);
+    }
+}
+
+/**
+ * @brief The value of a pixel of the rectangle is twice its covered area in subpixels,
+ * which is what (cover << (POLY_SUBPIXEL_SHIFT + 1)) - area of the edge cells adds up to.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline>
+void RasterizerShapeFastPath::SweepRect(Scanline& sl, int32_t y, const RasterizerScanlineAntialias& rasterizer) const
+{
+    int32_t coverY = MATH_MIN(y2_, (y + 1) << POLY_SUBPIXEL_SHIFT) - MATH_MAX(y1_, y << POLY_SUBPIXEL_SHIFT);
+    if (coverY <= 0 || x2_ <= x1_) {
+        return;
+    }
+    int32_t x = x1_ >> POLY_SUBPIXEL_SHIFT;
+    int32_t lastX = (x2_ - 1) >> POLY_SUBPIXEL_SHIFT;
+    uint32_t alpha;
+    if (x == lastX) {
+        alpha = rasterizer.CalculateAlpha((coverY * (x2_ - x1_)) << 1);
+        if (alpha) {
+            sl.AddCell(x, alpha);
+        }
+        return;
+    }
+    alpha = rasterizer.CalculateAlpha((coverY * (((x + 1) << POLY_SUBPIXEL_SHIFT) - x1_)) << 1);
+    if (alpha) {
+        sl.AddCell(x, alpha);
+    }
+    alpha = rasterizer.CalculateAlpha(coverY << (POLY_SUBPIXEL_SHIFT + 1));
+    if (lastX > x + 1 && alpha) {
+        sl.AddSpan(x + 1, lastX - x - 1, alpha);
+    }
+    alpha = rasterizer.CalculateAlpha((coverY * (x2_ - (lastX << POLY_SUBPIXEL_SHIFT))) << 1);
+    if (alpha) {
+        sl.AddCell(lastX, alpha);
+    }
+}
+
+/**
+ * @brief The rows of the corners are copied from the corner masks, the rows between them
+ * and the middle of the corner rows are solid.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline>
+void RasterizerShapeFastPath::SweepRoundedRect(Scanline& sl, int32_t y,
+                                               const RasterizerScanlineAntialias& rasterizer) const
+{
+    int32_t x1 = x1_ >> POLY_SUBPIXEL_SHIFT;
+    int32_t x2 = x2_ >> POLY_SUBPIXEL_SHIFT;
+    int32_t height = (y2_ - y1_) >> POLY_SUBPIXEL_SHIFT;
+    int32_t radius = cornerRadius_;
+    int32_t row = y - (y1_ >> POLY_SUBPIXEL_SHIFT);
+    uint32_t solid = rasterizer.CalculateAlpha(POLY_SUBPIXEL_SCALE << (POLY_SUBPIXEL_SHIFT + 1));
+    if (row < 0 || row >= height) {
+        return;
+    }
+    if (row >= radius && row < height - radius) {
+        sl.AddSpan(x1, x2 - x1, solid);
+        return;
+    }
+    int32_t maskSize = radius * radius;
+    const uint8_t* leftMask = cornerMasks_ + (CORNER_COUNT - 1) * maskSize; // top left
+    const uint8_t* rightMask = cornerMasks_; // top right
+    if (row >= radius) {
+        row -= height - radius;
+        leftMask = cornerMasks_ + 2 * maskSize; // 2: bottom left
+        rightMask = cornerMasks_ + maskSize; // bottom right
+    }
+    AddMaskRow(sl, leftMask + row * radius, x1);
+    if (x2 - x1 > 2 * radius) { // 2: left and right corners
+        sl.AddSpan(x1 + radius, x2 - x1 - 2 * radius, solid); // 2: left and right corners
+    }
+    AddMaskRow(sl, rightMask + row * radius, x2 - radius);
+}
+
+template <class Scanline>
+void RasterizerShapeFastPath::AddMaskRow(Scanline& sl, const uint8_t* mask, int32_t x) const
+{
+    int32_t start = 0;
+    while (start < cornerRadius_) {
+        while (start < cornerRadius_ && mask[start] == 0) {
+            start++;
+        }
+        int32_t end = start;
+        while (end < cornerRadius_ && mask[end] != 0) {
+            end++;
+        }
+        if (end > start) {
+            sl.AddCells(x + start, end - start, mask + start);
+        }
+        start = end;
+    }
+}
+
+int32_t RasterizerShapeFastPath::CornerSegments(int32_t radius)
+{
+    return MATH_MIN(MATH_MAX(radius >> POLY_SUBPIXEL_SHIFT, 2), static_cast<int32_t>(CORNER_MAX_SEGMENTS));
+}
+
+/**
+ * @brief The corners are top right, bottom right, bottom left and top left, each arc runs clockwise.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerShapeFastPath::CornerPoint(int32_t corner, int32_t radius, int32_t index, int32_t& x, int32_t& y)
+{
+    float angle = static_cast<float>(index * QUARTER_IN_DEGREE) / CornerSegments(radius);
+    int32_t sine = MATH_ROUND32(radius * Sin(angle));
+    int32_t cosine = MATH_ROUND32(radius * Sin(angle + QUARTER_IN_DEGREE));
+    switch (corner) {
+        case 0: // top right
+            x = sine;
+            y = -cosine;
+            break;
+        case 1: // bottom right
+            x = cosine;
+            y = sine;
+            break;
+        case 2: // 2: bottom left
+            x = -sine;
+            y = cosine;
+            break;
+        default: // top left
+            x = -cosine;
+            y = -sine;
+            break;
+    }
+}
+
+/**
+ * @brief Each corner is rasterized on its own as its arc closed through the corner center,
+ * with the arc segments of the full outline. The center edges lie on pixel borders and
+ * the cells are exact translations of the ones of the full outline, so the masks hold
+ * the same alpha as the corner pixels of the outline rasterized as a path.
+ * @since 1.0
+ * @version 1.0
+ */
+bool RasterizerShapeFastPath::BuildCornerMasks(FillingRule fillingRule)
+{
+    int32_t radius = radius_ >> POLY_SUBPIXEL_SHIFT;
+    if (cornerMasks_ != nullptr && cornerRadius_ == radius) {
+        return true;
+    }
+    uint32_t size = static_cast<uint32_t>(CORNER_COUNT * radius * radius);
+    if (size > cornerMasksCapacity_) {
+        if (cornerMasks_ != nullptr) {
+            GeometryArrayAllocator<uint8_t>::Deallocate(cornerMasks_, cornerMasksCapacity_);
+        }
+        cornerMasksCapacity_ = 0;
+        cornerMasks_ = GeometryArrayAllocator<uint8_t>::Allocate(size);
+        if (cornerMasks_ == nullptr) {
+            GRAPHIC_LOGE("RasterizerShapeFastPath::BuildCornerMasks Allocate fail\n");
+            return false;
+        }
+        cornerMasksCapacity_ = size;
+    }
+    cornerRadius_ = 0;
+    if (memset_s(cornerMasks_, cornerMasksCapacity_, 0, size) != EOK) {
+        return false;
+    }
+
+    RasterizerScanlineAntialias cornerRasterizer;
+    cornerRasterizer.SetFillingRule(fillingRule);
+    GeometryScanline sl;
+    int32_t segments = CornerSegments(radius_);
+    for (int32_t corner = 0; corner < CORNER_COUNT; corner++) {
+        // The corner box starts at 0, its center is the inner corner of the box
+        int32_t centerX = (corner == 0 || corner == 1) ? 0 : radius_;
+        int32_t centerY = (corner == 0 || corner == CORNER_COUNT - 1) ? radius_ : 0;
+        cornerRasterizer.Reset();
+        for (int32_t index = 0; index <= segments; index++) {
+            int32_t x;
+            int32_t y;
+            CornerPoint(corner, radius_, index, x, y);
+            if (index == 0) {
+                cornerRasterizer.MoveTo(centerX + x, centerY + y);
+            } else {
+                cornerRasterizer.LineTo(centerX + x, centerY + y);
+            }
+        }
+        cornerRasterizer.LineTo(centerX, centerY);
+        if (!cornerRasterizer.RewindScanlines()) {
+            continue;
+        }
+        uint8_t* mask = cornerMasks_ + corner * radius * radius;
+        sl.Reset(cornerRasterizer.GetMinX(), cornerRasterizer.GetMaxX());
+        while (cornerRasterizer.SweepScanline(sl)) {
+            int32_t y = sl.GetYLevel();
+            uint32_t numSpans = sl.NumSpans();
+            GeometryScanline::ConstIterator span = sl.Begin();
+            for (; numSpans && y >= 0 && y < radius; --numSpans, ++span) {
+                for (int32_t i = 0; i < span->spanLength; i++) {
+                    int32_t x = span->x + i;
+                    if (x >= 0 && x < radius) {
+                        mask[y * radius + x] = span->covers[i];
+                    }
+                }
+            }
+        }
+    }
+    cornerRadius_ = radius;
+    return true;
+}
+
+template void RasterizerShapeFastPath::SweepScanline<GeometryScanline>(
+    GeometryScanline& sl, int32_t y, const RasterizerScanlineAntialias& rasterizer) const;
+template void RasterizerShapeFastPath::SweepScanline<GeometryScanlinePacked>(
+    GeometryScanlinePacked& sl, int32_t y, const RasterizerScanlineAntialias& rasterizer) const;
+} // namespace OHOS
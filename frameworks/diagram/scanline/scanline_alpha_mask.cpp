@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/scanline/scanline_alpha_mask.h"
+#include "gfx_utils/graphic_log.h"
+#include "gfx_utils/graphic_math.h"
+#include "securec.h"
+#if defined(ARM_NEON_OPT)
+#include "graphic_neon_utils.h"
+#elif defined(X86_SSE2_OPT)
+#include <emmintrin.h>
+#endif
+
+namespace OHOS {
+namespace {
+#ifdef X86_SSE2_OPT
+constexpr uint32_t SSE2_STEP_8 = 8;
+#endif
+constexpr uint32_t MASK_ROUND = 128;
+constexpr uint32_t MASK_SHIFT = 8;
+} // namespace
+
+AlphaMaskBuffer::AlphaMaskBuffer()
+    : data_(nullptr), ownData_(nullptr), ownSize_(0), width_(0), height_(0), stride_(0)
+{
+}
+
+AlphaMaskBuffer::~AlphaMaskBuffer()
+{
+    GeometryArrayAllocator<uint8_t>::Deallocate(ownData_, ownSize_);
+}
+
+bool AlphaMaskBuffer::Resize(int32_t width, int32_t height)
+{
+    data_ = nullptr;
+    width_ = 0;
+    height_ = 0;
+    stride_ = 0;
+    if (width <= 0 || height <= 0) {
+        return true;
+    }
+    uint64_t wideSize = static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
+    if (wideSize > UINT32_MAX) {
+        GRAPHIC_LOGE("AlphaMaskBuffer::Resize mask size overflow\n");
+        return false;
+    }
+    uint32_t size = static_cast<uint32_t>(wideSize);
+    if (size > ownSize_) {
+        GeometryArrayAllocator<uint8_t>::Deallocate(ownData_, ownSize_);
+        ownData_ = GeometryArrayAllocator<uint8_t>::Allocate(size);
+        ownSize_ = (ownData_ != nullptr) ? size : 0;
+        if (ownData_ == nullptr) {
+            GRAPHIC_LOGE("AlphaMaskBuffer::Resize can not allocate the mask\n");
+            return false;
+        }
+    }
+    data_ = ownData_;
+    width_ = width;
+    height_ = height;
+    stride_ = width;
+    Clear(0);
+    return true;
+}
+
+void AlphaMaskBuffer::Attach(uint8_t* data, int32_t width, int32_t height, int32_t stride)
+{
+    bool valid = (data != nullptr && width > 0 && height > 0 && stride >= width);
+    data_ = valid ? data : nullptr;
+    width_ = valid ? width : 0;
+    height_ = valid ? height : 0;
+    stride_ = valid ? stride : 0;
+}
+
+void AlphaMaskBuffer::Clear(uint8_t value)
+{
+    for (int32_t y = 0; y < height_; y++) {
+        if (memset_s(GetRow(y), width_, value, width_) != EOK) {
+            GRAPHIC_LOGE("AlphaMaskBuffer::Clear memset_s failed\n");
+            return;
+        }
+    }
+}
+
+/**
+ * @brief The spans are clipped to the mask, a solid run sets its pixels to its single cover.
+ * @since 1.0
+ * @version 1.0
+ */
+void AlphaMaskBuffer::AddScanline(const GeometryScanlinePacked& sl, int32_t originX, int32_t originY)
+{
+    int32_t y = sl.GetYLevel() - originY;
+    if (y < 0 || y >= height_) {
+        return;
+    }
+    uint8_t* row = GetRow(y);
+    uint32_t numSpans = sl.NumSpans();
+    GeometryScanlinePacked::ConstIterator span = sl.Begin();
+    for (; numSpans; --numSpans, ++span) {
+        bool solid = span->spanLength < 0;
+        int32_t x = span->x - originX;
+        int32_t x1 = MATH_MAX(x, 0);
+        int32_t x2 = MATH_MIN(x + (solid ? -span->spanLength : span->spanLength), width_);
+        if (x1 >= x2) {
+            continue;
+        }
+        if (solid) {
+            if (memset_s(row + x1, x2 - x1, span->covers[0], x2 - x1) != EOK) {
+                GRAPHIC_LOGE("AlphaMaskBuffer::AddScanline memset_s failed\n");
+                return;
+            }
+        } else if (memcpy_s(row + x1, x2 - x1, span->covers + (x1 - x), x2 - x1) != EOK) {
+            GRAPHIC_LOGE("AlphaMaskBuffer::AddScanline memcpy_s failed\n");
+            return;
+        }
+    }
+}
+
+/**
+ * @brief The covers left and right of the mask are cleared, the ones inside are multiplied.
+ * @since 1.0
+ * @version 1.0
+ */
+void AlphaMaskBuffer::MaskCovers(int32_t x, int32_t y, uint8_t* covers, uint32_t len) const
+{
+    if (y < 0 || y >= height_) {
+        if (memset_s(covers, len, 0, len) != EOK) {
+            GRAPHIC_LOGE("AlphaMaskBuffer::MaskCovers memset_s failed\n");
+        }
+        return;
+    }
+    int64_t end = static_cast<int64_t>(x) + len;
+    int32_t x1 = MATH_MAX(x, 0);
+    int32_t x2 = static_cast<int32_t>(MATH_MIN(end, static_cast<int64_t>(width_)));
+    if (x1 >= x2) {
+        if (memset_s(covers, len, 0, len) != EOK) {
+            GRAPHIC_LOGE("AlphaMaskBuffer::MaskCovers memset_s failed\n");
+        }
+        return;
+    }
+    uint32_t left = static_cast<uint32_t>(x1 - x);
+    uint32_t right = static_cast<uint32_t>(end - x2);
+    if ((left > 0 && memset_s(covers, left, 0, left) != EOK) ||
+        (right > 0 && memset_s(covers + (len - right), right, 0, right) != EOK)) {
+        GRAPHIC_LOGE("AlphaMaskBuffer::MaskCovers memset_s failed\n");
+        return;
+    }
+    MultiplyCovers(covers + left, GetRow(y) + x1, static_cast<uint32_t>(x2 - x1));
+}
+
+/**
+ * @brief cover * mask / 255 rounded to nearest, (t + (t >> 8)) >> 8 with t = cover * mask + 128,
+ * which fits in 16 bits so 8 pixels are multiplied per vector.
+ * @since 1.0
+ * @version 1.0
+ */
+void AlphaMaskBuffer::MultiplyCovers(uint8_t* covers, const uint8_t* mask, uint32_t len)
+{
+    uint32_t i = 0;
+#if defined(ARM_NEON_OPT)
+    for (; i + NEON_STEP_8 <= len; i += NEON_STEP_8) {
+        vst1_u8(covers + i, Multipling(vld1_u8(covers + i), vld1_u8(mask + i)));
+    }
+#elif defined(X86_SSE2_OPT)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16(MASK_ROUND);
+    for (; i + SSE2_STEP_8 <= len; i += SSE2_STEP_8) {
+        __m128i cover = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(covers + i)), zero);
+        __m128i alpha = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(mask + i)), zero);
+        __m128i value = _mm_add_epi16(_mm_mullo_epi16(cover, alpha), round);
+        value = _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, MASK_SHIFT)), MASK_SHIFT);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(covers + i), _mm_packus_epi16(value, value));
+    }
+#endif
+    for (; i < len; i++) {
+        uint32_t value = covers[i] * mask[i] + MASK_ROUND;
+        covers[i] = static_cast<uint8_t>((value + (value >> MASK_SHIFT)) >> MASK_SHIFT);
+    }
+}
+} // namespace OHOS
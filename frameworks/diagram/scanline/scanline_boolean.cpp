@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/scanline/scanline_boolean.h"
+
+namespace OHOS {
+/**
+ * @brief Intersection multiplies the covers, union multiplies what both leave uncovered,
+ * xor adds them and folds the sum back above full coverage, difference multiplies A with
+ * what B leaves uncovered. Full coverage stays full.
+ * @since 1.0
+ * @version 1.0
+ */
+uint32_t ScanlineBooleanBase::CombineCovers(ScanlineBooleanOp op, uint32_t c1, uint32_t c2)
+{
+    const uint32_t fullCover = COVER_MASK * COVER_MASK;
+    uint32_t cover;
+    switch (op) {
+        case BOOL_INTERSECT:
+            cover = c1 * c2;
+            break;
+        case BOOL_UNION:
+            cover = fullCover - (COVER_MASK - c1) * (COVER_MASK - c2);
+            break;
+        case BOOL_XOR:
+            cover = c1 + c2;
+            return (cover > COVER_MASK) ? (COVER_MASK + COVER_MASK - cover) : cover;
+        default:
+            cover = c1 * (COVER_MASK - c2);
+            break;
+    }
+    return (cover == fullCover) ? static_cast<uint32_t>(COVER_MASK) : (cover >> COVER_SHIFT);
+}
+
+void ScanlineBooleanBase::StartPiece(GeometryScanlinePacked::ConstIterator span, SpanPiece& piece)
+{
+    piece.solid = span->spanLength < 0;
+    piece.x = span->x;
+    piece.end = span->x + (piece.solid ? -span->spanLength : span->spanLength);
+    piece.spanX = span->x;
+    piece.covers = span->covers;
+}
+
+template <class Scanline>
+void ScanlineBooleanBase::AddPiece(const SpanPiece& piece, int32_t end, Scanline& sl)
+{
+    if (piece.solid) {
+        sl.AddSpan(piece.x, end - piece.x, piece.covers[0]);
+    } else {
+        sl.AddCells(piece.x, end - piece.x, piece.covers + (piece.x - piece.spanX));
+    }
+}
+
+template <class Scanline>
+void ScanlineBooleanBase::AddBoth(ScanlineBooleanOp op, const SpanPiece& a, const SpanPiece& b,
+                                  int32_t end, Scanline& sl)
+{
+    if (a.solid && b.solid) {
+        uint32_t cover = CombineCovers(op, a.covers[0], b.covers[0]);
+        if (cover) {
+            sl.AddSpan(a.x, end - a.x, cover);
+        }
+        return;
+    }
+    const uint8_t* covers1 = a.solid ? a.covers : a.covers + (a.x - a.spanX);
+    const uint8_t* covers2 = b.solid ? b.covers : b.covers + (b.x - b.spanX);
+    for (int32_t x = a.x; x < end; x++) {
+        uint32_t cover = CombineCovers(op, *covers1, *covers2);
+        if (cover) {
+            sl.AddCell(x, cover);
+        }
+        covers1 += a.solid ? 0 : 1;
+        covers2 += b.solid ? 0 : 1;
+    }
+}
+
+/**
+ * @brief Both rows are walked from left to right. The part of a span left of the other shape's
+ * current span is added alone, which union and xor keep for both shapes and difference keeps for A,
+ * the part covered by both is combined.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline>
+void ScanlineBooleanBase::CombineRow(ScanlineBooleanOp op,
+                                     GeometryScanlinePacked::ConstIterator a, uint32_t numA,
+                                     GeometryScanlinePacked::ConstIterator b, uint32_t numB, Scanline& sl)
+{
+    bool keepA = (op != BOOL_INTERSECT);
+    bool keepB = (op == BOOL_UNION || op == BOOL_XOR);
+    SpanPiece pieceA;
+    SpanPiece pieceB;
+    if (numA) {
+        StartPiece(a, pieceA);
+    }
+    if (numB) {
+        StartPiece(b, pieceB);
+    }
+    while (numA || numB) {
+        if (numA && (!numB || pieceA.end <= pieceB.x)) {
+            if (!keepA && !numB) {
+                return;
+            }
+            if (keepA) {
+                AddPiece(pieceA, pieceA.end, sl);
+            }
+            if (--numA) {
+                StartPiece(++a, pieceA);
+            }
+            continue;
+        }
+        if (numB && (!numA || pieceB.end <= pieceA.x)) {
+            if (!keepB && !numA) {
+                return;
+            }
+            if (keepB) {
+                AddPiece(pieceB, pieceB.end, sl);
+            }
+            if (--numB) {
+                StartPiece(++b, pieceB);
+            }
+            continue;
+        }
+        // The spans overlap, first the part of the one that starts earlier
+        if (pieceA.x < pieceB.x) {
+            if (keepA) {
+                AddPiece(pieceA, pieceB.x, sl);
+            }
+            pieceA.x = pieceB.x;
+        } else if (pieceB.x < pieceA.x) {
+            if (keepB) {
+                AddPiece(pieceB, pieceA.x, sl);
+            }
+            pieceB.x = pieceA.x;
+        }
+        int32_t end = MATH_MIN(pieceA.end, pieceB.end);
+        AddBoth(op, pieceA, pieceB, end, sl);
+        pieceA.x = end;
+        pieceB.x = end;
+        if (end == pieceA.end && --numA) {
+            StartPiece(++a, pieceA);
+        }
+        if (end == pieceB.end && --numB) {
+            StartPiece(++b, pieceB);
+        }
+    }
+}
+
+template void ScanlineBooleanBase::CombineRow<GeometryScanline>(ScanlineBooleanOp op,
+    GeometryScanlinePacked::ConstIterator a, uint32_t numA,
+    GeometryScanlinePacked::ConstIterator b, uint32_t numB, GeometryScanline& sl);
+template void ScanlineBooleanBase::CombineRow<GeometryScanlinePacked>(ScanlineBooleanOp op,
+    GeometryScanlinePacked::ConstIterator a, uint32_t numA,
+    GeometryScanlinePacked::ConstIterator b, uint32_t numB, GeometryScanlinePacked& sl);
+} // namespace OHOS
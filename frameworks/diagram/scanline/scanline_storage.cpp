@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/scanline/scanline_storage.h"
+#include "gfx_utils/graphic_log.h"
+#include "gfx_utils/graphic_math.h"
+#include "securec.h"
+
+namespace OHOS {
+ScanlineStorage::ScanlineStorage()
+    : rows_(nullptr),
+      rowsCapacity_(0),
+      numRows_(0),
+      spans_(nullptr),
+      spansCapacity_(0),
+      numSpans_(0),
+      covers_(nullptr),
+      coversCapacity_(0),
+      numCovers_(0),
+      currRow_(0),
+      minX_(0),
+      maxX_(-1),
+      offsetX_(0),
+      offsetY_(0)
+{
+}
+
+ScanlineStorage::~ScanlineStorage()
+{
+    GeometryArrayAllocator<StorageRow>::Deallocate(rows_, rowsCapacity_);
+    GeometryArrayAllocator<StorageSpan>::Deallocate(spans_, spansCapacity_);
+    GeometryArrayAllocator<uint8_t>::Deallocate(covers_, coversCapacity_);
+}
+
+void ScanlineStorage::Reset()
+{
+    numRows_ = 0;
+    numSpans_ = 0;
+    numCovers_ = 0;
+    currRow_ = 0;
+    minX_ = 0;
+    maxX_ = -1;
+}
+
+/**
+ * @brief A span whose covers are all equal keeps a single cover,
+ * the solid runs of a packed scanline are kept as they are.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline>
+bool ScanlineStorage::AddScanline(const Scanline& sl)
+{
+    uint32_t numSpans = sl.NumSpans();
+    if (numSpans == 0) {
+        return true;
+    }
+    if (numRows_ > 0 && sl.GetYLevel() <= rows_[numRows_ - 1].y) {
+        GRAPHIC_LOGE("ScanlineStorage::AddScanline scanlines must be added from top to bottom\n");
+        return false;
+    }
+    uint32_t numCovers = 0;
+    typename Scanline::ConstIterator span = sl.Begin();
+    for (uint32_t i = 0; i < numSpans; i++) {
+        numCovers += (span[i].spanLength < 0) ? 1 : static_cast<uint32_t>(span[i].spanLength);
+    }
+    if (!ReserveStorage(rows_, rowsCapacity_, numRows_, numRows_ + 1) ||
+        !ReserveStorage(spans_, spansCapacity_, numSpans_, numSpans_ + numSpans) ||
+        !ReserveStorage(covers_, coversCapacity_, numCovers_, numCovers_ + numCovers)) {
+        GRAPHIC_LOGE("ScanlineStorage::AddScanline Allocate fail\n");
+        return false;
+    }
+    StorageRow& row = rows_[numRows_++];
+    row.y = sl.GetYLevel();
+    row.firstSpan = numSpans_;
+    row.numSpans = numSpans;
+    for (; numSpans; --numSpans, ++span) {
+        StorageSpan& stored = spans_[numSpans_++];
+        int32_t spanLength = span->spanLength;
+        stored.x = span->x;
+        stored.coverIndex = numCovers_;
+        if (spanLength < 0) {
+            stored.spanLength = spanLength;
+            covers_[numCovers_++] = span->covers[0];
+        } else {
+            int32_t i = 1;
+            while (i < spanLength && span->covers[i] == span->covers[0]) {
+                i++;
+            }
+            if (spanLength > 1 && i == spanLength) {
+                stored.spanLength = -spanLength;
+                covers_[numCovers_++] = span->covers[0];
+            } else {
+                stored.spanLength = spanLength;
+                if (memcpy_s(covers_ + numCovers_, coversCapacity_ - numCovers_, span->covers, spanLength) != EOK) {
+                    numRows_--;
+                    numSpans_ = row.firstSpan;
+                    numCovers_ = spans_[row.firstSpan].coverIndex;
+                    return false;
+                }
+                numCovers_ += static_cast<uint32_t>(spanLength);
+            }
+        }
+        int32_t lastX = span->x + MATH_ABS(spanLength) - 1;
+        if (minX_ > maxX_) {
+            minX_ = span->x;
+            maxX_ = lastX;
+        } else {
+            minX_ = MATH_MIN(minX_, span->x);
+            maxX_ = MATH_MAX(maxX_, lastX);
+        }
+    }
+    return true;
+}
+
+bool ScanlineStorage::CopyFrom(const ScanlineStorage& source)
+{
+    Reset();
+    if (!ReserveStorage(rows_, rowsCapacity_, 0, source.numRows_) ||
+        !ReserveStorage(spans_, spansCapacity_, 0, source.numSpans_) ||
+        !ReserveStorage(covers_, coversCapacity_, 0, source.numCovers_)) {
+        GRAPHIC_LOGE("ScanlineStorage::CopyFrom Allocate fail\n");
+        return false;
+    }
+    if ((source.numRows_ > 0 && memcpy_s(rows_, rowsCapacity_ * sizeof(StorageRow), source.rows_,
+                                         source.numRows_ * sizeof(StorageRow)) != EOK) ||
+        (source.numSpans_ > 0 && memcpy_s(spans_, spansCapacity_ * sizeof(StorageSpan), source.spans_,
+                                          source.numSpans_ * sizeof(StorageSpan)) != EOK) ||
+        (source.numCovers_ > 0 && memcpy_s(covers_, coversCapacity_, source.covers_, source.numCovers_) != EOK)) {
+        return false;
+    }
+    numRows_ = source.numRows_;
+    numSpans_ = source.numSpans_;
+    numCovers_ = source.numCovers_;
+    minX_ = source.minX_;
+    maxX_ = source.maxX_;
+    offsetX_ = source.offsetX_;
+    offsetY_ = source.offsetY_;
+    return true;
+}
+
+template <class Scanline>
+bool ScanlineStorage::SweepScanline(Scanline& sl)
+{
+    if (currRow_ >= numRows_) {
+        return false;
+    }
+    const StorageRow& row = rows_[currRow_++];
+    sl.ResetSpans();
+    for (uint32_t i = 0; i < row.numSpans; i++) {
+        const StorageSpan& span = spans_[row.firstSpan + i];
+        if (span.spanLength < 0) {
+            sl.AddSpan(span.x + offsetX_, static_cast<uint32_t>(-span.spanLength), covers_[span.coverIndex]);
+        } else {
+            sl.AddCells(span.x + offsetX_, static_cast<uint32_t>(span.spanLength), covers_ + span.coverIndex);
+        }
+    }
+    sl.Finalize(row.y + offsetY_);
+    return true;
+}
+
+uint8_t ScanlineStorage::GetCover(int32_t x, int32_t y) const
+{
+    x -= offsetX_;
+    y -= offsetY_;
+    if (numRows_ == 0 || x < minX_ || x > maxX_) {
+        return 0;
+    }
+    // The last row at or above y, then the last span of that row starting at or left of x
+    uint32_t low = 0;
+    uint32_t high = numRows_;
+    while (high - low > 1) {
+        uint32_t middle = (low + high) >> 1;
+        if (rows_[middle].y <= y) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    const StorageRow& row = rows_[low];
+    if (row.y != y || row.numSpans == 0) {
+        return 0;
+    }
+    const StorageSpan* spans = spans_ + row.firstSpan;
+    low = 0;
+    high = row.numSpans;
+    while (high - low > 1) {
+        uint32_t middle = (low + high) >> 1;
+        if (spans[middle].x <= x) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    const StorageSpan& span = spans[low];
+    int32_t offset = x - span.x;
+    if (offset < 0 || offset >= MATH_ABS(span.spanLength)) {
+        return 0;
+    }
+    return (span.spanLength < 0) ? covers_[span.coverIndex] : covers_[span.coverIndex + offset];
+}
+
+uint32_t ScanlineStorage::GetSerializedSize() const
+{
+    return sizeof(StorageHeader) + numRows_ * sizeof(StorageRow) + numSpans_ * sizeof(StorageSpan) + numCovers_;
+}
+
+bool ScanlineStorage::Serialize(uint8_t* data, uint32_t size) const
+{
+    if (data == nullptr || size < GetSerializedSize()) {
+        return false;
+    }
+    StorageHeader header;
+    header.magic = STORAGE_MAGIC;
+    header.numRows = numRows_;
+    header.numSpans = numSpans_;
+    header.numCovers = numCovers_;
+    header.minX = minX_;
+    header.maxX = maxX_;
+    uint32_t rowsSize = numRows_ * sizeof(StorageRow);
+    uint32_t spansSize = numSpans_ * sizeof(StorageSpan);
+    if (memcpy_s(data, size, &header, sizeof(header)) != EOK) {
+        return false;
+    }
+    data += sizeof(header);
+    size -= sizeof(header);
+    if ((rowsSize > 0 && memcpy_s(data, size, rows_, rowsSize) != EOK) ||
+        (spansSize > 0 && memcpy_s(data + rowsSize, size - rowsSize, spans_, spansSize) != EOK) ||
+        (numCovers_ > 0 && memcpy_s(data + rowsSize + spansSize, size - rowsSize - spansSize,
+                                    covers_, numCovers_) != EOK)) {
+        return false;
+    }
+    return true;
+}
+
+bool ScanlineStorage::Deserialize(const uint8_t* data, uint32_t size)
+{
+    Reset();
+    StorageHeader header;
+    if (data == nullptr || size < sizeof(header) || memcpy_s(&header, sizeof(header), data, sizeof(header)) != EOK) {
+        return false;
+    }
+    uint64_t dataSize = sizeof(header) + static_cast<uint64_t>(header.numRows) * sizeof(StorageRow) +
+                        static_cast<uint64_t>(header.numSpans) * sizeof(StorageSpan) + header.numCovers;
+    if (header.magic != STORAGE_MAGIC || dataSize > size) {
+        GRAPHIC_LOGE("ScanlineStorage::Deserialize invalid data\n");
+        return false;
+    }
+    if (!ReserveStorage(rows_, rowsCapacity_, 0, header.numRows) ||
+        !ReserveStorage(spans_, spansCapacity_, 0, header.numSpans) ||
+        !ReserveStorage(covers_, coversCapacity_, 0, header.numCovers)) {
+        GRAPHIC_LOGE("ScanlineStorage::Deserialize Allocate fail\n");
+        return false;
+    }
+    uint32_t rowsSize = header.numRows * sizeof(StorageRow);
+    uint32_t spansSize = header.numSpans * sizeof(StorageSpan);
+    data += sizeof(header);
+    if ((rowsSize > 0 && memcpy_s(rows_, rowsCapacity_ * sizeof(StorageRow), data, rowsSize) != EOK) ||
+        (spansSize > 0 && memcpy_s(spans_, spansCapacity_ * sizeof(StorageSpan), data + rowsSize, spansSize) != EOK) ||
+        (header.numCovers > 0 &&
+         memcpy_s(covers_, coversCapacity_, data + rowsSize + spansSize, header.numCovers) != EOK)) {
+        return false;
+    }
+    numRows_ = header.numRows;
+    numSpans_ = header.numSpans;
+    numCovers_ = header.numCovers;
+    minX_ = header.minX;
+    maxX_ = header.maxX;
+    if (!CheckStorage()) {
+        GRAPHIC_LOGE("ScanlineStorage::Deserialize invalid data\n");
+        Reset();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Rows go down and own consecutive spans, spans go right within the bounds and their covers
+ * lie in the arena, so replaying and GetCover never read outside the storage. The bounds fit
+ * the scanlines the spans are replayed into.
+ * @since 1.0
+ * @version 1.0
+ */
+bool ScanlineStorage::CheckStorage() const
+{
+    if (minX_ < INT16_MIN || maxX_ > INT16_MAX ||
+        (numRows_ > 0 && (maxX_ < minX_ || static_cast<int64_t>(maxX_) - minX_ >= SCANLINE_MAX_WIDTH))) {
+        return false;
+    }
+    uint32_t nextSpan = 0;
+    for (uint32_t i = 0; i < numRows_; i++) {
+        const StorageRow& row = rows_[i];
+        if ((i > 0 && row.y <= rows_[i - 1].y) || row.firstSpan != nextSpan ||
+            row.numSpans == 0 || row.numSpans > numSpans_ - nextSpan) {
+            return false;
+        }
+        nextSpan += row.numSpans;
+        int64_t lastX = static_cast<int64_t>(minX_) - 1;
+        for (uint32_t j = row.firstSpan; j < nextSpan; j++) {
+            const StorageSpan& span = spans_[j];
+            int64_t length = (span.spanLength < 0) ? -static_cast<int64_t>(span.spanLength) : span.spanLength;
+            uint64_t numCovers = (span.spanLength < 0) ? 1 : static_cast<uint64_t>(length);
+            if (length == 0 || span.x <= lastX || span.x + length - 1 > maxX_ ||
+                span.coverIndex + numCovers > numCovers_) {
+                return false;
+            }
+            lastX = span.x + length - 1;
+        }
+    }
+    return nextSpan == numSpans_;
+}
+
+/**
+ * @brief Make sure data holds at least size elements, the first used elements are kept
+ * and the capacity grows geometrically.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class T>
+bool ScanlineStorage::ReserveStorage(T*& data, uint32_t& capacity, uint32_t used, uint32_t size)
+{
+    if (size <= capacity) {
+        return true;
+    }
+    uint32_t newCapacity = MATH_MAX(capacity << 1, size);
+    T* newData = GeometryArrayAllocator<T>::Allocate(newCapacity);
+    if (newData == nullptr) {
+        return false;
+    }
+    if (data != nullptr) {
+        if (used > 0 && memcpy_s(newData, newCapacity * sizeof(T), data, used * sizeof(T)) != EOK) {
+            GeometryArrayAllocator<T>::Deallocate(newData, newCapacity);
+            return false;
+        }
+        GeometryArrayAllocator<T>::Deallocate(data, capacity);
+    }
+    data = newData;
+    capacity = newCapacity;
+    return true;
+}
+
+template bool ScanlineStorage::AddScanline<GeometryScanline>(const GeometryScanline& sl);
+template bool ScanlineStorage::AddScanline<GeometryScanlinePacked>(const GeometryScanlinePacked& sl);
+template bool ScanlineStorage::SweepScanline<GeometryScanline>(GeometryScanline& sl);
+template bool ScanlineStorage::SweepScanline<GeometryScanlinePacked>(GeometryScanlinePacked& sl);
+} // namespace OHOS
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/spancolorfill/fill_base.h"
+#if defined(ARM_NEON_OPT)
+#include "graphic_neon_utils.h"
+#elif defined(X86_SSE2_OPT)
+#include <emmintrin.h>
+#endif
+
+namespace OHOS {
+namespace {
+#if defined(ARM_NEON_OPT) || defined(X86_SSE2_OPT)
+constexpr uint32_t COLORS_PER_VECTOR = 4;
+#endif
+} // namespace
+
+/**
+ * @brief The channels are added as bytes, a saturating add clamps them at MAX_COLOR_NUM.
+ * @since 1.0
+ * @version 1.0
+ */
+void SpanBlendColor::AddColors(Rgba8T* span, const Rgba8T* colors1, const Rgba8T* colors2, uint32_t len)
+{
+    uint8_t* dst = reinterpret_cast<uint8_t*>(span);
+    const uint8_t* src1 = reinterpret_cast<const uint8_t*>(colors1);
+    const uint8_t* src2 = reinterpret_cast<const uint8_t*>(colors2);
+    uint32_t numBytes = len * sizeof(Rgba8T);
+    uint32_t i = 0;
+#if defined(ARM_NEON_OPT)
+    const uint32_t step = COLORS_PER_VECTOR * sizeof(Rgba8T);
+    for (; i + step <= numBytes; i += step) {
+        vst1q_u8(dst + i, vqaddq_u8(vld1q_u8(src1 + i), vld1q_u8(src2 + i)));
+    }
+#elif defined(X86_SSE2_OPT)
+    const uint32_t step = COLORS_PER_VECTOR * sizeof(Rgba8T);
+    for (; i + step <= numBytes; i += step) {
+        __m128i sum = _mm_adds_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src1 + i)),
+                                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(src2 + i)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), sum);
+    }
+#endif
+    for (; i < numBytes; i++) {
+        uint32_t sum = src1[i] + src2[i];
+        dst[i] = static_cast<uint8_t>((sum >= MAX_COLOR_NUM) ? MAX_COLOR_NUM : sum);
+    }
+}
+} // namespace OHOS
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_linear.h"
+#if defined(ARM_NEON_OPT)
+#include "graphic_neon_utils.h"
+#elif defined(X86_SSE2_OPT)
+#include <emmintrin.h>
+#endif
+
+namespace OHOS {
+#if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+namespace {
+/* The periods of a position are clamped to keep them in the range of int32_t. */
+constexpr float MAX_PERIODS = 4194304.0f;
+#if defined(ARM_NEON_OPT) || defined(X86_SSE2_OPT)
+constexpr uint32_t INDICES_PER_VECTOR = 4;
+#endif
+
+/* The position minus its whole periods, period is size for repeat and 2 * size for reflect. */
+inline int32_t SpreadIndex(float position, float period, int32_t size, GradientSpreadMode spread)
+{
+    float periods = MATH_MIN(MATH_MAX(position * (1.0f / period), -MAX_PERIODS), MAX_PERIODS);
+    float whole = static_cast<float>(static_cast<int32_t>(periods));
+    whole -= (whole > periods) ? 1.0f : 0.0f;
+    float offset = MATH_MIN(MATH_MAX(position - whole * period, 0.0f), period - 1.0f);
+    int32_t index = static_cast<int32_t>(offset);
+    if (spread == GRADIENT_SPREAD_REFLECT && index >= size) {
+        index = 2 * size - 1 - index; // 2: the reflected half of the period
+    }
+    return index;
+}
+} // namespace
+
+/**
+ * @brief The positions of the span are start + i * step in lut indices, start is the transformed
+ * first pixel. The indices are calculated in batches and then looked up.
+ * @since 1.0
+ * @version 1.0
+ */
+void SpanLinearGradient::Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+{
+    const TransAffine& transform = interpolator_.GetTransformer();
+    float x1 = static_cast<float>(x);
+    float y1 = static_cast<float>(y);
+    transform.Transform(&x1, &y1);
+    float x2 = static_cast<float>(x) + 1.0f;
+    float y2 = static_cast<float>(y);
+    transform.Transform(&x2, &y2);
+    int32_t size = static_cast<int32_t>(colorFunction_.GetSize());
+    float scale = size / distance_;
+    float start = x1 * scale;
+    float step = (x2 - x1) * scale;
+    int32_t indices[INDEX_BATCH];
+    for (uint32_t done = 0; done < len; done += INDEX_BATCH) {
+        uint32_t batch = MATH_MIN(len - done, static_cast<uint32_t>(INDEX_BATCH));
+        CalculateIndices(indices, start + static_cast<float>(done) * step, step, batch, size, spread_);
+        for (uint32_t i = 0; i < batch; i++, span++) {
+            const Rgba8T& color = colorFunction_[indices[i]];
+            span->red = color.red;
+            span->green = color.green;
+            span->blue = color.blue;
+            span->alpha = color.alpha;
+        }
+    }
+}
+
+/**
+ * @brief A padded position is clamped to the lut. A repeated or reflected one is reduced to its
+ * period with a floor made of a truncation, which the vectors of ARMv7 and SSE2 have.
+ * @since 1.0
+ * @version 1.0
+ */
+void SpanLinearGradient::CalculateIndices(int32_t* indices, float start, float step, uint32_t len, int32_t size,
+                                          GradientSpreadMode spread)
+{
+    float maxIndex = static_cast<float>(size - 1);
+    float period = (spread == GRADIENT_SPREAD_REFLECT) ? 2.0f * size : static_cast<float>(size); // 2: reflect
+    uint32_t i = 0;
+#if defined(ARM_NEON_OPT)
+    const float32x4_t vStart = vdupq_n_f32(start);
+    const float32x4_t vStep = vdupq_n_f32(step);
+    const float32x4_t vZero = vdupq_n_f32(0.0f);
+    const float32x4_t vOne = vdupq_n_f32(1.0f);
+    const float32x4_t vPeriod = vdupq_n_f32(period);
+    const float32x4_t vInverse = vdupq_n_f32(1.0f / period);
+    const float32x4_t vMaxPeriods = vdupq_n_f32(MAX_PERIODS);
+    const float32x4_t vMinPeriods = vdupq_n_f32(-MAX_PERIODS);
+    const float32x4_t vLast = vdupq_n_f32((spread == GRADIENT_SPREAD_PAD) ? maxIndex : period - 1.0f);
+    const int32x4_t vSize = vdupq_n_s32(size);
+    const int32x4_t vMirror = vdupq_n_s32(2 * size - 1); // 2: the reflected half of the period
+    const int32_t lanes[INDICES_PER_VECTOR] = {0, 1, 2, 3};
+    int32x4_t vIndex = vld1q_s32(lanes);
+    for (; i + INDICES_PER_VECTOR <= len; i += INDICES_PER_VECTOR) {
+        float32x4_t position = vaddq_f32(vStart, vmulq_f32(vcvtq_f32_s32(vIndex), vStep));
+        vIndex = vaddq_s32(vIndex, vdupq_n_s32(INDICES_PER_VECTOR));
+        if (spread != GRADIENT_SPREAD_PAD) {
+            float32x4_t periods = vmulq_f32(position, vInverse);
+            periods = vminq_f32(vmaxq_f32(periods, vMinPeriods), vMaxPeriods);
+            float32x4_t whole = vcvtq_f32_s32(vcvtq_s32_f32(periods));
+            whole = vsubq_f32(whole, vbslq_f32(vcgtq_f32(whole, periods), vOne, vZero));
+            position = vsubq_f32(position, vmulq_f32(whole, vPeriod));
+        }
+        int32x4_t index = vcvtq_s32_f32(vminq_f32(vmaxq_f32(position, vZero), vLast));
+        if (spread == GRADIENT_SPREAD_REFLECT) {
+            index = vbslq_s32(vcgeq_s32(index, vSize), vsubq_s32(vMirror, index), index);
+        }
+        vst1q_s32(indices + i, index);
+    }
+#elif defined(X86_SSE2_OPT)
+    const __m128 vStart = _mm_set1_ps(start);
+    const __m128 vStep = _mm_set1_ps(step);
+    const __m128 vZero = _mm_setzero_ps();
+    const __m128 vOne = _mm_set1_ps(1.0f);
+    const __m128 vPeriod = _mm_set1_ps(period);
+    const __m128 vInverse = _mm_set1_ps(1.0f / period);
+    const __m128 vMaxPeriods = _mm_set1_ps(MAX_PERIODS);
+    const __m128 vMinPeriods = _mm_set1_ps(-MAX_PERIODS);
+    const __m128 vLast = _mm_set1_ps((spread == GRADIENT_SPREAD_PAD) ? maxIndex : period - 1.0f);
+    const __m128i vHalf = _mm_set1_epi32(size - 1);
+    const __m128i vMirror = _mm_set1_epi32(2 * size - 1); // 2: the reflected half of the period
+    __m128i vIndex = _mm_setr_epi32(0, 1, 2, 3);
+    for (; i + INDICES_PER_VECTOR <= len; i += INDICES_PER_VECTOR) {
+        __m128 position = _mm_add_ps(vStart, _mm_mul_ps(_mm_cvtepi32_ps(vIndex), vStep));
+        vIndex = _mm_add_epi32(vIndex, _mm_set1_epi32(INDICES_PER_VECTOR));
+        if (spread != GRADIENT_SPREAD_PAD) {
+            __m128 periods = _mm_min_ps(_mm_max_ps(_mm_mul_ps(position, vInverse), vMinPeriods), vMaxPeriods);
+            __m128 whole = _mm_cvtepi32_ps(_mm_cvttps_epi32(periods));
+            whole = _mm_sub_ps(whole, _mm_and_ps(_mm_cmpgt_ps(whole, periods), vOne));
+            position = _mm_sub_ps(position, _mm_mul_ps(whole, vPeriod));
+        }
+        __m128i index = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(position, vZero), vLast));
+        if (spread == GRADIENT_SPREAD_REFLECT) {
+            __m128i mirrored = _mm_cmpgt_epi32(index, vHalf);
+            index = _mm_or_si128(_mm_and_si128(mirrored, _mm_sub_epi32(vMirror, index)),
+                                 _mm_andnot_si128(mirrored, index));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(indices + i), index);
+    }
+#endif
+    for (; i < len; i++) {
+        float position = start + static_cast<float>(i) * step;
+        if (spread == GRADIENT_SPREAD_PAD) {
+            indices[i] = static_cast<int32_t>(MATH_MIN(MATH_MAX(position, 0.0f), maxIndex));
+        } else {
+            indices[i] = SpreadIndex(position, period, size, spread);
+        }
+    }
+}
+#endif
+} // namespace OHOS
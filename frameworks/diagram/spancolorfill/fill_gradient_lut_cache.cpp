@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_lut_cache.h"
+#include "gfx_utils/diagram/common/common_basics.h"
+#include "gfx_utils/graphic_log.h"
+#include <new>
+
+namespace OHOS {
+#if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+namespace {
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+void HashBytes(uint64_t& hash, const void* data, uint32_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (uint32_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+}
+
+/* Locks the cache for the scope. */
+class CacheLock {
+public:
+    explicit CacheLock(GraphicMutex& mutex) : mutex_(mutex)
+    {
+        mutex_.Lock();
+    }
+
+    ~CacheLock()
+    {
+        mutex_.Unlock();
+    }
+
+private:
+    GraphicMutex& mutex_;
+};
+
+/*
+ * The colors from color1 to color2 at weights round(i * BASE_MASK / distance) for i < len,
+ * the weights of ColorInterpolator. The weight is (2 * i * BASE_MASK + distance) / (2 * distance)
+ * kept as a quotient and a remainder, which are stepped without a division.
+ */
+void InterpolateColors(Rgba8T* colors, const Rgba8T& color1, const Rgba8T& color2, uint32_t len, uint32_t distance)
+{
+    const uint32_t denominator = 2 * distance;       // 2: the half of the rounding
+    const uint32_t step = 2 * Rgba8T::BASE_MASK;     // 2: the half of the rounding
+    const uint32_t quotientStep = step / denominator;
+    const uint32_t remainderStep = step % denominator;
+    uint32_t weight = 0;
+    uint32_t remainder = distance;
+    for (uint32_t i = 0; i < len; i++, colors++) {
+        uint8_t alpha = static_cast<uint8_t>(weight);
+        colors->red = Rgba8T::Lerp(color1.red, color2.red, alpha);
+        colors->green = Rgba8T::Lerp(color1.green, color2.green, alpha);
+        colors->blue = Rgba8T::Lerp(color1.blue, color2.blue, alpha);
+        colors->alpha = Rgba8T::Lerp(color1.alpha, color2.alpha, alpha);
+        weight += quotientStep;
+        remainder += remainderStep;
+        if (remainder >= denominator) {
+            remainder -= denominator;
+            weight++;
+        }
+    }
+}
+
+void FillColors(Rgba8T* colors, const Rgba8T& color, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++, colors++) {
+        colors->red = color.red;
+        colors->green = color.green;
+        colors->blue = color.blue;
+        colors->alpha = color.alpha;
+    }
+}
+} // namespace
+
+/**
+ * @brief The stops are kept to tell luts with the same hash apart.
+ * @since 1.0
+ * @version 1.0
+ */
+struct FillGradientLutCache::CacheEntry : public HeapBase {
+    uint64_t hash;
+    GradientColorStop* stops;
+    uint32_t numStops;
+    uint16_t lutSize;
+    Rgba8T* colors;
+    uint32_t refCount;
+    CacheEntry* prev;
+    CacheEntry* next;
+    CacheEntry* nextInBucket;
+    bool cached;
+};
+
+FillGradientLutCache::FillGradientLutCache(uint32_t capacity)
+    : head_(nullptr), tail_(nullptr), capacity_(capacity), stats_()
+{
+    for (uint32_t i = 0; i < HASH_BUCKETS; i++) {
+        buckets_[i] = nullptr;
+    }
+}
+
+FillGradientLutCache::~FillGradientLutCache()
+{
+    Clear();
+}
+
+/**
+ * @brief The instance is built in static storage and never destroyed, so a FillGradientLut that is
+ * copied or destroyed during the static destruction still finds it.
+ * @since 1.0
+ * @version 1.0
+ */
+FillGradientLutCache& FillGradientLutCache::GetInstance()
+{
+    alignas(FillGradientLutCache) static uint8_t storage[sizeof(FillGradientLutCache)];
+    static FillGradientLutCache* instance = ::new (storage) FillGradientLutCache();
+    return *instance;
+}
+
+void FillGradientLutCache::BuildLut(const GradientColorStop* stops, uint32_t numStops, Rgba8T* colors,
+                                    uint16_t lutSize)
+{
+    if (numStops == 0) {
+        return;
+    }
+    uint32_t start = MATH_MIN(static_cast<uint32_t>(stops[0].offset * lutSize), static_cast<uint32_t>(lutSize));
+    FillColors(colors, stops[0].color, start);
+    for (uint32_t index = 1; index < numStops; index++) {
+        uint32_t end = MATH_MIN(static_cast<uint32_t>(stops[index].offset * lutSize), static_cast<uint32_t>(lutSize));
+        if (end > start) {
+            InterpolateColors(colors + start, stops[index - 1].color, stops[index].color, end - start,
+                              end - start + 1);
+            start = end;
+        }
+    }
+    FillColors(colors + start, stops[numStops - 1].color, lutSize - start);
+}
+
+uint64_t FillGradientLutCache::HashStops(const GradientColorStop* stops, uint32_t numStops, uint16_t lutSize)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    HashBytes(hash, &lutSize, sizeof(lutSize));
+    for (uint32_t i = 0; i < numStops; i++) {
+        uint8_t channels[] = {stops[i].color.red, stops[i].color.green, stops[i].color.blue, stops[i].color.alpha};
+        HashBytes(hash, &stops[i].offset, sizeof(stops[i].offset));
+        HashBytes(hash, channels, sizeof(channels));
+    }
+    return hash;
+}
+
+bool FillGradientLutCache::SameStops(const CacheEntry* entry, const GradientColorStop* stops, uint32_t numStops,
+                                     uint16_t lutSize)
+{
+    if (entry->numStops != numStops || entry->lutSize != lutSize) {
+        return false;
+    }
+    for (uint32_t i = 0; i < numStops; i++) {
+        const GradientColorStop& stop = entry->stops[i];
+        if (stop.offset != stops[i].offset || stop.color.red != stops[i].color.red ||
+            stop.color.green != stops[i].color.green || stop.color.blue != stops[i].color.blue ||
+            stop.color.alpha != stops[i].color.alpha) {
+            return false;
+        }
+    }
+    return true;
+}
+
+FillGradientLutCache::CacheEntry* FillGradientLutCache::Acquire(const GradientColorStop* stops, uint32_t numStops,
+                                                                uint16_t lutSize)
+{
+    CacheLock lock(mutex_);
+    uint64_t hash = HashStops(stops, numStops, lutSize);
+    CacheEntry* entry = buckets_[hash % HASH_BUCKETS];
+    while (entry != nullptr && (entry->hash != hash || !SameStops(entry, stops, numStops, lutSize))) {
+        entry = entry->nextInBucket;
+    }
+    if (entry != nullptr) {
+        stats_.hits++;
+        entry->refCount++;
+        // Move to the front of the recently used list
+        if (entry != head_) {
+            Unlink(entry);
+            Insert(entry);
+        }
+        return entry;
+    }
+    stats_.misses++;
+    entry = CreateEntry(stops, numStops, lutSize, hash);
+    if (entry == nullptr) {
+        return nullptr;
+    }
+    if (capacity_ > 0) {
+        Evict(capacity_ - 1);
+        entry->cached = true;
+        Insert(entry);
+        entry->nextInBucket = buckets_[hash % HASH_BUCKETS];
+        buckets_[hash % HASH_BUCKETS] = entry;
+        stats_.entries++;
+    }
+    return entry;
+}
+
+FillGradientLutCache::CacheEntry* FillGradientLutCache::CreateEntry(const GradientColorStop* stops,
+                                                                    uint32_t numStops, uint16_t lutSize,
+                                                                    uint64_t hash)
+{
+    CacheEntry* entry = new CacheEntry();
+    if (entry == nullptr) {
+        return nullptr;
+    }
+    entry->stops = (numStops > 0) ? GeometryArrayAllocator<GradientColorStop>::Allocate(numStops) : nullptr;
+    entry->colors = GeometryArrayAllocator<Rgba8T>::Allocate(lutSize);
+    if ((numStops > 0 && entry->stops == nullptr) || entry->colors == nullptr) {
+        GRAPHIC_LOGE("FillGradientLutCache::CreateEntry Allocate fail\n");
+        entry->numStops = numStops;
+        entry->lutSize = lutSize;
+        DeleteEntry(entry);
+        return nullptr;
+    }
+    for (uint32_t i = 0; i < numStops; i++) {
+        entry->stops[i].offset = stops[i].offset;
+        entry->stops[i].color.red = stops[i].color.red;
+        entry->stops[i].color.green = stops[i].color.green;
+        entry->stops[i].color.blue = stops[i].color.blue;
+        entry->stops[i].color.alpha = stops[i].color.alpha;
+    }
+    BuildLut(stops, numStops, entry->colors, lutSize);
+    entry->hash = hash;
+    entry->numStops = numStops;
+    entry->lutSize = lutSize;
+    entry->refCount = 1;
+    entry->prev = nullptr;
+    entry->next = nullptr;
+    entry->nextInBucket = nullptr;
+    entry->cached = false;
+    return entry;
+}
+
+void FillGradientLutCache::AddRef(CacheEntry* entry)
+{
+    if (entry == nullptr) {
+        return;
+    }
+    CacheLock lock(mutex_);
+    entry->refCount++;
+}
+
+void FillGradientLutCache::Release(CacheEntry* entry)
+{
+    if (entry == nullptr) {
+        return;
+    }
+    CacheLock lock(mutex_);
+    if (--entry->refCount == 0 && !entry->cached) {
+        DeleteEntry(entry);
+    }
+}
+
+const Rgba8T* FillGradientLutCache::GetColors(const CacheEntry* entry)
+{
+    return (entry != nullptr) ? entry->colors : nullptr;
+}
+
+void FillGradientLutCache::Insert(CacheEntry* entry)
+{
+    entry->prev = nullptr;
+    entry->next = head_;
+    if (head_ != nullptr) {
+        head_->prev = entry;
+    }
+    head_ = entry;
+    if (tail_ == nullptr) {
+        tail_ = entry;
+    }
+}
+
+void FillGradientLutCache::Unlink(CacheEntry* entry)
+{
+    if (entry->prev != nullptr) {
+        entry->prev->next = entry->next;
+    } else {
+        head_ = entry->next;
+    }
+    if (entry->next != nullptr) {
+        entry->next->prev = entry->prev;
+    } else {
+        tail_ = entry->prev;
+    }
+    entry->prev = nullptr;
+    entry->next = nullptr;
+}
+
+/**
+ * @brief Drop the least recently used luts until at most capacity are cached, a lut still in use
+ * is freed by its last Release.
+ * @since 1.0
+ * @version 1.0
+ */
+void FillGradientLutCache::Evict(uint32_t capacity)
+{
+    while (tail_ != nullptr && stats_.entries > capacity) {
+        CacheEntry* entry = tail_;
+        Unlink(entry);
+        CacheEntry** link = &buckets_[entry->hash % HASH_BUCKETS];
+        while (*link != entry) {
+            link = &(*link)->nextInBucket;
+        }
+        *link = entry->nextInBucket;
+        entry->nextInBucket = nullptr;
+        entry->cached = false;
+        stats_.entries--;
+        stats_.evictions++;
+        if (entry->refCount == 0) {
+            DeleteEntry(entry);
+        }
+    }
+}
+
+void FillGradientLutCache::DeleteEntry(CacheEntry* entry)
+{
+    if (entry->stops != nullptr) {
+        GeometryArrayAllocator<GradientColorStop>::Deallocate(entry->stops, entry->numStops);
+    }
+    if (entry->colors != nullptr) {
+        GeometryArrayAllocator<Rgba8T>::Deallocate(entry->colors, entry->lutSize);
+    }
+    delete entry;
+}
+
+void FillGradientLutCache::SetCapacity(uint32_t capacity)
+{
+    CacheLock lock(mutex_);
+    capacity_ = capacity;
+    Evict(capacity_);
+}
+
+void FillGradientLutCache::Clear()
+{
+    CacheLock lock(mutex_);
+    uint32_t evictions = stats_.evictions;
+    Evict(0);
+    stats_.evictions = evictions;
+}
+
+FillGradientLutCacheStats FillGradientLutCache::GetStats()
+{
+    CacheLock lock(mutex_);
+    return stats_;
+}
+
+void FillGradientLutCache::ResetStats()
+{
+    CacheLock lock(mutex_);
+    uint32_t entries = stats_.entries;
+    stats_ = FillGradientLutCacheStats();
+    stats_.entries = entries;
+}
+#endif
+} // namespace OHOS
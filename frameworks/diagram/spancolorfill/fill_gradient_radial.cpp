@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_radial.h"
+
+#include <cmath>
+#if defined(ARM_NEON_OPT)
+#include "graphic_neon_utils.h"
+#elif defined(X86_SSE2_OPT)
+#include <emmintrin.h>
+#endif
+
+namespace OHOS {
+#if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+namespace {
+#if defined(ARM_NEON_OPT) || defined(X86_SSE2_OPT)
+constexpr uint32_t INDICES_PER_VECTOR = 4;
+#endif
+/* The fixed point indices have 8 fraction bits, the fixed scale has 21 or 22 significant bits. */
+constexpr int32_t FIXED_INDEX_SHIFT = 8;
+constexpr double FIXED_SCALE_MIN = 2097152.0;
+constexpr double MAX_FIXED_SCALE = 1099511627776.0;
+constexpr int32_t MAX_FIXED_SHIFT = 48;
+constexpr uint64_t MAX_ROOT_INPUT_BITS = 1ull << 62;
+/* The root is taken to an eighth of a lut entry, fewer bits mostly fit into 32 bits. */
+constexpr double ROOT_STEPS_PER_INDEX = 8.0;
+/* The stepped positions have 16 fraction bits, the clamps keep a span within 62 bits. */
+constexpr int32_t POSITION_SHIFT = 16;
+constexpr double MAX_FIXED_ORIGIN = 1152921504606846976.0;
+constexpr double MAX_FIXED_STEP = 268435456.0;
+/* The operands of the root have at most 15 bits, 4 fraction bits of a subpixel at most. */
+constexpr int64_t MAX_ROOT_OPERAND = 1 << 15;
+constexpr int32_t MAX_OPERAND_FRACTION_BITS = 4;
+
+/* Round a value of the setup, clamped to +-limit first so that the conversion can not overflow. */
+inline int64_t ClampToFixed(double value, double limit)
+{
+    return std::llround(MATH_MIN(MATH_MAX(value, -limit), limit));
+}
+
+/* The integer square root, bit by bit without a division. */
+template <class T>
+T ISqrt(T value)
+{
+    T root = 0;
+    T bit = static_cast<T>(1) << (sizeof(T) * 8 - 2); // 8: bits per byte, 2: the highest power of 4
+    while (bit > value) {
+        bit >>= 2; // 2: the next power of 4
+    }
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2; // 2: the next power of 4
+    }
+    return root;
+}
+
+/* The root from a guess, integer Newton steps fall to it from above after the first step. */
+inline uint32_t NextRoot(uint32_t value, uint32_t guess)
+{
+    uint32_t root = MATH_MAX(guess, 1u);
+    uint32_t next = static_cast<uint32_t>((static_cast<uint64_t>(root) + value / root) >> 1);
+    do {
+        root = next;
+        next = static_cast<uint32_t>((static_cast<uint64_t>(root) + value / MATH_MAX(root, 1u)) >> 1);
+    } while (next < root);
+    return root;
+}
+} // namespace
+
+SpanRadialGradient::SpanRadialGradient(FillInterpolator& inter, FillGradientLut& colorFunction, float startRadius,
+                                       float endRadius, float focalX, float focalY)
+    : interpolator_(inter), colorFunction_(colorFunction), size_(static_cast<int32_t>(colorFunction.GetSize()))
+{
+    int32_t start = static_cast<int32_t>(startRadius * GRADIENT_SUBPIXEL_SCALE);
+    int32_t end = static_cast<int32_t>(endRadius * GRADIENT_SUBPIXEL_SCALE);
+    int32_t fx = static_cast<int32_t>(focalX * GRADIENT_SUBPIXEL_SCALE);
+    int32_t fy = static_cast<int32_t>(focalY * GRADIENT_SUBPIXEL_SCALE);
+    endRadiusSquare_ = static_cast<float>(end) * static_cast<float>(end);
+    float denominator = endRadiusSquare_ - (static_cast<float>(fx) * fx + static_cast<float>(fy) * fy);
+    if (denominator == 0.0f) {
+        // A focal point on the end circle is moved towards the center, as GradientRadialCalculate does
+        fx += (fx < 0) ? 1 : ((fx > 0) ? -1 : 0);
+        fy += (fy < 0) ? 1 : ((fy > 0) ? -1 : 0);
+        denominator = endRadiusSquare_ - (static_cast<float>(fx) * fx + static_cast<float>(fy) * fy);
+    }
+    focalX_ = static_cast<float>(fx);
+    focalY_ = static_cast<float>(fy);
+    float deltaRadius = MATH_MAX(static_cast<float>(end - start), 1.0f);
+    indexScale_ = end / denominator * size_ / deltaRadius;
+    indexOffset_ = start * size_ / deltaRadius;
+
+    fixedPoint_ = denominator > 0.0f;
+    fixedScale_ = 0;
+    fixedShift_ = 0;
+    fixedOffset_ = 0;
+    maxFixedPosition_ = 0;
+    rootShift_ = 0;
+    coordinateShift_ = POSITION_SHIFT;
+    fixedBox_ = 0;
+    fixedFocalX_ = 0;
+    fixedFocalY_ = 0;
+    fixedRadiusSquare_ = 0;
+    fixedOriginX_ = 0;
+    fixedOriginY_ = 0;
+    fixedStepX_ = 0;
+    fixedStepY_ = 0;
+    fixedRowStepX_ = 0;
+    fixedRowStepY_ = 0;
+    if (fixedPoint_) {
+        PrepareFixedPoint(start, end, fx, fy);
+        Prepare();
+    }
+}
+
+/**
+ * @brief The setup of the fixed point path that depends on the circles. A position on the gradient
+ * is at least half the distance of its pixel to the focal point, so a pixel outside a box of twice
+ * the larger radius takes the last lut entry. Within the box the operands of the root are shifted
+ * to 15 bits, so the value under the root fits into 62 bits.
+ * @since 1.0
+ * @version 1.0
+ */
+void SpanRadialGradient::PrepareFixedPoint(int32_t start, int32_t end, int32_t fx, int32_t fy)
+{
+    int64_t radius = std::llabs(static_cast<int64_t>(end));
+    int64_t box = 2 * (MATH_MAX(radius, std::llabs(static_cast<int64_t>(start))) + 1); // 2: twice the radius
+    coordinateShift_ = POSITION_SHIFT - MAX_OPERAND_FRACTION_BITS;
+    while (((box << POSITION_SHIFT) >> coordinateShift_) >= MAX_ROOT_OPERAND) {
+        coordinateShift_++;
+    }
+    fixedBox_ = box << POSITION_SHIFT;
+    fixedFocalX_ = (static_cast<int64_t>(fx) << POSITION_SHIFT) >> coordinateShift_;
+    fixedFocalY_ = (static_cast<int64_t>(fy) << POSITION_SHIFT) >> coordinateShift_;
+    int64_t fixedRadius = (radius << POSITION_SHIFT) >> coordinateShift_;
+    fixedRadiusSquare_ = fixedRadius * fixedRadius;
+
+    // The root and the dot product are in 2^(2 * (coordinateShift_ - POSITION_SHIFT)) subpixels squared
+    double unitScale = std::ldexp(1.0, 2 * (coordinateShift_ - POSITION_SHIFT)); // 2: squared
+    double scale = static_cast<double>(indexScale_) * (1 << FIXED_INDEX_SHIFT) * unitScale;
+    int32_t shift = 0;
+    while (std::fabs(scale) > 0 && std::fabs(scale) < FIXED_SCALE_MIN && shift < MAX_FIXED_SHIFT) {
+        scale *= 2; // 2: one more fraction bit
+        shift++;
+    }
+    fixedScale_ = ClampToFixed(scale, MAX_FIXED_SCALE);
+    fixedShift_ = shift;
+    fixedOffset_ = ClampToFixed(static_cast<double>(indexOffset_) * (1 << FIXED_INDEX_SHIFT), MAX_FIXED_ORIGIN);
+    // 2: the product of a position and the scale keeps a bit of headroom
+    maxFixedPosition_ = (INT64_MAX / 2) / ((fixedScale_ != 0) ? std::llabs(fixedScale_) : 1);
+    // 2: the value is shifted by an even count, which halves in the root
+    double rootStep = std::fabs(static_cast<double>(indexScale_)) * unitScale * ROOT_STEPS_PER_INDEX;
+    rootShift_ = 0;
+    while (rootShift_ < MAX_FIXED_SHIFT && rootStep * (1ll << (rootShift_ / 2 + 1)) <= 1.0) {
+        rootShift_ += 2; // 2: an even shift
+    }
+}
+
+/**
+ * @brief The setup of the fixed point path that depends on the transform: the position of pixel
+ * (0, 0) relative to the focal point and the steps to the next pixel and the next row, in subpixels
+ * with POSITION_SHIFT fraction bits.
+ * @since 1.0
+ * @version 1.0
+ */
+void SpanRadialGradient::Prepare()
+{
+    if (!fixedPoint_) {
+        return;
+    }
+    const float* data = interpolator_.GetTransformer().GetData();
+    double scale = std::ldexp(static_cast<double>(GRADIENT_SUBPIXEL_SCALE), POSITION_SHIFT);
+    // 0, 3: the steps of x, 1, 4: the steps of y, 2, 5: the translation
+    fixedOriginX_ = ClampToFixed(data[2] * scale - std::ldexp(focalX_, POSITION_SHIFT), MAX_FIXED_ORIGIN);
+    fixedOriginY_ = ClampToFixed(data[5] * scale - std::ldexp(focalY_, POSITION_SHIFT), MAX_FIXED_ORIGIN);
+    fixedStepX_ = ClampToFixed(data[0] * scale, MAX_FIXED_STEP);
+    fixedStepY_ = ClampToFixed(data[3] * scale, MAX_FIXED_STEP);
+    fixedRowStepX_ = ClampToFixed(data[1] * scale, MAX_FIXED_STEP);
+    fixedRowStepY_ = ClampToFixed(data[4] * scale, MAX_FIXED_STEP); // 4: the step of y in y
+}
+
+/**
+ * @brief The first pixel of the span and the step to the next one in the subpixels of
+ * GradientRadialCalculate, relative to the focal point.
+ * @since 1.0
+ * @version 1.0
+ */
+void SpanRadialGradient::BeginSpan(int32_t x, int32_t y, float& startX, float& startY, float& stepX, float& stepY)
+{
+    const TransAffine& transform = interpolator_.GetTransformer();
+    float x1 = static_cast<float>(x);
+    float y1 = static_cast<float>(y);
+    transform.Transform(&x1, &y1);
+    float x2 = static_cast<float>(x) + 1.0f;
+    float y2 = static_cast<float>(y);
+    transform.Transform(&x2, &y2);
+    startX = x1 * GRADIENT_SUBPIXEL_SCALE - focalX_;
+    startY = y1 * GRADIENT_SUBPIXEL_SCALE - focalY_;
+    stepX = (x2 - x1) * GRADIENT_SUBPIXEL_SCALE;
+    stepY = (y2 - y1) * GRADIENT_SUBPIXEL_SCALE;
+}
+
+void SpanRadialGradient::LookUp(Rgba8T* span, const int32_t* indices, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++, span++) {
+        const Rgba8T& color = colorFunction_[indices[i]];
+        span->red = color.red;
+        span->green = color.green;
+        span->blue = color.blue;
+        span->alpha = color.alpha;
+    }
+}
+
+void SpanRadialGradient::GenerateFloat(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+{
+    float startX;
+    float startY;
+    float stepX;
+    float stepY;
+    BeginSpan(x, y, startX, startY, stepX, stepY);
+    int32_t indices[INDEX_BATCH];
+    for (uint32_t done = 0; done < len; done += INDEX_BATCH) {
+        uint32_t batch = MATH_MIN(len - done, static_cast<uint32_t>(INDEX_BATCH));
+        CalculateIndices(indices, startX + done * stepX, startY + done * stepY, stepX, stepY, batch);
+        LookUp(span + done, indices, batch);
+    }
+}
+
+/**
+ * @brief The positions of 4 pixels per vector. NEON of ARMv7 has no square root, it is the
+ * reciprocal square root estimate refined by two Newton steps, times the value.
+ * @since 1.0
+ * @version 1.0
+ */
+void SpanRadialGradient::CalculateIndices(int32_t* indices, float startX, float startY, float stepX, float stepY,
+                                          uint32_t len) const
+{
+    float maxIndex = static_cast<float>(size_ - 1);
+    uint32_t i = 0;
+#if defined(ARM_NEON_OPT)
+    const float32x4_t vFocalX = vdupq_n_f32(focalX_);
+    const float32x4_t vFocalY = vdupq_n_f32(focalY_);
+    const float32x4_t vRadiusSquare = vdupq_n_f32(endRadiusSquare_);
+    const float32x4_t vScale = vdupq_n_f32(indexScale_);
+    const float32x4_t vOffset = vdupq_n_f32(indexOffset_);
+    const float32x4_t vZero = vdupq_n_f32(0.0f);
+    const float32x4_t vLast = vdupq_n_f32(maxIndex);
+    const float lanes[INDICES_PER_VECTOR] = {0.0f, 1.0f, 2.0f, 3.0f};
+    float32x4_t vLane = vld1q_f32(lanes);
+    for (; i + INDICES_PER_VECTOR <= len; i += INDICES_PER_VECTOR) {
+        float32x4_t dx = vaddq_f32(vdupq_n_f32(startX), vmulq_f32(vLane, vdupq_n_f32(stepX)));
+        float32x4_t dy = vaddq_f32(vdupq_n_f32(startY), vmulq_f32(vLane, vdupq_n_f32(stepY)));
+        vLane = vaddq_f32(vLane, vdupq_n_f32(static_cast<float>(INDICES_PER_VECTOR)));
+        float32x4_t cross = vsubq_f32(vmulq_f32(dx, vFocalY), vmulq_f32(dy, vFocalX));
+        float32x4_t distance = vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy));
+        float32x4_t value = vabsq_f32(vsubq_f32(vmulq_f32(vRadiusSquare, distance), vmulq_f32(cross, cross)));
+#if defined(__aarch64__)
+        float32x4_t root = vsqrtq_f32(value);
+#else
+        value = vmaxq_f32(value, vdupq_n_f32(1.0f));
+        float32x4_t inverse = vrsqrteq_f32(value);
+        inverse = vmulq_f32(inverse, vrsqrtsq_f32(vmulq_f32(value, inverse), inverse));
+        inverse = vmulq_f32(inverse, vrsqrtsq_f32(vmulq_f32(value, inverse), inverse));
+        float32x4_t root = vmulq_f32(value, inverse);
+#endif
+        float32x4_t dot = vaddq_f32(vmulq_f32(dx, vFocalX), vmulq_f32(dy, vFocalY));
+        float32x4_t position = vsubq_f32(vmulq_f32(vaddq_f32(dot, root), vScale), vOffset);
+        vst1q_s32(indices + i, vcvtq_s32_f32(vminq_f32(vmaxq_f32(position, vZero), vLast)));
+    }
+#elif defined(X86_SSE2_OPT)
+    const __m128 vFocalX = _mm_set1_ps(focalX_);
+    const __m128 vFocalY = _mm_set1_ps(focalY_);
+    const __m128 vRadiusSquare = _mm_set1_ps(endRadiusSquare_);
+    const __m128 vScale = _mm_set1_ps(indexScale_);
+    const __m128 vOffset = _mm_set1_ps(indexOffset_);
+    const __m128 vZero = _mm_setzero_ps();
+    const __m128 vLast = _mm_set1_ps(maxIndex);
+    const __m128 vSign = _mm_set1_ps(-0.0f);
+    __m128 vLane = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    for (; i + INDICES_PER_VECTOR <= len; i += INDICES_PER_VECTOR) {
+        __m128 dx = _mm_add_ps(_mm_set1_ps(startX), _mm_mul_ps(vLane, _mm_set1_ps(stepX)));
+        __m128 dy = _mm_add_ps(_mm_set1_ps(startY), _mm_mul_ps(vLane, _mm_set1_ps(stepY)));
+        vLane = _mm_add_ps(vLane, _mm_set1_ps(static_cast<float>(INDICES_PER_VECTOR)));
+        __m128 cross = _mm_sub_ps(_mm_mul_ps(dx, vFocalY), _mm_mul_ps(dy, vFocalX));
+        __m128 distance = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 value = _mm_sub_ps(_mm_mul_ps(vRadiusSquare, distance), _mm_mul_ps(cross, cross));
+        __m128 root = _mm_sqrt_ps(_mm_andnot_ps(vSign, value));
+        __m128 dot = _mm_add_ps(_mm_mul_ps(dx, vFocalX), _mm_mul_ps(dy, vFocalY));
+        __m128 position = _mm_sub_ps(_mm_mul_ps(_mm_add_ps(dot, root), vScale), vOffset);
+        __m128i index = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(position, vZero), vLast));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(indices + i), index);
+    }
+#endif
+    for (; i < len; i++) {
+        float dx = startX + i * stepX;
+        float dy = startY + i * stepY;
+        float cross = dx * focalY_ - dy * focalX_;
+        float value = endRadiusSquare_ * (dx * dx + dy * dy) - cross * cross;
+        float position = (dx * focalX_ + dy * focalY_ + Sqrt(std::fabs(value))) * indexScale_ - indexOffset_;
+        indices[i] = static_cast<int32_t>(MATH_MIN(MATH_MAX(position, 0.0f), maxIndex));
+    }
+}
+
+/**
+ * @brief Only the position of the first pixel is set up per span, from the integers of Prepare.
+ * The position is stepped with integer adds, within the box around the focal point the value under
+ * the root is evaluated from its operands shifted to 15 bits. The value is shifted right by
+ * rootShift_, which keeps the root to an eighth of a lut entry and mostly fits it into 32 bits.
+ * @since 1.0
+ * @version 1.0
+ */
+void SpanRadialGradient::GenerateFixedPoint(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+{
+    if (!fixedPoint_) {
+        // A focal point on or outside the end circle is not bounded by the box
+        GenerateFloat(span, x, y, len);
+        return;
+    }
+    int64_t positionX = fixedOriginX_ + x * fixedStepX_ + y * fixedRowStepX_;
+    int64_t positionY = fixedOriginY_ + x * fixedStepY_ + y * fixedRowStepY_;
+    const int64_t maxIndex = size_ - 1;
+    uint64_t root = 0;
+    int64_t rootDelta = 0;
+    for (; len; --len, span++, positionX += fixedStepX_, positionY += fixedStepY_) {
+        int64_t index = maxIndex;
+        if (positionX >= -fixedBox_ && positionX <= fixedBox_ && positionY >= -fixedBox_ && positionY <= fixedBox_) {
+            int64_t dx = positionX >> coordinateShift_;
+            int64_t dy = positionY >> coordinateShift_;
+            int64_t cross = dx * fixedFocalY_ - dy * fixedFocalX_;
+            int64_t value = fixedRadiusSquare_ * (dx * dx + dy * dy) - cross * cross;
+            uint64_t magnitude = static_cast<uint64_t>((value < 0) ? -value : value) >> rootShift_;
+            uint64_t previous = root;
+            if (magnitude > UINT32_MAX) {
+                root = ISqrt(MATH_MIN(magnitude, MAX_ROOT_INPUT_BITS));
+            } else {
+                // The root of the last pixel plus its change is close to this one, mostly two divisions
+                int64_t guess = static_cast<int64_t>(root) + rootDelta;
+                root = NextRoot(static_cast<uint32_t>(magnitude),
+                    static_cast<uint32_t>(MATH_MIN(MATH_MAX(guess, 1ll), static_cast<int64_t>(UINT16_MAX))));
+            }
+            rootDelta = static_cast<int64_t>(root) - static_cast<int64_t>(previous);
+            int64_t dot = dx * fixedFocalX_ + dy * fixedFocalY_;
+            int64_t position = dot + (static_cast<int64_t>(root) << (rootShift_ / 2)); // 2: the root halves
+            position = MATH_MIN(MATH_MAX(position, -maxFixedPosition_), maxFixedPosition_);
+            index = (((position * fixedScale_) >> fixedShift_) - fixedOffset_) >> FIXED_INDEX_SHIFT;
+            index = MATH_MIN(MATH_MAX(index, static_cast<int64_t>(0)), maxIndex);
+        }
+        const Rgba8T& color = colorFunction_[static_cast<uint32_t>(index)];
+        span->red = color.red;
+        span->green = color.green;
+        span->blue = color.blue;
+        span->alpha = color.alpha;
+    }
+}
+#endif
+} // namespace OHOS
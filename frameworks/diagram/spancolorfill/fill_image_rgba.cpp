@@ -0,0 +1,455 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/spancolorfill/fill_image_rgba.h"
+#include "gfx_utils/graphic_log.h"
+#include "gfx_utils/graphic_math.h"
+#include "securec.h"
+#include <cstring>
+#if defined(ARM_NEON_OPT)
+#include "graphic_neon_utils.h"
+#elif defined(X86_SSE2_OPT)
+#include <emmintrin.h>
+#endif
+
+namespace OHOS {
+namespace {
+constexpr float HALF_PIXEL = 0.5f;
+constexpr int32_t HALF_SUBPIXEL = FillInterpolator::SUBPIXEL_SCALE / 2;
+constexpr int32_t SUBPIXEL_MASK = FillInterpolator::SUBPIXEL_SCALE - 1;
+constexpr int32_t WEIGHT_DOWNSHIFT = FillInterpolator::SUBPIXEL_SHIFT - SpanImageRgba::WEIGHT_SHIFT;
+constexpr uint32_t WEIGHT_ROUND = SpanImageRgba::WEIGHT_SCALE / 2;
+constexpr uint32_t AVERAGE_SHIFT = 2;
+constexpr uint32_t AVERAGE_ROUND = 2;
+constexpr uint32_t BYTE_MASK = 0xFF;
+constexpr uint32_t ALPHA_GREEN_MASK = 0xFF00FF00;
+constexpr uint32_t OPAQUE_ALPHA = 0xFF000000;
+constexpr uint32_t RED_BLUE_SHIFT = 16;
+constexpr uint32_t GREEN_SHIFT = 8;
+constexpr uint32_t BLUE_SHIFT = 16;
+constexpr uint32_t CHANNEL_BITS = 8;
+constexpr uint32_t CHANNELS = 4;
+constexpr uint32_t RGB565_RED_SHIFT = 11;
+constexpr uint32_t RGB565_GREEN_SHIFT = 5;
+constexpr uint32_t RGB565_RED_MASK = 0x1F;
+constexpr uint32_t RGB565_GREEN_MASK = 0x3F;
+constexpr uint32_t RGB565_BLUE_MASK = 0x1F;
+// 3: a 5 bit channel is widened to 8 bits, 2: and its top bits repeated in the low bits
+constexpr uint32_t RGB565_WIDEN_5 = 3;
+constexpr uint32_t RGB565_REPEAT_5 = 2;
+// 2: a 6 bit channel is widened to 8 bits, 4: and its top bits repeated in the low bits
+constexpr uint32_t RGB565_WIDEN_6 = 2;
+constexpr uint32_t RGB565_REPEAT_6 = 4;
+#if defined(ARM_NEON_OPT) || defined(X86_SSE2_OPT)
+constexpr uint32_t PIXELS_PER_VECTOR = 8;
+#endif
+#if defined(X86_SSE2_OPT)
+constexpr uint32_t SSE2_COLORS = 4;
+constexpr uint32_t SSE2_WEIGHTS = 4;
+#endif
+
+/*
+ * The readers of the supported color modes, which pack a pixel into the 32 bits the bytes of
+ * Rgba8T are read as, red in the low byte. Color32 and Color24 are stored blue first.
+ * A pixel may be unaligned, it is loaded through memcpy into a local, which compiles to one load.
+ */
+struct ReadArgb8888 {
+    enum { BYTES = 4 };
+
+    static uint32_t Read(const uint8_t* pixel)
+    {
+        uint32_t value;
+        std::memcpy(&value, pixel, sizeof(value));
+        return (value & ALPHA_GREEN_MASK) | ((value >> RED_BLUE_SHIFT) & BYTE_MASK) |
+               ((value & BYTE_MASK) << RED_BLUE_SHIFT);
+    }
+};
+
+struct ReadXrgb8888 {
+    enum { BYTES = 4 };
+
+    static uint32_t Read(const uint8_t* pixel)
+    {
+        return ReadArgb8888::Read(pixel) | OPAQUE_ALPHA;
+    }
+};
+
+struct ReadRgb888 {
+    enum { BYTES = 3 };
+
+    static uint32_t Read(const uint8_t* pixel)
+    {
+        const Color24* source = reinterpret_cast<const Color24*>(pixel);
+        return source->red | (source->green << GREEN_SHIFT) | (source->blue << BLUE_SHIFT) | OPAQUE_ALPHA;
+    }
+};
+
+struct ReadRgb565 {
+    enum { BYTES = 2 };
+
+    static uint32_t Read(const uint8_t* pixel)
+    {
+        uint16_t packed;
+        std::memcpy(&packed, pixel, sizeof(packed));
+        uint32_t value = packed;
+        uint32_t red = (value >> RGB565_RED_SHIFT) & RGB565_RED_MASK;
+        uint32_t green = (value >> RGB565_GREEN_SHIFT) & RGB565_GREEN_MASK;
+        uint32_t blue = value & RGB565_BLUE_MASK;
+        red = (red << RGB565_WIDEN_5) | (red >> RGB565_REPEAT_5);
+        green = (green << RGB565_WIDEN_6) | (green >> RGB565_REPEAT_6);
+        blue = (blue << RGB565_WIDEN_5) | (blue >> RGB565_REPEAT_5);
+        return red | (green << GREEN_SHIFT) | (blue << BLUE_SHIFT) | OPAQUE_ALPHA;
+    }
+};
+
+struct ImageView {
+    const uint8_t* data;
+    int32_t width;
+    int32_t height;
+    bool repeatX;
+    bool repeatY;
+};
+
+/* Wraps a repeated coordinate into [0, size), a coordinate which is not repeated must be inside. */
+inline bool ResolveCoordinate(int32_t& coordinate, int32_t size, bool repeat)
+{
+    if (repeat) {
+        coordinate %= size;
+        if (coordinate < 0) {
+            coordinate += size;
+        }
+        return true;
+    }
+    return coordinate >= 0 && coordinate < size;
+}
+
+/* The packed pixel, transparent outside of the image. */
+template <class Format>
+inline uint32_t ReadPixel(const ImageView& image, int32_t x, int32_t y)
+{
+    if (!ResolveCoordinate(x, image.width, image.repeatX) || !ResolveCoordinate(y, image.height, image.repeatY)) {
+        return 0;
+    }
+    return Format::Read(image.data + (y * image.width + x) * Format::BYTES);
+}
+
+inline uint8_t LerpWeight(uint32_t p, uint32_t q, uint32_t weight)
+{
+    return static_cast<uint8_t>((p * (SpanImageRgba::WEIGHT_SCALE - weight) + q * weight + WEIGHT_ROUND) >>
+                                SpanImageRgba::WEIGHT_SHIFT);
+}
+
+#if defined(ARM_NEON_OPT)
+/* (p * (WEIGHT_SCALE - w) + q * w) / WEIGHT_SCALE rounded, at most 255 * 128 before the shift. */
+inline uint8x8_t NeonLerpWeight(uint8x8_t p, uint8x8_t q, uint8x8_t weight, uint8x8_t inverse)
+{
+    return vrshrn_n_u16(vmlal_u8(vmull_u8(p, inverse), q, weight), SpanImageRgba::WEIGHT_SHIFT);
+}
+
+inline uint8x8_t NeonAverage(uint8x8_t a, uint8x8_t b, uint8x8_t c, uint8x8_t d)
+{
+    return vrshrn_n_u16(vaddq_u16(vaddl_u8(a, b), vaddl_u8(c, d)), AVERAGE_SHIFT);
+}
+#elif defined(X86_SSE2_OPT)
+/*
+ * The same on 16 bit lanes as p * WEIGHT_SCALE + (q - p) * w, the product wraps but the sum is
+ * the one of the 2 products. The weight of a pixel is repeated over its 4 lanes.
+ */
+inline __m128i Sse2LerpWeight(__m128i p, __m128i q, __m128i weight)
+{
+    __m128i value = _mm_add_epi16(_mm_slli_epi16(p, SpanImageRgba::WEIGHT_SHIFT),
+                                  _mm_mullo_epi16(_mm_sub_epi16(q, p), weight));
+    return _mm_srli_epi16(_mm_add_epi16(value, _mm_set1_epi16(WEIGHT_ROUND)), SpanImageRgba::WEIGHT_SHIFT);
+}
+
+/* The weights of 8 pixels, spread[n] has the ones of pixels 2n and 2n + 1. */
+inline void Sse2SpreadWeights(const uint8_t* weights, __m128i* spread)
+{
+    __m128i words = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(weights)),
+                                      _mm_setzero_si128());
+    __m128i low = _mm_unpacklo_epi16(words, words);
+    __m128i high = _mm_unpackhi_epi16(words, words);
+    spread[0] = _mm_unpacklo_epi32(low, low);
+    spread[1] = _mm_unpackhi_epi32(low, low);
+    spread[2] = _mm_unpacklo_epi32(high, high); // 2: pixels 4 and 5
+    spread[3] = _mm_unpackhi_epi32(high, high); // 3: pixels 6 and 7
+}
+
+inline __m128i Sse2Average(__m128i a, __m128i b, __m128i c, __m128i d)
+{
+    __m128i sum = _mm_add_epi16(_mm_add_epi16(a, b), _mm_add_epi16(c, d));
+    return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(AVERAGE_ROUND)), AVERAGE_SHIFT);
+}
+#endif
+} // namespace
+
+SpanImageRgba::SpanImageRgba(FillInterpolator& inter, ImageFilterMode filter, PatternRepeatMode repeat)
+    : interpolator_(inter), filter_(filter), repeat_(repeat), data_(nullptr), width_(0), height_(0),
+      nearestFunc_(nullptr), cornersFunc_(nullptr)
+{
+}
+
+bool SpanImageRgba::IsSupported(ColorMode mode)
+{
+    return mode == ARGB8888 || mode == XRGB8888 || mode == RGB888 || mode == RGB565;
+}
+
+bool SpanImageRgba::Attach(const ImageInfo* image)
+{
+    data_ = nullptr;
+    nearestFunc_ = nullptr;
+    cornersFunc_ = nullptr;
+    if (image == nullptr || image->data == nullptr || image->header.width == 0 || image->header.height == 0 ||
+        !IsSupported(static_cast<ColorMode>(image->header.colorMode))) {
+        GRAPHIC_LOGE("SpanImageRgba::Attach the image is not supported\n");
+        return false;
+    }
+    switch (image->header.colorMode) {
+        case ARGB8888:
+            nearestFunc_ = GatherNearest<ReadArgb8888>;
+            cornersFunc_ = GatherCorners<ReadArgb8888>;
+            break;
+        case XRGB8888:
+            nearestFunc_ = GatherNearest<ReadXrgb8888>;
+            cornersFunc_ = GatherCorners<ReadXrgb8888>;
+            break;
+        case RGB888:
+            nearestFunc_ = GatherNearest<ReadRgb888>;
+            cornersFunc_ = GatherCorners<ReadRgb888>;
+            break;
+        default:
+            nearestFunc_ = GatherNearest<ReadRgb565>;
+            cornersFunc_ = GatherCorners<ReadRgb565>;
+            break;
+    }
+    data_ = image->data;
+    width_ = image->header.width;
+    height_ = image->header.height;
+    return true;
+}
+
+template <class Format>
+void SpanImageRgba::GatherNearest(const SpanImageRgba& image, const int32_t* xs, const int32_t* ys,
+                                  uint32_t* colors, uint32_t len)
+{
+    const ImageView view = {image.data_, image.width_, image.height_, image.RepeatX(), image.RepeatY()};
+    for (uint32_t i = 0; i < len; i++) {
+        colors[i] = ReadPixel<Format>(view, xs[i] >> FillInterpolator::SUBPIXEL_SHIFT,
+                                      ys[i] >> FillInterpolator::SUBPIXEL_SHIFT);
+    }
+}
+
+template <class Format>
+void SpanImageRgba::GatherCorners(const SpanImageRgba& image, const int32_t* xs, const int32_t* ys,
+                                  SampleCorners& corners, uint32_t len)
+{
+    const ImageView view = {image.data_, image.width_, image.height_, image.RepeatX(), image.RepeatY()};
+    const int32_t rowBytes = view.width * Format::BYTES;
+    for (uint32_t i = 0; i < len; i++) {
+        // The pixel centers are half a pixel from the pixel edges the coordinates are relative to
+        int32_t x = xs[i] - HALF_SUBPIXEL;
+        int32_t y = ys[i] - HALF_SUBPIXEL;
+        int32_t left = x >> FillInterpolator::SUBPIXEL_SHIFT;
+        int32_t top = y >> FillInterpolator::SUBPIXEL_SHIFT;
+        corners.weightX[i] = static_cast<uint8_t>((x & SUBPIXEL_MASK) >> WEIGHT_DOWNSHIFT);
+        corners.weightY[i] = static_cast<uint8_t>((y & SUBPIXEL_MASK) >> WEIGHT_DOWNSHIFT);
+        if (left >= 0 && top >= 0 && left < view.width - 1 && top < view.height - 1) {
+            const uint8_t* pixel = view.data + top * rowBytes + left * Format::BYTES;
+            corners.topLeft[i] = Format::Read(pixel);
+            corners.topRight[i] = Format::Read(pixel + Format::BYTES);
+            corners.bottomLeft[i] = Format::Read(pixel + rowBytes);
+            corners.bottomRight[i] = Format::Read(pixel + rowBytes + Format::BYTES);
+        } else {
+            corners.topLeft[i] = ReadPixel<Format>(view, left, top);
+            corners.topRight[i] = ReadPixel<Format>(view, left + 1, top);
+            corners.bottomLeft[i] = ReadPixel<Format>(view, left, top + 1);
+            corners.bottomRight[i] = ReadPixel<Format>(view, left + 1, top + 1);
+        }
+    }
+}
+
+void SpanImageRgba::Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+{
+    if (data_ == nullptr) {
+        if (memset_s(span, len * sizeof(Rgba8T), 0, len * sizeof(Rgba8T)) != EOK) {
+            GRAPHIC_LOGE("SpanImageRgba::Generate memset_s failed\n");
+        }
+        return;
+    }
+    int32_t xs[SAMPLE_BATCH];
+    int32_t ys[SAMPLE_BATCH];
+    SampleCorners corners;
+    // The interpolator is stepped as a local, the stores of the coordinates could alias it
+    FillInterpolator interpolator = interpolator_;
+    interpolator.Begin(x + HALF_PIXEL, y + HALF_PIXEL, len);
+    while (len > 0) {
+        uint32_t count = MATH_MIN(len, static_cast<uint32_t>(SAMPLE_BATCH));
+        for (uint32_t i = 0; i < count; i++, ++interpolator) {
+            interpolator.Coordinates(&xs[i], &ys[i]);
+        }
+        switch (filter_) {
+            case IMAGE_FILTER_NEAREST:
+                nearestFunc_(*this, xs, ys, corners.topLeft, count);
+                if (memcpy_s(span, count * sizeof(Rgba8T), corners.topLeft, count * sizeof(uint32_t)) != EOK) {
+                    GRAPHIC_LOGE("SpanImageRgba::Generate memcpy_s failed\n");
+                    return;
+                }
+                break;
+            case IMAGE_FILTER_BOX:
+                cornersFunc_(*this, xs, ys, corners, count);
+                AverageCorners(span, corners, count);
+                break;
+            default:
+                cornersFunc_(*this, xs, ys, corners, count);
+                LerpCorners(span, corners, count);
+                break;
+        }
+        span += count;
+        len -= count;
+    }
+}
+
+void SpanImageRgba::LerpCorners(Rgba8T* span, const SampleCorners& corners, uint32_t len)
+{
+    uint32_t i = 0;
+#if defined(ARM_NEON_OPT)
+    for (; i + PIXELS_PER_VECTOR <= len; i += PIXELS_PER_VECTOR) {
+        uint8x8_t top[NEON_A + 1];
+        uint8x8_t right[NEON_A + 1];
+        uint8x8_t bottom[NEON_A + 1];
+        uint8x8_t corner[NEON_A + 1];
+        // The channels only need to be stored in the order they are loaded
+        LoadBuf_ARGB8888(reinterpret_cast<uint8_t*>(const_cast<uint32_t*>(corners.topLeft + i)),
+                         top[NEON_R], top[NEON_G], top[NEON_B], top[NEON_A]);
+        LoadBuf_ARGB8888(reinterpret_cast<uint8_t*>(const_cast<uint32_t*>(corners.topRight + i)),
+                         right[NEON_R], right[NEON_G], right[NEON_B], right[NEON_A]);
+        LoadBuf_ARGB8888(reinterpret_cast<uint8_t*>(const_cast<uint32_t*>(corners.bottomLeft + i)),
+                         bottom[NEON_R], bottom[NEON_G], bottom[NEON_B], bottom[NEON_A]);
+        LoadBuf_ARGB8888(reinterpret_cast<uint8_t*>(const_cast<uint32_t*>(corners.bottomRight + i)),
+                         corner[NEON_R], corner[NEON_G], corner[NEON_B], corner[NEON_A]);
+        uint8x8_t weightX = vld1_u8(corners.weightX + i);
+        uint8x8_t weightY = vld1_u8(corners.weightY + i);
+        uint8x8_t inverseX = vsub_u8(vdup_n_u8(WEIGHT_SCALE), weightX);
+        uint8x8_t inverseY = vsub_u8(vdup_n_u8(WEIGHT_SCALE), weightY);
+        for (uint32_t channel = 0; channel <= NEON_A; channel++) {
+            uint8x8_t upper = NeonLerpWeight(top[channel], right[channel], weightX, inverseX);
+            uint8x8_t lower = NeonLerpWeight(bottom[channel], corner[channel], weightX, inverseX);
+            top[channel] = NeonLerpWeight(upper, lower, weightY, inverseY);
+        }
+        StoreBuf_ARGB8888(reinterpret_cast<uint8_t*>(span + i), top[NEON_R], top[NEON_G], top[NEON_B],
+                          top[NEON_A]);
+    }
+#elif defined(X86_SSE2_OPT)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + PIXELS_PER_VECTOR <= len; i += PIXELS_PER_VECTOR) {
+        __m128i weightX[SSE2_WEIGHTS];
+        __m128i weightY[SSE2_WEIGHTS];
+        Sse2SpreadWeights(corners.weightX + i, weightX);
+        Sse2SpreadWeights(corners.weightY + i, weightY);
+        __m128i result[2]; // 2: 4 pixels each
+        for (uint32_t half = 0; half < 2; half++) { // 2: 4 pixels each
+            uint32_t index = i + half * SSE2_COLORS;
+            __m128i topLeft = _mm_loadu_si128(reinterpret_cast<const __m128i*>(corners.topLeft + index));
+            __m128i topRight = _mm_loadu_si128(reinterpret_cast<const __m128i*>(corners.topRight + index));
+            __m128i bottomLeft = _mm_loadu_si128(reinterpret_cast<const __m128i*>(corners.bottomLeft + index));
+            __m128i bottomRight = _mm_loadu_si128(reinterpret_cast<const __m128i*>(corners.bottomRight + index));
+            const __m128i* spreadX = weightX + half * 2; // 2: spread weights per 4 pixels
+            const __m128i* spreadY = weightY + half * 2; // 2: spread weights per 4 pixels
+            __m128i upper = Sse2LerpWeight(_mm_unpacklo_epi8(topLeft, zero), _mm_unpacklo_epi8(topRight, zero),
+                                           spreadX[0]);
+            __m128i lower = Sse2LerpWeight(_mm_unpacklo_epi8(bottomLeft, zero),
+                                           _mm_unpacklo_epi8(bottomRight, zero), spreadX[0]);
+            __m128i low = Sse2LerpWeight(upper, lower, spreadY[0]);
+            upper = Sse2LerpWeight(_mm_unpackhi_epi8(topLeft, zero), _mm_unpackhi_epi8(topRight, zero), spreadX[1]);
+            lower = Sse2LerpWeight(_mm_unpackhi_epi8(bottomLeft, zero), _mm_unpackhi_epi8(bottomRight, zero),
+                                   spreadX[1]);
+            result[half] = _mm_packus_epi16(low, Sse2LerpWeight(upper, lower, spreadY[1]));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(span + i), result[0]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(span + i + SSE2_COLORS), result[1]);
+    }
+#endif
+    for (; i < len; i++) {
+        uint32_t weightX = corners.weightX[i];
+        uint32_t weightY = corners.weightY[i];
+        uint8_t channels[CHANNELS];
+        for (uint32_t channel = 0; channel < CHANNELS; channel++) {
+            uint32_t shift = channel * CHANNEL_BITS;
+            uint32_t upper = LerpWeight((corners.topLeft[i] >> shift) & BYTE_MASK,
+                                        (corners.topRight[i] >> shift) & BYTE_MASK, weightX);
+            uint32_t lower = LerpWeight((corners.bottomLeft[i] >> shift) & BYTE_MASK,
+                                        (corners.bottomRight[i] >> shift) & BYTE_MASK, weightX);
+            channels[channel] = LerpWeight(upper, lower, weightY);
+        }
+        span[i].red = channels[0];
+        span[i].green = channels[1];
+        span[i].blue = channels[2]; // 2: blue
+        span[i].alpha = channels[3]; // 3: alpha
+    }
+}
+
+void SpanImageRgba::AverageCorners(Rgba8T* span, const SampleCorners& corners, uint32_t len)
+{
+    uint32_t i = 0;
+#if defined(ARM_NEON_OPT)
+    for (; i + PIXELS_PER_VECTOR <= len; i += PIXELS_PER_VECTOR) {
+        uint8x8_t top[NEON_A + 1];
+        uint8x8_t right[NEON_A + 1];
+        uint8x8_t bottom[NEON_A + 1];
+        uint8x8_t corner[NEON_A + 1];
+        LoadBuf_ARGB8888(reinterpret_cast<uint8_t*>(const_cast<uint32_t*>(corners.topLeft + i)),
+                         top[NEON_R], top[NEON_G], top[NEON_B], top[NEON_A]);
+        LoadBuf_ARGB8888(reinterpret_cast<uint8_t*>(const_cast<uint32_t*>(corners.topRight + i)),
+                         right[NEON_R], right[NEON_G], right[NEON_B], right[NEON_A]);
+        LoadBuf_ARGB8888(reinterpret_cast<uint8_t*>(const_cast<uint32_t*>(corners.bottomLeft + i)),
+                         bottom[NEON_R], bottom[NEON_G], bottom[NEON_B], bottom[NEON_A]);
+        LoadBuf_ARGB8888(reinterpret_cast<uint8_t*>(const_cast<uint32_t*>(corners.bottomRight + i)),
+                         corner[NEON_R], corner[NEON_G], corner[NEON_B], corner[NEON_A]);
+        for (uint32_t channel = 0; channel <= NEON_A; channel++) {
+            top[channel] = NeonAverage(top[channel], right[channel], bottom[channel], corner[channel]);
+        }
+        StoreBuf_ARGB8888(reinterpret_cast<uint8_t*>(span + i), top[NEON_R], top[NEON_G], top[NEON_B],
+                          top[NEON_A]);
+    }
+#elif defined(X86_SSE2_OPT)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + SSE2_COLORS <= len; i += SSE2_COLORS) {
+        __m128i topLeft = _mm_loadu_si128(reinterpret_cast<const __m128i*>(corners.topLeft + i));
+        __m128i topRight = _mm_loadu_si128(reinterpret_cast<const __m128i*>(corners.topRight + i));
+        __m128i bottomLeft = _mm_loadu_si128(reinterpret_cast<const __m128i*>(corners.bottomLeft + i));
+        __m128i bottomRight = _mm_loadu_si128(reinterpret_cast<const __m128i*>(corners.bottomRight + i));
+        __m128i low = Sse2Average(_mm_unpacklo_epi8(topLeft, zero), _mm_unpacklo_epi8(topRight, zero),
+                                  _mm_unpacklo_epi8(bottomLeft, zero), _mm_unpacklo_epi8(bottomRight, zero));
+        __m128i high = Sse2Average(_mm_unpackhi_epi8(topLeft, zero), _mm_unpackhi_epi8(topRight, zero),
+                                   _mm_unpackhi_epi8(bottomLeft, zero), _mm_unpackhi_epi8(bottomRight, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(span + i), _mm_packus_epi16(low, high));
+    }
+#endif
+    for (; i < len; i++) {
+        uint8_t channels[CHANNELS];
+        for (uint32_t channel = 0; channel < CHANNELS; channel++) {
+            uint32_t shift = channel * CHANNEL_BITS;
+            uint32_t sum = ((corners.topLeft[i] >> shift) & BYTE_MASK) + ((corners.topRight[i] >> shift) & BYTE_MASK) +
+                           ((corners.bottomLeft[i] >> shift) & BYTE_MASK) +
+                           ((corners.bottomRight[i] >> shift) & BYTE_MASK);
+            channels[channel] = static_cast<uint8_t>((sum + AVERAGE_ROUND) >> AVERAGE_SHIFT);
+        }
+        span[i].red = channels[0];
+        span[i].green = channels[1];
+        span[i].blue = channels[2]; // 2: blue
+        span[i].alpha = channels[3]; // 3: alpha
+    }
+}
+} // namespace OHOS
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/spancolorfill/fill_pattern_rgba.h"
+#if defined(ARM_NEON_OPT)
+#include "graphic_neon_utils.h"
+#elif defined(X86_SSE2_OPT)
+#include <emmintrin.h>
+#endif
+
+namespace OHOS {
+#if defined(GRAPHIC_ENABLE_PATTERN_FILL_FLAG) && GRAPHIC_ENABLE_PATTERN_FILL_FLAG
+namespace {
+#if defined(ARM_NEON_OPT) || defined(X86_SSE2_OPT)
+constexpr uint32_t COLORS_PER_VECTOR = 8;
+#endif
+#if defined(X86_SSE2_OPT)
+constexpr int32_t ALPHA_GREEN_MASK = static_cast<int32_t>(0xFF00FF00);
+constexpr int32_t RED_BLUE_MASK = 0x00FF00FF;
+/* 0xB1: swap the two 16 bit halves of every 32 bit color. */
+constexpr int32_t SWAP_HALVES = 0xB1;
+
+/* The red and blue bytes of 4 colors are swapped, green and alpha stay. */
+inline __m128i SwapRedBlue(__m128i colors)
+{
+    __m128i redBlue = _mm_and_si128(colors, _mm_set1_epi32(RED_BLUE_MASK));
+    redBlue = _mm_shufflehi_epi16(_mm_shufflelo_epi16(redBlue, SWAP_HALVES), SWAP_HALVES);
+    return _mm_or_si128(_mm_and_si128(colors, _mm_set1_epi32(ALPHA_GREEN_MASK)), redBlue);
+}
+#endif
+} // namespace
+
+void CopyPatternRun(Rgba8T* span, const Color32* colors, uint32_t len)
+{
+    uint32_t i = 0;
+#if defined(ARM_NEON_OPT)
+    for (; i + COLORS_PER_VECTOR <= len; i += COLORS_PER_VECTOR) {
+        uint8x8_t r;
+        uint8x8_t g;
+        uint8x8_t b;
+        uint8x8_t a;
+        LoadBuf_ARGB8888(reinterpret_cast<uint8_t*>(const_cast<Color32*>(colors + i)), r, g, b, a);
+        // Rgba8T is stored in the order of ABGR8888, which is ARGB8888 with red and blue exchanged
+        StoreBuf_ARGB8888(reinterpret_cast<uint8_t*>(span + i), b, g, r, a);
+    }
+#elif defined(X86_SSE2_OPT)
+    for (; i + COLORS_PER_VECTOR <= len; i += COLORS_PER_VECTOR) {
+        const __m128i* source = reinterpret_cast<const __m128i*>(colors + i);
+        __m128i* target = reinterpret_cast<__m128i*>(span + i);
+        __m128i first = _mm_loadu_si128(source);
+        __m128i second = _mm_loadu_si128(source + 1);
+        _mm_storeu_si128(target, SwapRedBlue(first));
+        _mm_storeu_si128(target + 1, SwapRedBlue(second));
+    }
+#endif
+    for (; i < len; i++) {
+        span[i].red = colors[i].red;
+        span[i].green = colors[i].green;
+        span[i].blue = colors[i].blue;
+        span[i].alpha = colors[i].alpha;
+    }
+}
+
+void FillPatternNoColor(Rgba8T* span, uint32_t len)
+{
+    for (; len; --len, span++) {
+        span->red = 0;
+        span->green = 0;
+        span->blue = 0;
+        span->alpha = MAX_COLOR_NUM;
+    }
+}
+#endif
+} // namespace OHOS
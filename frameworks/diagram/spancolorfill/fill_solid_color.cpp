@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/spancolorfill/fill_solid_color.h"
+#include "gfx_utils/graphic_log.h"
+#include "securec.h"
+#include <cstring>
+#if defined(ARM_NEON_OPT)
+#include "graphic_neon_utils.h"
+#elif defined(X86_SSE2_OPT)
+#include <emmintrin.h>
+#endif
+
+namespace OHOS {
+namespace {
+constexpr uint32_t ARGB8888_BYTES = 4;
+constexpr uint32_t RGB888_BYTES = 3;
+constexpr uint32_t RGB565_BYTES = 2;
+constexpr uint32_t RGB565_RED_SHIFT = 11;
+constexpr uint32_t RGB565_GREEN_SHIFT = 5;
+constexpr uint32_t RGB565_RED_BITS = 3;
+constexpr uint32_t RGB565_GREEN_BITS = 2;
+constexpr uint32_t RGB565_BLUE_BITS = 3;
+constexpr uint32_t RGB565_GREEN_MASK = 0x3F;
+constexpr uint32_t RGB565_BLUE_MASK = 0x1F;
+#ifdef X86_SSE2_OPT
+constexpr uint32_t SSE2_STEP_4 = 4;
+constexpr uint32_t SSE2_STEP_8 = 8;
+constexpr uint32_t COVER_ROUND = 128;
+constexpr uint32_t COVER_SHIFT = 8;
+constexpr uint32_t FULL_COVERS = 0xFFFFFFFF;
+#endif
+
+inline uint16_t PackRgb565(uint8_t red, uint8_t green, uint8_t blue)
+{
+    return static_cast<uint16_t>(((red >> RGB565_RED_BITS) << RGB565_RED_SHIFT) |
+                                 ((green >> RGB565_GREEN_BITS) << RGB565_GREEN_SHIFT) | (blue >> RGB565_BLUE_BITS));
+}
+
+#if defined(ARM_NEON_OPT)
+/* Lerp of Rgba8T in 16 bits, (v + (v >> 8)) >> 8 with v = p * (255 - a) + q * a + 128. */
+inline uint8x8_t NeonLerpCover(uint8x8_t p, uint8x8_t q, uint8x8_t alpha)
+{
+    uint16x8_t value = vmlal_u8(vmlal_u8(vdupq_n_u16(BASEMSB), p, vmvn_u8(alpha)), q, alpha);
+    return vshrn_n_u16(vaddq_u16(value, vshrq_n_u16(value, NEON_STEP_8)), NEON_STEP_8);
+}
+
+/* Prelerp of Rgba8T, the byte sum may wrap but the result is at most 255. */
+inline uint8x8_t NeonPrelerpCover(uint8x8_t p, uint8x8_t alpha)
+{
+    return vsub_u8(vadd_u8(p, alpha), Multipling(p, alpha));
+}
+#elif defined(X86_SSE2_OPT)
+/* Multiply of Rgba8T on 16 bit lanes. */
+inline __m128i Sse2MultiplyCover(__m128i a, __m128i b)
+{
+    __m128i value = _mm_add_epi16(_mm_mullo_epi16(a, b), _mm_set1_epi16(COVER_ROUND));
+    return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, COVER_SHIFT)), COVER_SHIFT);
+}
+
+/* Lerp of Rgba8T on 16 bit lanes, v = p * (255 - a) + q * a + 128 fits in 16 bits. */
+inline __m128i Sse2LerpCover(__m128i p, __m128i q, __m128i alpha)
+{
+    __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(MAX_COLOR_NUM), alpha);
+    __m128i value = _mm_add_epi16(_mm_mullo_epi16(p, inverse), _mm_mullo_epi16(q, alpha));
+    value = _mm_add_epi16(value, _mm_set1_epi16(COVER_ROUND));
+    return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, COVER_SHIFT)), COVER_SHIFT);
+}
+
+/* 2 pixels of ARGB8888 on 16 bit lanes, the alpha lanes are Prelerp and the color lanes Lerp. */
+inline __m128i Sse2BlendArgb(__m128i dst, __m128i src, __m128i alpha, __m128i alphaLanes)
+{
+    __m128i color = Sse2LerpCover(dst, src, alpha);
+    __m128i prelerp = _mm_sub_epi16(_mm_add_epi16(dst, alpha), Sse2MultiplyCover(dst, alpha));
+    return _mm_or_si128(_mm_and_si128(alphaLanes, prelerp), _mm_andnot_si128(alphaLanes, color));
+}
+#endif
+} // namespace
+
+FillSolidColor::FillSolidColor()
+    : data_(nullptr), width_(0), height_(0), stride_(0), pixelBytes_(0),
+      blendFunc_(nullptr), fillFunc_(nullptr), color_(0, 0, 0, 0)
+{
+}
+
+bool FillSolidColor::IsSupported(ColorMode mode)
+{
+    return mode == ARGB8888 || mode == XRGB8888 || mode == RGB888 || mode == RGB565;
+}
+
+bool FillSolidColor::Attach(const BufferInfo& dst)
+{
+    data_ = nullptr;
+    blendFunc_ = nullptr;
+    fillFunc_ = nullptr;
+    if (dst.virAddr == nullptr || !IsSupported(dst.mode)) {
+        GRAPHIC_LOGE("FillSolidColor::Attach the buffer is not supported\n");
+        return false;
+    }
+    switch (dst.mode) {
+        case ARGB8888:
+        case XRGB8888:
+            pixelBytes_ = ARGB8888_BYTES;
+            blendFunc_ = BlendArgb8888;
+            fillFunc_ = FillArgb8888;
+            break;
+        case RGB888:
+            pixelBytes_ = RGB888_BYTES;
+            blendFunc_ = BlendRgb888;
+            fillFunc_ = FillRgb888;
+            break;
+        default:
+            pixelBytes_ = RGB565_BYTES;
+            blendFunc_ = BlendRgb565;
+            fillFunc_ = FillRgb565;
+            break;
+    }
+    data_ = static_cast<uint8_t*>(dst.virAddr);
+    width_ = dst.width;
+    height_ = dst.height;
+    stride_ = dst.stride;
+    return true;
+}
+
+/**
+ * @brief Clips the span to the buffer, skip is the number of pixels cut off at the left.
+ * @return the first pixel of the clipped span, or nullptr if nothing is left.
+ * @since 1.0
+ * @version 1.0
+ */
+uint8_t* FillSolidColor::ClipSpan(int32_t& x, int32_t y, uint32_t& len, uint32_t& skip) const
+{
+    if (data_ == nullptr || y < 0 || y >= height_) {
+        return nullptr;
+    }
+    int64_t end = MATH_MIN(static_cast<int64_t>(x) + len, static_cast<int64_t>(width_));
+    int32_t x1 = MATH_MAX(x, 0);
+    if (x1 >= end) {
+        return nullptr;
+    }
+    skip = static_cast<uint32_t>(x1 - x);
+    len = static_cast<uint32_t>(end - x1);
+    x = x1;
+    return data_ + static_cast<uint32_t>(y) * stride_ + static_cast<uint32_t>(x1) * pixelBytes_;
+}
+
+void FillSolidColor::BlendHline(int32_t x, int32_t y, uint32_t len, uint8_t cover)
+{
+    uint32_t skip = 0;
+    uint8_t* dst = ClipSpan(x, y, len, skip);
+    if (dst == nullptr || cover == 0 || color_.alpha == 0) {
+        return;
+    }
+    if (cover == MAX_COLOR_NUM && color_.alpha == MAX_COLOR_NUM) {
+        fillFunc_(dst, color_, len);
+        return;
+    }
+    uint8_t covers[COVER_CHUNK];
+    if (memset_s(covers, sizeof(covers), cover, sizeof(covers)) != EOK) {
+        GRAPHIC_LOGE("FillSolidColor::BlendHline memset_s failed\n");
+        return;
+    }
+    while (len > 0) {
+        uint32_t chunk = MATH_MIN(len, static_cast<uint32_t>(COVER_CHUNK));
+        blendFunc_(dst, color_, covers, chunk);
+        dst += chunk * pixelBytes_;
+        len -= chunk;
+    }
+}
+
+void FillSolidColor::BlendSolidHspan(int32_t x, int32_t y, uint32_t len, const uint8_t* covers)
+{
+    uint32_t skip = 0;
+    uint8_t* dst = ClipSpan(x, y, len, skip);
+    if (dst == nullptr || color_.alpha == 0) {
+        return;
+    }
+    blendFunc_(dst, color_, covers + skip, len);
+}
+
+void FillSolidColor::FillArgb8888(uint8_t* dst, const Rgba8T& color, uint32_t len)
+{
+    uint32_t pixel = 0;
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(&pixel);
+    bytes[0] = color.blue;
+    bytes[1] = color.green;
+    bytes[2] = color.red;   // 2: red byte
+    bytes[3] = color.alpha; // 3: alpha byte
+    // dst may be unaligned, the pixel is stored through memcpy, which compiles to one store
+    for (uint32_t i = 0; i < len; i++, dst += ARGB8888_BYTES) {
+        std::memcpy(dst, &pixel, sizeof(pixel));
+    }
+}
+
+void FillSolidColor::FillRgb888(uint8_t* dst, const Rgba8T& color, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++, dst += RGB888_BYTES) {
+        dst[0] = color.blue;
+        dst[1] = color.green;
+        dst[2] = color.red; // 2: red byte
+    }
+}
+
+void FillSolidColor::FillRgb565(uint8_t* dst, const Rgba8T& color, uint32_t len)
+{
+    uint16_t pixel = PackRgb565(color.red, color.green, color.blue);
+    for (uint32_t i = 0; i < len; i++, dst += RGB565_BYTES) {
+        std::memcpy(dst, &pixel, sizeof(pixel));
+    }
+}
+
+/**
+ * @brief The pixels are B, G, R, A bytes. SSE2 blends 4 pixels per iteration, the cover of each
+ * pixel is repeated on its 4 lanes, NEON blends 8 pixels on planes of the channels.
+ * @since 1.0
+ * @version 1.0
+ */
+void FillSolidColor::BlendArgb8888(uint8_t* dst, const Rgba8T& color, const uint8_t* covers, uint32_t len)
+{
+    uint32_t i = 0;
+#if defined(ARM_NEON_OPT)
+    const uint8x8_t srcRed = vdup_n_u8(color.red);
+    const uint8x8_t srcGreen = vdup_n_u8(color.green);
+    const uint8x8_t srcBlue = vdup_n_u8(color.blue);
+    const uint8x8_t srcAlpha = vdup_n_u8(color.alpha);
+    for (; i + NEON_STEP_8 <= len; i += NEON_STEP_8) {
+        uint8_t* buf = dst + i * ARGB8888_BYTES;
+        uint8x8_t alpha = Multipling(srcAlpha, vld1_u8(covers + i));
+        uint8x8_t r;
+        uint8x8_t g;
+        uint8x8_t b;
+        uint8x8_t a;
+        LoadBuf_ARGB8888(buf, r, g, b, a);
+        r = NeonLerpCover(r, srcRed, alpha);
+        g = NeonLerpCover(g, srcGreen, alpha);
+        b = NeonLerpCover(b, srcBlue, alpha);
+        a = NeonPrelerpCover(a, alpha);
+        StoreBuf_ARGB8888(buf, r, g, b, a);
+    }
+#elif defined(X86_SSE2_OPT)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i srcAlpha = _mm_set1_epi16(color.alpha);
+    // 2: two pixels per 8 lanes, the alpha lanes are not read
+    const __m128i src = _mm_setr_epi16(color.blue, color.green, color.red, 0, color.blue, color.green, color.red, 0);
+    const __m128i alphaLanes = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+    const __m128i opaque = _mm_set1_epi32(static_cast<int32_t>(
+        (static_cast<uint32_t>(color.alpha) << 24) | (static_cast<uint32_t>(color.red) << 16) | // 24, 16: bytes
+        (static_cast<uint32_t>(color.green) << 8) | color.blue));                              // 8: green byte
+    for (; i + SSE2_STEP_4 <= len; i += SSE2_STEP_4) {
+        __m128i* buf = reinterpret_cast<__m128i*>(dst + i * ARGB8888_BYTES);
+        const uint8_t* cover4 = covers + i;
+        // 8, 16, 24: the covers of the 4 pixels, read as one word
+        uint32_t fourCovers = cover4[0] | (static_cast<uint32_t>(cover4[1]) << 8) |
+                              (static_cast<uint32_t>(cover4[2]) << 16) | (static_cast<uint32_t>(cover4[3]) << 24);
+        if (fourCovers == FULL_COVERS && color.alpha == MAX_COLOR_NUM) {
+            _mm_storeu_si128(buf, opaque);
+            continue;
+        }
+        __m128i cover = _mm_cvtsi32_si128(static_cast<int32_t>(fourCovers));
+        cover = _mm_unpacklo_epi8(cover, cover);
+        cover = _mm_unpacklo_epi16(cover, cover);
+        __m128i alphaLow = Sse2MultiplyCover(srcAlpha, _mm_unpacklo_epi8(cover, zero));
+        __m128i alphaHigh = Sse2MultiplyCover(srcAlpha, _mm_unpackhi_epi8(cover, zero));
+        __m128i pixels = _mm_loadu_si128(buf);
+        __m128i low = Sse2BlendArgb(_mm_unpacklo_epi8(pixels, zero), src, alphaLow, alphaLanes);
+        __m128i high = Sse2BlendArgb(_mm_unpackhi_epi8(pixels, zero), src, alphaHigh, alphaLanes);
+        _mm_storeu_si128(buf, _mm_packus_epi16(low, high));
+    }
+#endif
+    for (; i < len; i++) {
+        uint8_t alpha = Rgba8T::Multiply(color.alpha, covers[i]);
+        uint8_t* pixel = dst + i * ARGB8888_BYTES;
+        pixel[0] = Rgba8T::Lerp(pixel[0], color.blue, alpha);
+        pixel[1] = Rgba8T::Lerp(pixel[1], color.green, alpha);
+        pixel[2] = Rgba8T::Lerp(pixel[2], color.red, alpha); // 2: red byte
+        pixel[3] = Rgba8T::Prelerp(pixel[3], alpha, alpha);  // 3: alpha byte
+    }
+}
+
+/**
+ * @brief The pixels are B, G, R bytes, NEON blends 8 pixels on planes of the channels, SSE2 has
+ * no deinterleaving load of 3 bytes and blends them one by one.
+ * @since 1.0
+ * @version 1.0
+ */
+void FillSolidColor::BlendRgb888(uint8_t* dst, const Rgba8T& color, const uint8_t* covers, uint32_t len)
+{
+    uint32_t i = 0;
+#if defined(ARM_NEON_OPT)
+    const uint8x8_t srcRed = vdup_n_u8(color.red);
+    const uint8x8_t srcGreen = vdup_n_u8(color.green);
+    const uint8x8_t srcBlue = vdup_n_u8(color.blue);
+    const uint8x8_t srcAlpha = vdup_n_u8(color.alpha);
+    for (; i + NEON_STEP_8 <= len; i += NEON_STEP_8) {
+        uint8_t* buf = dst + i * RGB888_BYTES;
+        uint8x8_t alpha = Multipling(srcAlpha, vld1_u8(covers + i));
+        uint8x8_t r;
+        uint8x8_t g;
+        uint8x8_t b;
+        uint8x8_t a = alpha;
+        LoadBuf_RGB888(buf, r, g, b, a);
+        r = NeonLerpCover(r, srcRed, alpha);
+        g = NeonLerpCover(g, srcGreen, alpha);
+        b = NeonLerpCover(b, srcBlue, alpha);
+        StoreBuf_RGB888(buf, r, g, b, a);
+    }
+#endif
+    for (; i < len; i++) {
+        uint8_t alpha = Rgba8T::Multiply(color.alpha, covers[i]);
+        uint8_t* pixel = dst + i * RGB888_BYTES;
+        pixel[0] = Rgba8T::Lerp(pixel[0], color.blue, alpha);
+        pixel[1] = Rgba8T::Lerp(pixel[1], color.green, alpha);
+        pixel[2] = Rgba8T::Lerp(pixel[2], color.red, alpha); // 2: red byte
+    }
+}
+
+/**
+ * @brief The channels are widened to 8 bits as the blenders do (red << 3, green << 2, blue << 3),
+ * blended and narrowed again. Both NEON and SSE2 blend 8 pixels on planes of the channels.
+ * @since 1.0
+ * @version 1.0
+ */
+void FillSolidColor::BlendRgb565(uint8_t* dst, const Rgba8T& color, const uint8_t* covers, uint32_t len)
+{
+    uint32_t i = 0;
+#if defined(ARM_NEON_OPT)
+    const uint8x8_t srcRed = vdup_n_u8(color.red);
+    const uint8x8_t srcGreen = vdup_n_u8(color.green);
+    const uint8x8_t srcBlue = vdup_n_u8(color.blue);
+    const uint8x8_t srcAlpha = vdup_n_u8(color.alpha);
+    for (; i + NEON_STEP_8 <= len; i += NEON_STEP_8) {
+        uint8_t* buf = dst + i * RGB565_BYTES;
+        uint8x8_t alpha = Multipling(srcAlpha, vld1_u8(covers + i));
+        uint8x8_t r;
+        uint8x8_t g;
+        uint8x8_t b;
+        uint8x8_t a = alpha;
+        LoadBuf_RGB565(buf, r, g, b, a);
+        r = NeonLerpCover(r, srcRed, alpha);
+        g = NeonLerpCover(g, srcGreen, alpha);
+        b = NeonLerpCover(b, srcBlue, alpha);
+        StoreBuf_RGB565(buf, r, g, b, a);
+    }
+#elif defined(X86_SSE2_OPT)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i srcAlpha = _mm_set1_epi16(color.alpha);
+    const __m128i srcRed = _mm_set1_epi16(color.red);
+    const __m128i srcGreen = _mm_set1_epi16(color.green);
+    const __m128i srcBlue = _mm_set1_epi16(color.blue);
+    const __m128i greenMask = _mm_set1_epi16(RGB565_GREEN_MASK);
+    const __m128i blueMask = _mm_set1_epi16(RGB565_BLUE_MASK);
+    for (; i + SSE2_STEP_8 <= len; i += SSE2_STEP_8) {
+        __m128i* buf = reinterpret_cast<__m128i*>(dst + i * RGB565_BYTES);
+        __m128i cover = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(covers + i)), zero);
+        __m128i alpha = Sse2MultiplyCover(srcAlpha, cover);
+        __m128i pixels = _mm_loadu_si128(buf);
+        __m128i r = _mm_slli_epi16(_mm_srli_epi16(pixels, RGB565_RED_SHIFT), RGB565_RED_BITS);
+        __m128i g = _mm_slli_epi16(_mm_and_si128(_mm_srli_epi16(pixels, RGB565_GREEN_SHIFT), greenMask),
+                                   RGB565_GREEN_BITS);
+        __m128i b = _mm_slli_epi16(_mm_and_si128(pixels, blueMask), RGB565_BLUE_BITS);
+        r = _mm_srli_epi16(Sse2LerpCover(r, srcRed, alpha), RGB565_RED_BITS);
+        g = _mm_srli_epi16(Sse2LerpCover(g, srcGreen, alpha), RGB565_GREEN_BITS);
+        b = _mm_srli_epi16(Sse2LerpCover(b, srcBlue, alpha), RGB565_BLUE_BITS);
+        pixels = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, RGB565_RED_SHIFT), _mm_slli_epi16(g, RGB565_GREEN_SHIFT)),
+                              b);
+        _mm_storeu_si128(buf, pixels);
+    }
+#endif
+    for (; i < len; i++) {
+        uint8_t alpha = Rgba8T::Multiply(color.alpha, covers[i]);
+        uint8_t* pixel = dst + i * RGB565_BYTES;
+        uint32_t value = pixel[0] | (static_cast<uint32_t>(pixel[1]) << 8); // 8: the high byte
+        uint8_t red = static_cast<uint8_t>((value >> RGB565_RED_SHIFT) << RGB565_RED_BITS);
+        uint8_t green = static_cast<uint8_t>(((value >> RGB565_GREEN_SHIFT) & RGB565_GREEN_MASK) << RGB565_GREEN_BITS);
+        uint8_t blue = static_cast<uint8_t>((value & RGB565_BLUE_MASK) << RGB565_BLUE_BITS);
+        red = Rgba8T::Lerp(red, color.red, alpha);
+        green = Rgba8T::Lerp(green, color.green, alpha);
+        blue = Rgba8T::Lerp(blue, color.blue, alpha);
+        value = PackRgb565(red, green, blue);
+        pixel[0] = static_cast<uint8_t>(value);
+        pixel[1] = static_cast<uint8_t>(value >> 8); // 8: the high byte
+    }
+}
+} // namespace OHOS
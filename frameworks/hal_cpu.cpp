@@ -16,7 +16,7 @@
 #include "hal_cpu.h"
 #ifdef _WIN32
 #include <windows.h>
-#elif defined __LINUX__
+#elif defined __LINUX__ || defined __linux__
 #include <unistd.h>
 #endif
 
@@ -36,7 +36,7 @@ uint32_t HalGetCpuCoreNum()
     SYSTEM_INFO sysInfo;
     GetSystemInfo(&sysInfo);
     cpuCoreNum = sysInfo.dwNumberOfProcessors;
-#elif defined __LINUX__
+#elif defined __LINUX__ || defined __linux__
     cpuCoreNum = sysconf(_SC_NPROCESSORS_ONLN);
 #elif ((defined (HAL_CPU_NUM)) && (HAL_CPU_NUM < 8))
     cpuCoreNum = HAL_CPU_NUM;
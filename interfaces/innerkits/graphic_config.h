@@ -310,6 +310,33 @@ namespace OHOS {
 #define ARM_NEON_OPT
 #endif
 
+/**
+ * @brief x86 SSE2 ability, which is enabled by default. Used by the simulator builds.
+ */
+#ifndef ENABLE_X86_SSE2
+#define ENABLE_X86_SSE2                   1
+#endif
+
+/**
+ * @brief Actually use x86 SSE2 optimization.
+ *        __SSE2__ is set by the compiler for x86-64 and according to the compilation option -msse2
+ */
+#if defined(__SSE2__) && !defined(ARM_NEON_OPT) && ENABLE_X86_SSE2 == 1
+#define X86_SSE2_OPT
+#endif
+
+/**
+ * @brief Integer evaluation of radial gradients, which is enabled by default on ARM targets without an FPU.
+ *        __ARM_FP is set by the compiler when the target has floating point hardware
+ */
+#ifndef ENABLE_GRADIENT_FIXED_POINT
+#if defined(__arm__) && !defined(__ARM_FP)
+#define ENABLE_GRADIENT_FIXED_POINT       1
+#else
+#define ENABLE_GRADIENT_FIXED_POINT       0
+#endif
+#endif
+
 /**
  * @brief Graphics bottom-layer RGBA, which is enabled by default.
  */
@@ -365,6 +392,14 @@ namespace OHOS {
 #ifndef ENABLE_DEBUG_PERFORMANCE_TRACE
 #define ENABLE_DEBUG_PERFORMANCE_TRACE    0
 #endif
+/**
+ * @brief 8-byte rasterizer cells sorted by value, which is disabled by default.
+ * After it is enabled, the cell memory of vector drawing is halved, the coordinates of the
+ * outline must fit in 16 bits (see CellPackedAntiAlias).
+ */
+#ifndef ENABLE_PACKED_RASTERIZER_CELLS
+#define ENABLE_PACKED_RASTERIZER_CELLS    0
+#endif
 /**
  * @brief Function for receiving input events in screen-off mode, which is disabled by default.
  */
@@ -67,6 +67,17 @@ enum PatternRepeatMode {
     NO_REPEAT,
 };
 
+/**
+ * pad The colors of the ends continue beyond the gradient
+ * repeat The gradient starts again after its end
+ * reflect The gradient goes back and forth between its ends
+ */
+enum GradientSpreadMode {
+    GRADIENT_SPREAD_PAD,
+    GRADIENT_SPREAD_REPEAT,
+    GRADIENT_SPREAD_REFLECT
+};
+
 /**
  * @brief Sub - pixel offset and mask flag
  * @since 1.0
@@ -21,115 +21,68 @@
 #include "securec.h"
 
 namespace OHOS {
+/**
+ * @class Filterblur
+ * @brief Box blur of images of 4 byte pixels in place. The blur slides a window down the image,
+ * the sums of its columns are updated with the row entering and the row leaving the window, and
+ * each row is blurred by sliding along the column sums. Only the rows the window has left are
+ * kept, in a ring of radius + 1 rows, so that the result equals the mean of the box of every
+ * pixel without an integral image of the whole image.
+ * @since 1.0
+ * @version 1.0
+ */
 class Filterblur {
 #if defined(GRAPHIC_ENABLE_BLUR_EFFECT_FLAG) && GRAPHIC_ENABLE_BLUR_EFFECT_FLAG
 
 public:
-    Filterblur()
-    {
-        integral_ = nullptr;
-        imageWidth_ = 0;
-        imageHeight_ = 0;
-    }
-    ~Filterblur()
+    Filterblur() : ring_(nullptr), sums_(nullptr), ringSize_(0), sumsSize_(0) {}
+
+    /* The buffers are scratch memory, a copy allocates its own. */
+    Filterblur(const Filterblur&) : ring_(nullptr), sums_(nullptr), ringSize_(0), sumsSize_(0) {}
+
+    Filterblur& operator=(const Filterblur&)
     {
-        if (integral_ != nullptr) {
-            free(integral_);
-        }
+        return *this;
     }
 
+    ~Filterblur();
+
     template <class Img>
     void BoxBlur(Img& img, uint16_t radius, int32_t channel, int32_t stride)
     {
-        if (radius < 1) {
+        if (radius < 1 || channel != FOUR_TIMES) {
             return;
         }
-        int32_t width = img.GetWidth();
-        int32_t height = img.GetHeight();
-        bool isGetRGBAIntegral = false;
-        if (integral_ == nullptr || ((imageWidth_ * imageHeight_) != (width * height))) {
-            if (integral_ != nullptr) {
-                free(integral_);
-            }
-            integral_ = (int32_t*)malloc((width + 1) * (height + 1) * channel * sizeof(int32_t));
-            isGetRGBAIntegral = true;
-        }
-        if (channel == FOUR_TIMES) {
-            if (isGetRGBAIntegral) {
-                GetRGBAIntegralImage((uint8_t*)img.PixValuePtr(0, 0), width, height, stride);
-            }
-#ifndef __ICCARM__
-#pragma omp parallel for
-#endif
-            for (int32_t y = 0; y < height; y++) {
-                int32_t y1 = MATH_MAX(y - radius, 0);
-                int32_t y2 = MATH_MIN(y + radius + 1, height);
-                uint8_t* lineImageHeader = (uint8_t*)img.PixValuePtr(0, 0) + y * stride;
-                uint8_t* linePD = lineImageHeader;
-                int32_t* lineP1 = integral_ + y1 * ((width + 1) << 2);
-                int32_t* lineP2 = integral_ + y2 * ((width + 1) << 2);
+        BoxBlurRgba((uint8_t*)img.PixValuePtr(0, 0), img.GetWidth(), img.GetHeight(), stride, radius);
+    }
 
-                for (int32_t x = 0; x < width; x++) {
-                    int32_t x1 = MATH_MAX(x - radius, 0);
-                    int32_t x2 = MATH_MIN(x + radius + 1, width);
-                    int32_t index1 = x1 << 2;
-                    int32_t index2 = x2 << 2;
-                    int32_t sumB = lineP2[index2 + 0] - lineP1[index2 + 0] -
-                               lineP2[index1 + 0] + lineP1[index1 + 0];
-                    int32_t sumG = lineP2[index2 + 1] - lineP1[index2 + 1] -
-                               lineP2[index1 + 1] + lineP1[index1 + 1];
-                    int32_t sumR = lineP2[index2 + 2] - lineP1[index2 + 2] -
-                               lineP2[index1 + 2] + lineP1[index1 + 2];
+    /**
+     * @brief Every pixel of the first 3 channels becomes the rounded mean of the box of
+     * 2 * radius + 1 pixels around it, cut at the image edges. The fourth channel is kept.
+     * @param pixels The image of 4 byte pixels, rows are stride bytes apart.
+     * @since 1.0
+     * @version 1.0
+     */
+    void BoxBlurRgba(uint8_t* pixels, int32_t width, int32_t height, int32_t stride, uint16_t radius);
 
-                    const int32_t pixelCount = (x2 - x1) * (y2 - y1);
-                    linePD[0] = (sumB + (pixelCount >> 1)) / pixelCount;
-                    linePD[1] = (sumG + (pixelCount >> 1)) / pixelCount;
-                    linePD[2] = (sumR + (pixelCount >> 1)) / pixelCount;
-                    uint8_t* alpha = lineImageHeader + (x << 2);
-                    linePD[3] = alpha[3];
-                    linePD += 4;
-                }
-            }
-        }
-    }
 private:
-    void GetRGBAIntegralImage(uint8_t* src, uint16_t width, uint16_t height, uint16_t stride)
-    {
-        int32_t channel = FOUR_TIMES;
-        if (integral_ != nullptr && ((imageWidth_ * imageHeight_) != (width * height))) {
-            int32_t integralSize = (width + 1) * channel * sizeof(int32_t);
-            memset_s(integral_, integralSize, 0, integralSize);
-        }
-        for (int y = 0; y < height; y++) {
-            uint8_t* linePS = src + y * stride;
-            //	last position
-            int32_t* linePL = integral_ + y * (width + 1) * channel + channel;
-            //	curretn position£¬waring the first column of every line row is zero
-            int32_t* linePD = integral_ + (y + 1) * (width + 1) * channel + channel;
-            //	the first column is 0
-            linePD[-4] = 0;
-            linePD[-3] = 0;
-            linePD[-2] = 0;
-            linePD[-1] = 0;
-            for (int x = 0, sumB = 0, sumG = 0, sumR = 0, sumA = 0; x < width; x++) {
-                sumB += linePS[0];
-                sumG += linePS[1];
-                sumR += linePS[2];
-                sumA += linePS[3];
-                linePD[0] = linePL[0] + sumB;
-                linePD[1] = linePL[1] + sumG;
-                linePD[2] = linePL[2] + sumR;
-                linePD[3] = linePL[3] + sumA;
-                linePS += channel;
-                linePL += channel;
-                linePD += channel;
-            }
-        }
-    }
+    enum BlurScale {
+        /** (2 * 128 + 1) * 255 is the largest column sum which fits in 16 bits */
+        MAX_SUM16_RADIUS = 128
+    };
+
+    bool Reserve(uint32_t ringSize, uint32_t sumsSize);
+
+    template <class Sum>
+    void BlurRgba(uint8_t* pixels, int32_t width, int32_t height, int32_t stride, int32_t radius);
+
+    template <class Sum>
+    static void BlurRow(uint8_t* row, const Sum* sums, int32_t width, int32_t radius, uint32_t rows);
 
-    int32_t* integral_;
-    int32_t imageWidth_;
-    int32_t imageHeight_;
+    uint8_t* ring_;
+    uint8_t* sums_;
+    uint32_t ringSize_;
+    uint32_t sumsSize_;
 #endif
 };
 } // namespace OHOS
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GRAPHIC_LITE_FILTER_GAUSSIAN_BLUR_H
+#define GRAPHIC_LITE_FILTER_GAUSSIAN_BLUR_H
+
+#include "gfx_utils/diagram/common/common_basics.h"
+#include "gfx_utils/graphic_math.h"
+#include "graphic_config.h"
+
+namespace OHOS {
+/**
+ * @class FilterGaussianBlur
+ * @brief Approximates a Gaussian blur with a standard deviation of radius / 2, as the shadow blur
+ * of a canvas, by 3 box blurs whose variances add up to the Gaussian one. The rows are blurred
+ * one by one, the columns in strips of STRIP_LANES bytes which walk down the image together with
+ * the cache lines they share. Every line passes through 2 scratch lines of a single allocation.
+ * The box sums of up to MAX_VECTOR_RADIUS are kept in 16 bit lanes with NEON and SSE2, across the
+ * 4 channels of a pixel in the rows and across a strip in the columns. The image edges repeat.
+ * @since 1.0
+ * @version 1.0
+ */
+class FilterGaussianBlur {
+#if defined(GRAPHIC_ENABLE_BLUR_EFFECT_FLAG) && GRAPHIC_ENABLE_BLUR_EFFECT_FLAG
+
+public:
+    enum GaussianScale {
+        BOX_PASSES = 3,
+        STRIP_LANES = 16,
+        /** 2 * 63 + 1 is the largest box whose rounded mean is a 16 bit multiplication */
+        MAX_VECTOR_RADIUS = 63
+    };
+
+    FilterGaussianBlur() : scratch_(nullptr), scratchSize_(0) {}
+
+    /* The scratch is not shared, a copy allocates its own. */
+    FilterGaussianBlur(const FilterGaussianBlur&) : scratch_(nullptr), scratchSize_(0) {}
+
+    FilterGaussianBlur& operator=(const FilterGaussianBlur&)
+    {
+        return *this;
+    }
+
+    ~FilterGaussianBlur();
+
+    /**
+     * @brief Blur all 4 channels of the image in place, which suits premultiplied colors.
+     * @param pixels The image of 4 byte pixels, rows are stride bytes apart.
+     * @param radius The blur radius, twice the standard deviation.
+     * @since 1.0
+     * @version 1.0
+     */
+    void BlurRgba(uint8_t* pixels, int32_t width, int32_t height, int32_t stride, uint16_t radius);
+
+    /**
+     * @brief Blur an 8 bit alpha mask in place, rows are stride bytes apart.
+     * @since 1.0
+     * @version 1.0
+     */
+    void BlurA8(uint8_t* pixels, int32_t width, int32_t height, int32_t stride, uint16_t radius);
+
+    /**
+     * @brief The radii of the 3 box blurs, in ascending order, whose variances add up to the
+     * variance radius * radius / 4 the closest. A box of radius 0 is skipped.
+     * @since 1.0
+     * @version 1.0
+     */
+    static void GetBoxRadii(uint16_t radius, uint16_t boxRadii[BOX_PASSES]);
+
+private:
+    bool Reserve(uint32_t size);
+
+    void Blur(uint8_t* pixels, int32_t width, int32_t height, int32_t stride, int32_t channels, uint16_t radius);
+
+    uint8_t* scratch_;
+    uint32_t scratchSize_;
+#endif
+};
+} // namespace OHOS
+#endif
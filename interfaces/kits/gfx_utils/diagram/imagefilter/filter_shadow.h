@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GRAPHIC_LITE_FILTER_SHADOW_H
+#define GRAPHIC_LITE_FILTER_SHADOW_H
+
+#include "gfx_utils/diagram/common/paint.h"
+#include "gfx_utils/diagram/imagefilter/filter_gaussian_blur.h"
+#include "gfx_utils/diagram/scanline/scanline_alpha_mask.h"
+#include "gfx_utils/diagram/spancolorfill/fill_solid_color.h"
+
+namespace OHOS {
+/**
+ * @class FilterShadow
+ * @brief Draws the shadow of a shape from its covers alone. The covers are written into an A8 mask
+ * around the bounds of the shape, with a margin as wide as the blur spreads them, the mask is
+ * blurred with FilterGaussianBlur, and the shadow color is blended through the blurred covers at
+ * the shadow offset. The blur and the mask take a quarter of the work and memory of an ARGB8888
+ * layer. The mask and the blur scratch are kept for the next shadow.
+ * @since 1.0
+ * @version 1.0
+ */
+class FilterShadow : public HeapBase {
+#if defined(GRAPHIC_ENABLE_SHADOW_EFFECT_FLAG) && GRAPHIC_ENABLE_SHADOW_EFFECT_FLAG && \
+    defined(GRAPHIC_ENABLE_BLUR_EFFECT_FLAG) && GRAPHIC_ENABLE_BLUR_EFFECT_FLAG
+
+public:
+    FilterShadow() : originX_(0), originY_(0) {}
+
+    ~FilterShadow() {}
+
+    /**
+     * @brief Rasterize, blur and blend the shadow of the source with the blur, color and offsets
+     * of the paint.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Source>
+    void Render(Source& source, const Paint& paint, FillSolidColor& fill)
+    {
+        if (!Rasterize(source, paint.GetShadowBlur())) {
+            return;
+        }
+        Blur(paint.GetShadowBlur());
+        Composite(fill, paint.GetShadowColor(), MATH_ROUND(paint.GetShadowOffsetX()),
+                  MATH_ROUND(paint.GetShadowOffsetY()));
+    }
+
+    /**
+     * @brief Write the covers of the source into the mask, whose top left pixel is the margin of
+     * the radius above and left of the bounds of the source. Source is RasterizerScanlineAntialias
+     * or ScanlineStorage, which know the rows of their shape.
+     * @return false if the source is empty or the mask can not be allocated.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Source>
+    bool Rasterize(Source& source, uint16_t radius)
+    {
+        if (!source.RewindScanlines()) {
+            return false;
+        }
+        const int32_t margin = GetMargin(radius);
+        originX_ = source.GetMinX() - margin;
+        originY_ = source.GetMinY() - margin;
+        int32_t width = source.GetMaxX() - source.GetMinX() + 1 + margin + margin;
+        int32_t height = source.GetMaxY() - source.GetMinY() + 1 + margin + margin;
+        if (!mask_.Resize(width, height) || mask_.GetWidth() == 0) {
+            return false;
+        }
+        mask_.AddShape(source, originX_, originY_);
+        return true;
+    }
+
+    /**
+     * @brief Blur the covers of the mask with the shadow blur radius.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Blur(uint16_t radius);
+
+    /**
+     * @brief Blend the color through the covers of the mask into the buffer of fill, with the mask
+     * moved by the offset. The runs of covers 0 are skipped.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Composite(FillSolidColor& fill, const ColorType& color, int32_t offsetX, int32_t offsetY);
+
+    /**
+     * @brief How far the blur of the radius spreads a cover, the sum of its box radii.
+     * @since 1.0
+     * @version 1.0
+     */
+    static int32_t GetMargin(uint16_t radius);
+
+    const AlphaMaskBuffer& GetMask() const
+    {
+        return mask_;
+    }
+
+    int32_t GetOriginX() const
+    {
+        return originX_;
+    }
+
+    int32_t GetOriginY() const
+    {
+        return originY_;
+    }
+
+private:
+    // Disable copying
+    FilterShadow(const FilterShadow&);
+    const FilterShadow& operator=(const FilterShadow&);
+
+    AlphaMaskBuffer mask_;
+    FilterGaussianBlur blur_;
+    int32_t originX_;
+    int32_t originY_;
+#endif
+};
+} // namespace OHOS
+#endif
@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file rasterized_path_cache.h
+ * @brief Defines the cache of the swept scanlines of static paths
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_RASTERIZED_PATH_CACHE_H
+#define GRAPHIC_LITE_RASTERIZED_PATH_CACHE_H
+
+#include "gfx_utils/diagram/depiction/depict_transform.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/diagram/scanline/scanline_storage.h"
+#include "gfx_utils/heap_base.h"
+
+namespace OHOS {
+/**
+ * @brief Counters of RasterizedPathCache, hits and misses are counted by AddPath,
+ * evictions are entries dropped to stay within the byte budget and rejections are
+ * paths whose scanlines alone exceed it. entries and bytes describe the current content.
+ * @since 1.0
+ * @version 1.0
+ */
+struct RasterizedPathCacheStats {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t rejections;
+    uint32_t entries;
+    uint32_t bytes;
+};
+
+/**
+ * @class RasterizedPathCache
+ * @brief Keeps the swept scanlines of paths, keyed by the path vertices, the transform,
+ * the filling rule, the clip box or region and the scanline window of the rasterizer.
+ * A path that is found again is replayed without being rasterized. The scanlines are kept
+ * in a ScanlineStorage, runs of equal covers keep one cover. The least recently used paths
+ * are dropped to keep the cache within its byte budget. A path whose scanlines can not be stored
+ * is swept from the rasterizer itself, which must then be left unchanged until the next AddPath.
+ * It has the RewindScanlines/SweepScanline/GetMinX/GetMaxX interface of RasterizerScanlineAntialias.
+ * @since 1.0
+ * @version 1.0
+ */
+class RasterizedPathCache : public HeapBase {
+public:
+    enum CacheScale {
+        DEFAULT_BYTE_BUDGET = 256 * 1024,
+        HASH_BUCKETS = 64
+    };
+
+    explicit RasterizedPathCache(uint32_t byteBudget = DEFAULT_BYTE_BUDGET);
+
+    ~RasterizedPathCache();
+
+    /**
+     * @brief Select the scanlines of the vertex source transformed by transform. On a miss the path
+     * is rasterized by rasterizer with its filling rule, clip box and scanline window and stored.
+     * @return true if the scanlines were found in the cache.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <typename VertexSource>
+    bool AddPath(RasterizerScanlineAntialias& rasterizer, VertexSource& vs, TransAffine& transform,
+                 uint32_t pathId = 0)
+    {
+        float x;
+        float y;
+        uint32_t cmd;
+
+        CacheKey key;
+        StartKey(rasterizer, transform, key);
+        vs.Rewind(pathId);
+        while (!IsStop(cmd = vs.GenerateVertex(&x, &y))) {
+            HashVertex(key, x, y, cmd);
+        }
+        CacheEntry* entry = FindEntry(rasterizer, key, nullptr);
+        for (; entry != nullptr; entry = FindEntry(rasterizer, key, entry)) {
+            if (SameVertices(vs, pathId, *entry)) {
+                Select(entry);
+                return true;
+            }
+        }
+        DepictTransform<VertexSource> transformed(vs, transform);
+        rasterizer.Reset();
+        rasterizer.AddPath(transformed, pathId);
+        entry = Store(rasterizer, key);
+        if (entry != nullptr) {
+            CopyVertices(vs, pathId, *entry);
+        }
+        return false;
+    }
+
+    int32_t GetMinX() const
+    {
+        if (passThrough_ != nullptr) {
+            return passThrough_->GetMinX();
+        }
+        return (current_ != nullptr) ? current_->storage.GetMinX() : 0;
+    }
+    int32_t GetMaxX() const
+    {
+        if (passThrough_ != nullptr) {
+            return passThrough_->GetMaxX();
+        }
+        return (current_ != nullptr) ? current_->storage.GetMaxX() : -1;
+    }
+    int32_t GetMinY() const
+    {
+        if (passThrough_ != nullptr) {
+            return passThrough_->GetMinY();
+        }
+        return (current_ != nullptr) ? current_->storage.GetMinY() : 0;
+    }
+    int32_t GetMaxY() const
+    {
+        if (passThrough_ != nullptr) {
+            return passThrough_->GetMaxY();
+        }
+        return (current_ != nullptr) ? current_->storage.GetMaxY() : -1;
+    }
+
+    /**
+     * @brief Whether the scanlines selected by the last AddPath are swept from the rasterizer
+     * because they could not be stored.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool IsPassThrough() const
+    {
+        return passThrough_ != nullptr;
+    }
+
+    /**
+     * @brief Start replaying the scanlines selected by the last AddPath.
+     * @return false if the path has no scanline.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool RewindScanlines();
+    template <class Scanline>
+    bool SweepScanline(Scanline& sl);
+
+    /**
+     * @brief Change the byte budget, entries are dropped until the cache fits it.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetByteBudget(uint32_t byteBudget);
+
+    uint32_t GetByteBudget() const
+    {
+        return byteBudget_;
+    }
+
+    /**
+     * @brief Drop all entries, the statistics are kept.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Clear();
+
+    const RasterizedPathCacheStats& GetStats() const
+    {
+        return stats_;
+    }
+
+    void ResetStats()
+    {
+        uint32_t entries = stats_.entries;
+        uint32_t bytes = stats_.bytes;
+        stats_ = RasterizedPathCacheStats();
+        stats_.entries = entries;
+        stats_.bytes = bytes;
+    }
+
+private:
+    /**
+     * @brief The path and the clip region are reduced to 64 bit FNV-1a hashes to find the entries,
+     * the other parts of the key are compared exactly. The vertices and the region rectangles
+     * of an entry are compared on a hit, so paths whose hashes collide are told apart.
+     * @since 1.0
+     * @version 1.0
+     */
+    struct CacheKey {
+        uint64_t pathHash;
+        uint64_t regionHash;
+        uint32_t numVertices;
+        uint32_t numRegionRects;
+        float matrix[6]; // 6: the affine part of the transform
+        int32_t clipX1;
+        int32_t clipY1;
+        int32_t clipX2;
+        int32_t clipY2;
+        int32_t windowMinY;
+        int32_t windowMaxY;
+        FillingRule fillingRule;
+        bool clipping;
+    };
+
+    struct CacheVertex {
+        float x;
+        float y;
+        uint32_t cmd;
+    };
+
+    /**
+     * @brief The entry storage is copied from the scratch storage, so it holds no spare capacity.
+     * vertices keeps the key.numVertices vertices of the path before the transform,
+     * region the left, top, right and bottom of the key.numRegionRects clip rectangles.
+     * @since 1.0
+     * @version 1.0
+     */
+    struct CacheEntry : public HeapBase {
+        CacheKey key;
+        ScanlineStorage storage;
+        CacheVertex* vertices;
+        int32_t* region;
+        uint32_t dataSize;
+        CacheEntry* prev;
+        CacheEntry* next;
+        CacheEntry* nextInBucket;
+        bool cached;
+    };
+
+    static void StartKey(const RasterizerScanlineAntialias& rasterizer, const TransAffine& transform, CacheKey& key);
+    static void HashVertex(CacheKey& key, float x, float y, uint32_t cmd);
+    static void GetBounds(const Rect32& rect, int32_t* bounds);
+    static void HashBytes(uint64_t& hash, const void* data, uint32_t size);
+    static bool SameKey(const CacheKey& a, const CacheKey& b);
+    static uint32_t BucketOf(const CacheKey& key);
+
+    /**
+     * @brief The next entry after entry, or the first one when entry is nullptr,
+     * whose key and clip region equal the ones of the rasterizer.
+     * @since 1.0
+     * @version 1.0
+     */
+    CacheEntry* FindEntry(const RasterizerScanlineAntialias& rasterizer, const CacheKey& key,
+                          CacheEntry* entry) const;
+
+    template <typename VertexSource>
+    static bool SameVertices(VertexSource& vs, uint32_t pathId, const CacheEntry& entry)
+    {
+        float x;
+        float y;
+        uint32_t cmd;
+        uint32_t i = 0;
+        vs.Rewind(pathId);
+        while (!IsStop(cmd = vs.GenerateVertex(&x, &y))) {
+            if (i >= entry.key.numVertices) {
+                return false;
+            }
+            const CacheVertex& vertex = entry.vertices[i++];
+            if (vertex.x != x || vertex.y != y || vertex.cmd != cmd) {
+                return false;
+            }
+        }
+        return i == entry.key.numVertices;
+    }
+
+    template <typename VertexSource>
+    static void CopyVertices(VertexSource& vs, uint32_t pathId, CacheEntry& entry)
+    {
+        float x;
+        float y;
+        uint32_t cmd;
+        uint32_t i = 0;
+        vs.Rewind(pathId);
+        while (!IsStop(cmd = vs.GenerateVertex(&x, &y)) && i < entry.key.numVertices) {
+            CacheVertex& vertex = entry.vertices[i++];
+            vertex.x = x;
+            vertex.y = y;
+            vertex.cmd = cmd;
+        }
+    }
+
+    /**
+     * @brief Select the entry and make it the most recently used one.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Select(CacheEntry* entry);
+
+    /**
+     * @brief Record the rasterizer into the scratch storage and copy it into a new entry,
+     * the rasterizer is passed through when either fails.
+     * @return The selected entry, its vertices are still to be copied.
+     * @since 1.0
+     * @version 1.0
+     */
+    CacheEntry* Store(RasterizerScanlineAntialias& rasterizer, const CacheKey& key);
+    CacheEntry* CreateEntry(const RasterizerScanlineAntialias& rasterizer, const CacheKey& key);
+    void Insert(CacheEntry* entry);
+    void Unlink(CacheEntry* entry);
+    void Evict(uint32_t byteBudget);
+    void ReleaseCurrent();
+    void DeleteEntry(CacheEntry* entry);
+
+    // Disable copying
+    RasterizedPathCache(const RasterizedPathCache&);
+    const RasterizedPathCache& operator=(const RasterizedPathCache&);
+
+    CacheEntry* buckets_[HASH_BUCKETS];
+    CacheEntry* head_;
+    CacheEntry* tail_;
+    CacheEntry* current_;
+    RasterizerScanlineAntialias* passThrough_;
+    uint32_t byteBudget_;
+    RasterizedPathCacheStats stats_;
+    ScanlineStorage scratch_;
+};
+} // namespace OHOS
+#endif
@@ -24,12 +24,20 @@
 #define GRAPHIC_LITE_RASTERIZER_CELLS_ANTIALIAS_H
 
 #include "gfx_utils/diagram/common/common_math.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_dense_coverage.h"
 #include "gfx_utils/vector.h"
 
 namespace OHOS {
 // There is no constructor defined for pixel cells,
 // which is to avoid the additional overhead of allocating cell arrays
 struct CellBuildAntiAlias {
+    /**
+     * @brief Cells are sorted through an array of pointers unless CELL_SORT_RADIX is selected.
+     */
+    enum CellSortDefault {
+        DEFAULT_SORT_BY_VALUE = 0
+    };
+
     int32_t x;
     int32_t y;
     int32_t cover;
@@ -52,7 +60,69 @@ struct CellBuildAntiAlias {
     }
 };
 
-class RasterizerCellsAntiAlias {
+/**
+ * @brief 8-byte storage layout of a finished cell, half the size of CellBuildAntiAlias.
+ * A cell collects the edges that cross its pixel until the outline moves to another pixel,
+ * however often they zigzag inside it, so its cover is the height the outline moved through the
+ * pixel. Only the last edge of one subpath and the first edge of the next one can cross the same
+ * pixel in the same direction, at most COVER_LIMIT together, and the area stays below AREA_LIMIT.
+ * The cells are exact as long as the coordinates fit in 16 bits, as they do inside a clip box of
+ * [-COORD_MAX, COORD_MAX]. The coordinates of unclipped outlines beyond INT16_MAX saturate, and
+ * so does a cover or area outside of the bit fields; the coverage of those cells is wrong.
+ * Cells are still accumulated in a CellBuildAntiAlias and converted when they are stored,
+ * the packed layout is sorted by value so that no pointer array is needed.
+ * @since 1.0
+ * @version 1.0
+ */
+struct CellPackedAntiAlias {
+    enum CellSortDefault {
+        DEFAULT_SORT_BY_VALUE = 1
+    };
+
+    enum PackedBits {
+        COVER_BITS = 10,
+        AREA_BITS = 32 - COVER_BITS,
+        COVER_LIMIT = (1 << (COVER_BITS - 1)) - 1,
+        AREA_LIMIT = (1 << (AREA_BITS - 1)) - 1
+    };
+
+    int16_t x;
+    int16_t y;
+    int32_t cover : COVER_BITS;
+    int32_t area : AREA_BITS;
+
+    CellPackedAntiAlias& operator=(const CellBuildAntiAlias& cell)
+    {
+        x = static_cast<int16_t>(MATH_MAX(INT16_MIN, MATH_MIN(INT16_MAX, cell.x)));
+        y = static_cast<int16_t>(MATH_MAX(INT16_MIN, MATH_MIN(INT16_MAX, cell.y)));
+        cover = MATH_MAX(-COVER_LIMIT, MATH_MIN(COVER_LIMIT, cell.cover));
+        area = MATH_MAX(-AREA_LIMIT, MATH_MIN(AREA_LIMIT, cell.area));
+        return *this;
+    }
+};
+
+/**
+ * @brief The part of the cell rasterizer that does not depend on the cell layout.
+ * @since 1.0
+ * @version 1.0
+ */
+class RasterizerCellsBase {
+public:
+    /**
+     * @brief Backend used to order the cells of each scanline by X.
+     * CELL_SORT_QUICK sorts an array of cell pointers per row with quicksort,
+     * CELL_SORT_RADIX scatters the cells by value into their rows and sorts each row
+     * on the row-relative X (insertion sort for short rows, LSD radix sort otherwise),
+     * the result is read with GetScanlineSortedCells.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum CellSortMode {
+        CELL_SORT_QUICK,
+        CELL_SORT_RADIX
+    };
+
+protected:
     struct SortedYLevel {
         uint32_t start;
         uint32_t num;
@@ -74,23 +144,106 @@ class RasterizerCellsAntiAlias {
         DX_LIMIT = CONSTITUTION << POLY_SUBPIXEL_SHIFT
     };
 
+    /**
+     * @brief Digit width of one LSD radix pass over the row-relative X of the cells,
+     * rows with at most RADIX_ROW_THRESHOLD cells are insertion sorted instead.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum RadixScale {
+        RADIX_SHIFT = 8,
+        RADIX_SIZE = 1 << RADIX_SHIFT,
+        RADIX_MASK = RADIX_SIZE - 1,
+        RADIX_MAX_PASSES = 4,
+        RADIX_ROW_THRESHOLD = 32
+    };
+};
+
+/**
+ * @brief Builds, stores and sorts the cells of the outline.
+ * Cell is the storage layout, CellBuildAntiAlias or CellPackedAntiAlias.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Cell>
+class RasterizerCells : public RasterizerCellsBase {
 public:
-    ~RasterizerCellsAntiAlias();
+    using CellType = Cell;
+
+    ~RasterizerCells();
 
     /**
-     * @brief RasterizerCellsAntiAlias Class constructor
+     * @brief RasterizerCells Class constructor
      * initialization numBlocks_,maxBlocks_,currBlock_ etc
      * @since 1.0
      * @version 1.0
      */
-    RasterizerCellsAntiAlias(uint32_t cellBlockLimit = 1024);
+    RasterizerCells(uint32_t cellBlockLimit = 1024);
 
     /**
      * Reinitialize settings numBlocks_,maxBlocks_,currBlock_ etc。
+     * The cell blocks and sort buffers are kept for the next frame unless capacity retention is off.
      * @since 1.0
      * @version 1.0
      */
     void Reset();
+
+    /**
+     * @brief Release the cell blocks and sort buffers that the current cells do not use.
+     * @since 1.0
+     * @version 1.0
+     */
+    void ShrinkToFit();
+
+    /**
+     * @brief Whether Reset keeps the cell blocks and sort buffers, enabled by default so that
+     * steady-state frames do not allocate. When disabled, Reset calls ShrinkToFit.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetRetainCapacity(bool retainCapacity)
+    {
+        retainCapacity_ = retainCapacity;
+    }
+
+    /**
+     * @brief Bytes currently held by the cell blocks and sort buffers.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetMemoryUsage() const
+    {
+        return memoryBytes_;
+    }
+
+    /**
+     * @brief High-water mark of GetMemoryUsage since construction.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetPeakMemoryUsage() const
+    {
+        return peakMemoryBytes_;
+    }
+
+    /**
+     * @brief Only keep the cells of the rows minY to maxY, the edges are still walked
+     * from end to end so the kept rows are the same as without the window.
+     * The window survives Reset.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetYWindow(int32_t minY, int32_t maxY)
+    {
+        windowMinY_ = minY;
+        windowMaxY_ = maxY;
+    }
+
+    void ResetYWindow()
+    {
+        windowMinY_ = INT32_MIN;
+        windowMaxY_ = INT32_MAX;
+    }
     void SetStyle(const CellBuildAntiAlias& styleCell);
 
     /**
@@ -138,6 +291,63 @@ public:
         return numCells_;
     }
 
+    /**
+     * @brief Number of cells dropped since Reset because the cell block limit was reached
+     * or a cell block could not be allocated.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetDroppedCells() const
+    {
+        return droppedCells_;
+    }
+
+    /**
+     * @brief Number of cells the cell block limit can hold, without the reserved blocks.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetCellCapacity() const
+    {
+        return (cellBlockLimit_ - reservedBlocks_) * CELL_BLOCK_SIZE;
+    }
+
+    /**
+     * @brief Bytes of the cell block limit, including the reserved blocks.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetCellMemoryLimit() const
+    {
+        return cellBlockLimit_ * CELL_BLOCK_SIZE * sizeof(Cell);
+    }
+
+    /**
+     * @brief Reserve bytes of the cell block limit, rounded up to cell blocks, for another buffer
+     * such as the path record of the rasterizer, so that the cell blocks and that buffer together stay
+     * within the limit. Retained cell blocks that no longer fit are released. The reservation survives Reset.
+     * @return false if the cells use the blocks, the reservation is then unchanged.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool ReserveMemory(uint32_t bytes);
+
+    /**
+     * @brief Accumulate the cells into an active dense coverage buffer instead of storing
+     * and sorting them, until Reset. Cells outside the buffer are dropped.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetDenseCoverage(RasterizerDenseCoverage* dense)
+    {
+        dense_ = dense;
+    }
+
+    bool GetDense() const
+    {
+        return dense_ != nullptr;
+    }
+
     /**
      * @brief In the process of rasterization, it is calculated according to the coordinate height of Y
      * Total number of cells.
@@ -160,7 +370,7 @@ public:
      * @since 1.0
      * @version 1.0
      */
-    const CellBuildAntiAlias * const *GetScanlineCells(uint32_t yLevel)
+    const Cell* const* GetScanlineCells(uint32_t yLevel)
     {
         uint32_t MaxSize = maxY_ - minY_ + 1 + CELLS_SIZE;
         if ((yLevel - minY_) > MaxSize) {
@@ -170,14 +380,67 @@ public:
         return sortedCells_ + sortedY_[yLevel - minY_].start;
     }
 
+    /**
+     * @brief In the process of rasterization, it is calculated according to the coordinate height of Y
+     * The first address of the cells sorted by value, only valid when GetSortedByValue() is true.
+     * @since 1.0
+     * @version 1.0
+     */
+    const Cell* GetScanlineSortedCells(uint32_t yLevel)
+    {
+        uint32_t MaxSize = maxY_ - minY_ + 1 + CELLS_SIZE;
+        if ((yLevel - minY_) > MaxSize) {
+            return sortedCellValues_;
+        }
+
+        return sortedCellValues_ + sortedY_[yLevel - minY_].start;
+    }
+
     bool GetSorted() const
     {
         return sorted_;
     }
 
+    /**
+     * @brief Whether the last sort stored the cells by value (CELL_SORT_RADIX)
+     * instead of through the sorted pointer array.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool GetSortedByValue() const
+    {
+        return sortedByValue_;
+    }
+
+    /**
+     * @brief Select the backend of SortAllCells, it takes effect on the next sort.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetSortMode(CellSortMode sortMode)
+    {
+        sortMode_ = sortMode;
+    }
+
+    CellSortMode GetSortMode() const
+    {
+        return sortMode_;
+    }
+
+    /**
+     * @brief The radix key of a cell at x, relative to minX - 1: the cells of an edge
+     * may land one pixel left of minX and must still sort first.
+     * @since 1.0
+     * @version 1.0
+     */
+    static uint32_t GetRadixKey(int32_t x, int32_t minX)
+    {
+        return static_cast<uint32_t>(x) - static_cast<uint32_t>(minX) + 1;
+    }
+
 private:
-    RasterizerCellsAntiAlias(const CellBuildAntiAlias&);
-    const CellBuildAntiAlias& operator=(const CellBuildAntiAlias&);
+    RasterizerCells(const RasterizerCells&);
+    const RasterizerCells& operator=(const RasterizerCells&);
 
     /**
      * @brief Set the current cell during rasterization.
@@ -214,30 +477,73 @@ private:
 
     /**
      * @brief Allocate array space for cells during rasterization.
+     * @return false if the block can not be allocated, currCellPtr_ must not be written then.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool AllocateBlock();
+
+    /**
+     * @brief Sort the cells by value: a stable scatter into the Y buckets of sortedY_,
+     * then every row is sorted on its row-relative X.
+     * @param maxRowCells Number of cells of the longest row.
+     * @return false if the sort buffers can not be allocated, the caller falls back to quicksort.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool SortCellsRadix(uint32_t maxRowCells);
+
+    /**
+     * @brief Stable LSD radix sort of one row on the row-relative X, radixRow_ holds the other half.
      * @since 1.0
      * @version 1.0
      */
-    void AllocateBlock();
+    void SortRowRadix(Cell* row, uint32_t num);
+
+    template <class T>
+    bool ReserveSortBuffer(T*& buffer, uint32_t& capacity, uint32_t size);
+
+    template <class T>
+    void ReleaseSortBuffer(T*& buffer, uint32_t& capacity);
 
 private:
     uint32_t numBlocks_;
     uint32_t maxBlocks_;
     uint32_t currBlock_;
     uint32_t numCells_;
+    uint32_t droppedCells_;
     uint32_t cellBlockLimit_;
-    CellBuildAntiAlias** cells_;
-    CellBuildAntiAlias* currCellPtr_;
-    CellBuildAntiAlias** sortedCells_;
+    uint32_t reservedBlocks_;
+    Cell** cells_;
+    Cell* currCellPtr_;
+    Cell** sortedCells_;
+    uint32_t sortedCellsCapacity_;
     SortedYLevel* sortedY_;
+    uint32_t sortedYCapacity_;
+    Cell* sortedCellValues_;
+    uint32_t sortedCellValuesCapacity_;
+    Cell* radixRow_;
+    uint32_t radixRowCapacity_;
+    RasterizerDenseCoverage* dense_;
+    uint32_t memoryBytes_;
+    uint32_t peakMemoryBytes_;
+    CellSortMode sortMode_;
     CellBuildAntiAlias currCell_;
     CellBuildAntiAlias styleCell_;
     int32_t minX_;
     int32_t minY_;
     int32_t maxX_;
     int32_t maxY_;
+    int32_t windowMinY_;
+    int32_t windowMaxY_;
     bool sorted_;
+    bool sortedByValue_;
+    bool retainCapacity_;
 };
 
+using RasterizerCellsAntiAlias = RasterizerCells<CellBuildAntiAlias>;
+using RasterizerCellsAntiAliasPacked = RasterizerCells<CellPackedAntiAlias>;
+
 class ScanlineHitRegionMeasure {
 public:
     ScanlineHitRegionMeasure(int32_t x) : xCoordinate_(x), hitMeasureFlags_(false) {}
@@ -281,16 +587,18 @@ inline void SwapCells(T* oneCells, T* twoCells)
     *twoCells = tempCells;
 }
 
-void QsortCellsSweep(CellBuildAntiAlias*** base, CellBuildAntiAlias*** iIndex, CellBuildAntiAlias*** jIndex);
+template <class Cell>
+void QsortCellsSweep(Cell*** base, Cell*** iIndex, Cell*** jIndex);
 
 /**
  * @brief In the rasterization process, all cells are sorted quickly.
  * @since 1.0
  * @version 1.0
  */
-void QsortCells(CellBuildAntiAlias** start, uint32_t num);
+template <class Cell>
+void QsortCells(Cell** start, uint32_t num);
 
-void QsortCellsFor(CellBuildAntiAlias*** iIndex, CellBuildAntiAlias*** jIndex,
-                   CellBuildAntiAlias*** limit, CellBuildAntiAlias*** base);
+template <class Cell>
+void QsortCellsFor(Cell*** iIndex, Cell*** jIndex, Cell*** limit, Cell*** base);
 } // namespace OHOS
 #endif
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file rasterizer_dense_coverage.h
+ * @brief Defines the dense coverage buffer of small paths
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_RASTERIZER_DENSE_COVERAGE_H
+#define GRAPHIC_LITE_RASTERIZER_DENSE_COVERAGE_H
+
+#include "gfx_utils/diagram/common/common_basics.h"
+
+namespace OHOS {
+/**
+ * @class RasterizerDenseCoverage
+ * @brief Accumulates the cells of a small path into the cover and area of every pixel of its
+ * bounding box, so that they need no cell blocks and no sort. A row is read back from its leftmost
+ * to its rightmost touched pixel and prefix summed into the areas CalculateAlpha takes.
+ * @since 1.0
+ * @version 1.0
+ */
+class RasterizerDenseCoverage {
+public:
+    /**
+     * @brief Accumulated cover and area of one pixel.
+     * @since 1.0
+     * @version 1.0
+     */
+    struct DenseCell {
+        int32_t cover;
+        int32_t area;
+    };
+
+    RasterizerDenseCoverage();
+
+    ~RasterizerDenseCoverage();
+
+    /**
+     * @brief Size the buffer to the pixels minX to maxX of the rows minY to maxY and clear it.
+     * @return false if the buffer can not be allocated, the buffer is not active then.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool SetBounds(int32_t minX, int32_t minY, int32_t maxX, int32_t maxY);
+
+    /**
+     * @brief Deactivate the buffer, it is kept for the next path unless capacity retention is off.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Reset();
+
+    /**
+     * @brief Release the buffer unless it is active.
+     * @since 1.0
+     * @version 1.0
+     */
+    void ShrinkToFit();
+
+    void SetRetainCapacity(bool retainCapacity)
+    {
+        retainCapacity_ = retainCapacity;
+    }
+
+    /**
+     * @brief Whether SetBounds succeeded since the last Reset.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool IsActive() const
+    {
+        return active_;
+    }
+
+    /**
+     * @brief Bytes currently held by the buffer and its high-water mark.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetMemoryUsage() const
+    {
+        return memoryBytes_;
+    }
+
+    uint32_t GetPeakMemoryUsage() const
+    {
+        return peakMemoryBytes_;
+    }
+
+    /**
+     * @brief Add a cell to its pixel and widen the touched range of its row.
+     * @return false if the pixel is outside the buffer, the cell is dropped.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool AddCell(int32_t x, int32_t y, int32_t cover, int32_t area)
+    {
+        int32_t col = x - minX_;
+        int32_t row = y - minY_;
+        if (col < 0 || col >= width_ || row < 0 || row >= height_) {
+            return false;
+        }
+        DenseCell& cell = cells_[row * width_ + col];
+        cell.cover += cover;
+        cell.area += area;
+        RowRange& range = rows_[row];
+        if (col < range.minX) {
+            range.minX = col;
+        }
+        if (col > range.maxX) {
+            range.maxX = col;
+        }
+        return true;
+    }
+
+    /**
+     * @brief The accumulated pixels of row y from the leftmost to the rightmost pixel a cell touched.
+     * @param x Receives the X of the first pixel.
+     * @return Number of pixels, 0 if no cell touched the row.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetRow(int32_t y, int32_t& x, const DenseCell*& cells) const
+    {
+        int32_t row = y - minY_;
+        if (row < 0 || row >= height_ || rows_[row].minX > rows_[row].maxX) {
+            return 0;
+        }
+        const RowRange& range = rows_[row];
+        x = range.minX + minX_;
+        cells = cells_ + row * width_ + range.minX;
+        return static_cast<uint32_t>(range.maxX - range.minX + 1);
+    }
+
+    /**
+     * @brief Prefix sum the covers of num pixels, starting from cover, into their areas
+     * (cover << (POLY_SUBPIXEL_SHIFT + 1)) - area. cover receives the cover after the last pixel.
+     * Vectorized with NEON or SSE2.
+     * @since 1.0
+     * @version 1.0
+     */
+    static void PrefixSum(const DenseCell* cells, uint32_t num, int32_t& cover, int32_t* areas);
+
+private:
+    struct RowRange {
+        int32_t minX;
+        int32_t maxX;
+    };
+
+    RasterizerDenseCoverage(const RasterizerDenseCoverage&);
+    const RasterizerDenseCoverage& operator=(const RasterizerDenseCoverage&);
+
+    template <class T>
+    bool Reserve(T*& buffer, uint32_t& capacity, uint32_t size);
+
+    template <class T>
+    void Release(T*& buffer, uint32_t& capacity);
+
+    DenseCell* cells_;
+    uint32_t cellsCapacity_;
+    RowRange* rows_;
+    uint32_t rowsCapacity_;
+    int32_t minX_;
+    int32_t minY_;
+    int32_t width_;
+    int32_t height_;
+    uint32_t memoryBytes_;
+    uint32_t peakMemoryBytes_;
+    bool retainCapacity_;
+    bool active_;
+};
+} // namespace OHOS
+#endif
@@ -25,8 +25,31 @@
 
 #include "rasterizer_cells_antialias.h"
 #include "rasterizer_scanline_clip.h"
+#include "rasterizer_shape_fast_path.h"
 #include "gfx_utils/diagram/scanline/geometry_scanline.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline_packed.h"
 namespace OHOS {
+#if defined(ENABLE_PACKED_RASTERIZER_CELLS) && ENABLE_PACKED_RASTERIZER_CELLS
+using RasterizerOutline = RasterizerCellsAntiAliasPacked;
+#else
+using RasterizerOutline = RasterizerCellsAntiAlias;
+#endif
+
+/**
+ * @brief Counters of the tiled fallback of RasterizerScanlineAntialias.
+ * tiledPaths is the number of paths that overflowed the cell block limit and were tiled,
+ * tilePasses is the number of tiles rasterized, tileRetries counts tiles that overflowed
+ * again and were split, droppedCells are cells lost in tiles of one row that still overflowed.
+ * @since 1.0
+ * @version 1.0
+ */
+struct RasterizerTilingStats {
+    uint32_t tiledPaths;
+    uint32_t tilePasses;
+    uint32_t tileRetries;
+    uint32_t droppedCells;
+};
+
 /**
  * @class RasterizerScanlineAntiAlias
  * @brief Polygon rasterization is used for high-quality rendering of filled polygons,
@@ -59,6 +82,17 @@ public:
         AA_MASK2 = AA_SCALE2 - 1
     };
 
+    /**
+     * @brief Paths whose bounding box covers at most DENSE_AREA_LIMIT pixels are accumulated
+     * into a dense coverage buffer, DENSE_CHUNK pixels of a row are converted to alpha at a time.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum DenseScale {
+        DENSE_AREA_LIMIT = 64 * 64,
+        DENSE_CHUNK = 64
+    };
+
     /**
      * Construction of rasterized scanline antialiasing constructor
      * @brief It mainly includes the allocation quota of cell block and cutter
@@ -68,19 +102,51 @@ public:
      */
     RasterizerScanlineAntialias(uint32_t cell_block_limit = (1 << (AA_SHIFT + 2)))
         : outline_(cell_block_limit),
+          dense_(),
           clipper_(),
           fillingRule_(FILL_NON_ZERO),
           autoClose_(true),
           startX_(0),
           startY_(0),
           status_(STATUS_INITIAL),
-          scanY_(0)
+          scanY_(0),
+          shapes_(),
+          records_(nullptr),
+          recordsCapacity_(0),
+          numRecords_(0),
+          windowMinY_(INT32_MIN),
+          windowMaxY_(INT32_MAX),
+          pathMinX_(0),
+          pathMinY_(0),
+          pathMaxX_(0),
+          pathMaxY_(0),
+          tileMinY_(0),
+          tileHeight_(0),
+          tileBaseHeight_(0),
+          tilingStats_(),
+          denseAreaLimit_(DENSE_AREA_LIMIT),
+          recordMinX_(INT32_MAX),
+          recordMinY_(INT32_MAX),
+          recordMaxX_(INT32_MIN),
+          recordMaxY_(INT32_MIN),
+          clipX1_(0),
+          clipY1_(0),
+          clipX2_(0),
+          clipY2_(0),
+          autoTiling_(false),
+          recordFailed_(false),
+          tiled_(false),
+          clipping_(false),
+          deferred_(true),
+          shapeRewound_(false)
     {
         for (int32_t coverIndex = 0; coverIndex < AA_SCALE; coverIndex++) {
             gammar_[coverIndex] = coverIndex;
         }
     }
 
+    ~RasterizerScanlineAntialias();
+
     /**
      * @brief Reset the cell array for building contour lines,
      * Reset the scan line status value, etc.
@@ -97,11 +163,57 @@ public:
     void ResetClipping();
     void ClipBox(float x1, float y1, float x2, float y2);
 
+    /**
+     * @brief Clip to the union of pixel rectangles, such as the dirty areas of a frame.
+     * The path is rasterized once within their bounding box and the scanlines are cut to the rectangles,
+     * they are the same as the scanlines of the path clipped to each rectangle.
+     * @return false if the rectangles can not be stored, the path is then only clipped to their bounding box.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool ClipRegion(const Rect32* rects, uint32_t numRects);
+
+    /**
+     * @brief The rectangles of ClipRegion sorted by top.
+     * @return the number of rectangles, 0 without a clip region.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetClipRegion(const Rect32*& rects) const
+    {
+        return clipper_.GetRegion(rects);
+    }
+
     void AutoClose(bool flag)
     {
         autoClose_ = flag;
     }
 
+    void SetFillingRule(FillingRule fillingRule)
+    {
+        fillingRule_ = fillingRule;
+    }
+
+    FillingRule GetFillingRule() const
+    {
+        return fillingRule_;
+    }
+
+    /**
+     * @brief The clip box in 1 / 256 pixel units.
+     * @return false if the rasterizer does not clip.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool GetClipBox(int32_t& x1, int32_t& y1, int32_t& x2, int32_t& y2) const
+    {
+        x1 = clipX1_;
+        y1 = clipY1_;
+        x2 = clipX2_;
+        y2 = clipY2_;
+        return clipping_;
+    }
+
     /**
      * @brief Set the starting position of the element according to the of 1 / 256 pixel unit.
      * @since 1.0
@@ -135,6 +247,16 @@ public:
     void ClosePolygon();
     void AddVertex(float x, float y, uint32_t cmd);
 
+    /**
+     * @brief Add a closed rectangle with quarter circle corners of the radius, in pixel units.
+     * With the shape fast path, when it is the only shape, its corners are pixel aligned and the radius
+     * is an integer of at most CORNER_MAX_RADIUS, the rows are filled from cached corner coverage masks,
+     * otherwise its outline is rasterized like any path. The scanlines are the same either way.
+     * @since 1.0
+     * @version 1.0
+     */
+    void AddRoundedRect(float x1, float y1, float x2, float y2, float radius);
+
     /**
      * @brief Obtain the vertex information coordinates from the vertex source and follow the scanning process
      * Sets the procedure for adding an array of cells.
@@ -149,7 +271,7 @@ public:
 
         uint32_t cmd;
         vs.Rewind(pathId);
-        if (outline_.GetSorted()) {
+        if (outline_.GetSorted() || shapeRewound_) {
             Reset();
         }
         while (!IsStop(cmd = vs.GenerateVertex(&x, &y))) {
@@ -164,19 +286,31 @@ public:
      */
     int32_t GetMinX() const
     {
-        return outline_.GetMinX();
+        if (shapes_.GetShape() != RasterizerShapeFastPath::SHAPE_PATH) {
+            return shapes_.GetMinX();
+        }
+        return tiled_ ? pathMinX_ : outline_.GetMinX();
     }
     int32_t GetMinY() const
     {
-        return outline_.GetMinY();
+        if (shapes_.GetShape() != RasterizerShapeFastPath::SHAPE_PATH) {
+            return MATH_MAX(shapes_.GetMinY(), windowMinY_);
+        }
+        return tiled_ ? pathMinY_ : outline_.GetMinY();
     }
     int32_t GetMaxX() const
     {
-        return outline_.GetMaxX();
+        if (shapes_.GetShape() != RasterizerShapeFastPath::SHAPE_PATH) {
+            return shapes_.GetMaxX();
+        }
+        return tiled_ ? pathMaxX_ : outline_.GetMaxX();
     }
     int32_t GetMaxY() const
     {
-        return outline_.GetMaxY();
+        if (shapes_.GetShape() != RasterizerShapeFastPath::SHAPE_PATH) {
+            return MATH_MIN(shapes_.GetMaxY(), windowMaxY_);
+        }
+        return tiled_ ? pathMaxY_ : outline_.GetMaxY();
     }
 
     /**
@@ -200,17 +334,284 @@ public:
      * The color information is obtained successfully,
      * and then the alpha information of color is calculated by gamma function
      * Fill in the new scanline and have subsequent render.
+     * Scanline is GeometryScanline or GeometryScanlinePacked.
      * @since 1.0
      * @version 1.0
      */
-    bool SweepScanline(GeometryScanline& sl);
+    template <class Scanline>
+    bool SweepScanline(Scanline& sl);
+
+    /**
+     * @brief Select the backend used to sort the cells of each scanline by X.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetCellSortMode(RasterizerCellsBase::CellSortMode sortMode)
+    {
+        outline_.SetSortMode(sortMode);
+    }
+
+    /**
+     * @brief Release the cell and dense coverage memory retained across Reset.
+     * @since 1.0
+     * @version 1.0
+     */
+    void ShrinkToFit()
+    {
+        outline_.ShrinkToFit();
+        dense_.ShrinkToFit();
+    }
+
+    void SetRetainCapacity(bool retainCapacity)
+    {
+        outline_.SetRetainCapacity(retainCapacity);
+        dense_.SetRetainCapacity(retainCapacity);
+    }
+
+    /**
+     * @brief High-water mark of the memory held by the cell rasterizer and the dense coverage buffer, in bytes.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetPeakMemoryUsage() const
+    {
+        return outline_.GetPeakMemoryUsage() + dense_.GetPeakMemoryUsage();
+    }
+
+    /**
+     * @brief Only sweep the scanlines minY to maxY, used to rasterize one band of a shape.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetScanlineWindow(int32_t minY, int32_t maxY)
+    {
+        windowMinY_ = minY;
+        windowMaxY_ = maxY;
+        outline_.SetYWindow(minY, maxY);
+    }
+
+    void GetScanlineWindow(int32_t& minY, int32_t& maxY) const
+    {
+        minY = windowMinY_;
+        maxY = windowMaxY_;
+    }
+
+    void ResetScanlineWindow()
+    {
+        windowMinY_ = INT32_MIN;
+        windowMaxY_ = INT32_MAX;
+        outline_.ResetYWindow();
+    }
+
+    /**
+     * @brief When the cells of a path overflow the cell block limit, the path is rasterized again
+     * in Y tiles that fit the limit, the scanlines are the same as with an unbounded limit.
+     * This needs every clipper operation of the path to be recorded while it is added, 12 bytes each,
+     * so it is disabled by default. The record is charged to the cell block limit: it only grows into
+     * cell blocks that no cell uses and the cells of later paths have fewer blocks. In the worst case
+     * the cell blocks and the record together take GetCellMemoryLimit bytes of the outline plus one
+     * cell block of rounding, the sort buffers of the cells come on top as without tiling.
+     * A path whose record does not fit is rasterized untiled.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetAutoTiling(bool autoTiling)
+    {
+        autoTiling_ = autoTiling;
+    }
+
+    bool GetAutoTiling() const
+    {
+        return autoTiling_;
+    }
+
+    /**
+     * @brief Counters of the tiled fallback, accumulated until ResetTilingStats.
+     * @since 1.0
+     * @version 1.0
+     */
+    const RasterizerTilingStats& GetTilingStats() const
+    {
+        return tilingStats_;
+    }
+
+    void ResetTilingStats()
+    {
+        tilingStats_ = RasterizerTilingStats();
+    }
+
+    /**
+     * @brief Paths are recorded until their bounding box exceeds areaLimit pixels, a path that stays
+     * within it is accumulated into a dense coverage buffer by RewindScanlines, without storing
+     * and sorting cells. The scanlines are the same as with cells. 0 always uses cells.
+     * Takes effect from the next Reset.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetDenseAreaLimit(uint32_t areaLimit)
+    {
+        denseAreaLimit_ = areaLimit;
+    }
+
+    uint32_t GetDenseAreaLimit() const
+    {
+        return denseAreaLimit_;
+    }
+
+    /**
+     * @brief Whether the last RewindScanlines chose the dense coverage buffer.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool IsDense() const
+    {
+        return outline_.GetDense();
+    }
+
+    /**
+     * @brief Recognize rectangles and pixel aligned rounded rectangles and sweep them
+     * without cells, see RasterizerShapeFastPath. This keeps up to RECT_MAX_RECORDS clipper operations
+     * of every path deferred, so it is disabled by default. Takes effect from the next Reset.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetShapeFastPath(bool shapeFastPath)
+    {
+        shapes_.SetEnabled(shapeFastPath);
+    }
+
+    bool GetShapeFastPath() const
+    {
+        return shapes_.GetEnabled();
+    }
+
+    /**
+     * @brief The shape chosen by the last RewindScanlines.
+     * @since 1.0
+     * @version 1.0
+     */
+    RasterizerShapeFastPath::RasterizerShape GetShape() const
+    {
+        return shapes_.GetShape();
+    }
 
 private:
+    /**
+     * @brief Clipper operation in 1 / 256 pixel units, replayed for every tile.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum RecordScale {
+        RECORD_BLOCK_SIZE = 64
+    };
+
+    using PathRecord = RasterizerPathRecord;
+
+    void ClipperMoveTo(int32_t x, int32_t y);
+    void ClipperLineTo(int32_t x, int32_t y);
+    bool AddRecord(int32_t x, int32_t y, bool moveTo);
+
+    /**
+     * @brief Replay the recorded operations into the clipper, the edges without rows in minY to maxY
+     * are skipped.
+     * @since 1.0
+     * @version 1.0
+     */
+    void ReplayRecords(int32_t minY = INT32_MIN, int32_t maxY = INT32_MAX);
+
+    /**
+     * @brief Stop deferring the path, the recorded operations are replayed into cells.
+     * @since 1.0
+     * @version 1.0
+     */
+    void FlushRecords();
+    bool DenseFits() const;
+
+    /**
+     * @brief Replay the deferred path into a dense coverage buffer sized by its clipped bounding box.
+     * @return false if the buffer can not be allocated.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool StartDense();
+
+    /**
+     * @brief A path still deferred at sorting time is rasterized dense, or into cells
+     * when the dense buffer can not be allocated.
+     * @since 1.0
+     * @version 1.0
+     */
+    void ResolveDeferred();
+    template <class Scanline>
+    void SweepDense(Scanline& sl);
+    template <class Scanline>
+    void AddDenseRuns(Scanline& sl, const RasterizerDenseCoverage::DenseCell* cells,
+                      const uint8_t* alpha, uint32_t num, int32_t x) const;
+
+    /**
+     * @brief Feed the outline of the pending rounded rectangle to the clipper.
+     * @since 1.0
+     * @version 1.0
+     */
+    void FlushRoundedRect();
+    void AddRoundedPolygon();
+
+    /**
+     * @brief Split the rows of an overflowed path into tiles that fit the cell block limit.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool StartTiling();
+
+    /**
+     * @brief Replay the path into the next tile that has cells, a tile that overflows is halved,
+     * a tile that fits lets the next one grow back towards the height chosen by StartTiling.
+     * @return false when all tiles are swept.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool NextTile();
+
+    /**
+     * @brief SweepCells converts SWEEP_CHUNK runs of cells at a time, each run has
+     * the area of its cell and of the span after it.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum SweepScale {
+        SWEEP_CHUNK = 32,
+        SWEEP_AREAS = 2
+    };
+
+    /**
+     * @brief The cells of one X and the span up to the next X.
+     * @since 1.0
+     * @version 1.0
+     */
+    struct SweepRun {
+        int32_t x;
+        int32_t nextX;
+        bool hasArea;
+    };
+
+    template <class Scanline, class CellIterator>
+    bool SweepCells(Scanline& sl, CellIterator cells, uint32_t numCells);
+    template <class Scanline>
+    void AddRuns(Scanline& sl, const SweepRun* runs, const int32_t* areas, uint32_t numRuns) const;
+
+    /**
+     * @brief CalculateAlpha for num areas, vectorized with NEON or SSE2.
+     * @since 1.0
+     * @version 1.0
+     */
+    void CalculateAlphas(const int32_t* areas, uint32_t num, uint8_t* alpha) const;
+
     // Disable copying
     RasterizerScanlineAntialias(const RasterizerScanlineAntialias&);
     const RasterizerScanlineAntialias& operator=(const RasterizerScanlineAntialias&);
 
-    RasterizerCellsAntiAlias outline_;
+    RasterizerOutline outline_;
+    RasterizerDenseCoverage dense_;
     RasterizerScanlineClip clipper_;
     int32_t gammar_[AA_SCALE];
     FillingRule fillingRule_;
@@ -219,6 +620,35 @@ private:
     int32_t startY_;
     uint32_t status_;
     int32_t scanY_;
+    RasterizerShapeFastPath shapes_;
+    PathRecord* records_;
+    uint32_t recordsCapacity_;
+    uint32_t numRecords_;
+    int32_t windowMinY_;
+    int32_t windowMaxY_;
+    int32_t pathMinX_;
+    int32_t pathMinY_;
+    int32_t pathMaxX_;
+    int32_t pathMaxY_;
+    int32_t tileMinY_;
+    int32_t tileHeight_;
+    int32_t tileBaseHeight_;
+    RasterizerTilingStats tilingStats_;
+    uint32_t denseAreaLimit_;
+    int32_t recordMinX_;
+    int32_t recordMinY_;
+    int32_t recordMaxX_;
+    int32_t recordMaxY_;
+    int32_t clipX1_;
+    int32_t clipY1_;
+    int32_t clipX2_;
+    int32_t clipY2_;
+    bool autoTiling_;
+    bool recordFailed_;
+    bool tiled_;
+    bool clipping_;
+    bool deferred_;
+    bool shapeRewound_;
 };
 } // namespace OHOS
 #endif
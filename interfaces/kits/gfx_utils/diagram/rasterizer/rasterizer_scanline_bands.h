@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file rasterizer_scanline_bands.h
+ * @brief Defines the band parallel rasterization stage
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_RASTERIZER_SCANLINE_BANDS_H
+#define GRAPHIC_LITE_RASTERIZER_SCANLINE_BANDS_H
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/diagram/scanline/scanline_storage.h"
+#include "gfx_utils/diagram/vertexprimitive/geometry_path_storage.h"
+#include "gfx_utils/heap_base.h"
+#include "graphic_semaphore.h"
+#include "graphic_thread.h"
+
+namespace OHOS {
+/**
+ * @class RasterizerScanlineBands
+ * @brief Rasterizes a shape in horizontal bands on several threads.
+ * The path is recorded once, then every band replays it into its own RasterizerScanlineAntialias
+ * that only keeps the cells of its rows, sorts and sweeps them.
+ * The first band is swept on the calling thread while the other bands are swept on workers
+ * into a band local ScanlineStorage in the packed form, so solid runs stay solid runs.
+ * A band whose scanlines can not be stored is rasterized again on the calling thread.
+ * SweepScanline delivers all scanlines from top to bottom and they cover the pixels
+ * of a single RasterizerScanlineAntialias with the same covers.
+ * It has the RewindScanlines/SweepScanline/GetMinX/GetMaxX interface of RasterizerScanlineAntialias.
+ * @since 1.0
+ * @version 1.0
+ */
+class RasterizerScanlineBands : public HeapBase {
+public:
+    /**
+     * @brief MAX_BANDS limits the worker threads,
+     * bands are not made thinner than MIN_BAND_HEIGHT rows.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum BandScale {
+        MAX_BANDS = 8,
+        MIN_BAND_HEIGHT = 32,
+        BAND_STACK_SIZE = 0x8000
+    };
+
+    /**
+     * @brief Construct the band rasterizer.
+     * @param maxBands Upper bound of the bands, 0 uses the number of CPU cores.
+     * @param cellBlockLimit Cell block limit of every band.
+     * @since 1.0
+     * @version 1.0
+     */
+    RasterizerScanlineBands(uint32_t maxBands = 0, uint32_t cellBlockLimit = 1 << 10);
+
+    ~RasterizerScanlineBands();
+
+    /**
+     * @brief Wait for the workers and drop the recorded path.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Reset();
+
+    void ResetClipping();
+    void ClipBox(float x1, float y1, float x2, float y2);
+
+    /**
+     * @brief Clip every band to the union of pixel rectangles, see RasterizerScanlineAntialias::ClipRegion.
+     * @return false if a band can not store the rectangles, all bands are then only clipped to
+     * their bounding box.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool ClipRegion(const Rect32* rects, uint32_t numRects);
+
+    void AddVertex(float x, float y, uint32_t cmd);
+
+    /**
+     * @brief Record the vertices of the vertex source, they are rasterized by RewindScanlines.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <typename VertexSource>
+    void AddPath(VertexSource& vs, uint32_t pathId = 0)
+    {
+        float x;
+        float y;
+
+        uint32_t cmd;
+        vs.Rewind(pathId);
+        while (!IsStop(cmd = vs.GenerateVertex(&x, &y))) {
+            AddVertex(x, y, cmd);
+        }
+    }
+
+    int32_t GetMinX() const
+    {
+        return bands_[0]->rasterizer.GetMinX();
+    }
+    int32_t GetMaxX() const
+    {
+        return bands_[0]->rasterizer.GetMaxX();
+    }
+    int32_t GetMinY() const
+    {
+        return minY_;
+    }
+    int32_t GetMaxY() const
+    {
+        return maxY_;
+    }
+
+    /**
+     * @brief Split the rows of the path into bands and start rasterizing them.
+     * @return false if the path has no edge.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool RewindScanlines();
+
+    /**
+     * @brief Deliver the next scanline, the bands are consumed in order
+     * and a band is only waited for when its first scanline is needed.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    bool SweepScanline(Scanline& sl);
+
+    /**
+     * @brief Number of bands used by the last RewindScanlines.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetNumBands() const
+    {
+        return numBands_;
+    }
+
+    uint32_t GetMaxBands() const
+    {
+        return maxBands_;
+    }
+
+private:
+    struct Band : public HeapBase {
+        explicit Band(uint32_t cellBlockLimit)
+            : rasterizer(cellBlockLimit), owner(nullptr), thread(nullptr), minY(0), maxY(0),
+              active(false), stored(false), failed(false), pending(false), quit(false) {}
+
+        RasterizerScanlineAntialias rasterizer;
+        GeometryScanlinePacked scanline;
+        ScanlineStorage storage;
+        GraphicSemaphore start;
+        GraphicSemaphore done;
+        RasterizerScanlineBands* owner;
+        ThreadId thread;
+        int32_t minY;
+        int32_t maxY;
+        bool active;
+        // The scanlines are replayed from storage, failed means they could not all be stored
+        bool stored;
+        bool failed;
+        bool pending;
+        bool quit;
+    };
+
+#ifdef _WIN32
+    static DWORD WINAPI BandWorker(LPVOID arg);
+#else
+    static void* BandWorker(void* arg);
+#endif
+
+    /**
+     * @brief Replay the recorded path into the band, and on workers sweep it into the band storage.
+     * A band that can not be stored is marked failed and swept from its rasterizer after
+     * SweepScanline rasterized it again.
+     * @since 1.0
+     * @version 1.0
+     */
+    void RasterizeBand(Band& band, bool store);
+    bool StartWorker(Band& band);
+    void WaitBands();
+
+    // Disable copying
+    RasterizerScanlineBands(const RasterizerScanlineBands&);
+    const RasterizerScanlineBands& operator=(const RasterizerScanlineBands&);
+
+    VertexBlockStorage vertices_;
+    Band* bands_[MAX_BANDS];
+    uint32_t maxBands_;
+    uint32_t numBands_;
+    uint32_t currBand_;
+    float clipX1_;
+    float clipY1_;
+    float clipX2_;
+    float clipY2_;
+    int32_t vertexMinY_;
+    int32_t vertexMaxY_;
+    int32_t minY_;
+    int32_t maxY_;
+    bool clipping_;
+    bool regionClipping_;
+    bool rewound_;
+};
+} // namespace OHOS
+#endif
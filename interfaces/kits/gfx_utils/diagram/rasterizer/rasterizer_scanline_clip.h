@@ -106,11 +106,19 @@ public:
           x1_(0),
           y1_(0),
           clippingFlags_(0),
-          clipping_(false) {}
+          region_(nullptr),
+          regionClipX_(nullptr),
+          regionCapacity_(0),
+          numRegionRects_(0),
+          clipping_(false),
+          regionClipping_(false) {}
+
+    ~RasterizerScanlineClip();
 
     void ResetClipping()
     {
         clipping_ = false;
+        regionClipping_ = false;
     }
 
     /**
@@ -123,6 +131,69 @@ public:
         clipBox_ = Rect32(left, top, right, bottom);
         clipBox_.Normalize();
         clipping_ = true;
+        regionClipping_ = false;
+    }
+
+    /**
+     * @brief Clip to the union of numRects pixel rectangles, whose right and bottom are inclusive.
+     * The path is clipped to their bounding box in 1 / 256 pixel units, and ClipScanline
+     * masks the swept scanlines against the rectangles.
+     * @return false if the rectangles can not be stored, the path is then only clipped to the bounding box.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool ClipRegion(const Rect32* rects, uint32_t numRects);
+
+    bool GetRegionClipping() const
+    {
+        return regionClipping_;
+    }
+
+    /**
+     * @brief The region rectangles sorted by top.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetRegion(const Rect32*& rects) const
+    {
+        rects = region_;
+        return regionClipping_ ? numRegionRects_ : 0;
+    }
+
+    /**
+     * @brief The clip box in 1 / 256 pixel units, for a region the bounding box of its rectangles.
+     * @since 1.0
+     * @version 1.0
+     */
+    const Rect32& GetClipBox() const
+    {
+        return clipBox_;
+    }
+
+    /**
+     * @brief Whether a region rectangle crosses the scanline y, the other scanlines are not swept.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool RegionCrosses(int32_t y) const
+    {
+        for (uint32_t i = 0; i < numRegionRects_ && region_[i].GetTop() <= y; i++) {
+            if (region_[i].GetBottom() >= y) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Keep the spans of the scanline y that are inside the region rectangles.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    void ClipScanline(int32_t y, Scanline& sl)
+    {
+        sl.ClipSpans(regionClipX_, MergeRegionRanges(y));
     }
 
     /**
@@ -154,12 +225,22 @@ public:
      *   1100  |  1000  | 1001
      *         |        |
      *   clip_box.x1  clip_box.x2
+     * Cells is RasterizerCellsAntiAlias or RasterizerCellsAntiAliasPacked.
      * @since 1.0
      * @version 1.0
      */
-    void LineTo(RasterizerCellsAntiAlias& ras, int32_t x2, int32_t y2);
+    template <class Cells>
+    void LineTo(Cells& ras, int32_t x2, int32_t y2);
 
 private:
+    /**
+     * @brief Merge the x ranges of the region rectangles crossing the scanline y into regionClipX_.
+     * @return the number of merged ranges.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t MergeRegionRanges(int32_t y);
+
     /**
      * @brief In the RASTERIZER process,Judge the mark according to the last clipping range
      * And the cutting range judgment flag this time,
@@ -167,15 +248,26 @@ private:
      * @since 1.0
      * @version 1.0
      */
-    inline void LineClipY(RasterizerCellsAntiAlias& ras,
+    template <class Cells>
+    inline void LineClipY(Cells& ras,
                           int32_t x1, int32_t y1,
                           int32_t x2, int32_t y2,
                           uint32_t clipFlagsOne, uint32_t clipFlagsTwo) const;
+
+    // Disable copying
+    RasterizerScanlineClip(const RasterizerScanlineClip&);
+    const RasterizerScanlineClip& operator=(const RasterizerScanlineClip&);
+
     Rect32 clipBox_;
     int32_t x1_;
     int32_t y1_;
     uint32_t clippingFlags_;
+    Rect32* region_;
+    int32_t* regionClipX_;
+    uint32_t regionCapacity_;
+    uint32_t numRegionRects_;
     bool clipping_;
+    bool regionClipping_;
 };
 } // namespace OHOS
 #endif
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file rasterizer_shape_fast_path.h
+ * @brief Defines the rectangle and rounded rectangle fast path of the scanline rasterizer
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_RASTERIZER_SHAPE_FAST_PATH_H
+#define GRAPHIC_LITE_RASTERIZER_SHAPE_FAST_PATH_H
+
+#include "gfx_utils/diagram/common/common_basics.h"
+
+namespace OHOS {
+class RasterizerScanlineAntialias;
+
+/**
+ * @brief Clipper operation in 1 / 256 pixel units, recorded by RasterizerScanlineAntialias.
+ * @since 1.0
+ * @version 1.0
+ */
+struct RasterizerPathRecord {
+    int32_t x;
+    int32_t y;
+    bool moveTo;
+};
+
+/**
+ * @class RasterizerShapeFastPath
+ * @brief Recognizes a path that is a single axis-aligned rectangle, or keeps a pixel aligned
+ * rounded rectangle, and sweeps it without cells. The rectangle rows are computed from its bounds,
+ * the corner rows of the rounded rectangle are copied from coverage masks of its four corners.
+ * The scanlines are the same as the ones of the outline rasterized as a path.
+ * @since 1.0
+ * @version 1.0
+ */
+class RasterizerShapeFastPath {
+public:
+    /**
+     * @brief Shape recognized by the rasterizer. SHAPE_RECT is a single axis-aligned rectangle,
+     * SHAPE_ROUNDED_RECT a pixel aligned rectangle added by AddRoundedRect.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum RasterizerShape {
+        SHAPE_PATH,
+        SHAPE_RECT,
+        SHAPE_ROUNDED_RECT
+    };
+
+    /**
+     * @brief The corner coverage masks of rounded rectangles are cached up to CORNER_MAX_RADIUS pixels,
+     * the quarter arcs have at most CORNER_MAX_SEGMENTS segments. A path of more than RECT_MAX_RECORDS
+     * clipper operations is not a rectangle.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum ShapeScale {
+        CORNER_MAX_RADIUS = 64,
+        CORNER_MAX_SEGMENTS = 32,
+        CORNER_COUNT = 4,
+        RECT_MAX_RECORDS = 6
+    };
+
+    RasterizerShapeFastPath();
+
+    ~RasterizerShapeFastPath();
+
+    /**
+     * @brief Forget the shape and the pending rounded rectangle, the corner masks are kept.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Reset()
+    {
+        shape_ = SHAPE_PATH;
+        pending_ = false;
+    }
+
+    void SetEnabled(bool enabled)
+    {
+        enabled_ = enabled;
+    }
+
+    bool GetEnabled() const
+    {
+        return enabled_;
+    }
+
+    /**
+     * @brief The clip box in 1 / 256 pixel units, a rectangle is clipped to it
+     * and a rounded rectangle is only kept when it lies inside.
+     * @since 1.0
+     * @version 1.0
+     */
+    void ClipBox(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+    {
+        clipX1_ = x1;
+        clipY1_ = y1;
+        clipX2_ = x2;
+        clipY2_ = y2;
+        clipping_ = true;
+    }
+
+    void ResetClipping()
+    {
+        clipping_ = false;
+    }
+
+    /**
+     * @brief Set the rounded rectangle in 1 / 256 pixel units, the radius is limited to half the shorter side.
+     * @param first Whether nothing else was added to the rasterizer before it.
+     * @return true if it is kept pending for the corner masks, false if its outline has to be rasterized.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool SetRoundedRect(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t radius, bool first);
+
+    /**
+     * @brief Whether a rounded rectangle is pending, it is no longer pending afterwards.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool TakePending()
+    {
+        bool pending = pending_;
+        pending_ = false;
+        return pending;
+    }
+
+    /**
+     * @brief The bounds and radius of the last rounded rectangle, or the bounds of the rectangle.
+     * @since 1.0
+     * @version 1.0
+     */
+    void GetBounds(int32_t& x1, int32_t& y1, int32_t& x2, int32_t& y2) const
+    {
+        x1 = x1_;
+        y1 = y1_;
+        x2 = x2_;
+        y2 = y2_;
+    }
+
+    int32_t GetRadius() const
+    {
+        return radius_;
+    }
+
+    /**
+     * @brief Sweep the pending rounded rectangle from the corner masks of its radius.
+     * @return false if the masks can not be allocated, its outline has to be rasterized then.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool StartRoundedRect(FillingRule fillingRule);
+
+    /**
+     * @brief A recorded path of one closed polygon with four alternating horizontal and vertical edges
+     * is a rectangle, its clipped bounds are kept instead of cells.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool DetectRect(const RasterizerPathRecord* records, uint32_t numRecords);
+
+    RasterizerShape GetShape() const
+    {
+        return shape_;
+    }
+
+    /**
+     * @brief The pixel bounds of the shape.
+     * @since 1.0
+     * @version 1.0
+     */
+    int32_t GetMinX() const
+    {
+        return x1_ >> POLY_SUBPIXEL_SHIFT;
+    }
+
+    int32_t GetMinY() const
+    {
+        return y1_ >> POLY_SUBPIXEL_SHIFT;
+    }
+
+    int32_t GetMaxX() const
+    {
+        return x2_ >> POLY_SUBPIXEL_SHIFT;
+    }
+
+    int32_t GetMaxY() const
+    {
+        return y2_ >> POLY_SUBPIXEL_SHIFT;
+    }
+
+    bool IsEmpty() const
+    {
+        return (x1_ >= x2_) || (y1_ >= y2_);
+    }
+
+    /**
+     * @brief Add the spans of row y of the shape to sl, the alpha is calculated by the rasterizer.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    void SweepScanline(Scanline& sl, int32_t y, const RasterizerScanlineAntialias& rasterizer) const;
+
+    /**
+     * @brief Offset of the point index of the arc of the corner from its center, in 1 / 256 pixel units.
+     * @since 1.0
+     * @version 1.0
+     */
+    static void CornerPoint(int32_t corner, int32_t radius, int32_t index, int32_t& x, int32_t& y);
+    static int32_t CornerSegments(int32_t radius);
+
+private:
+    RasterizerShapeFastPath(const RasterizerShapeFastPath&);
+    const RasterizerShapeFastPath& operator=(const RasterizerShapeFastPath&);
+
+    /**
+     * @brief Rasterize the four corners of the current radius into the corner masks,
+     * they are kept until the radius changes.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool BuildCornerMasks(FillingRule fillingRule);
+    template <class Scanline>
+    void SweepRect(Scanline& sl, int32_t y, const RasterizerScanlineAntialias& rasterizer) const;
+    template <class Scanline>
+    void SweepRoundedRect(Scanline& sl, int32_t y, const RasterizerScanlineAntialias& rasterizer) const;
+    template <class Scanline>
+    void AddMaskRow(Scanline& sl, const uint8_t* mask, int32_t x) const;
+
+    RasterizerShape shape_;
+    int32_t x1_;
+    int32_t y1_;
+    int32_t x2_;
+    int32_t y2_;
+    int32_t radius_;
+    int32_t clipX1_;
+    int32_t clipY1_;
+    int32_t clipX2_;
+    int32_t clipY2_;
+    uint8_t* cornerMasks_;
+    uint32_t cornerMasksCapacity_;
+    int32_t cornerRadius_;
+    bool clipping_;
+    bool enabled_;
+    bool pending_;
+};
+} // namespace OHOS
+#endif
@@ -147,6 +147,44 @@ public:
         lastScaneLineXCoord_ = x + spanLength - 1;
     }
 
+    /**
+     * Keep the covers inside the numClips ranges [clipX[2 * i], clipX[2 * i + 1]),
+     * the ranges are sorted and disjoint. Spans are cut at the range ends and dropped outside.
+     */
+    void ClipSpans(const int32_t* clipX, uint32_t numClips)
+    {
+        uint32_t numSpans = NumSpans();
+        if (numSpans == 0) {
+            return;
+        }
+        if (arrayClipSpans_.GetSize() < numSpans) {
+            arrayClipSpans_.Resize(arraySpans_.GetSize());
+        }
+        for (uint32_t i = 0; i < numSpans; i++) {
+            arrayClipSpans_[i] = arraySpans_[i + 1];
+        }
+        curSpanBlock_ = &arraySpans_[0];
+        lastScaneLineXCoord_ = 0x7FFFFFF0;
+        uint32_t clip = 0;
+        for (uint32_t i = 0; i < numSpans; i++) {
+            const SpanBlock& span = arrayClipSpans_[i];
+            int32_t x = span.x;
+            int32_t end = x + span.spanLength;
+            while (clip < numClips && clipX[clip * 2 + 1] <= x) { // 2: start and end of a range
+                clip++;
+            }
+            for (uint32_t c = clip; c < numClips && clipX[c * 2] < end; c++) { // 2: start and end of a range
+                int32_t from = (clipX[c * 2] > x) ? clipX[c * 2] : x; // 2: start and end of a range
+                int32_t to = (clipX[c * 2 + 1] < end) ? clipX[c * 2 + 1] : end; // 2: start and end of a range
+                curSpanBlock_++;
+                curSpanBlock_->x = static_cast<int16_t>(from);
+                curSpanBlock_->spanLength = static_cast<int16_t>(to - from);
+                curSpanBlock_->covers = span.covers + (from - x);
+                lastScaneLineXCoord_ = to - 1 - minScaneLineXCoord_;
+            }
+        }
+    }
+
     /**
      * End operation
      */
@@ -187,6 +225,7 @@ private:
     int32_t scaneLineYCoord_;
     GeometryPlainDataArray<uint8_t> arrayCovers_;
     GeometryPlainDataArray<SpanBlock> arraySpans_;
+    GeometryPlainDataArray<SpanBlock> arrayClipSpans_;
     SpanBlock* curSpanBlock_;
 };
 } // namespace OHOS
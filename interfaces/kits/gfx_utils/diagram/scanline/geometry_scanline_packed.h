@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file geometry_scanline_packed.h
+ *
+ * @brief The packed scanline container. Like GeometryScanline it holds the horizontal, disjoint spans
+ * of one scanline sorted by x, but a solid run of pixels with the same coverage keeps a single cover.
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_GEOMETRY_SCANLINE_PACKED_H
+#define GRAPHIC_LITE_GEOMETRY_SCANLINE_PACKED_H
+
+#include "gfx_utils/diagram/vertexprimitive/geometry_plaindata_array.h"
+#include "gfx_utils/graphic_log.h"
+#include "securec.h"
+namespace OHOS {
+/**
+ * @class GeometryScanlinePacked
+ * @brief Packed scanline container with the iteration API of GeometryScanline.
+ * A span with a positive spanLength has one cover per pixel, the cells at the edges of a polygon.
+ * A span with a negative spanLength is a solid run of -spanLength pixels that all have the single
+ * cover at covers, so the inside of large fills is neither written nor read pixel by pixel.
+ * @since 1.0
+ * @version 1.0
+ */
+class GeometryScanlinePacked {
+public:
+    struct SpanBlock {
+        int16_t x;
+        int16_t spanLength;
+        uint8_t* covers;
+    };
+    using Iterator = SpanBlock* ;
+    using ConstIterator = const SpanBlock* ;
+    GeometryScanlinePacked() : lastScaneLineXCoord_(0x7FFFFFF0), scaneLineYCoord_(0),
+                               curCover_(nullptr), curSpanBlock_(nullptr) {}
+
+    /**
+     * Prepare the scanline for the spans of [minX, maxX]. A solid run stores one cover,
+     * so the covers of a scanline never exceed its width.
+     */
+    void Reset(int32_t minX, int32_t maxX)
+    {
+        const int32_t liftNumber = 3;
+        uint32_t maxLen = maxX - minX + liftNumber;
+        if (maxLen > arraySpans_.GetSize()) {
+            arraySpans_.Resize(maxLen);
+            arrayCovers_.Resize(maxLen);
+        }
+        ResetSpans();
+    }
+
+    /**
+     * Add one cell, it extends the previous span when that one ends at x - 1 and has cells.
+     */
+    void AddCell(int32_t x, uint32_t cover)
+    {
+        *curCover_ = static_cast<uint8_t>(cover);
+        if (x == lastScaneLineXCoord_ + 1 && curSpanBlock_->spanLength > 0) {
+            curSpanBlock_->spanLength++;
+        } else {
+            curSpanBlock_++;
+            curSpanBlock_->x = static_cast<int16_t>(x);
+            curSpanBlock_->spanLength = 1;
+            curSpanBlock_->covers = curCover_;
+        }
+        curCover_++;
+        lastScaneLineXCoord_ = x;
+    }
+
+    /**
+     * Add cellLength cells with their own covers.
+     */
+    void AddCells(int32_t x, uint32_t cellLength, const uint8_t* covers)
+    {
+        if (memcpy_s(curCover_, cellLength * sizeof(uint8_t), covers, cellLength * sizeof(uint8_t)) != EOK) {
+            GRAPHIC_LOGE("AddCells fail");
+            return;
+        }
+        if (x == lastScaneLineXCoord_ + 1 && curSpanBlock_->spanLength > 0) {
+            curSpanBlock_->spanLength += static_cast<int16_t>(cellLength);
+        } else {
+            curSpanBlock_++;
+            curSpanBlock_->x = static_cast<int16_t>(x);
+            curSpanBlock_->spanLength = static_cast<int16_t>(cellLength);
+            curSpanBlock_->covers = curCover_;
+        }
+        curCover_ += cellLength;
+        lastScaneLineXCoord_ = x + cellLength - 1;
+    }
+
+    /**
+     * Add a solid run of spanLength pixels with one cover, it extends the previous span
+     * when that one is a solid run of the same cover ending at x - 1.
+     */
+    void AddSpan(int32_t x, uint32_t spanLength, uint32_t cover)
+    {
+        if (x == lastScaneLineXCoord_ + 1 && curSpanBlock_->spanLength < 0 && *curSpanBlock_->covers == cover) {
+            curSpanBlock_->spanLength -= static_cast<int16_t>(spanLength);
+        } else {
+            *curCover_ = static_cast<uint8_t>(cover);
+            curSpanBlock_++;
+            curSpanBlock_->x = static_cast<int16_t>(x);
+            curSpanBlock_->spanLength = -static_cast<int16_t>(spanLength);
+            curSpanBlock_->covers = curCover_++;
+        }
+        lastScaneLineXCoord_ = x + spanLength - 1;
+    }
+
+    /**
+     * Keep the covers inside the numClips ranges [clipX[2 * i], clipX[2 * i + 1]),
+     * the ranges are sorted and disjoint. Spans are cut at the range ends and dropped outside,
+     * a cut solid run keeps its single cover.
+     */
+    void ClipSpans(const int32_t* clipX, uint32_t numClips)
+    {
+        uint32_t numSpans = NumSpans();
+        if (numSpans == 0) {
+            return;
+        }
+        if (arrayClipSpans_.GetSize() < numSpans) {
+            arrayClipSpans_.Resize(arraySpans_.GetSize());
+        }
+        for (uint32_t i = 0; i < numSpans; i++) {
+            arrayClipSpans_[i] = arraySpans_[i + 1];
+        }
+        curSpanBlock_ = &arraySpans_[0];
+        lastScaneLineXCoord_ = 0x7FFFFFF0;
+        uint32_t clip = 0;
+        for (uint32_t i = 0; i < numSpans; i++) {
+            const SpanBlock& span = arrayClipSpans_[i];
+            bool solid = span.spanLength < 0;
+            int32_t x = span.x;
+            int32_t end = x + (solid ? -span.spanLength : span.spanLength);
+            while (clip < numClips && clipX[clip * 2 + 1] <= x) { // 2: start and end of a range
+                clip++;
+            }
+            for (uint32_t c = clip; c < numClips && clipX[c * 2] < end; c++) { // 2: start and end of a range
+                int32_t from = (clipX[c * 2] > x) ? clipX[c * 2] : x; // 2: start and end of a range
+                int32_t to = (clipX[c * 2 + 1] < end) ? clipX[c * 2 + 1] : end; // 2: start and end of a range
+                curSpanBlock_++;
+                curSpanBlock_->x = static_cast<int16_t>(from);
+                curSpanBlock_->spanLength = static_cast<int16_t>(solid ? from - to : to - from);
+                curSpanBlock_->covers = solid ? span.covers : span.covers + (from - x);
+                lastScaneLineXCoord_ = to - 1;
+            }
+        }
+    }
+
+    /**
+     * End operation
+     */
+    void Finalize(int32_t y)
+    {
+        scaneLineYCoord_ = y;
+    }
+    void ResetSpans()
+    {
+        lastScaneLineXCoord_ = 0x7FFFFFF0;
+        curCover_ = arrayCovers_.Data();
+        curSpanBlock_ = arraySpans_.Data();
+        if (curSpanBlock_ != nullptr) {
+            curSpanBlock_->spanLength = 0;
+        }
+    }
+
+    int32_t GetYLevel() const
+    {
+        return scaneLineYCoord_;
+    }
+    uint32_t NumSpans() const
+    {
+        return uint32_t(curSpanBlock_ - &arraySpans_[0]);
+    }
+    ConstIterator Begin() const
+    {
+        return &arraySpans_[1];
+    }
+    Iterator Begin()
+    {
+        return &arraySpans_[1];
+    }
+
+private:
+    GeometryScanlinePacked(const GeometryScanlinePacked&);
+    const GeometryScanlinePacked& operator=(const GeometryScanlinePacked&);
+
+private:
+    int32_t lastScaneLineXCoord_;
+    int32_t scaneLineYCoord_;
+    GeometryPlainDataArray<uint8_t> arrayCovers_;
+    GeometryPlainDataArray<SpanBlock> arraySpans_;
+    GeometryPlainDataArray<SpanBlock> arrayClipSpans_;
+    uint8_t* curCover_;
+    SpanBlock* curSpanBlock_;
+};
+} // namespace OHOS
+#endif
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file scanline_alpha_mask.h
+ * @brief Defines the A8 alpha mask and the scanline adaptor that applies it
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_SCANLINE_ALPHA_MASK_H
+#define GRAPHIC_LITE_SCANLINE_ALPHA_MASK_H
+
+#include "gfx_utils/diagram/scanline/geometry_scanline.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline_packed.h"
+#include "gfx_utils/heap_base.h"
+
+namespace OHOS {
+/**
+ * @class AlphaMaskBuffer
+ * @brief An 8 bit alpha mask, one byte per pixel. The mask owns its pixels after Resize,
+ * or uses the pixels of an other buffer after Attach. Pixels outside the mask are 0.
+ * @since 1.0
+ * @version 1.0
+ */
+class AlphaMaskBuffer : public HeapBase {
+public:
+    AlphaMaskBuffer();
+
+    ~AlphaMaskBuffer();
+
+    /**
+     * @brief Allocate a cleared mask of width x height pixels, the pixels are reused when they are large enough.
+     * @return false if the pixels can not be allocated or do not fit 32 bits, the mask is then empty.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool Resize(int32_t width, int32_t height);
+
+    /**
+     * @brief Use the pixels of an other buffer, stride is the number of bytes of a row.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Attach(uint8_t* data, int32_t width, int32_t height, int32_t stride);
+
+    void Clear(uint8_t value);
+
+    int32_t GetWidth() const
+    {
+        return width_;
+    }
+    int32_t GetHeight() const
+    {
+        return height_;
+    }
+    int32_t GetStride() const
+    {
+        return stride_;
+    }
+
+    uint8_t* GetRow(int32_t y)
+    {
+        return data_ + y * stride_;
+    }
+    const uint8_t* GetRow(int32_t y) const
+    {
+        return data_ + y * stride_;
+    }
+
+    uint8_t GetPixel(int32_t x, int32_t y) const
+    {
+        return (x >= 0 && x < width_ && y >= 0 && y < height_) ? data_[y * stride_ + x] : 0;
+    }
+
+    /**
+     * @brief Write the covers of a shape into the mask, the pixels outside its spans are kept.
+     * Source is a scanline source such as RasterizerScanlineAntialias, ScanlineStorage or ScanlineBoolean.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Source>
+    void AddShape(Source& source)
+    {
+        AddShape(source, 0, 0);
+    }
+
+    /**
+     * @brief Write the covers of a shape into the mask, the pixel (originX, originY) of the shape
+     * becomes the top left pixel of the mask.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Source>
+    void AddShape(Source& source, int32_t originX, int32_t originY)
+    {
+        if (data_ == nullptr || !source.RewindScanlines()) {
+            return;
+        }
+        scanline_.Reset(source.GetMinX(), source.GetMaxX());
+        while (source.SweepScanline(scanline_)) {
+            AddScanline(scanline_, originX, originY);
+        }
+    }
+
+    /**
+     * @brief Multiply len covers of the row y starting at x with the mask, cover * mask / 255.
+     * @since 1.0
+     * @version 1.0
+     */
+    void MaskCovers(int32_t x, int32_t y, uint8_t* covers, uint32_t len) const;
+
+    /**
+     * @brief The cover times mask kernel, vectorized with NEON or SSE2.
+     * @since 1.0
+     * @version 1.0
+     */
+    static void MultiplyCovers(uint8_t* covers, const uint8_t* mask, uint32_t len);
+
+private:
+    void AddScanline(const GeometryScanlinePacked& sl, int32_t originX, int32_t originY);
+
+    // Disable copying
+    AlphaMaskBuffer(const AlphaMaskBuffer&);
+    const AlphaMaskBuffer& operator=(const AlphaMaskBuffer&);
+
+    uint8_t* data_;
+    uint8_t* ownData_;
+    uint32_t ownSize_;
+    int32_t width_;
+    int32_t height_;
+    int32_t stride_;
+    GeometryScanlinePacked scanline_;
+};
+
+/**
+ * @class ScanlineAlphaMask
+ * @brief Renders a scanline source through an AlphaMaskBuffer, the covers of every span are multiplied
+ * with the mask row before they reach the blender. A GeometryScanline is masked in place,
+ * a GeometryScanlinePacked receives the masked covers without the runs that the mask hides.
+ * It has the RewindScanlines/SweepScanline/GetMinX/GetMaxX interface of RasterizerScanlineAntialias.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Source>
+class ScanlineAlphaMask : public HeapBase {
+public:
+    ScanlineAlphaMask(Source& source, const AlphaMaskBuffer& mask) : source_(source), mask_(mask) {}
+
+    int32_t GetMinX() const
+    {
+        return source_.GetMinX();
+    }
+    int32_t GetMaxX() const
+    {
+        return source_.GetMaxX();
+    }
+
+    bool RewindScanlines()
+    {
+        if (!source_.RewindScanlines()) {
+            return false;
+        }
+        scanline_.Reset(source_.GetMinX(), source_.GetMaxX());
+        return true;
+    }
+
+    /**
+     * @brief Deliver the next scanline of the source inside the rows of the mask, masked in place.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool SweepScanline(GeometryScanline& sl)
+    {
+        while (source_.SweepScanline(sl)) {
+            int32_t y = sl.GetYLevel();
+            if (y < 0 || y >= mask_.GetHeight()) {
+                continue;
+            }
+            uint32_t numSpans = sl.NumSpans();
+            GeometryScanline::Iterator span = sl.Begin();
+            for (; numSpans; --numSpans, ++span) {
+                mask_.MaskCovers(span->x, y, span->covers, span->spanLength);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Deliver the next scanline of the source inside the rows of the mask,
+     * masked and without the pixels that end up with cover 0.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool SweepScanline(GeometryScanlinePacked& sl)
+    {
+        while (SweepScanline(scanline_)) {
+            sl.ResetSpans();
+            uint32_t numSpans = scanline_.NumSpans();
+            GeometryScanline::ConstIterator span = scanline_.Begin();
+            for (; numSpans; --numSpans, ++span) {
+                AddNonZero(sl, span->x, span->covers, span->spanLength);
+            }
+            if (sl.NumSpans()) {
+                sl.Finalize(scanline_.GetYLevel());
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static void AddNonZero(GeometryScanlinePacked& sl, int32_t x, const uint8_t* covers, int32_t len)
+    {
+        int32_t start = 0;
+        while (start < len) {
+            while (start < len && covers[start] == 0) {
+                start++;
+            }
+            int32_t end = start;
+            while (end < len && covers[end] != 0) {
+                end++;
+            }
+            if (end > start) {
+                sl.AddCells(x + start, end - start, covers + start);
+            }
+            start = end;
+        }
+    }
+
+    // Disable copying
+    ScanlineAlphaMask(const ScanlineAlphaMask&);
+    const ScanlineAlphaMask& operator=(const ScanlineAlphaMask&);
+
+    Source& source_;
+    const AlphaMaskBuffer& mask_;
+    GeometryScanline scanline_;
+};
+} // namespace OHOS
+#endif
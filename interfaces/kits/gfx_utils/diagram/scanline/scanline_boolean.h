@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file scanline_boolean.h
+ * @brief Defines the boolean operations of two scanline shapes
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_SCANLINE_BOOLEAN_H
+#define GRAPHIC_LITE_SCANLINE_BOOLEAN_H
+
+#include "gfx_utils/diagram/scanline/geometry_scanline.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline_packed.h"
+#include "gfx_utils/graphic_math.h"
+#include "gfx_utils/heap_base.h"
+
+namespace OHOS {
+/**
+ * @brief The boolean operations of two shapes A and B, BOOL_DIFFERENCE is A minus B.
+ * @since 1.0
+ * @version 1.0
+ */
+enum ScanlineBooleanOp {
+    BOOL_INTERSECT,
+    BOOL_UNION,
+    BOOL_XOR,
+    BOOL_DIFFERENCE
+};
+
+/**
+ * @class ScanlineBooleanBase
+ * @brief Combines one row of two packed scanlines span by span. Where only one shape has spans
+ * they are copied or dropped, where both have a solid run the covers are combined once,
+ * so the cost follows the edges rather than the area.
+ * @since 1.0
+ * @version 1.0
+ */
+class ScanlineBooleanBase : public HeapBase {
+public:
+    /**
+     * @brief The cover of a pixel covered by c1 in A and c2 in B.
+     * @since 1.0
+     * @version 1.0
+     */
+    static uint32_t CombineCovers(ScanlineBooleanOp op, uint32_t c1, uint32_t c2);
+
+    /**
+     * @brief Add the combined spans of a and b to sl, a row missing in a shape has no spans.
+     * Scanline is GeometryScanline or GeometryScanlinePacked.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    static void CombineRow(ScanlineBooleanOp op,
+                           GeometryScanlinePacked::ConstIterator a, uint32_t numA,
+                           GeometryScanlinePacked::ConstIterator b, uint32_t numB, Scanline& sl);
+
+private:
+    enum CoverScale {
+        COVER_SHIFT = 8,
+        COVER_MASK = 255
+    };
+
+    /**
+     * @brief The part of a span from x1 to x2 that is being combined.
+     * @since 1.0
+     * @version 1.0
+     */
+    struct SpanPiece {
+        int32_t x;
+        int32_t end;
+        int32_t spanX;
+        const uint8_t* covers;
+        bool solid;
+    };
+
+    static void StartPiece(GeometryScanlinePacked::ConstIterator span, SpanPiece& piece);
+
+    template <class Scanline>
+    static void AddPiece(const SpanPiece& piece, int32_t end, Scanline& sl);
+
+    template <class Scanline>
+    static void AddBoth(ScanlineBooleanOp op, const SpanPiece& a, const SpanPiece& b, int32_t end, Scanline& sl);
+};
+
+/**
+ * @class ScanlineBoolean
+ * @brief Combines the scanlines of two shapes with a boolean operation, row by row.
+ * Source1 and Source2 are scanline sources such as RasterizerScanlineAntialias or ScanlineStorage.
+ * It has the RewindScanlines/SweepScanline/GetMinX/GetMaxX interface of RasterizerScanlineAntialias,
+ * so it can be rendered, recorded into a ScanlineStorage or combined again.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Source1, class Source2>
+class ScanlineBoolean : public ScanlineBooleanBase {
+public:
+    ScanlineBoolean(Source1& source1, Source2& source2, ScanlineBooleanOp op)
+        : source1_(source1), source2_(source2), op_(op), minX_(0), maxX_(-1), has1_(false), has2_(false) {}
+
+    void SetOperation(ScanlineBooleanOp op)
+    {
+        op_ = op;
+    }
+
+    ScanlineBooleanOp GetOperation() const
+    {
+        return op_;
+    }
+
+    int32_t GetMinX() const
+    {
+        return minX_;
+    }
+    int32_t GetMaxX() const
+    {
+        return maxX_;
+    }
+
+    /**
+     * @brief Rewind both sources.
+     * @return false if the result has no scanline for certain.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool RewindScanlines()
+    {
+        has1_ = source1_.RewindScanlines();
+        has2_ = source2_.RewindScanlines();
+        if (has1_) {
+            scanline1_.Reset(source1_.GetMinX(), source1_.GetMaxX());
+            has1_ = source1_.SweepScanline(scanline1_);
+        }
+        if (has2_) {
+            scanline2_.Reset(source2_.GetMinX(), source2_.GetMaxX());
+            has2_ = source2_.SweepScanline(scanline2_);
+        }
+        if (op_ == BOOL_INTERSECT) {
+            has1_ = has1_ && has2_;
+            has2_ = has1_;
+            minX_ = MATH_MAX(source1_.GetMinX(), source2_.GetMinX());
+            maxX_ = MATH_MIN(source1_.GetMaxX(), source2_.GetMaxX());
+            return has1_ && minX_ <= maxX_;
+        }
+        if (op_ == BOOL_DIFFERENCE || !has2_) {
+            minX_ = source1_.GetMinX();
+            maxX_ = source1_.GetMaxX();
+            has2_ = has2_ && has1_;
+            return has1_;
+        }
+        if (!has1_) {
+            minX_ = source2_.GetMinX();
+            maxX_ = source2_.GetMaxX();
+            return has2_;
+        }
+        minX_ = MATH_MIN(source1_.GetMinX(), source2_.GetMinX());
+        maxX_ = MATH_MAX(source1_.GetMaxX(), source2_.GetMaxX());
+        return true;
+    }
+
+    /**
+     * @brief Deliver the next combined scanline, rows of one shape only are combined with an empty row.
+     * Scanline is GeometryScanline or GeometryScanlinePacked.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    bool SweepScanline(Scanline& sl)
+    {
+        while (has1_ || has2_) {
+            if ((op_ == BOOL_INTERSECT && !(has1_ && has2_)) || (op_ == BOOL_DIFFERENCE && !has1_)) {
+                break;
+            }
+            int32_t y1 = has1_ ? scanline1_.GetYLevel() : INT32_MAX;
+            int32_t y2 = has2_ ? scanline2_.GetYLevel() : INT32_MAX;
+            int32_t y = MATH_MIN(y1, y2);
+            bool row1 = (y1 == y);
+            bool row2 = (y2 == y);
+            sl.ResetSpans();
+            CombineRow(op_, scanline1_.Begin(), row1 ? scanline1_.NumSpans() : 0,
+                       scanline2_.Begin(), row2 ? scanline2_.NumSpans() : 0, sl);
+            if (row1) {
+                has1_ = source1_.SweepScanline(scanline1_);
+            }
+            if (row2) {
+                has2_ = source2_.SweepScanline(scanline2_);
+            }
+            if (sl.NumSpans()) {
+                sl.Finalize(y);
+                return true;
+            }
+        }
+        has1_ = false;
+        has2_ = false;
+        return false;
+    }
+
+private:
+    // Disable copying
+    ScanlineBoolean(const ScanlineBoolean&);
+    const ScanlineBoolean& operator=(const ScanlineBoolean&);
+
+    Source1& source1_;
+    Source2& source2_;
+    ScanlineBooleanOp op_;
+    GeometryScanlinePacked scanline1_;
+    GeometryScanlinePacked scanline2_;
+    int32_t minX_;
+    int32_t maxX_;
+    bool has1_;
+    bool has2_;
+};
+} // namespace OHOS
+#endif
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file scanline_storage.h
+ * @brief Defines the storage of the swept scanlines of a shape
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_SCANLINE_STORAGE_H
+#define GRAPHIC_LITE_SCANLINE_STORAGE_H
+
+#include "gfx_utils/diagram/scanline/geometry_scanline.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline_packed.h"
+#include "gfx_utils/heap_base.h"
+
+namespace OHOS {
+/**
+ * @class ScanlineStorage
+ * @brief Records the scanlines of a shape once so that they can be replayed, moved, queried and saved.
+ * The covers of all scanlines share one contiguous arena, rows index their spans and spans index
+ * their covers, a span whose covers are all equal keeps a single cover.
+ * Replaying has the RewindScanlines/SweepScanline/GetMinX/GetMaxX interface of RasterizerScanlineAntialias,
+ * the offset moves the replayed scanlines, for example for a shadow.
+ * @since 1.0
+ * @version 1.0
+ */
+class ScanlineStorage : public HeapBase {
+public:
+    ScanlineStorage();
+
+    ~ScanlineStorage();
+
+    /**
+     * @brief Drop the recorded scanlines, the capacity and the offset are kept.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Reset();
+
+    /**
+     * @brief Append one swept scanline, scanlines are appended from top to bottom.
+     * Scanline is GeometryScanline or GeometryScanlinePacked.
+     * @return false if the scanline is above the last one or can not be stored.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    bool AddScanline(const Scanline& sl);
+
+    /**
+     * @brief Reset the storage and record all scanlines of the rasterizer.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Rasterizer>
+    bool Record(Rasterizer& rasterizer)
+    {
+        Reset();
+        if (!rasterizer.RewindScanlines()) {
+            return true;
+        }
+        scanline_.Reset(rasterizer.GetMinX(), rasterizer.GetMaxX());
+        while (rasterizer.SweepScanline(scanline_)) {
+            if (!AddScanline(scanline_)) {
+                Reset();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Replace the scanlines and the offset with the ones of source, a storage that was empty
+     * gets exactly the capacity the scanlines need.
+     * @return false if they can not be stored, the storage is then empty.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool CopyFrom(const ScanlineStorage& source);
+
+    /**
+     * @brief Move the replayed scanlines, the bounds and GetCover by dx and dy pixels.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetOffset(int32_t dx, int32_t dy)
+    {
+        offsetX_ = dx;
+        offsetY_ = dy;
+    }
+
+    int32_t GetOffsetX() const
+    {
+        return offsetX_;
+    }
+    int32_t GetOffsetY() const
+    {
+        return offsetY_;
+    }
+
+    /**
+     * @brief The bounding box of the covered pixels, moved by the offset.
+     * @since 1.0
+     * @version 1.0
+     */
+    int32_t GetMinX() const
+    {
+        return minX_ + offsetX_;
+    }
+    int32_t GetMaxX() const
+    {
+        return maxX_ + offsetX_;
+    }
+    int32_t GetMinY() const
+    {
+        return (numRows_ > 0) ? rows_[0].y + offsetY_ : offsetY_;
+    }
+    int32_t GetMaxY() const
+    {
+        return (numRows_ > 0) ? rows_[numRows_ - 1].y + offsetY_ : offsetY_ - 1;
+    }
+
+    bool IsEmpty() const
+    {
+        return numRows_ == 0;
+    }
+    uint32_t GetNumRows() const
+    {
+        return numRows_;
+    }
+
+    /**
+     * @brief Start replaying the scanlines.
+     * @return false if there is no scanline.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool RewindScanlines()
+    {
+        currRow_ = 0;
+        return numRows_ > 0;
+    }
+
+    /**
+     * @brief Deliver the next scanline moved by the offset, Scanline is GeometryScanline or GeometryScanlinePacked.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    bool SweepScanline(Scanline& sl);
+
+    /**
+     * @brief The cover of the pixel x, y, moved by the offset, 0 outside the shape.
+     * Rows and spans are binary searched, so hit testing does not replay the shape.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint8_t GetCover(int32_t x, int32_t y) const;
+
+    /**
+     * @brief Size in bytes of the serialized scanlines.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetSerializedSize() const;
+
+    /**
+     * @brief Write the scanlines without the offset into data, in the byte order of the device.
+     * @return false if size is smaller than GetSerializedSize.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool Serialize(uint8_t* data, uint32_t size) const;
+
+    /**
+     * @brief Replace the scanlines with the ones written by Serialize, the data is checked before it is used.
+     * @return false if the data is not valid, the storage is then empty.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool Deserialize(const uint8_t* data, uint32_t size);
+
+private:
+    struct StorageRow {
+        int32_t y;
+        uint32_t firstSpan;
+        uint32_t numSpans;
+    };
+
+    /**
+     * @brief A negative spanLength is a run of -spanLength pixels with the single cover at coverIndex.
+     * @since 1.0
+     * @version 1.0
+     */
+    struct StorageSpan {
+        int32_t x;
+        int32_t spanLength;
+        uint32_t coverIndex;
+    };
+
+    struct StorageHeader {
+        uint32_t magic;
+        uint32_t numRows;
+        uint32_t numSpans;
+        uint32_t numCovers;
+        int32_t minX;
+        int32_t maxX;
+    };
+
+    /**
+     * @brief Replayed spans have the 16 bit X and length of the scanlines, so the bounds must fit 16 bits
+     * and a row is at most SCANLINE_MAX_WIDTH pixels wide.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum StorageScale {
+        STORAGE_MAGIC = 0x534C5354,
+        SCANLINE_MAX_WIDTH = INT16_MAX
+    };
+
+    bool CheckStorage() const;
+
+    template <class T>
+    static bool ReserveStorage(T*& data, uint32_t& capacity, uint32_t used, uint32_t size);
+
+    // Disable copying
+    ScanlineStorage(const ScanlineStorage&);
+    const ScanlineStorage& operator=(const ScanlineStorage&);
+
+    StorageRow* rows_;
+    uint32_t rowsCapacity_;
+    uint32_t numRows_;
+    StorageSpan* spans_;
+    uint32_t spansCapacity_;
+    uint32_t numSpans_;
+    uint8_t* covers_;
+    uint32_t coversCapacity_;
+    uint32_t numCovers_;
+    uint32_t currRow_;
+    int32_t minX_;
+    int32_t maxX_;
+    int32_t offsetX_;
+    int32_t offsetY_;
+    GeometryScanlinePacked scanline_;
+};
+} // namespace OHOS
+#endif
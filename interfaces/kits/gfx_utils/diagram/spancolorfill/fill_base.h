@@ -24,6 +24,8 @@
 #define GRAPHIC_LITE_FILL_BASE_H
 #include "gfx_utils/color.h"
 #include "gfx_utils/diagram/vertexprimitive/geometry_plaindata_array.h"
+#include "gfx_utils/graphic_log.h"
+#include "gfx_utils/heap_base.h"
 namespace OHOS {
 class FillBase {
 public:
@@ -52,6 +54,77 @@ private:
     GeometryPlainDataArray<Rgba8T> spans_;
 };
 
+/**
+ * @class SpanScratchArena
+ * @brief The color buffers that span generators borrow while they generate a span, one arena serves
+ * a render pass. Buffers are borrowed and released last in first out, a generator releases what it
+ * borrowed before it returns, so nested generators share the buffers. A buffer only grows,
+ * once the longest span has been seen nothing is allocated anymore.
+ * @since 1.0
+ * @version 1.0
+ */
+class SpanScratchArena : public HeapBase {
+public:
+    enum ArenaScale {
+        MAX_SCRATCH_BUFFERS = 8
+    };
+
+    SpanScratchArena() : numBorrowed_(0) {}
+
+    /**
+     * @brief Borrow a buffer of at least len colors.
+     * @return nullptr if all buffers are borrowed or the buffer can not grow.
+     * @since 1.0
+     * @version 1.0
+     */
+    Rgba8T* Borrow(uint32_t len)
+    {
+        if (numBorrowed_ >= MAX_SCRATCH_BUFFERS) {
+            GRAPHIC_LOGE("SpanScratchArena::Borrow all buffers are borrowed\n");
+            return nullptr;
+        }
+        Rgba8T* colors = buffers_[numBorrowed_].Resize(len);
+        if (colors == nullptr) {
+            return nullptr;
+        }
+        numBorrowed_++;
+        return colors;
+    }
+
+    /**
+     * @brief Release the count buffers borrowed last.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Release(uint32_t count)
+    {
+        numBorrowed_ = (count < numBorrowed_) ? numBorrowed_ - count : 0;
+    }
+
+    /**
+     * @brief Release all buffers at the start of a render pass, their memory is kept.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Reset()
+    {
+        numBorrowed_ = 0;
+    }
+
+    uint32_t GetNumBorrowed() const
+    {
+        return numBorrowed_;
+    }
+
+private:
+    // Disable copying
+    SpanScratchArena(const SpanScratchArena&);
+    const SpanScratchArena& operator=(const SpanScratchArena&);
+
+    FillBase buffers_[MAX_SCRATCH_BUFFERS];
+    uint32_t numBorrowed_;
+};
+
 class SpanBase {
 public:
     virtual void Prepare() = 0;
@@ -75,13 +148,46 @@ private:
     Rgba8T color_;
 };
 
+/**
+ * @class SpanBlendColor
+ * @brief Adds the colors of two span generators, saturated channel by channel. The colors of the
+ * generators are borrowed from the arena of the render pass, or from an arena of its own that is
+ * created on the first span. If no buffer can be borrowed the span is blended pixel by pixel.
+ * @since 1.0
+ * @version 1.0
+ */
 class SpanBlendColor : public SpanBase {
 public:
     SpanBlendColor(SpanBase& spanGenerator1, SpanBase& spanGenerator2)
         : spanGenerator1_(spanGenerator1),
-          spanGenerator2_(spanGenerator2)
+          spanGenerator2_(spanGenerator2),
+          arena_(nullptr),
+          ownArena_(nullptr)
+    {
+    }
+    SpanBlendColor(SpanBase& spanGenerator1, SpanBase& spanGenerator2, SpanScratchArena& arena)
+        : spanGenerator1_(spanGenerator1),
+          spanGenerator2_(spanGenerator2),
+          arena_(&arena),
+          ownArena_(nullptr)
+    {
+    }
+    /**
+     * @brief A copy shares the arena of the render pass, but not the arena of its own.
+     * @since 1.0
+     * @version 1.0
+     */
+    SpanBlendColor(const SpanBlendColor& other)
+        : spanGenerator1_(other.spanGenerator1_),
+          spanGenerator2_(other.spanGenerator2_),
+          arena_((other.arena_ != other.ownArena_) ? other.arena_ : nullptr),
+          ownArena_(nullptr)
     {
     }
+    ~SpanBlendColor()
+    {
+        delete ownArena_;
+    }
     void Prepare()
     {
         spanGenerator1_.Prepare();
@@ -89,29 +195,55 @@ public:
     }
     void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
     {
-        FillBase allocator1;
-        FillBase allocator2;
-
-        Rgba8T* colors1 = allocator1.Resize(len);
-        Rgba8T* colors2 = allocator2.Resize(len);
-
+        if (arena_ == nullptr) {
+            arena_ = ownArena_ = new SpanScratchArena();
+        }
+        Rgba8T* colors1 = (arena_ != nullptr) ? arena_->Borrow(len) : nullptr;
+        Rgba8T* colors2 = (colors1 != nullptr) ? arena_->Borrow(len) : nullptr;
+        if (colors2 == nullptr) {
+            if (colors1 != nullptr) {
+                arena_->Release(1);
+            }
+            GeneratePixels(spanGenerator1_, spanGenerator2_, span, x, y, len);
+            return;
+        }
         spanGenerator1_.Generate(colors1, x, y, len);
         spanGenerator2_.Generate(colors2, x, y, len);
+        AddColors(span, colors1, colors2, len);
+        arena_->Release(2); // 2: the colors of both generators
+    }
 
-        for (; len; --len, ++span, colors1++, colors2++) {
-            span->red = (colors1->red+colors2->red) >= MAX_COLOR_NUM ?
-                        MAX_COLOR_NUM:(colors1->red+colors2->red);
-            span->green = (colors1->green+colors2->green) >= MAX_COLOR_NUM ?
-                        MAX_COLOR_NUM:(colors1->green+colors2->green);
-            span->blue = (colors1->blue+colors2->blue) >= MAX_COLOR_NUM ?
-                        MAX_COLOR_NUM:(colors1->blue+colors2->blue);
-            span->alpha = (colors1->alpha+colors2->alpha) >= MAX_COLOR_NUM ?
-                        MAX_COLOR_NUM:(colors1->alpha+colors2->alpha);
+    /**
+     * @brief span = colors1 + colors2 saturated at MAX_COLOR_NUM, 4 colors per vector with NEON or SSE2.
+     * @since 1.0
+     * @version 1.0
+     */
+    static void AddColors(Rgba8T* span, const Rgba8T* colors1, const Rgba8T* colors2, uint32_t len);
+
+    /**
+     * @brief Blend a span one pixel at a time with the colors of the generators on the stack,
+     * when no buffer can be borrowed.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Generator1, class Generator2>
+    static void GeneratePixels(Generator1& spanGenerator1, Generator2& spanGenerator2,
+                               Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+    {
+        for (uint32_t i = 0; i < len; i++) {
+            Rgba8T color1;
+            Rgba8T color2;
+            spanGenerator1.Generate(&color1, x + static_cast<int32_t>(i), y, 1);
+            spanGenerator2.Generate(&color2, x + static_cast<int32_t>(i), y, 1);
+            AddColors(span + i, &color1, &color2, 1);
         }
     }
+
 private:
     SpanBase& spanGenerator1_;
     SpanBase& spanGenerator2_;
+    SpanScratchArena* arena_;
+    SpanScratchArena* ownArena_;
 };
 } // namespace OHOS
 #endif
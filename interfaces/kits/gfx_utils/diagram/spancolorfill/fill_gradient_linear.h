@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file fill_gradient_linear.h
+ * @brief Defines the span generator of linear gradients stepping along the span
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_FILL_GRADIENT_LINEAR_H
+#define GRAPHIC_LITE_FILL_GRADIENT_LINEAR_H
+
+#include "gfx_utils/diagram/common/common_basics.h"
+#include "gfx_utils/diagram/spancolorfill/fill_base.h"
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_lut.h"
+#include "gfx_utils/diagram/spancolorfill/fill_interpolator.h"
+
+namespace OHOS {
+#if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+/**
+ * @class SpanLinearGradient
+ * @brief The linear gradient of FillGradient with GradientLinearCalculate. The position on the
+ * gradient is linear along a span under an affine transform, so it is transformed once per span
+ * and advanced by a constant step, the lut indices of 4 pixels are calculated per vector.
+ * Beyond its ends the gradient is padded, repeated or reflected.
+ * @since 1.0
+ * @version 1.0
+ */
+class SpanLinearGradient : public SpanBase {
+public:
+    /**
+     * @brief The gradient runs along the x axis of the transformed space from 0 to distance.
+     * @param inter The interpolator of FillGradient, only its transform is used.
+     * @since 1.0
+     * @version 1.0
+     */
+    SpanLinearGradient(FillInterpolator& inter, FillGradientLut& colorFunction, float distance,
+                       GradientSpreadMode spread = GRADIENT_SPREAD_PAD)
+        : interpolator_(inter),
+          colorFunction_(colorFunction),
+          distance_(MATH_MAX(distance, 1.0f / GRADIENT_SUBPIXEL_SCALE)),
+          spread_(spread) {}
+
+    void Prepare() {}
+
+    void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len);
+
+    /**
+     * @brief The lut indices of the positions start + i * step on a lut of size colors, i < len.
+     * @since 1.0
+     * @version 1.0
+     */
+    static void CalculateIndices(int32_t* indices, float start, float step, uint32_t len, int32_t size,
+                                 GradientSpreadMode spread);
+
+private:
+    enum IndexBatch {
+        INDEX_BATCH = 64
+    };
+
+    // Disable copying
+    SpanLinearGradient(const SpanLinearGradient&);
+    const SpanLinearGradient& operator=(const SpanLinearGradient&);
+
+    FillInterpolator& interpolator_;
+    FillGradientLut& colorFunction_;
+    float distance_;
+    GradientSpreadMode spread_;
+};
+#endif
+} // namespace OHOS
+#endif
@@ -27,6 +27,7 @@
 #include "gfx_utils/diagram/vertexprimitive/geometry_dda_line.h"
 #include "gfx_utils/diagram/vertexprimitive/geometry_plaindata_array.h"
 #include "gfx_utils/diagram/vertexprimitive/geometry_range_adapter.h"
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_lut_cache.h"
 #include "gfx_utils/diagram/spancolorfill/fill_interpolator.h"
 #include "gfx_utils/vector.h"
 namespace OHOS {
@@ -34,7 +35,9 @@ const uint32_t COLOR_PROFILE_SIZE = 4;
 const uint16_t COLOR_LUT_SIZE = 512;
 /**
 * @brief According to remove_all,add_color,and build_lut,
-* build the color gradient process, start, end and middle gradient colors
+* build the color gradient process, start, end and middle gradient colors.
+* The lut is shared through FillGradientLutCache with the gradients of the same colors,
+* copies of a FillGradientLut share it too.
 * @param The parameters are colorinterpolator color interpolator and colorlutsize color cell size
 * @since 1.0
 * @version 1.0
@@ -42,7 +45,36 @@ const uint16_t COLOR_LUT_SIZE = 512;
 class FillGradientLut {
 #if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
 public:
-    FillGradientLut() : colorProfile_(COLOR_PROFILE_SIZE), colorType_(COLOR_LUT_SIZE), colorLutSize_(COLOR_LUT_SIZE) {}
+    FillGradientLut()
+        : colorProfile_(COLOR_PROFILE_SIZE), lut_(nullptr), colorType_(EmptyLut()), colorLutSize_(COLOR_LUT_SIZE) {}
+
+    FillGradientLut(const FillGradientLut& other)
+        : colorProfile_(other.colorProfile_),
+          lut_(other.lut_),
+          colorType_(other.colorType_),
+          colorLutSize_(other.colorLutSize_)
+    {
+        FillGradientLutCache::GetInstance().AddRef(lut_);
+    }
+
+    FillGradientLut& operator=(const FillGradientLut& other)
+    {
+        if (this != &other) {
+            FillGradientLutCache::GetInstance().AddRef(other.lut_);
+            FillGradientLutCache::GetInstance().Release(lut_);
+            colorProfile_ = other.colorProfile_;
+            lut_ = other.lut_;
+            colorType_ = other.colorType_;
+            colorLutSize_ = other.colorLutSize_;
+        }
+        return *this;
+    }
+
+    ~FillGradientLut()
+    {
+        FillGradientLutCache::GetInstance().Release(lut_);
+    }
+
     /**
      * @brief Remove all colors
      * @since 1.0
@@ -62,13 +94,14 @@ public:
      */
     void AddColor(float offset, const Rgba8T& color)
     {
-        colorProfile_.PushBack(ColorPoint(offset, color));
+        colorProfile_.PushBack(GradientColorStop(offset, color));
     }
 
     /**
      * @brief Building a color_typ array from gradient colors
      * Array length 0-255
-     * The contents of the array are distributed on the array according to the gradient color
+     * The contents of the array are distributed on the array according to the gradient color.
+     * A lut of the same colors is taken from FillGradientLutCache instead of being built again
      * @since 1.0
      * @version 1.0
      */
@@ -80,39 +113,15 @@ public:
         QuickSort(colorProfile_, OffsetLess);
         colorProfile_.ReSize(RemoveDuplicates(colorProfile_, OffsetEqual));
         if (colorProfile_.Size() > 1) {
-            uint32_t index;
-            uint32_t start = static_cast<uint32_t>(colorProfile_[0].offset * colorLutSize_);
-            uint32_t end;
-            Rgba8T color = colorProfile_[0].color;
-
-            /*
-             * Assign initial color calculation to colorprofile [0]
-             */
-            for (index = 0; index < start; index++) {
-                colorType_[index] = color;
-            }
-            /*
-             * From 1 to colorprofile Interpolation color calculation between size ()
-             */
-            for (index = 1; index < colorProfile_.Size(); index++) {
-                end = static_cast<uint32_t>(colorProfile_[index].offset * colorLutSize_);
-                ColorInterpolator ci(colorProfile_[index - 1].color,
-                                     colorProfile_[index].color,
-                                     end - start + 1);
-                while (start < end) {
-                    colorType_[start] = ci.GetColor();
-                    ++ci;
-                    ++start;
-                }
-            }
-            color = colorProfile_.End()->color;
-            /*
-             * Give end color to colorprofile last
-             */
-            for (; end < colorType_.GetSize(); end++) {
-                color = colorProfile_.End()->color;
-                colorType_[end] = color;
+            FillGradientLutCache& cache = FillGradientLutCache::GetInstance();
+            FillGradientLutCache::CacheEntry* lut = cache.Acquire(colorProfile_.Begin(), colorProfile_.Size(),
+                                                                  colorLutSize_);
+            if (lut == nullptr) {
+                return;
             }
+            cache.Release(lut_);
+            lut_ = lut;
+            colorType_ = FillGradientLutCache::GetColors(lut_);
         }
     }
 
@@ -132,35 +141,22 @@ public:
         return colorType_[i];
     }
 private:
-    struct ColorPoint {
-        float offset;
-        Rgba8T color;
-
-        ColorPoint() {}
-        /**
-         * @brief Input parameter
-         * @param offsetValue (0-1)
-         * @param color_ Added color
-         */
-        ColorPoint(float offsetValue, const Rgba8T& colorValue)
-            : offset(offsetValue), color(colorValue)
-        {
-            if (offset < 0.0f) {
-                offset = 0.0f;
-            }
-            if (offset > 1.0f) {
-                offset = 1.0f;
-            }
-        }
-    };
+    /**
+     * @brief The colors before the first BuildLut
+     */
+    static const Rgba8T* EmptyLut()
+    {
+        static const Rgba8T emptyLut[COLOR_LUT_SIZE];
+        return emptyLut;
+    }
 
     /**
      * @brief OffsetLess Returns the comparison result that the offset of a is smaller than that of B
-     * @param colorPoint1 struct ColorPoint struct
-     * @param colorPoint2 struct ColorPoint struct
+     * @param colorPoint1 struct GradientColorStop struct
+     * @param colorPoint2 struct GradientColorStop struct
      * @return true: colorpoint1 precedes colorpoint2 false colorpoint1 follows colorpoint2
      */
-    static bool OffsetLess(const ColorPoint& colorPoint1, const ColorPoint& colorPoint2)
+    static bool OffsetLess(const GradientColorStop& colorPoint1, const GradientColorStop& colorPoint2)
     {
         return colorPoint1.offset < colorPoint2.offset;
     }
@@ -168,17 +164,18 @@ private:
     /**
      * @brief OffsetEqual Returns a comparison result in
      * which the offset of comparison a is equal to that of comparison b
-     * @param colorPoint1 struct ColorPoint struct
-     * @param colorPoint2 struct ColorPoint struct
+     * @param colorPoint1 struct GradientColorStop struct
+     * @param colorPoint2 struct GradientColorStop struct
      * @return Return true: the offsets of colorpoint1 and colorpoint2 are equal,
      * and false: the offsets of a and B are not equal
      */
-    static bool OffsetEqual(const ColorPoint& colorPoint1, const ColorPoint& colorPoint2)
+    static bool OffsetEqual(const GradientColorStop& colorPoint1, const GradientColorStop& colorPoint2)
     {
         return colorPoint1.offset == colorPoint2.offset;
     }
-    Graphic::Vector<ColorPoint> colorProfile_;
-    GeometryPlainDataArray<Rgba8T> colorType_;
+    Graphic::Vector<GradientColorStop> colorProfile_;
+    FillGradientLutCache::CacheEntry* lut_;
+    const Rgba8T* colorType_;
     uint16_t colorLutSize_;
 #endif
 };
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file fill_gradient_lut_cache.h
+ * @brief Defines the process wide cache of gradient color luts
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_FILL_GRADIENT_LUT_CACHE_H
+#define GRAPHIC_LITE_FILL_GRADIENT_LUT_CACHE_H
+
+#include "gfx_utils/color.h"
+#include "gfx_utils/heap_base.h"
+#include "graphic_mutex.h"
+
+namespace OHOS {
+#if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+/**
+ * @brief A color stop of a gradient, the offset is clamped to [0, 1].
+ * @since 1.0
+ * @version 1.0
+ */
+struct GradientColorStop {
+    float offset;
+    Rgba8T color;
+
+    GradientColorStop() : offset(0) {}
+    GradientColorStop(float offsetValue, const Rgba8T& colorValue) : offset(offsetValue), color(colorValue)
+    {
+        if (offset < 0.0f) {
+            offset = 0.0f;
+        }
+        if (offset > 1.0f) {
+            offset = 1.0f;
+        }
+    }
+};
+
+/**
+ * @brief Counters of FillGradientLutCache, hits and misses are counted by Acquire, evictions are
+ * luts dropped from the cache to stay within its capacity. entries is the current content.
+ * @since 1.0
+ * @version 1.0
+ */
+struct FillGradientLutCacheStats {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t entries;
+};
+
+/**
+ * @class FillGradientLutCache
+ * @brief Keeps the color luts of gradients, keyed by the sorted color stops and the lut size.
+ * Gradients with the same stops share one lut, which is reference counted: a lut dropped from
+ * the cache stays valid until its last user releases it. At most capacity luts are kept, the
+ * least recently used one is dropped first. The cache is locked by its public functions.
+ * @since 1.0
+ * @version 1.0
+ */
+class FillGradientLutCache : public HeapBase {
+public:
+    enum CacheScale {
+        DEFAULT_CAPACITY = 16,
+        HASH_BUCKETS = 32
+    };
+
+    struct CacheEntry;
+
+    explicit FillGradientLutCache(uint32_t capacity = DEFAULT_CAPACITY);
+
+    ~FillGradientLutCache();
+
+    /**
+     * @brief The cache shared by all FillGradientLut, it is never destroyed.
+     * @since 1.0
+     * @version 1.0
+     */
+    static FillGradientLutCache& GetInstance();
+
+    /**
+     * @brief Take a reference to the lut of lutSize colors of the stops, which are sorted by offset
+     * without duplicate offsets. The lut is built on a miss.
+     * @return The lut, or nullptr if it can not be allocated.
+     * @since 1.0
+     * @version 1.0
+     */
+    CacheEntry* Acquire(const GradientColorStop* stops, uint32_t numStops, uint16_t lutSize);
+
+    void AddRef(CacheEntry* entry);
+
+    /**
+     * @brief Drop a reference taken by Acquire or AddRef, a lut which is no longer cached is freed
+     * with its last reference.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Release(CacheEntry* entry);
+
+    static const Rgba8T* GetColors(const CacheEntry* entry);
+
+    /**
+     * @brief Change the number of cached luts, the least recently used ones are dropped to fit.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetCapacity(uint32_t capacity);
+
+    uint32_t GetCapacity() const
+    {
+        return capacity_;
+    }
+
+    /**
+     * @brief Drop all luts from the cache, the statistics are kept.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Clear();
+
+    FillGradientLutCacheStats GetStats();
+
+    void ResetStats();
+
+    /**
+     * @brief Build the lut of lutSize colors of the stops. Between two stops the colors are
+     * interpolated with a weight stepped as a quotient and a remainder, without floats.
+     * @since 1.0
+     * @version 1.0
+     */
+    static void BuildLut(const GradientColorStop* stops, uint32_t numStops, Rgba8T* colors, uint16_t lutSize);
+
+private:
+    static uint64_t HashStops(const GradientColorStop* stops, uint32_t numStops, uint16_t lutSize);
+    static bool SameStops(const CacheEntry* entry, const GradientColorStop* stops, uint32_t numStops,
+                          uint16_t lutSize);
+    CacheEntry* CreateEntry(const GradientColorStop* stops, uint32_t numStops, uint16_t lutSize, uint64_t hash);
+    void Insert(CacheEntry* entry);
+    void Unlink(CacheEntry* entry);
+    void Evict(uint32_t capacity);
+    static void DeleteEntry(CacheEntry* entry);
+
+    // Disable copying
+    FillGradientLutCache(const FillGradientLutCache&);
+    const FillGradientLutCache& operator=(const FillGradientLutCache&);
+
+    CacheEntry* buckets_[HASH_BUCKETS];
+    CacheEntry* head_;
+    CacheEntry* tail_;
+    uint32_t capacity_;
+    FillGradientLutCacheStats stats_;
+    GraphicMutex mutex_;
+};
+#endif
+} // namespace OHOS
+#endif
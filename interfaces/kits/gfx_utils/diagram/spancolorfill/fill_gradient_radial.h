@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file fill_gradient_radial.h
+ * @brief Defines the span generator of radial and focal gradients evaluated per span
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_FILL_GRADIENT_RADIAL_H
+#define GRAPHIC_LITE_FILL_GRADIENT_RADIAL_H
+
+#include "gfx_utils/diagram/common/common_basics.h"
+#include "gfx_utils/diagram/spancolorfill/fill_base.h"
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_lut.h"
+#include "gfx_utils/diagram/spancolorfill/fill_interpolator.h"
+
+namespace OHOS {
+#if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+/**
+ * @class SpanRadialGradient
+ * @brief The radial gradient of FillGradient with GradientRadialCalculate, from the start circle
+ * around the focal point to the end circle around the origin. Relative to the focal point f, a
+ * pixel d is at (d.f + sqrt(R^2 |d|^2 - (d x f)^2)) * R / (R^2 - |f|^2) on the gradient.
+ * The first pixel of a span is transformed once and the others are stepped from it. With an FPU
+ * the positions of 4 pixels are evaluated per vector, without one, that is with
+ * ENABLE_GRADIENT_FIXED_POINT, the position is stepped in fixed point and the value under the root
+ * is evaluated in integers, set up once per gradient in Prepare. Both take the lut indices of
+ * GradientRadialCalculate within one entry.
+ * @since 1.0
+ * @version 1.0
+ */
+class SpanRadialGradient : public SpanBase {
+public:
+    /**
+     * @brief The parameters are the ones of FillGradient and GradientRadialCalculate.
+     * @param inter The interpolator of FillGradient, only its transform is used.
+     * @param startRadius The radius of the start circle, distance1 of FillGradient.
+     * @param endRadius The radius of the end circle, distance2 of FillGradient.
+     * @param focalX, focalY The center of the start circle relative to the end circle.
+     * @since 1.0
+     * @version 1.0
+     */
+    SpanRadialGradient(FillInterpolator& inter, FillGradientLut& colorFunction, float startRadius, float endRadius,
+                       float focalX = 0, float focalY = 0);
+
+    /**
+     * @brief Set up the fixed point path for the current transform of the interpolator.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Prepare();
+
+    void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+    {
+#if defined(ENABLE_GRADIENT_FIXED_POINT) && ENABLE_GRADIENT_FIXED_POINT
+        GenerateFixedPoint(span, x, y, len);
+#else
+        GenerateFloat(span, x, y, len);
+#endif
+    }
+
+    /**
+     * @brief Generate with float vectors.
+     * @since 1.0
+     * @version 1.0
+     */
+    void GenerateFloat(Rgba8T* span, int32_t x, int32_t y, uint32_t len);
+
+    /**
+     * @brief Generate with integers only, a focal point on or outside the end circle is generated
+     * with floats.
+     * @since 1.0
+     * @version 1.0
+     */
+    void GenerateFixedPoint(Rgba8T* span, int32_t x, int32_t y, uint32_t len);
+
+private:
+    enum IndexBatch {
+        INDEX_BATCH = 64
+    };
+
+    void PrepareFixedPoint(int32_t start, int32_t end, int32_t fx, int32_t fy);
+    void BeginSpan(int32_t x, int32_t y, float& startX, float& startY, float& stepX, float& stepY);
+    void CalculateIndices(int32_t* indices, float startX, float startY, float stepX, float stepY, uint32_t len) const;
+    void LookUp(Rgba8T* span, const int32_t* indices, uint32_t len);
+
+    // Disable copying
+    SpanRadialGradient(const SpanRadialGradient&);
+    const SpanRadialGradient& operator=(const SpanRadialGradient&);
+
+    FillInterpolator& interpolator_;
+    FillGradientLut& colorFunction_;
+    int32_t size_;
+    /** The focal point in the 1 / GRADIENT_SUBPIXEL_SCALE pixels of GradientRadialCalculate */
+    float focalX_;
+    float focalY_;
+    float endRadiusSquare_;
+    /** A position on the gradient times indexScale_ minus indexOffset_ is its lut index */
+    float indexScale_;
+    float indexOffset_;
+    /** The same in fixed point, a position in the units of the root times fixedScale_ >> fixedShift_ */
+    int64_t fixedScale_;
+    int32_t fixedShift_;
+    int64_t fixedOffset_;
+    int64_t maxFixedPosition_;
+    /** The value under the root is shifted right by rootShift_ before the integer root */
+    int32_t rootShift_;
+    /** False if the focal point is on or outside the end circle, the fixed point path is not used */
+    bool fixedPoint_;
+    /** A fixed position shifted right by coordinateShift_ is an operand of the root */
+    int32_t coordinateShift_;
+    /** Outside +-fixedBox_ around the focal point a pixel takes the last lut entry */
+    int64_t fixedBox_;
+    int64_t fixedFocalX_;
+    int64_t fixedFocalY_;
+    int64_t fixedRadiusSquare_;
+    /** Pixel (0, 0) relative to the focal point and the steps to the next pixel and row */
+    int64_t fixedOriginX_;
+    int64_t fixedOriginY_;
+    int64_t fixedStepX_;
+    int64_t fixedStepY_;
+    int64_t fixedRowStepX_;
+    int64_t fixedRowStepY_;
+};
+#endif
+} // namespace OHOS
+#endif
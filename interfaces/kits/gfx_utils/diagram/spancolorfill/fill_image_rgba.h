@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file fill_image_rgba.h
+ * @brief Defines the span generator of images sampled under an affine transform
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_FILL_IMAGE_RGBA_H
+#define GRAPHIC_LITE_FILL_IMAGE_RGBA_H
+
+#include "gfx_utils/color.h"
+#include "gfx_utils/diagram/common/common_basics.h"
+#include "gfx_utils/diagram/spancolorfill/fill_base.h"
+#include "gfx_utils/diagram/spancolorfill/fill_interpolator.h"
+#include "gfx_utils/image_info.h"
+
+namespace OHOS {
+/**
+ * nearest The pixel under the sample point
+ * bilinear The 4 pixels around the sample point weighted by its distance to them
+ * box The 4 pixels around the sample point averaged, which halves an image without aliasing
+ */
+enum ImageFilterMode {
+    IMAGE_FILTER_NEAREST,
+    IMAGE_FILTER_BILINEAR,
+    IMAGE_FILTER_BOX
+};
+
+/**
+ * @class SpanImageRgba
+ * @brief Samples an image under the transform of the interpolator, which maps the centers of the
+ * span pixels into the image. The pixels of ARGB8888, XRGB8888, RGB888 and RGB565 images are read
+ * in their own format. The samples of a span are gathered in batches, the bilinear weights are
+ * fractions of 1 / WEIGHT_SCALE, and the 4 pixels of the bilinear and box filters are combined
+ * in vectors of 8 pixels with NEON and of 4 with SSE2. Outside of the image the span is transparent,
+ * unless the axis is repeated by the repeat mode.
+ * @since 1.0
+ * @version 1.0
+ */
+class SpanImageRgba : public SpanBase {
+public:
+    enum ImageScale {
+        SAMPLE_BATCH = 64,
+        WEIGHT_SHIFT = 7,
+        WEIGHT_SCALE = 1 << WEIGHT_SHIFT
+    };
+
+    /**
+     * @brief The 4 pixels around a batch of sample points, with the weights of the right and
+     * bottom pixels in [0, WEIGHT_SCALE). A pixel is packed into the 32 bits the bytes of Rgba8T
+     * are read as, red in the low byte, so that it is gathered with one store.
+     * @since 1.0
+     * @version 1.0
+     */
+    struct SampleCorners {
+        uint32_t topLeft[SAMPLE_BATCH];
+        uint32_t topRight[SAMPLE_BATCH];
+        uint32_t bottomLeft[SAMPLE_BATCH];
+        uint32_t bottomRight[SAMPLE_BATCH];
+        uint8_t weightX[SAMPLE_BATCH];
+        uint8_t weightY[SAMPLE_BATCH];
+    };
+
+    SpanImageRgba(FillInterpolator& inter, ImageFilterMode filter = IMAGE_FILTER_BILINEAR,
+                  PatternRepeatMode repeat = NO_REPEAT);
+
+    /**
+     * @brief Sample the image, which is not copied and must outlive the generator.
+     * @return false if the image is empty or its color mode is not supported, the spans are
+     * transparent then.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool Attach(const ImageInfo* image);
+
+    static bool IsSupported(ColorMode mode);
+
+    void SetFilter(ImageFilterMode filter)
+    {
+        filter_ = filter;
+    }
+
+    ImageFilterMode GetFilter() const
+    {
+        return filter_;
+    }
+
+    void SetRepeat(PatternRepeatMode repeat)
+    {
+        repeat_ = repeat;
+    }
+
+    void Prepare() {}
+
+    void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len);
+
+    /**
+     * @brief Interpolate the corners horizontally and then vertically, each step rounds
+     * (p * (WEIGHT_SCALE - w) + q * w) / WEIGHT_SCALE.
+     * @since 1.0
+     * @version 1.0
+     */
+    static void LerpCorners(Rgba8T* span, const SampleCorners& corners, uint32_t len);
+
+    /**
+     * @brief The rounded average of the corners.
+     * @since 1.0
+     * @version 1.0
+     */
+    static void AverageCorners(Rgba8T* span, const SampleCorners& corners, uint32_t len);
+
+private:
+    using NearestFunc = void (*)(const SpanImageRgba& image, const int32_t* xs, const int32_t* ys,
+                                 uint32_t* colors, uint32_t len);
+    using CornersFunc = void (*)(const SpanImageRgba& image, const int32_t* xs, const int32_t* ys,
+                                 SampleCorners& corners, uint32_t len);
+
+    template <class Format>
+    static void GatherNearest(const SpanImageRgba& image, const int32_t* xs, const int32_t* ys,
+                              uint32_t* colors, uint32_t len);
+    template <class Format>
+    static void GatherCorners(const SpanImageRgba& image, const int32_t* xs, const int32_t* ys,
+                              SampleCorners& corners, uint32_t len);
+
+    bool RepeatX() const
+    {
+        return repeat_ == REPEAT || repeat_ == REPEAT_X;
+    }
+
+    bool RepeatY() const
+    {
+        return repeat_ == REPEAT || repeat_ == REPEAT_Y;
+    }
+
+    // Disable copying
+    SpanImageRgba(const SpanImageRgba&);
+    const SpanImageRgba& operator=(const SpanImageRgba&);
+
+    FillInterpolator& interpolator_;
+    ImageFilterMode filter_;
+    PatternRepeatMode repeat_;
+    const uint8_t* data_;
+    int32_t width_;
+    int32_t height_;
+    NearestFunc nearestFunc_;
+    CornersFunc cornersFunc_;
+};
+} // namespace OHOS
+#endif
@@ -18,6 +18,7 @@
 #include <gfx_utils/image_info.h>
 #include "gfx_utils/color.h"
 #include "fill_base.h"
+#include "gfx_utils/diagram/common/common_basics.h"
 /**
  * @file span_pattern_rgba.h
  * @brief Defines Scan line of pattern
@@ -26,33 +27,160 @@
  */
 
 namespace OHOS {
+#if defined(GRAPHIC_ENABLE_PATTERN_FILL_FLAG) && GRAPHIC_ENABLE_PATTERN_FILL_FLAG
+/**
+ * @brief An ARGB8888 pattern image placed at startX, startY. colors is nullptr for images
+ * of other color modes, which are filled with FillPatternRgba::NoColor.
+ * @since 1.0
+ * @version 1.0
+ */
+struct PatternImage {
+    const Color32* colors;
+    int32_t width;
+    int32_t height;
+    float startX;
+    float startY;
+
+    PatternImage() : colors(nullptr), width(0), height(0), startX(0), startY(0) {}
+
+    void Attach(const ImageInfo* image, float x, float y)
+    {
+        colors = nullptr;
+        width = 0;
+        height = 0;
+        if (image != nullptr && image->header.colorMode == ARGB8888 && image->data != nullptr &&
+            image->header.width > 0 && image->header.height > 0) {
+            colors = reinterpret_cast<const Color32*>(image->data);
+            width = image->header.width;
+            height = image->header.height;
+        }
+        startX = x;
+        startY = y;
+    }
+};
+
+/**
+ * @brief Copy len colors of a pattern row into a span, the blue, green, red, alpha bytes of
+ * Color32 become the red, green, blue, alpha of Rgba8T, 8 colors per vector.
+ * @since 1.0
+ * @version 1.0
+ */
+void CopyPatternRun(Rgba8T* span, const Color32* colors, uint32_t len);
+
+/**
+ * @brief Fill len colors with the opaque black of FillPatternRgba::NoColor.
+ * @since 1.0
+ * @version 1.0
+ */
+void FillPatternNoColor(Rgba8T* span, uint32_t len);
+
+/**
+ * @class SpanPatternRgba
+ * @brief The pattern span generator of one repeat mode. The row of the span is found once and
+ * the span is filled with runs, each run is a part of the row which is copied at once, or a
+ * part outside of the pattern in NO_REPEAT and across the repeated axis of REPEAT_X and REPEAT_Y.
+ * @since 1.0
+ * @version 1.0
+ */
+template <PatternRepeatMode repeatMode>
+class SpanPatternRgba {
+public:
+    SpanPatternRgba() {}
+
+    SpanPatternRgba(const ImageInfo* image, float startX, float startY)
+    {
+        image_.Attach(image, startX, startY);
+    }
+
+    void Attach(const ImageInfo* image, float startX, float startY)
+    {
+        image_.Attach(image, startX, startY);
+    }
+
+    void Prepare() {}
+
+    void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+    {
+        GenerateSpan(image_, span, x, y, len);
+    }
+
+    static void GenerateSpan(const PatternImage& image, Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+    {
+        const bool repeatX = (repeatMode == REPEAT || repeatMode == REPEAT_X);
+        const bool repeatY = (repeatMode == REPEAT || repeatMode == REPEAT_Y);
+        int32_t patternX = static_cast<int32_t>(x - image.startX);
+        int32_t patternY = static_cast<int32_t>(y - image.startY);
+        if (image.colors == nullptr) {
+            FillPatternNoColor(span, len);
+            return;
+        }
+        if (repeatY) {
+            patternY = Wrap(patternY, image.height);
+        } else if (patternY < 0 || patternY >= image.height) {
+            FillPatternNoColor(span, len);
+            return;
+        }
+        const Color32* row = image.colors + patternY * image.width;
+        if (repeatX) {
+            patternX = Wrap(patternX, image.width);
+            while (len > 0) {
+                uint32_t run = MATH_MIN(len, static_cast<uint32_t>(image.width - patternX));
+                CopyPatternRun(span, row + patternX, run);
+                span += run;
+                len -= run;
+                patternX = 0;
+            }
+            return;
+        }
+        if (patternX < 0) {
+            uint32_t run = MATH_MIN(len, static_cast<uint32_t>(-static_cast<int64_t>(patternX)));
+            FillPatternNoColor(span, run);
+            span += run;
+            len -= run;
+            patternX = 0;
+        }
+        if (len > 0 && patternX < image.width) {
+            uint32_t run = MATH_MIN(len, static_cast<uint32_t>(image.width - patternX));
+            CopyPatternRun(span, row + patternX, run);
+            span += run;
+            len -= run;
+        }
+        FillPatternNoColor(span, len);
+    }
+
+private:
+    /* The coordinate in [0, size), also for negative coordinates. */
+    static int32_t Wrap(int32_t coordinate, int32_t size)
+    {
+        int32_t wrapped = coordinate % size;
+        return (wrapped < 0) ? wrapped + size : wrapped;
+    }
+
+    PatternImage image_;
+};
+#endif
+
+/**
+ * @brief The pattern span generator of any repeat mode, each span is generated by the
+ * SpanPatternRgba of the mode.
+ * @since 1.0
+ * @version 1.0
+ */
 class FillPatternRgba : public SpanBase {
 #if defined(GRAPHIC_ENABLE_PATTERN_FILL_FLAG) && GRAPHIC_ENABLE_PATTERN_FILL_FLAG
 public:
-    FillPatternRgba() {}
+    FillPatternRgba() : patternRepeat_(NO_REPEAT) {}
 
     FillPatternRgba(const ImageInfo* image, PatternRepeatMode patternRepeat, float startX, float startY)
         : patternRepeat_(patternRepeat)
     {
-        if (image->header.colorMode == ARGB8888) {
-            patternImage_ = reinterpret_cast<Color32*>(const_cast<uint8_t*>(image->data));
-            patternImageheigth_ = image->header.height;
-            patternImagewidth_ = image->header.width;
-            patternStartX_ = startX;
-            patternStartY_ = startY;
-        }
+        image_.Attach(image, startX, startY);
     }
 
     void Attach(const ImageInfo* image, PatternRepeatMode patternRepeat, float startX, float startY)
     {
         patternRepeat_ = patternRepeat;
-        if (image->header.colorMode == ARGB8888) {
-            patternImage_ = reinterpret_cast<Color32*>(const_cast<uint8_t*>(image->data));
-            patternImageheigth_ = image->header.height;
-            patternImagewidth_ = image->header.width;
-            patternStartX_ = startX;
-            patternStartY_ = startY;
-        }
+        image_.Attach(image, startX, startY);
     }
 
     /**
@@ -76,73 +204,24 @@ public:
 
     void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
     {
-        y = static_cast<int32_t>(y - patternStartY_);
-        x = static_cast<int32_t>(x - patternStartX_);
-        for (; len; --len, span++, x++) {
-            if (patternRepeat_ == NO_REPEAT) {
-                if (x >= patternImagewidth_ ||
-                        y >= patternImageheigth_) {
-                    ChangeColor(span, NoColor());
-                } else {
-                    ChangeColor(span, patternImage_[patternImagewidth_ * y + x]);
-                }
-            }
-
-            if (patternRepeat_ == REPEAT) {
-                x = x % patternImagewidth_;
-                y = y % patternImageheigth_;
-                if (x >= patternImagewidth_ || y >= patternImageheigth_) {
-                    ChangeColor(span, NoColor());
-                } else {
-                    ChangeColor(span, patternImage_[patternImagewidth_ * y + x]);
-                }
-            }
-
-            if (patternRepeat_ == REPEAT_X) {
-                x = x % patternImagewidth_;
-                if (y >= patternImageheigth_) {
-                    ChangeColor(span, NoColor());
-                } else {
-                    y = y % patternImageheigth_;
-                    if (x >= patternImagewidth_ || y >= patternImageheigth_) {
-                        ChangeColor(span, NoColor());
-                    } else {
-                        ChangeColor(span, patternImage_[patternImagewidth_ * y + x]);
-                    }
-                }
-            }
-
-            if (patternRepeat_ == REPEAT_Y) {
-                y = y % patternImageheigth_;
-                if (x >= patternImageheigth_) {
-                    ChangeColor(span, NoColor());
-                } else {
-                    x = x % patternImagewidth_;
-                    if (x >= patternImagewidth_ ||
-                       y >= patternImageheigth_) {
-                        ChangeColor(span, NoColor());
-                    } else {
-                        ChangeColor(span, patternImage_[patternImagewidth_ * y + x]);
-                    }
-                }
-            }
+        switch (patternRepeat_) {
+            case REPEAT:
+                SpanPatternRgba<REPEAT>::GenerateSpan(image_, span, x, y, len);
+                break;
+            case REPEAT_X:
+                SpanPatternRgba<REPEAT_X>::GenerateSpan(image_, span, x, y, len);
+                break;
+            case REPEAT_Y:
+                SpanPatternRgba<REPEAT_Y>::GenerateSpan(image_, span, x, y, len);
+                break;
+            default:
+                SpanPatternRgba<NO_REPEAT>::GenerateSpan(image_, span, x, y, len);
+                break;
         }
     }
 private:
     PatternRepeatMode patternRepeat_;
-    const Color32* patternImage_;
-    uint16_t patternImageheigth_;
-    uint16_t patternImagewidth_;
-    float patternStartX_;
-    float patternStartY_;
-
-    void ChangeColor(Rgba8T* color, ColorType colorType)
-    {
-        color->red = colorType.red;
-        color->green = colorType.green;
-        color->blue = colorType.blue;
-        color->alpha = colorType.alpha;
-    }
+    PatternImage image_;
 #endif
 };
 } // namespace OHOS
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file fill_solid_color.h
+ * @brief Defines the rendering of scanlines with one constant color
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_FILL_SOLID_COLOR_H
+#define GRAPHIC_LITE_FILL_SOLID_COLOR_H
+
+#include "gfx_utils/color.h"
+#include "gfx_utils/graphic_buffer.h"
+#include "gfx_utils/heap_base.h"
+
+namespace OHOS {
+/**
+ * @class FillSolidColor
+ * @brief Blends one color through the covers of scanlines straight into a buffer, without the span of
+ * equal colors that SpanSoildColor fills and the blender reads back. Every pixel becomes
+ * Lerp(dst, color, color.alpha * cover), the alpha of ARGB8888 and XRGB8888 becomes
+ * Prelerp(dst.alpha, alpha, alpha). The kernels of ARGB8888, XRGB8888, RGB888 and RGB565 blend
+ * 8 pixels per vector with NEON, SSE2 has the kernels of the 32 bit modes and RGB565.
+ * @since 1.0
+ * @version 1.0
+ */
+class FillSolidColor : public HeapBase {
+public:
+    FillSolidColor();
+
+    /**
+     * @brief Render into the buffer, x and y are relative to its top left pixel.
+     * @return false if the color mode of the buffer is not supported, nothing is rendered then.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool Attach(const BufferInfo& dst);
+
+    void SetColor(const Rgba8T& color)
+    {
+        color_.red = color.red;
+        color_.green = color.green;
+        color_.blue = color.blue;
+        color_.alpha = color.alpha;
+    }
+
+    static bool IsSupported(ColorMode mode);
+
+    /**
+     * @brief Blend len pixels with the same cover, a full cover of an opaque color only stores it.
+     * @since 1.0
+     * @version 1.0
+     */
+    void BlendHline(int32_t x, int32_t y, uint32_t len, uint8_t cover);
+
+    /**
+     * @brief Blend len pixels with one cover each.
+     * @since 1.0
+     * @version 1.0
+     */
+    void BlendSolidHspan(int32_t x, int32_t y, uint32_t len, const uint8_t* covers);
+
+    /**
+     * @brief Blend the spans of a scanline, Scanline is GeometryScanline or GeometryScanlinePacked,
+     * whose solid runs become BlendHline.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    void RenderScanline(const Scanline& sl)
+    {
+        int32_t y = sl.GetYLevel();
+        uint32_t numSpans = sl.NumSpans();
+        typename Scanline::ConstIterator span = sl.Begin();
+        for (; numSpans; --numSpans, ++span) {
+            if (span->spanLength < 0) {
+                BlendHline(span->x, y, static_cast<uint32_t>(-span->spanLength), span->covers[0]);
+            } else {
+                BlendSolidHspan(span->x, y, static_cast<uint32_t>(span->spanLength), span->covers);
+            }
+        }
+    }
+
+    /**
+     * @brief Sweep all scanlines of a scanline source such as RasterizerScanlineAntialias and blend them.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Source, class Scanline>
+    void RenderScanlines(Source& source, Scanline& sl)
+    {
+        if (blendFunc_ == nullptr || !source.RewindScanlines()) {
+            return;
+        }
+        sl.Reset(source.GetMinX(), source.GetMaxX());
+        while (source.SweepScanline(sl)) {
+            RenderScanline(sl);
+        }
+    }
+
+private:
+    using SolidBlend = void (*)(uint8_t* dst, const Rgba8T& color, const uint8_t* covers, uint32_t len);
+    using SolidFill = void (*)(uint8_t* dst, const Rgba8T& color, uint32_t len);
+
+    enum FillScale {
+        COVER_CHUNK = 64
+    };
+
+    uint8_t* ClipSpan(int32_t& x, int32_t y, uint32_t& len, uint32_t& skip) const;
+
+    static void BlendArgb8888(uint8_t* dst, const Rgba8T& color, const uint8_t* covers, uint32_t len);
+    static void BlendRgb888(uint8_t* dst, const Rgba8T& color, const uint8_t* covers, uint32_t len);
+    static void BlendRgb565(uint8_t* dst, const Rgba8T& color, const uint8_t* covers, uint32_t len);
+    static void FillArgb8888(uint8_t* dst, const Rgba8T& color, uint32_t len);
+    static void FillRgb888(uint8_t* dst, const Rgba8T& color, uint32_t len);
+    static void FillRgb565(uint8_t* dst, const Rgba8T& color, uint32_t len);
+
+    uint8_t* data_;
+    int32_t width_;
+    int32_t height_;
+    uint32_t stride_;
+    uint32_t pixelBytes_;
+    SolidBlend blendFunc_;
+    SolidFill fillFunc_;
+    Rgba8T color_;
+};
+} // namespace OHOS
+#endif
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file fill_span_generator.h
+ * @brief Defines the span generators whose parts are chosen at compile time
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_FILL_SPAN_GENERATOR_H
+#define GRAPHIC_LITE_FILL_SPAN_GENERATOR_H
+
+#include "gfx_utils/diagram/spancolorfill/fill_base.h"
+#include "gfx_utils/diagram/spancolorfill/fill_gradient.h"
+
+namespace OHOS {
+/**
+ * A span generator is any class with Prepare() and Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len).
+ * The generators below take their parts as template parameters and call them by their qualified names,
+ * so a part that derives from SpanBase or Gradient is called without its vtable and the per pixel
+ * loop can be inlined and vectorized by the compiler.
+ */
+
+/**
+ * @class SpanGeneratorAdaptor
+ * @brief Wraps a span generator into a SpanBase for the callers that take a SpanBase reference,
+ * only the call of Generate for a whole span goes through the vtable.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Generator>
+class SpanGeneratorAdaptor : public SpanBase {
+public:
+    explicit SpanGeneratorAdaptor(Generator& generator) : generator_(generator) {}
+
+    void Prepare()
+    {
+        generator_.Generator::Prepare();
+    }
+
+    void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+    {
+        generator_.Generator::Generate(span, x, y, len);
+    }
+
+private:
+    Generator& generator_;
+};
+
+#if defined(GRAPHIC_ENABLE_GRADIENT_FILL_FLAG) && GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+/**
+ * @class SpanGradient
+ * @brief The gradient span generator of FillGradient with the interpolator, the gradient function
+ * and the color lut as template parameters, it fills the same colors. The interpolator and the
+ * gradient function are copied for every span, so they are expected to be small.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Interpolator, class GradientFunction, class ColorFunction>
+class SpanGradient {
+public:
+    /**
+     * @brief The parameters are the ones of FillGradient.
+     * @since 1.0
+     * @version 1.0
+     */
+    SpanGradient(Interpolator& inter, GradientFunction& gradientFunction,
+                 ColorFunction& colorFunction, float distance1, float distance2)
+        : interpolator_(inter),
+          gradientFunction_(gradientFunction),
+          colorFunction_(colorFunction),
+          distance1_(static_cast<int32_t>(distance1 * GRADIENT_SUBPIXEL_SCALE)),
+          distance2_(static_cast<int32_t>(distance2 * GRADIENT_SUBPIXEL_SCALE)) {}
+
+    void Prepare() {}
+
+    void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+    {
+        const int32_t downscaleShift = Interpolator::SUBPIXEL_SHIFT - GRADIENT_SUBPIXEL_SHIFT;
+        const int16_t size = static_cast<int16_t>(colorFunction_.GetSize());
+        // The state is copied to locals, the byte stores of the colors could alias it
+        Interpolator interpolator = interpolator_;
+        GradientFunction gradientFunction = gradientFunction_;
+        const int32_t distance1 = distance1_;
+        const int32_t distance2 = distance2_;
+        interpolator.Begin(x, y, len);
+        for (; len; --len, ++interpolator, span++) {
+            interpolator.Coordinates(&x, &y);
+            int32_t index = gradientFunction.GradientFunction::Calculate(x >> downscaleShift, y >> downscaleShift,
+                                                                         distance1, distance2, size);
+            // Channel by channel, the assignment of Rgba8T converts through Rgba
+            const Rgba8T& color = colorFunction_[index];
+            span->red = color.red;
+            span->green = color.green;
+            span->blue = color.blue;
+            span->alpha = color.alpha;
+        }
+    }
+
+private:
+    // Disable copying
+    SpanGradient(const SpanGradient&);
+    const SpanGradient& operator=(const SpanGradient&);
+
+    Interpolator& interpolator_;
+    GradientFunction& gradientFunction_;
+    ColorFunction& colorFunction_;
+    int32_t distance1_;
+    int32_t distance2_;
+};
+#endif
+
+/**
+ * @class SpanBlend
+ * @brief The SpanBlendColor of two span generators known at compile time, the colors of the
+ * generators are borrowed from the arena of the render pass, or from an arena of its own.
+ * If no buffer can be borrowed the span is blended pixel by pixel.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Generator1, class Generator2>
+class SpanBlend {
+public:
+    SpanBlend(Generator1& spanGenerator1, Generator2& spanGenerator2)
+        : spanGenerator1_(spanGenerator1), spanGenerator2_(spanGenerator2), arena_(nullptr) {}
+
+    SpanBlend(Generator1& spanGenerator1, Generator2& spanGenerator2, SpanScratchArena& arena)
+        : spanGenerator1_(spanGenerator1), spanGenerator2_(spanGenerator2), arena_(&arena) {}
+
+    void Prepare()
+    {
+        spanGenerator1_.Generator1::Prepare();
+        spanGenerator2_.Generator2::Prepare();
+    }
+
+    void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+    {
+        SpanScratchArena& arena = (arena_ != nullptr) ? *arena_ : ownArena_;
+        Rgba8T* colors1 = arena.Borrow(len);
+        Rgba8T* colors2 = (colors1 != nullptr) ? arena.Borrow(len) : nullptr;
+        if (colors2 == nullptr) {
+            arena.Release((colors1 != nullptr) ? 1 : 0);
+            SpanBlendColor::GeneratePixels(spanGenerator1_, spanGenerator2_, span, x, y, len);
+            return;
+        }
+        spanGenerator1_.Generator1::Generate(colors1, x, y, len);
+        spanGenerator2_.Generator2::Generate(colors2, x, y, len);
+        SpanBlendColor::AddColors(span, colors1, colors2, len);
+        arena.Release(2); // 2: the colors of both generators
+    }
+
+private:
+    // Disable copying
+    SpanBlend(const SpanBlend&);
+    const SpanBlend& operator=(const SpanBlend&);
+
+    Generator1& spanGenerator1_;
+    Generator2& spanGenerator2_;
+    SpanScratchArena* arena_;
+    SpanScratchArena ownArena_;
+};
+} // namespace OHOS
+#endif
@@ -71,7 +71,13 @@ public:
     void PushBack(const T& data)
     {
         if (size_ == capacity_) {
-            capacity_ <<= 1;
+            // An empty vector grows to 1, a full vector of UINT16_MAX elements can not grow
+            uint16_t capacity = (capacity_ == 0) ? 1 : static_cast<uint16_t>(MATH_MIN(capacity_ * 2, UINT16_MAX));
+            if (capacity == capacity_) {
+                GRAPHIC_LOGE("Vector::PushBack capacity overflow\n");
+                return;
+            }
+            capacity_ = capacity;
             T* array = new T[capacity_];
             for (uint16_t i = 0; i < size_; i++) {
                 array[i] = array_[i];
@@ -0,0 +1,1650 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/imagefilter/filter_blur.h"
+#include "gfx_utils/diagram/imagefilter/filter_gaussian_blur.h"
+#include "gfx_utils/diagram/imagefilter/filter_shadow.h"
+#include "gfx_utils/diagram/rasterizer/rasterized_path_cache.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_bands.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline_packed.h"
+#include "gfx_utils/diagram/scanline/scanline_alpha_mask.h"
+#include "gfx_utils/diagram/scanline/scanline_boolean.h"
+#include "gfx_utils/diagram/scanline/scanline_storage.h"
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_linear.h"
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_lut_cache.h"
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_radial.h"
+#include "gfx_utils/diagram/spancolorfill/fill_image_rgba.h"
+#include "gfx_utils/diagram/spancolorfill/fill_pattern_rgba.h"
+#include "gfx_utils/diagram/spancolorfill/fill_solid_color.h"
+#include "gfx_utils/diagram/spancolorfill/fill_span_generator.h"
+#include "gfx_utils/diagram/vertexprimitive/geometry_path_storage.h"
+#include "securec.h"
+
+#include <chrono>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace {
+    const int32_t PANEL_WIDTH = 1024;
+    const int32_t PANEL_HEIGHT = 600;
+    const uint32_t BENCH_CELL_BLOCK_LIMIT = 8192;
+    const uint32_t MCU_CELL_BLOCK_LIMIT = 1024;
+    const uint32_t BENCH_ROUNDS = 20;
+    const uint32_t LCG_MUL = 1103515245;
+    const uint32_t LCG_ADD = 12345;
+    const uint32_t LCG_SHIFT = 16;
+
+    class BenchRandom {
+    public:
+        explicit BenchRandom(uint32_t seed) : state_(seed) {}
+        int32_t Next(int32_t range)
+        {
+            state_ = state_ * LCG_MUL + LCG_ADD;
+            return static_cast<int32_t>((state_ >> LCG_SHIFT) % static_cast<uint32_t>(range));
+        }
+
+    private:
+        uint32_t state_;
+    };
+
+    class BenchTimer {
+    public:
+        BenchTimer() : start_(std::chrono::steady_clock::now()) {}
+        double ElapsedUs() const
+        {
+            return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    /* Edges crossing the whole panel height, each one leaves about one cell per row. */
+    template <class Cells>
+    void BuildCells(Cells& cells, uint32_t edgesPerRow)
+    {
+        BenchRandom random(edgesPerRow);
+        for (uint32_t i = 0; i < edgesPerRow; i++) {
+            int32_t x1 = random.Next(PANEL_WIDTH) << POLY_SUBPIXEL_SHIFT;
+            int32_t x2 = random.Next(PANEL_WIDTH) << POLY_SUBPIXEL_SHIFT;
+            cells.LineOperate(x1, 0, x2, PANEL_HEIGHT << POLY_SUBPIXEL_SHIFT);
+        }
+    }
+
+    /* A full panel polygon with a slanted edge on every side and a star-shaped hole. */
+    void BuildFill(UICanvasVertices& path)
+    {
+        const float inset = 16.0f;
+        path.MoveTo(0, inset);
+        path.LineTo(PANEL_WIDTH - inset, 0);
+        path.LineTo(PANEL_WIDTH, PANEL_HEIGHT - inset);
+        path.LineTo(inset, PANEL_HEIGHT);
+        path.EndPoly();
+        BenchRandom random(PANEL_HEIGHT);
+        const int16_t holePoints = 64;
+        for (int16_t i = 0; i < holePoints; i++) {
+            float x = static_cast<float>(random.Next(PANEL_WIDTH));
+            float y = static_cast<float>(random.Next(PANEL_HEIGHT));
+            if (i == 0) {
+                path.MoveTo(x, y);
+            } else {
+                path.LineTo(x, y);
+            }
+        }
+        path.EndPoly();
+    }
+
+    /* A ring icon of size pixels, the outline of a checkbox or radio button mark. */
+    void BuildIcon(UICanvasVertices& path, float size)
+    {
+        const int16_t ringPoints = 32;
+        const float ringWidth = 0.2f;
+        const float origin = 8.3f;
+        float center = origin + size / 2; // 2: half
+        float outerRadius = size / 2; // 2: half
+        float innerRadius = outerRadius * (1.0f - ringWidth);
+        for (int16_t i = 0; i < ringPoints; i++) {
+            float angle = i * CIRCLE_IN_DEGREE / ringPoints;
+            float x = center + outerRadius * Sin(angle + QUARTER_IN_DEGREE);
+            float y = center + outerRadius * Sin(angle);
+            if (i == 0) {
+                path.MoveTo(x, y);
+            } else {
+                path.LineTo(x, y);
+            }
+        }
+        path.EndPoly();
+        for (int16_t i = ringPoints; i > 0; i--) {
+            float angle = i * CIRCLE_IN_DEGREE / ringPoints;
+            float x = center + innerRadius * Sin(angle + QUARTER_IN_DEGREE);
+            float y = center + innerRadius * Sin(angle);
+            if (i == ringPoints) {
+                path.MoveTo(x, y);
+            } else {
+                path.LineTo(x, y);
+            }
+        }
+        path.EndPoly();
+    }
+
+    uint32_t CountPixels(const GeometryScanline& scanline)
+    {
+        uint32_t pixels = 0;
+        uint32_t numSpans = scanline.NumSpans();
+        GeometryScanline::ConstIterator span = scanline.Begin();
+        for (; numSpans; --numSpans, ++span) {
+            pixels += span->spanLength;
+        }
+        return pixels;
+    }
+
+    /*
+     * Stand-in for a blender: every cover of a cell span is read,
+     * a solid run of the packed scanline is handled once with its single cover.
+     */
+    template <class Scanline>
+    uint64_t ConsumeCovers(const Scanline& scanline, uint32_t& coverBytes)
+    {
+        uint64_t coverage = 0;
+        uint32_t numSpans = scanline.NumSpans();
+        typename Scanline::ConstIterator span = scanline.Begin();
+        for (; numSpans; --numSpans, ++span) {
+            if (span->spanLength < 0) {
+                coverage += static_cast<uint64_t>(span->covers[0]) * static_cast<uint32_t>(-span->spanLength);
+                coverBytes++;
+                continue;
+            }
+            for (int32_t i = 0; i < span->spanLength; i++) {
+                coverage += span->covers[i];
+            }
+            coverBytes += static_cast<uint32_t>(span->spanLength);
+        }
+        return coverage;
+    }
+
+    /* The SpanBlendColor before the scratch arena, two buffers are allocated and added channel by channel per span. */
+    class SpanBlendPerCall : public SpanBase {
+    public:
+        SpanBlendPerCall(SpanBase& spanGenerator1, SpanBase& spanGenerator2)
+            : spanGenerator1_(spanGenerator1), spanGenerator2_(spanGenerator2) {}
+        void Prepare()
+        {
+            spanGenerator1_.Prepare();
+            spanGenerator2_.Prepare();
+        }
+        void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+        {
+            FillBase allocator1;
+            FillBase allocator2;
+            Rgba8T* colors1 = allocator1.Resize(len);
+            Rgba8T* colors2 = allocator2.Resize(len);
+            spanGenerator1_.Generate(colors1, x, y, len);
+            spanGenerator2_.Generate(colors2, x, y, len);
+            for (; len; --len, ++span, colors1++, colors2++) {
+                span->red = MATH_MIN(colors1->red + colors2->red, MAX_COLOR_NUM);
+                span->green = MATH_MIN(colors1->green + colors2->green, MAX_COLOR_NUM);
+                span->blue = MATH_MIN(colors1->blue + colors2->blue, MAX_COLOR_NUM);
+                span->alpha = MATH_MIN(colors1->alpha + colors2->alpha, MAX_COLOR_NUM);
+            }
+        }
+
+    private:
+        SpanBase& spanGenerator1_;
+        SpanBase& spanGenerator2_;
+    };
+
+    /* Generate spans of len pixels down the panel until about pixels colors are filled. */
+    template <class Generator>
+    double BenchGenerate(Generator& generator, uint32_t len, uint32_t pixels, std::vector<Rgba8T>& colors,
+                         uint64_t& checksum)
+    {
+        BenchTimer timer;
+        generator.Prepare();
+        for (uint32_t i = 0; i < pixels / len; i++) {
+            generator.Generate(colors.data(), static_cast<int32_t>(i % PANEL_WIDTH) - static_cast<int32_t>(len / 2),
+                               static_cast<int32_t>(i % PANEL_HEIGHT), len); // 2: start left of the panel
+            checksum += colors[len - 1].red + colors[0].blue;
+        }
+        return timer.ElapsedUs();
+    }
+
+    /* The blender of the span path, every pixel is blended from its color in the span. */
+    void BlendColorSpan(uint8_t* pixel, ColorMode mode, const Rgba8T* colors, const uint8_t* covers, uint32_t len)
+    {
+        if (mode == RGB565) {
+            uint16_t* pixels = reinterpret_cast<uint16_t*>(pixel);
+            for (uint32_t i = 0; i < len; i++) {
+                uint8_t alpha = Rgba8T::Multiply(colors[i].alpha, covers[i]);
+                uint32_t value = pixels[i];
+                uint8_t red = Rgba8T::Lerp(static_cast<uint8_t>((value >> 11) << 3), colors[i].red, alpha); // 11, 3
+                uint8_t green = Rgba8T::Lerp(static_cast<uint8_t>(((value >> 5) & 0x3F) << 2), colors[i].green,
+                                             alpha); // 5, 2: green bits
+                uint8_t blue = Rgba8T::Lerp(static_cast<uint8_t>((value & 0x1F) << 3), colors[i].blue, alpha); // 3
+                // 3, 11, 2, 5: narrow and place the channels
+                pixels[i] = static_cast<uint16_t>(((red >> 3) << 11) | ((green >> 2) << 5) | (blue >> 3));
+            }
+            return;
+        }
+        for (uint32_t i = 0; i < len; i++, pixel += 4) { // 4: bytes of ARGB8888
+            uint8_t alpha = Rgba8T::Multiply(colors[i].alpha, covers[i]);
+            pixel[0] = Rgba8T::Lerp(pixel[0], colors[i].blue, alpha);
+            pixel[1] = Rgba8T::Lerp(pixel[1], colors[i].green, alpha);
+            pixel[2] = Rgba8T::Lerp(pixel[2], colors[i].red, alpha); // 2: red byte
+            pixel[3] = Rgba8T::Prelerp(pixel[3], alpha, alpha); // 3: alpha byte
+        }
+    }
+
+    /* Replay a recorded fill, generate the span of SpanSoildColor and blend it like a blender. */
+    double BenchSpanFill(ScanlineStorage& storage, BufferInfo& dst, SpanSoildColor& solid, std::vector<Rgba8T>& colors)
+    {
+        GeometryScanline scanline;
+        uint8_t* data = static_cast<uint8_t*>(dst.virAddr);
+        uint32_t pixelBytes = (dst.mode == RGB565) ? 2 : 4; // 2, 4: bytes per pixel
+        BenchTimer timer;
+        if (storage.RewindScanlines()) {
+            scanline.Reset(storage.GetMinX(), storage.GetMaxX());
+            while (storage.SweepScanline(scanline)) {
+                int32_t y = scanline.GetYLevel();
+                uint32_t numSpans = scanline.NumSpans();
+                GeometryScanline::ConstIterator span = scanline.Begin();
+                for (; numSpans && y < dst.height; --numSpans, ++span) {
+                    int32_t len = MATH_MIN(static_cast<int32_t>(span->spanLength), dst.width - span->x);
+                    solid.Generate(colors.data(), span->x, y, len);
+                    BlendColorSpan(data + y * dst.stride + span->x * pixelBytes, dst.mode, colors.data(),
+                                   span->covers, len);
+                }
+            }
+        }
+        return timer.ElapsedUs();
+    }
+
+    /* Fill every row of the panel, a gradient background. */
+    template <class Generator>
+    double BenchBackground(Generator& generator, std::vector<Rgba8T>& colors, uint64_t& checksum)
+    {
+        BenchTimer timer;
+        generator.Prepare();
+        for (int32_t y = 0; y < PANEL_HEIGHT; y++) {
+            generator.Generate(colors.data(), 0, y, PANEL_WIDTH);
+            checksum += colors[PANEL_WIDTH - 1].red + colors[0].blue + colors[PANEL_WIDTH / 2].green; // 2: middle
+        }
+        return timer.ElapsedUs();
+    }
+
+    /* Sweep a sorted path and consume its covers, the path is rewound for every round. */
+    template <class Scanline>
+    double BenchConsume(RasterizerScanlineAntialias& rasterizer, uint64_t& coverage, uint32_t& coverBytes)
+    {
+        Scanline scanline;
+        double totalUs = 0;
+        for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+            coverage = 0;
+            coverBytes = 0;
+            if (!rasterizer.RewindScanlines()) {
+                break;
+            }
+            scanline.Reset(rasterizer.GetMinX(), rasterizer.GetMaxX());
+            BenchTimer timer;
+            while (rasterizer.SweepScanline(scanline)) {
+                coverage += ConsumeCovers(scanline, coverBytes);
+            }
+            totalUs += timer.ElapsedUs();
+        }
+        return totalUs / BENCH_ROUNDS;
+    }
+
+    template <class Rasterizer>
+    double BenchSweep(Rasterizer& rasterizer, UICanvasVertices& path, uint32_t& numSpans)
+    {
+        GeometryScanline scanline;
+        double totalUs = 0;
+        for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+            numSpans = 0;
+            BenchTimer timer;
+            rasterizer.AddPath(path);
+            if (rasterizer.RewindScanlines()) {
+                scanline.Reset(rasterizer.GetMinX(), rasterizer.GetMaxX());
+                while (rasterizer.SweepScanline(scanline)) {
+                    numSpans += scanline.NumSpans();
+                }
+            }
+            totalUs += timer.ElapsedUs();
+        }
+        return totalUs / BENCH_ROUNDS;
+    }
+
+    /* Lines of small octagon rings over the whole panel, a page of text has as many vertices. */
+    void BuildText(UICanvasVertices& path)
+    {
+        const int16_t glyphPoints = 8;
+        const float pitch = 12.0f;
+        const float outerRadius = 5.0f;
+        const float innerRadius = 3.0f;
+        for (float cy = pitch / 2; cy < PANEL_HEIGHT; cy += pitch) { // 2: half
+            for (float cx = pitch / 2; cx < PANEL_WIDTH; cx += pitch) { // 2: half
+                for (int16_t i = 0; i < glyphPoints; i++) {
+                    float angle = i * CIRCLE_IN_DEGREE / glyphPoints;
+                    float x = cx + outerRadius * Sin(angle + QUARTER_IN_DEGREE);
+                    float y = cy + outerRadius * Sin(angle);
+                    (i == 0) ? path.MoveTo(x, y) : path.LineTo(x, y);
+                }
+                path.EndPoly();
+                for (int16_t i = glyphPoints; i > 0; i--) {
+                    float angle = i * CIRCLE_IN_DEGREE / glyphPoints;
+                    float x = cx + innerRadius * Sin(angle + QUARTER_IN_DEGREE);
+                    float y = cy + innerRadius * Sin(angle);
+                    (i == glyphPoints) ? path.MoveTo(x, y) : path.LineTo(x, y);
+                }
+                path.EndPoly();
+            }
+        }
+    }
+
+    /* A zigzag polygon whose edges all cross the panel height, edges cells per row. */
+    void BuildHatch(UICanvasVertices& path, uint32_t edges)
+    {
+        BenchRandom random(edges);
+        path.MoveTo(static_cast<float>(random.Next(PANEL_WIDTH)), 0);
+        for (uint32_t i = 1; i < edges; i++) {
+            path.LineTo(static_cast<float>(random.Next(PANEL_WIDTH)), (i % 2) ? PANEL_HEIGHT : 0); // 2: zigzag
+        }
+        path.EndPoly();
+    }
+
+    /* Only the sweep, the path is sorted once and rewound for every round. */
+    double BenchSweepOnly(RasterizerScanlineAntialias& rasterizer, UICanvasVertices& path, uint32_t& numSpans)
+    {
+        const uint32_t sweepRounds = BENCH_ROUNDS * 10; // 10: the sweep alone is short
+        GeometryScanline scanline;
+        double totalUs = 0;
+        rasterizer.AddPath(path);
+        for (uint32_t round = 0; round < sweepRounds; round++) {
+            numSpans = 0;
+            if (!rasterizer.RewindScanlines()) {
+                break;
+            }
+            scanline.Reset(rasterizer.GetMinX(), rasterizer.GetMaxX());
+            BenchTimer timer;
+            while (rasterizer.SweepScanline(scanline)) {
+                numSpans += scanline.NumSpans();
+            }
+            totalUs += timer.ElapsedUs();
+        }
+        return totalUs / sweepRounds;
+    }
+
+    struct BenchShape {
+        const char* name;
+        float x1;
+        float y1;
+        float x2;
+        float y2;
+        float radius;
+    };
+
+    double BenchRoundedRect(RasterizerScanlineAntialias& rasterizer, const BenchShape& shape, uint32_t& numSpans)
+    {
+        GeometryScanline scanline;
+        double totalUs = 0;
+        for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+            numSpans = 0;
+            BenchTimer timer;
+            rasterizer.AddRoundedRect(shape.x1, shape.y1, shape.x2, shape.y2, shape.radius);
+            if (rasterizer.RewindScanlines()) {
+                scanline.Reset(rasterizer.GetMinX(), rasterizer.GetMaxX());
+                while (rasterizer.SweepScanline(scanline)) {
+                    numSpans += scanline.NumSpans();
+                }
+            }
+            totalUs += timer.ElapsedUs();
+        }
+        return totalUs / BENCH_ROUNDS;
+    }
+
+    template <class Cells>
+    double BenchCellSort(RasterizerCellsBase::CellSortMode sortMode, uint32_t edgesPerRow,
+                         uint32_t& numCells, uint32_t& peakBytes, uint32_t cellBlockLimit = BENCH_CELL_BLOCK_LIMIT)
+    {
+        double totalUs = 0;
+        for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+            Cells cells(cellBlockLimit);
+            cells.SetSortMode(sortMode);
+            BuildCells(cells, edgesPerRow);
+            BenchTimer timer;
+            cells.SortAllCells();
+            totalUs += timer.ElapsedUs();
+            numCells = cells.GetTotalCells();
+            peakBytes = cells.GetPeakMemoryUsage();
+        }
+        return totalUs / BENCH_ROUNDS;
+    }
+}
+
+class DiagramBenchmarkTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: BenchCellSort_001
+ * @tc.desc: Compare the quicksort and radix cell sort at different cells-per-row densities.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchCellSort_001, TestSize.Level1)
+{
+    const uint32_t densities[] = {2, 8, 32, 128, 256};
+    printf("%-12s %-10s %-12s %-12s\n", "cells/row", "cells", "quick(us)", "radix(us)");
+    for (uint32_t density : densities) {
+        uint32_t quickCells = 0;
+        uint32_t radixCells = 0;
+        uint32_t peakBytes = 0;
+        double quickUs = BenchCellSort<RasterizerCellsAntiAlias>(RasterizerCellsBase::CELL_SORT_QUICK,
+                                                                 density, quickCells, peakBytes);
+        double radixUs = BenchCellSort<RasterizerCellsAntiAlias>(RasterizerCellsBase::CELL_SORT_RADIX,
+                                                                 density, radixCells, peakBytes);
+        EXPECT_EQ(quickCells, radixCells);
+        printf("%-12u %-10u %-12.1f %-12.1f\n", quickCells / PANEL_HEIGHT, quickCells, quickUs, radixUs);
+    }
+}
+
+/**
+ * @tc.name: BenchCellLayout_001
+ * @tc.desc: Compare the peak memory and sort time of the default and packed cell layouts
+ *           under the cell block limit of an MCU-sized heap.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchCellLayout_001, TestSize.Level1)
+{
+    const uint32_t densities[] = {2, 8, 32};
+    printf("%-12s %-10s %-14s %-14s %-14s %-14s %-14s %-14s\n", "cells/row", "cells",
+           "quick(us)", "quick(bytes)", "radix(us)", "radix(bytes)", "packed(us)", "packed(bytes)");
+    for (uint32_t density : densities) {
+        uint32_t quickCells = 0;
+        uint32_t radixCells = 0;
+        uint32_t packedCells = 0;
+        uint32_t quickBytes = 0;
+        uint32_t radixBytes = 0;
+        uint32_t packedBytes = 0;
+        double quickUs = BenchCellSort<RasterizerCellsAntiAlias>(
+            RasterizerCellsBase::CELL_SORT_QUICK, density, quickCells, quickBytes, MCU_CELL_BLOCK_LIMIT);
+        double radixUs = BenchCellSort<RasterizerCellsAntiAlias>(
+            RasterizerCellsBase::CELL_SORT_RADIX, density, radixCells, radixBytes, MCU_CELL_BLOCK_LIMIT);
+        double packedUs = BenchCellSort<RasterizerCellsAntiAliasPacked>(
+            RasterizerCellsBase::CELL_SORT_RADIX, density, packedCells, packedBytes, MCU_CELL_BLOCK_LIMIT);
+        EXPECT_EQ(quickCells, packedCells);
+        EXPECT_EQ(radixCells, packedCells);
+        EXPECT_LT(packedBytes, quickBytes);
+        printf("%-12u %-10u %-14.1f %-14u %-14.1f %-14u %-14.1f %-14u\n", packedCells / PANEL_HEIGHT, packedCells,
+               quickUs, quickBytes, radixUs, radixBytes, packedUs, packedBytes);
+    }
+}
+
+/**
+ * @tc.name: BenchBands_001
+ * @tc.desc: Compare the serial rasterizer with the band parallel one on a full panel fill.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchBands_001, TestSize.Level1)
+{
+    UICanvasVertices path;
+    BuildFill(path);
+
+    RasterizerScanlineAntialias serialRasterizer(BENCH_CELL_BLOCK_LIMIT);
+    uint32_t serialSpans = 0;
+    double serialUs = BenchSweep(serialRasterizer, path, serialSpans);
+    printf("%-8s %-10s %-12s %-8s\n", "bands", "spans", "time(us)", "speedup");
+    printf("%-8s %-10u %-12.1f %-8.2f\n", "serial", serialSpans, serialUs, 1.0);
+
+    const uint32_t bandCounts[] = {1, 2, 4, RasterizerScanlineBands::MAX_BANDS};
+    for (uint32_t maxBands : bandCounts) {
+        RasterizerScanlineBands bandRasterizer(maxBands, BENCH_CELL_BLOCK_LIMIT);
+        uint32_t bandSpans = 0;
+        double bandUs = BenchSweep(bandRasterizer, path, bandSpans);
+        EXPECT_EQ(serialSpans, bandSpans);
+        printf("%-8u %-10u %-12.1f %-8.2f\n", bandRasterizer.GetNumBands(), bandSpans, bandUs, serialUs / bandUs);
+    }
+}
+
+/**
+ * @tc.name: BenchDense_001
+ * @tc.desc: Compare the cell and the dense coverage rasterizer on icons of growing size.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchDense_001, TestSize.Level1)
+{
+    const float sizes[] = {8, 16, 32, 64, 128, 256, 512};
+    printf("%-8s %-10s %-12s %-12s %-8s\n", "size", "spans", "cells(us)", "dense(us)", "speedup");
+    for (float size : sizes) {
+        UICanvasVertices path;
+        BuildIcon(path, size);
+
+        RasterizerScanlineAntialias cellRasterizer(BENCH_CELL_BLOCK_LIMIT);
+        cellRasterizer.SetDenseAreaLimit(0);
+        uint32_t cellSpans = 0;
+        double cellUs = BenchSweep(cellRasterizer, path, cellSpans);
+
+        RasterizerScanlineAntialias denseRasterizer(BENCH_CELL_BLOCK_LIMIT);
+        denseRasterizer.SetDenseAreaLimit(UINT32_MAX);
+        uint32_t denseSpans = 0;
+        double denseUs = BenchSweep(denseRasterizer, path, denseSpans);
+        EXPECT_EQ(cellSpans, denseSpans);
+        printf("%-8.0f %-10u %-12.1f %-12.1f %-8.2f\n", size, denseSpans, cellUs, denseUs, cellUs / denseUs);
+    }
+}
+
+/**
+ * @tc.name: BenchSweep_001
+ * @tc.desc: Time SweepScanline alone on a full panel fill and a 64 edge hatch through cells
+ *           and on an icon through the dense buffer.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchSweep_001, TestSize.Level1)
+{
+    const float iconSize = 62.0f; // 62: the ring and its edge pixels fit DENSE_AREA_LIMIT
+    const uint32_t hatchEdges = 64;
+    UICanvasVertices fillPath;
+    BuildFill(fillPath);
+    UICanvasVertices hatchPath;
+    BuildHatch(hatchPath, hatchEdges);
+    UICanvasVertices iconPath;
+    BuildIcon(iconPath, iconSize);
+
+    RasterizerScanlineAntialias fillRasterizer(BENCH_CELL_BLOCK_LIMIT);
+    uint32_t fillSpans = 0;
+    double fillUs = BenchSweepOnly(fillRasterizer, fillPath, fillSpans);
+    RasterizerScanlineAntialias hatchRasterizer(BENCH_CELL_BLOCK_LIMIT);
+    uint32_t hatchSpans = 0;
+    double hatchUs = BenchSweepOnly(hatchRasterizer, hatchPath, hatchSpans);
+    RasterizerScanlineAntialias iconRasterizer(BENCH_CELL_BLOCK_LIMIT);
+    uint32_t iconSpans = 0;
+    double iconUs = BenchSweepOnly(iconRasterizer, iconPath, iconSpans);
+    EXPECT_TRUE(iconRasterizer.IsDense());
+    printf("%-8s %-10s %-12s\n", "path", "spans", "sweep(us)");
+    printf("%-8s %-10u %-12.1f\n", "fill", fillSpans, fillUs);
+    printf("%-8s %-10u %-12.1f\n", "hatch", hatchSpans, hatchUs);
+    printf("%-8s %-10u %-12.1f\n", "icon", iconSpans, iconUs);
+}
+
+/**
+ * @tc.name: BenchShapes_001
+ * @tc.desc: Compare rectangles and rounded rectangles rasterized as paths and through the shape fast path.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchShapes_001, TestSize.Level1)
+{
+    const BenchShape shapes[] = {
+        {"button", 20.3f, 30.6f, 140.3f, 70.6f, 0},
+        {"panel", 0, 0, PANEL_WIDTH, PANEL_HEIGHT, 0},
+        {"rbutton", 20.0f, 30.0f, 140.0f, 70.0f, 8.0f},
+        {"card", 100.0f, 50.0f, 400.0f, 250.0f, 16.0f},
+        {"rpanel", 0, 0, PANEL_WIDTH, PANEL_HEIGHT, 32.0f}
+    };
+    printf("%-8s %-10s %-12s %-12s %-8s\n", "shape", "spans", "path(us)", "fast(us)", "speedup");
+    for (const BenchShape& shape : shapes) {
+        RasterizerScanlineAntialias pathRasterizer(BENCH_CELL_BLOCK_LIMIT);
+        uint32_t pathSpans = 0;
+        double pathUs = BenchRoundedRect(pathRasterizer, shape, pathSpans);
+
+        RasterizerScanlineAntialias fastRasterizer(BENCH_CELL_BLOCK_LIMIT);
+        fastRasterizer.SetShapeFastPath(true);
+        uint32_t fastSpans = 0;
+        double fastUs = BenchRoundedRect(fastRasterizer, shape, fastSpans);
+        EXPECT_NE(fastRasterizer.GetShape(), RasterizerShapeFastPath::SHAPE_PATH);
+        EXPECT_EQ(pathSpans, fastSpans);
+        printf("%-8s %-10u %-12.1f %-12.1f %-8.2f\n", shape.name, fastSpans, pathUs, fastUs, pathUs / fastUs);
+    }
+}
+
+/**
+ * @tc.name: BenchPathCache_001
+ * @tc.desc: Compare rasterizing static paths every frame with replaying them from RasterizedPathCache.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchPathCache_001, TestSize.Level1)
+{
+    const float iconSize = 96.0f;
+    const uint32_t hatchEdges = 64;
+    UICanvasVertices fillPath;
+    BuildFill(fillPath);
+    UICanvasVertices hatchPath;
+    BuildHatch(hatchPath, hatchEdges);
+    UICanvasVertices iconPath;
+    BuildIcon(iconPath, iconSize);
+    const char* names[] = {"fill", "hatch", "icon"};
+    UICanvasVertices* paths[] = {&fillPath, &hatchPath, &iconPath};
+
+    TransAffine transform;
+    RasterizedPathCache cache(PANEL_WIDTH * PANEL_HEIGHT);
+    printf("%-8s %-10s %-12s %-12s %-8s\n", "path", "spans", "raster(us)", "cached(us)", "speedup");
+    for (uint32_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        RasterizerScanlineAntialias rasterizer(BENCH_CELL_BLOCK_LIMIT);
+        uint32_t rasterSpans = 0;
+        double rasterUs = BenchSweep(rasterizer, *paths[i], rasterSpans);
+
+        GeometryScanline scanline;
+        uint32_t cachedSpans = 0;
+        double cachedUs = 0;
+        for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+            cachedSpans = 0;
+            BenchTimer timer;
+            cache.AddPath(rasterizer, *paths[i], transform);
+            if (cache.RewindScanlines()) {
+                scanline.Reset(cache.GetMinX(), cache.GetMaxX());
+                while (cache.SweepScanline(scanline)) {
+                    cachedSpans += scanline.NumSpans();
+                }
+            }
+            cachedUs += timer.ElapsedUs();
+        }
+        cachedUs /= BENCH_ROUNDS;
+        EXPECT_EQ(rasterSpans, cachedSpans);
+        printf("%-8s %-10u %-12.1f %-12.1f %-8.2f\n", names[i], cachedSpans, rasterUs, cachedUs, rasterUs / cachedUs);
+    }
+    const RasterizedPathCacheStats& stats = cache.GetStats();
+    printf("hits %u misses %u entries %u bytes %u\n", stats.hits, stats.misses, stats.entries, stats.bytes);
+}
+
+/**
+ * @tc.name: BenchClipRegion_001
+ * @tc.desc: Compare rasterizing a path once per dirty rectangle with a single pass clipped to their region,
+ * for neighbouring list items and for rectangles scattered over the panel. The single pass gains on paths
+ * with many vertices such as text, a cheap path is only worth it when the rectangles are close together.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchClipRegion_001, TestSize.Level1)
+{
+    const uint32_t numRects = 4;
+    const Rect32 listRects[numRects] = {
+        Rect32(100, 100, 599, 159),
+        Rect32(100, 160, 599, 219),
+        Rect32(100, 220, 599, 279),
+        Rect32(80, 270, 619, 339)
+    };
+    const Rect32 scatteredRects[numRects] = {
+        Rect32(20, 30, 179, 89),
+        Rect32(300, 40, 439, 199),
+        Rect32(60, 250, 259, 329),
+        Rect32(320, 300, 419, 359)
+    };
+    const char* names[] = {"list", "scatter", "list", "scatter"};
+    const Rect32* regions[] = {listRects, scatteredRects, listRects, scatteredRects};
+    UICanvasVertices fillPath;
+    BuildFill(fillPath);
+    UICanvasVertices textPath;
+    BuildText(textPath);
+    RasterizerScanlineAntialias rectRasterizer(BENCH_CELL_BLOCK_LIMIT);
+    RasterizerScanlineAntialias regionRasterizer(BENCH_CELL_BLOCK_LIMIT);
+    GeometryScanline scanline;
+    printf("%-8s %-8s %-10s %-12s %-12s %-8s\n", "path", "rects", "pixels", "per-rect(us)", "region(us)", "speedup");
+    for (uint32_t r = 0; r < sizeof(regions) / sizeof(regions[0]); r++) {
+        const Rect32* rects = regions[r];
+        bool fill = (r < 2); // 2: the fill path is clipped first
+        UICanvasVertices& path = fill ? fillPath : textPath;
+        double rectUs = 0;
+        double regionUs = 0;
+        uint32_t rectPixels = 0;
+        uint32_t regionPixels = 0;
+        for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+            rectPixels = 0;
+            BenchTimer rectTimer;
+            for (uint32_t i = 0; i < numRects; i++) {
+                rectRasterizer.Reset();
+                rectRasterizer.ClipBox(rects[i].GetLeft(), rects[i].GetTop(),
+                                       rects[i].GetRight() + 1, rects[i].GetBottom() + 1);
+                rectRasterizer.AddPath(path);
+                if (!rectRasterizer.RewindScanlines()) {
+                    continue;
+                }
+                scanline.Reset(rectRasterizer.GetMinX(), rectRasterizer.GetMaxX());
+                while (rectRasterizer.SweepScanline(scanline)) {
+                    rectPixels += CountPixels(scanline);
+                }
+            }
+            rectUs += rectTimer.ElapsedUs();
+
+            regionPixels = 0;
+            BenchTimer regionTimer;
+            EXPECT_TRUE(regionRasterizer.ClipRegion(rects, numRects));
+            regionRasterizer.AddPath(path);
+            if (regionRasterizer.RewindScanlines()) {
+                scanline.Reset(regionRasterizer.GetMinX(), regionRasterizer.GetMaxX());
+                while (regionRasterizer.SweepScanline(scanline)) {
+                    regionPixels += CountPixels(scanline);
+                }
+            }
+            regionUs += regionTimer.ElapsedUs();
+        }
+        rectUs /= BENCH_ROUNDS;
+        regionUs /= BENCH_ROUNDS;
+        // Overlapping rectangles sweep their common pixels again
+        EXPECT_GE(rectPixels, regionPixels);
+        printf("%-8s %-8s %-10u %-12.1f %-12.1f %-8.2f\n", fill ? "fill" : "text", names[r], regionPixels,
+               rectUs, regionUs, rectUs / regionUs);
+    }
+}
+
+/**
+ * @tc.name: BenchPackedScanline_001
+ * @tc.desc: Compare sweeping and reading the covers of GeometryScanline and GeometryScanlinePacked.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchPackedScanline_001, TestSize.Level1)
+{
+    const float iconSize = 96.0f;
+    const uint32_t hatchEdges = 64;
+    UICanvasVertices fillPath;
+    BuildFill(fillPath);
+    UICanvasVertices hatchPath;
+    BuildHatch(hatchPath, hatchEdges);
+    UICanvasVertices iconPath;
+    BuildIcon(iconPath, iconSize);
+    const char* names[] = {"fill", "hatch", "icon"};
+    UICanvasVertices* paths[] = {&fillPath, &hatchPath, &iconPath};
+
+    printf("%-8s %-12s %-12s %-12s %-12s %-8s\n", "path", "covers", "packed", "plain(us)", "packed(us)", "speedup");
+    for (uint32_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        RasterizerScanlineAntialias rasterizer(BENCH_CELL_BLOCK_LIMIT);
+        rasterizer.AddPath(*paths[i]);
+        uint64_t plainCoverage = 0;
+        uint32_t plainBytes = 0;
+        double plainUs = BenchConsume<GeometryScanline>(rasterizer, plainCoverage, plainBytes);
+        uint64_t packedCoverage = 0;
+        uint32_t packedBytes = 0;
+        double packedUs = BenchConsume<GeometryScanlinePacked>(rasterizer, packedCoverage, packedBytes);
+        EXPECT_EQ(plainCoverage, packedCoverage);
+        printf("%-8s %-12u %-12u %-12.1f %-12.1f %-8.2f\n", names[i], plainBytes, packedBytes,
+               plainUs, packedUs, plainUs / packedUs);
+    }
+}
+
+/**
+ * @tc.name: BenchScanlineStorage_001
+ * @tc.desc: Compare rasterizing a shape and its shadow with recording the shape once and replaying it twice,
+ * the second time moved by the shadow offset.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchScanlineStorage_001, TestSize.Level1)
+{
+    const float iconSize = 96.0f;
+    const uint32_t hatchEdges = 64;
+    const int32_t shadowOffset = 4;
+    UICanvasVertices fillPath;
+    BuildFill(fillPath);
+    UICanvasVertices hatchPath;
+    BuildHatch(hatchPath, hatchEdges);
+    UICanvasVertices iconPath;
+    BuildIcon(iconPath, iconSize);
+    const char* names[] = {"fill", "hatch", "icon"};
+    UICanvasVertices* paths[] = {&fillPath, &hatchPath, &iconPath};
+
+    ScanlineStorage storage;
+    GeometryScanlinePacked scanline;
+    printf("%-8s %-10s %-12s %-12s %-8s\n", "path", "bytes", "raster(us)", "stored(us)", "speedup");
+    for (uint32_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        RasterizerScanlineAntialias rasterizer(BENCH_CELL_BLOCK_LIMIT);
+        uint32_t rasterSpans = 0;
+        double rasterUs = BenchSweep(rasterizer, *paths[i], rasterSpans) * 2; // 2: the shape and its shadow
+
+        double storedUs = 0;
+        for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+            BenchTimer timer;
+            rasterizer.AddPath(*paths[i]);
+            storage.Record(rasterizer);
+            for (int32_t offset = 0; offset <= shadowOffset; offset += shadowOffset) {
+                storage.SetOffset(offset, offset);
+                if (storage.RewindScanlines()) {
+                    scanline.Reset(storage.GetMinX(), storage.GetMaxX());
+                    while (storage.SweepScanline(scanline)) {
+                    }
+                }
+            }
+            storedUs += timer.ElapsedUs();
+        }
+        storedUs /= BENCH_ROUNDS;
+        printf("%-8s %-10u %-12.1f %-12.1f %-8.2f\n", names[i], storage.GetSerializedSize(), rasterUs, storedUs,
+               rasterUs / storedUs);
+    }
+}
+
+/**
+ * @tc.name: BenchScanlineBoolean_001
+ * @tc.desc: Compare clipping a fill to a ring shape by intersecting their scanlines with
+ * painting the clip shape into a panel sized A8 mask and multiplying the fill covers with it.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchScanlineBoolean_001, TestSize.Level1)
+{
+    const float clipSize = 480.0f;
+    UICanvasVertices fillPath;
+    BuildFill(fillPath);
+    UICanvasVertices clipPath;
+    BuildIcon(clipPath, clipSize);
+    RasterizerScanlineAntialias fillRasterizer(BENCH_CELL_BLOCK_LIMIT);
+    RasterizerScanlineAntialias clipRasterizer(BENCH_CELL_BLOCK_LIMIT);
+    GeometryScanlinePacked scanline;
+    std::vector<uint8_t> mask(PANEL_WIDTH * PANEL_HEIGHT);
+
+    double maskUs = 0;
+    double boolUs = 0;
+    uint64_t maskCoverage = 0;
+    uint64_t boolCoverage = 0;
+    uint32_t coverBytes = 0;
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        maskCoverage = 0;
+        BenchTimer maskTimer;
+        memset_s(mask.data(), mask.size(), 0, mask.size());
+        clipRasterizer.AddPath(clipPath);
+        if (clipRasterizer.RewindScanlines()) {
+            scanline.Reset(clipRasterizer.GetMinX(), clipRasterizer.GetMaxX());
+            while (clipRasterizer.SweepScanline(scanline)) {
+                uint8_t* row = mask.data() + scanline.GetYLevel() * PANEL_WIDTH;
+                uint32_t numSpans = scanline.NumSpans();
+                GeometryScanlinePacked::ConstIterator span = scanline.Begin();
+                for (; numSpans; --numSpans, ++span) {
+                    bool solid = span->spanLength < 0;
+                    int32_t len = solid ? -span->spanLength : span->spanLength;
+                    for (int32_t x = 0; x < len; x++) {
+                        row[span->x + x] = solid ? span->covers[0] : span->covers[x];
+                    }
+                }
+            }
+        }
+        fillRasterizer.AddPath(fillPath);
+        if (fillRasterizer.RewindScanlines()) {
+            scanline.Reset(fillRasterizer.GetMinX(), fillRasterizer.GetMaxX());
+            while (fillRasterizer.SweepScanline(scanline)) {
+                const uint8_t* row = mask.data() + scanline.GetYLevel() * PANEL_WIDTH;
+                uint32_t numSpans = scanline.NumSpans();
+                GeometryScanlinePacked::ConstIterator span = scanline.Begin();
+                for (; numSpans; --numSpans, ++span) {
+                    bool solid = span->spanLength < 0;
+                    int32_t len = solid ? -span->spanLength : span->spanLength;
+                    for (int32_t x = 0; x < len; x++) {
+                        uint32_t cover = solid ? span->covers[0] : span->covers[x];
+                        maskCoverage += ScanlineBooleanBase::CombineCovers(BOOL_INTERSECT, cover, row[span->x + x]);
+                    }
+                }
+            }
+        }
+        maskUs += maskTimer.ElapsedUs();
+
+        boolCoverage = 0;
+        coverBytes = 0;
+        BenchTimer boolTimer;
+        fillRasterizer.AddPath(fillPath);
+        clipRasterizer.AddPath(clipPath);
+        ScanlineBoolean<RasterizerScanlineAntialias, RasterizerScanlineAntialias> clipped(fillRasterizer,
+            clipRasterizer, BOOL_INTERSECT);
+        if (clipped.RewindScanlines()) {
+            scanline.Reset(clipped.GetMinX(), clipped.GetMaxX());
+            while (clipped.SweepScanline(scanline)) {
+                boolCoverage += ConsumeCovers(scanline, coverBytes);
+            }
+        }
+        boolUs += boolTimer.ElapsedUs();
+    }
+    maskUs /= BENCH_ROUNDS;
+    boolUs /= BENCH_ROUNDS;
+    EXPECT_EQ(maskCoverage, boolCoverage);
+    printf("%-10s %-12s %-12s %-8s\n", "covers", "mask(us)", "boolean(us)", "speedup");
+    printf("%-10u %-12.1f %-12.1f %-8.2f\n", coverBytes, maskUs, boolUs, maskUs / boolUs);
+}
+
+/**
+ * @tc.name: BenchScanlineAlphaMask_001
+ * @tc.desc: Compare masking the covers of a recorded fill with a scalar per pixel multiply
+ * and with ScanlineAlphaMask, whose kernel multiplies 8 covers per vector.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchScanlineAlphaMask_001, TestSize.Level1)
+{
+    const float clipSize = 480.0f;
+    const uint32_t argbBytes = 4;
+    UICanvasVertices fillPath;
+    BuildFill(fillPath);
+    UICanvasVertices clipPath;
+    BuildIcon(clipPath, clipSize);
+    RasterizerScanlineAntialias rasterizer(BENCH_CELL_BLOCK_LIMIT);
+    rasterizer.AddPath(clipPath);
+    AlphaMaskBuffer alphaMask;
+    EXPECT_TRUE(alphaMask.Resize(PANEL_WIDTH, PANEL_HEIGHT));
+    alphaMask.AddShape(rasterizer);
+    rasterizer.AddPath(fillPath);
+    ScanlineStorage fill;
+    EXPECT_TRUE(fill.Record(rasterizer));
+    GeometryScanline scanline;
+    ScanlineAlphaMask<ScanlineStorage> masked(fill, alphaMask);
+
+    double scalarUs = 0;
+    double simdUs = 0;
+    uint64_t scalarCoverage = 0;
+    uint64_t simdCoverage = 0;
+    uint32_t coverBytes = 0;
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        scalarCoverage = 0;
+        BenchTimer scalarTimer;
+        if (fill.RewindScanlines()) {
+            scanline.Reset(fill.GetMinX(), fill.GetMaxX());
+            while (fill.SweepScanline(scanline)) {
+                const uint8_t* row = alphaMask.GetRow(scanline.GetYLevel());
+                uint32_t numSpans = scanline.NumSpans();
+                GeometryScanline::Iterator span = scanline.Begin();
+                for (; numSpans; --numSpans, ++span) {
+                    for (int32_t x = 0; x < span->spanLength; x++) {
+                        uint32_t value = span->covers[x] * row[span->x + x] + 128; // 128: round to nearest
+                        span->covers[x] = static_cast<uint8_t>((value + (value >> 8)) >> 8); // 8: divide by 255
+                    }
+                }
+                uint32_t unused = 0;
+                scalarCoverage += ConsumeCovers(scanline, unused);
+            }
+        }
+        scalarUs += scalarTimer.ElapsedUs();
+
+        simdCoverage = 0;
+        coverBytes = 0;
+        BenchTimer simdTimer;
+        if (masked.RewindScanlines()) {
+            scanline.Reset(masked.GetMinX(), masked.GetMaxX());
+            while (masked.SweepScanline(scanline)) {
+                simdCoverage += ConsumeCovers(scanline, coverBytes);
+            }
+        }
+        simdUs += simdTimer.ElapsedUs();
+    }
+    scalarUs /= BENCH_ROUNDS;
+    simdUs /= BENCH_ROUNDS;
+    EXPECT_EQ(scalarCoverage, simdCoverage);
+    printf("%-10s %-12s %-12s %-12s %-8s\n", "covers", "maskBytes", "scalar(us)", "simd(us)", "speedup");
+    printf("%-10u %-12u %-12.1f %-12.1f %-8.2f\n", coverBytes, PANEL_WIDTH * PANEL_HEIGHT, scalarUs, simdUs,
+           scalarUs / simdUs);
+    printf("an ARGB layer of the panel would take %u bytes\n", PANEL_WIDTH * PANEL_HEIGHT * argbBytes);
+}
+
+/**
+ * @tc.name: BenchSpanDispatch_001
+ * @tc.desc: Compare the gradient span generator called through SpanBase and Gradient vtables
+ * with SpanGradient, whose interpolator, gradient function and lut are template parameters.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchSpanDispatch_001, TestSize.Level1)
+{
+    const uint32_t pixels = 1 << 18; // 18: fill 256K colors per span length
+    const uint32_t spanLengths[] = {4, 16, 64, 256, 1024};
+    const float distance = 600.0f;
+    FillGradientLut lut;
+    lut.AddColor(0.0f, Rgba8T(255, 0, 0, 255));
+    lut.AddColor(1.0f, Rgba8T(0, 0, 255, 255));
+    lut.BuildLut();
+    TransAffine transform;
+    transform.Rotate(0.3f); // 0.3: a rotated gradient
+    FillInterpolator interpolator(transform);
+    GradientLinearCalculate linear;
+    GradientRadialCalculate radial(distance, 0, 0);
+    FillGradient virtualLinear(interpolator, linear, lut, 0, distance);
+    FillGradient virtualRadial(interpolator, radial, lut, 0, distance);
+    SpanGradient<FillInterpolator, GradientLinearCalculate, FillGradientLut> staticLinear(interpolator, linear,
+                                                                                          lut, 0, distance);
+    SpanGradient<FillInterpolator, GradientRadialCalculate, FillGradientLut> staticRadial(interpolator, radial,
+                                                                                          lut, 0, distance);
+    SpanBase& linearBase = virtualLinear;
+    SpanBase& radialBase = virtualRadial;
+    std::vector<Rgba8T> colors(PANEL_WIDTH);
+
+    printf("%-8s %-14s %-14s %-8s %-14s %-14s %-8s\n", "length", "linearVirt(us)", "linearStat(us)", "speedup",
+           "radialVirt(us)", "radialStat(us)", "speedup");
+    for (uint32_t len : spanLengths) {
+        double timeUs[4] = {0}; // 4: two gradients, virtual and static
+        uint64_t checksum[4] = {0}; // 4: two gradients, virtual and static
+        for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+            timeUs[0] += BenchGenerate(linearBase, len, pixels, colors, checksum[0]);
+            timeUs[1] += BenchGenerate(staticLinear, len, pixels, colors, checksum[1]);
+            timeUs[2] += BenchGenerate(radialBase, len, pixels, colors, checksum[2]); // 2: radial virtual
+            timeUs[3] += BenchGenerate(staticRadial, len, pixels, colors, checksum[3]); // 3: radial static
+        }
+        EXPECT_EQ(checksum[0], checksum[1]);
+        EXPECT_EQ(checksum[2], checksum[3]); // 2, 3: radial virtual and static
+        printf("%-8u %-14.1f %-14.1f %-8.2f %-14.1f %-14.1f %-8.2f\n", len, timeUs[0] / BENCH_ROUNDS,
+               timeUs[1] / BENCH_ROUNDS, timeUs[0] / timeUs[1], timeUs[2] / BENCH_ROUNDS, // 2: radial virtual
+               timeUs[3] / BENCH_ROUNDS, timeUs[2] / timeUs[3]); // 2, 3: radial virtual and static
+    }
+}
+
+/**
+ * @tc.name: BenchSpanBlend_001
+ * @tc.desc: Compare blending two spans with buffers allocated per span and a per channel add
+ * with SpanBlendColor borrowing from a scratch arena and adding with a saturating vector add.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchSpanBlend_001, TestSize.Level1)
+{
+    const uint32_t pixels = 1 << 18; // 18: fill 256K colors per span length
+    const uint32_t spanLengths[] = {4, 16, 64, 256, 1024};
+    SpanSoildColor color1(Rgba8T(200, 100, 0, 128));
+    SpanSoildColor color2(Rgba8T(100, 100, 30, 255));
+    SpanScratchArena arena;
+    SpanBlendPerCall perCall(color1, color2);
+    SpanBlendColor borrowed(color1, color2, arena);
+    std::vector<Rgba8T> colors(PANEL_WIDTH);
+
+    printf("%-8s %-14s %-14s %-8s\n", "length", "perCall(us)", "arena(us)", "speedup");
+    for (uint32_t len : spanLengths) {
+        double perCallUs = 0;
+        double arenaUs = 0;
+        uint64_t perCallSum = 0;
+        uint64_t arenaSum = 0;
+        for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+            perCallUs += BenchGenerate(perCall, len, pixels, colors, perCallSum);
+            arenaUs += BenchGenerate(borrowed, len, pixels, colors, arenaSum);
+        }
+        EXPECT_EQ(perCallSum, arenaSum);
+        EXPECT_EQ(arena.GetNumBorrowed(), 0u);
+        printf("%-8u %-14.1f %-14.1f %-8.2f\n", len, perCallUs / BENCH_ROUNDS, arenaUs / BENCH_ROUNDS,
+               perCallUs / arenaUs);
+    }
+}
+
+/**
+ * @tc.name: BenchSolidFill_001
+ * @tc.desc: Compare filling a recorded shape with the span of SpanSoildColor blended per pixel
+ * with FillSolidColor, which blends the color through the covers with vector kernels.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchSolidFill_001, TestSize.Level1)
+{
+    const ColorMode modes[] = {ARGB8888, RGB565};
+    const char* modeNames[] = {"ARGB8888", "RGB565"};
+    const Rgba8T colors[] = {Rgba8T(40, 180, 220, 255), Rgba8T(40, 180, 220, 160)}; // opaque and translucent
+    UICanvasVertices path;
+    BuildFill(path);
+    RasterizerScanlineAntialias rasterizer(BENCH_CELL_BLOCK_LIMIT);
+    rasterizer.AddPath(path);
+    ScanlineStorage storage;
+    EXPECT_TRUE(storage.Record(rasterizer));
+    std::vector<Rgba8T> span(PANEL_WIDTH);
+
+    printf("%-10s %-6s %-12s %-12s %-12s %-8s %-8s\n", "mode", "alpha", "spans(us)", "solid(us)", "packed(us)",
+           "speedup", "packed");
+    for (uint32_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        for (const Rgba8T& color : colors) {
+            uint32_t stride = PANEL_WIDTH * ((modes[m] == RGB565) ? 2 : 4); // 2, 4: bytes per pixel
+            std::vector<uint8_t> spanData(stride * PANEL_HEIGHT, 0x5A); // 0x5A: the background
+            std::vector<uint8_t> solidData(spanData);
+            std::vector<uint8_t> packedData(spanData);
+            BufferInfo dst = {};
+            dst.virAddr = spanData.data();
+            dst.stride = stride;
+            dst.width = PANEL_WIDTH;
+            dst.height = PANEL_HEIGHT;
+            dst.mode = modes[m];
+            SpanSoildColor solid(color);
+            FillSolidColor fill;
+            fill.SetColor(color);
+            GeometryScanline scanline;
+            GeometryScanlinePacked packed;
+            double timeUs[3] = {0}; // 3: span, solid and packed solid
+            for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+                dst.virAddr = spanData.data();
+                timeUs[0] += BenchSpanFill(storage, dst, solid, span);
+                dst.virAddr = solidData.data();
+                EXPECT_TRUE(fill.Attach(dst));
+                BenchTimer solidTimer;
+                fill.RenderScanlines(storage, scanline);
+                timeUs[1] += solidTimer.ElapsedUs();
+                dst.virAddr = packedData.data();
+                EXPECT_TRUE(fill.Attach(dst));
+                BenchTimer packedTimer;
+                fill.RenderScanlines(storage, packed);
+                timeUs[2] += packedTimer.ElapsedUs(); // 2: packed solid
+            }
+            EXPECT_EQ(spanData, solidData);
+            EXPECT_EQ(spanData, packedData);
+            printf("%-10s %-6u %-12.1f %-12.1f %-12.1f %-8.2f %-8.2f\n", modeNames[m], color.alpha,
+                   timeUs[0] / BENCH_ROUNDS, timeUs[1] / BENCH_ROUNDS, timeUs[2] / BENCH_ROUNDS, // 2: packed solid
+                   timeUs[0] / timeUs[1], timeUs[0] / timeUs[2]); // 2: packed solid
+        }
+    }
+}
+
+/**
+ * @tc.name: BenchLinearGradient_001
+ * @tc.desc: Compare a full panel linear gradient of FillGradient and SpanGradient, which interpolate
+ * and divide per pixel, with SpanLinearGradient stepping along the span, for each spread mode.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchLinearGradient_001, TestSize.Level1)
+{
+    const float distance = 700.0f;
+    FillGradientLut lut;
+    lut.AddColor(0.0f, Rgba8T(255, 0, 0, 255));
+    lut.AddColor(0.5f, Rgba8T(0, 255, 0, 255)); // 0.5: the middle stop
+    lut.AddColor(1.0f, Rgba8T(0, 0, 255, 255));
+    lut.BuildLut();
+    TransAffine transform;
+    transform.Rotate(0.3f); // 0.3: a rotated gradient
+    FillInterpolator interpolator(transform);
+    GradientLinearCalculate linear;
+    FillGradient virtualLinear(interpolator, linear, lut, 0, distance);
+    SpanGradient<FillInterpolator, GradientLinearCalculate, FillGradientLut> staticLinear(interpolator, linear,
+                                                                                          lut, 0, distance);
+    SpanLinearGradient padded(interpolator, lut, distance);
+    SpanLinearGradient repeated(interpolator, lut, distance / 3, GRADIENT_SPREAD_REPEAT); // 3: repeat 3 times
+    SpanLinearGradient reflected(interpolator, lut, distance / 3, GRADIENT_SPREAD_REFLECT); // 3: reflect 3 times
+    SpanBase& linearBase = virtualLinear;
+    std::vector<Rgba8T> colors(PANEL_WIDTH);
+
+    double timeUs[5] = {0}; // 5: virtual, static and the three spread modes
+    uint64_t checksum[5] = {0}; // 5: virtual, static and the three spread modes
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        timeUs[0] += BenchBackground(linearBase, colors, checksum[0]);
+        timeUs[1] += BenchBackground(staticLinear, colors, checksum[1]);
+        timeUs[2] += BenchBackground(padded, colors, checksum[2]); // 2: pad
+        timeUs[3] += BenchBackground(repeated, colors, checksum[3]); // 3: repeat
+        timeUs[4] += BenchBackground(reflected, colors, checksum[4]); // 4: reflect
+    }
+    EXPECT_EQ(checksum[0], checksum[1]);
+    printf("%-12s %-12s %-12s %-12s %-12s %-8s\n", "virtual(us)", "static(us)", "pad(us)", "repeat(us)",
+           "reflect(us)", "speedup");
+    printf("%-12.1f %-12.1f %-12.1f %-12.1f %-12.1f %-8.2f\n", timeUs[0] / BENCH_ROUNDS, timeUs[1] / BENCH_ROUNDS,
+           timeUs[2] / BENCH_ROUNDS, timeUs[3] / BENCH_ROUNDS, timeUs[4] / BENCH_ROUNDS, // 2, 3, 4: spread modes
+           timeUs[0] / timeUs[2]); // 2: pad
+}
+
+/**
+ * @tc.name: BenchRadialGradient_001
+ * @tc.desc: Compare a full panel focal gradient of FillGradient and SpanGradient, which interpolate
+ * and take a square root per pixel, with SpanRadialGradient in float vectors and in fixed point.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchRadialGradient_001, TestSize.Level1)
+{
+    const float radius = 500.0f;
+    FillGradientLut lut;
+    lut.AddColor(0.0f, Rgba8T(255, 0, 0, 255));
+    lut.AddColor(0.5f, Rgba8T(0, 255, 0, 255)); // 0.5: the middle stop
+    lut.AddColor(1.0f, Rgba8T(0, 0, 255, 255));
+    lut.BuildLut();
+    TransAffine transform;
+    transform.Translate(-PANEL_WIDTH / 2, -PANEL_HEIGHT / 2); // 2: centered on the panel
+    FillInterpolator interpolator(transform);
+    GradientRadialCalculate radial(radius, 120.0f, -80.0f); // 120, -80: the focal point
+    FillGradient virtualRadial(interpolator, radial, lut, 0, radius);
+    SpanGradient<FillInterpolator, GradientRadialCalculate, FillGradientLut> staticRadial(interpolator, radial,
+                                                                                          lut, 0, radius);
+    SpanRadialGradient stepped(interpolator, lut, 0, radius, 120.0f, -80.0f); // 120, -80: the focal point
+    /* Both paths of SpanRadialGradient through the same Generate signature. */
+    struct FloatPath {
+        explicit FloatPath(SpanRadialGradient& gradient) : gradient_(gradient) {}
+        void Prepare() {}
+        void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+        {
+            gradient_.GenerateFloat(span, x, y, len);
+        }
+        SpanRadialGradient& gradient_;
+    } floatPath(stepped);
+    struct FixedPath {
+        explicit FixedPath(SpanRadialGradient& gradient) : gradient_(gradient) {}
+        void Prepare() {}
+        void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+        {
+            gradient_.GenerateFixedPoint(span, x, y, len);
+        }
+        SpanRadialGradient& gradient_;
+    } fixedPath(stepped);
+    SpanBase& radialBase = virtualRadial;
+    std::vector<Rgba8T> colors(PANEL_WIDTH);
+
+    double timeUs[4] = {0}; // 4: virtual, static, float and fixed point
+    uint64_t checksum[4] = {0}; // 4: virtual, static, float and fixed point
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        timeUs[0] += BenchBackground(radialBase, colors, checksum[0]);
+        timeUs[1] += BenchBackground(staticRadial, colors, checksum[1]);
+        timeUs[2] += BenchBackground(floatPath, colors, checksum[2]); // 2: float
+        timeUs[3] += BenchBackground(fixedPath, colors, checksum[3]); // 3: fixed point
+    }
+    EXPECT_EQ(checksum[0], checksum[1]);
+    printf("%-12s %-12s %-12s %-12s %-8s %-8s\n", "virtual(us)", "static(us)", "float(us)", "fixed(us)",
+           "float", "fixed");
+    printf("%-12.1f %-12.1f %-12.1f %-12.1f %-8.2f %-8.2f\n", timeUs[0] / BENCH_ROUNDS, timeUs[1] / BENCH_ROUNDS,
+           timeUs[2] / BENCH_ROUNDS, timeUs[3] / BENCH_ROUNDS, timeUs[0] / timeUs[2], // 2: float
+           timeUs[0] / timeUs[3]); // 3: fixed point
+}
+
+/**
+ * @tc.name: BenchGradientLut_001
+ * @tc.desc: Compare building a gradient lut with the float ColorInterpolator, with the integer
+ * interpolation of FillGradientLutCache, and FillGradientLut::BuildLut finding it in the cache.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchGradientLut_001, TestSize.Level1)
+{
+    const uint32_t builds = 2000;
+    const GradientColorStop stops[] = {
+        GradientColorStop(0.0f, Rgba8T(255, 0, 0, 255)),
+        GradientColorStop(0.3f, Rgba8T(0, 255, 0, 128)), // 0.3: a stop, 128: half alpha
+        GradientColorStop(0.6f, Rgba8T(0, 0, 255, 255)), // 0.6: a stop
+        GradientColorStop(1.0f, Rgba8T(255, 255, 255, 0)),
+    };
+    const uint32_t numStops = sizeof(stops) / sizeof(stops[0]);
+    std::vector<Rgba8T> colors(COLOR_LUT_SIZE);
+    FillGradientLut lut;
+
+    double timeUs[3] = {0}; // 3: float, integer and cached
+    uint64_t checksum[3] = {0}; // 3: float, integer and cached
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        BenchTimer floatTimer;
+        for (uint32_t build = 0; build < builds; build++) {
+            uint32_t start = 0;
+            for (uint32_t index = 1; index < numStops; index++) {
+                uint32_t end = static_cast<uint32_t>(stops[index].offset * COLOR_LUT_SIZE);
+                ColorInterpolator ci(stops[index - 1].color, stops[index].color, end - start + 1);
+                for (; start < end; ++ci, ++start) {
+                    colors[start] = ci.GetColor();
+                }
+            }
+            checksum[0] += colors[build % COLOR_LUT_SIZE].red;
+        }
+        timeUs[0] += floatTimer.ElapsedUs();
+        BenchTimer integerTimer;
+        for (uint32_t build = 0; build < builds; build++) {
+            FillGradientLutCache::BuildLut(stops, numStops, colors.data(), COLOR_LUT_SIZE);
+            checksum[1] += colors[build % COLOR_LUT_SIZE].red;
+        }
+        timeUs[1] += integerTimer.ElapsedUs();
+        BenchTimer cachedTimer;
+        for (uint32_t build = 0; build < builds; build++) {
+            lut.RemoveAll();
+            for (uint32_t index = 0; index < numStops; index++) {
+                lut.AddColor(stops[index].offset, stops[index].color);
+            }
+            lut.BuildLut();
+            checksum[2] += lut[build % COLOR_LUT_SIZE].red; // 2: cached
+        }
+        timeUs[2] += cachedTimer.ElapsedUs(); // 2: cached
+    }
+    EXPECT_EQ(checksum[0], checksum[1]);
+    EXPECT_EQ(checksum[0], checksum[2]); // 2: cached
+    printf("%-12s %-12s %-12s %-8s %-8s\n", "float(us)", "integer(us)", "cached(us)", "integer", "cached");
+    printf("%-12.1f %-12.1f %-12.1f %-8.2f %-8.2f\n", timeUs[0] / BENCH_ROUNDS, timeUs[1] / BENCH_ROUNDS,
+           timeUs[2] / BENCH_ROUNDS, timeUs[0] / timeUs[1], timeUs[0] / timeUs[2]); // 2: cached
+}
+
+/**
+ * @tc.name: BenchPattern_001
+ * @tc.desc: Compare a full panel tiled pattern of the former per pixel FillPatternRgba, which
+ * checked the repeat mode and wrapped every pixel, with the runs of the repeat mode generator,
+ * against copying the same bytes with memcpy.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchPattern_001, TestSize.Level1)
+{
+    const int32_t tileSize = 64;
+    std::vector<Color32> tile(tileSize * tileSize);
+    for (uint32_t i = 0; i < tile.size(); i++) {
+        tile[i].full = i * 2654435761u; // 2654435761: spread the colors
+    }
+    ImageInfo image = {};
+    image.header.colorMode = ARGB8888;
+    image.header.width = tileSize;
+    image.header.height = tileSize;
+    image.data = reinterpret_cast<const uint8_t*>(tile.data());
+    /* The former generator for REPEAT, which wrapped and converted every pixel. */
+    struct PerPixelPattern {
+        const Color32* colors;
+        int32_t size;
+        void Prepare() {}
+        void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+        {
+            for (; len; --len, span++, x++) {
+                x = x % size;
+                y = y % size;
+                const Color32& color = colors[size * y + x];
+                span->red = color.red;
+                span->green = color.green;
+                span->blue = color.blue;
+                span->alpha = color.alpha;
+            }
+        }
+    } perPixel = {tile.data(), tileSize};
+    FillPatternRgba pattern(&image, REPEAT, 0, 0);
+    SpanPatternRgba<REPEAT> repeated(&image, 0, 0);
+    std::vector<Rgba8T> colors(PANEL_WIDTH);
+
+    double timeUs[4] = {0}; // 4: per pixel, FillPatternRgba, SpanPatternRgba and memcpy
+    uint64_t checksum[4] = {0}; // 4: per pixel, FillPatternRgba, SpanPatternRgba and memcpy
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        timeUs[0] += BenchBackground(perPixel, colors, checksum[0]);
+        timeUs[1] += BenchBackground(pattern, colors, checksum[1]);
+        timeUs[2] += BenchBackground(repeated, colors, checksum[2]); // 2: SpanPatternRgba
+        BenchTimer timer;
+        for (int32_t y = 0; y < PANEL_HEIGHT; y++) {
+            const Color32* row = tile.data() + (y % tileSize) * tileSize;
+            for (int32_t x = 0; x < PANEL_WIDTH; x += tileSize) {
+                uint32_t bytes = MATH_MIN(tileSize, PANEL_WIDTH - x) * sizeof(Color32);
+                if (memcpy_s(&colors[x], (PANEL_WIDTH - x) * sizeof(Rgba8T), row, bytes) != EOK) {
+                    break;
+                }
+            }
+            checksum[3] += colors[y % PANEL_WIDTH].red; // 3: memcpy
+        }
+        timeUs[3] += timer.ElapsedUs(); // 3: memcpy
+    }
+    EXPECT_EQ(checksum[0], checksum[1]);
+    EXPECT_EQ(checksum[0], checksum[2]); // 2: SpanPatternRgba
+    printf("%-14s %-16s %-16s %-12s %-8s\n", "perPixel(us)", "fillPattern(us)", "spanPattern(us)", "memcpy(us)",
+           "speedup");
+    printf("%-14.1f %-16.1f %-16.1f %-12.1f %-8.2f\n", timeUs[0] / BENCH_ROUNDS, timeUs[1] / BENCH_ROUNDS,
+           timeUs[2] / BENCH_ROUNDS, timeUs[3] / BENCH_ROUNDS, timeUs[0] / timeUs[1]); // 2, 3: columns
+}
+
+/**
+ * @tc.name: BenchImage_001
+ * @tc.desc: Compare a full panel of a rotated and scaled image sampled per pixel with float
+ * bilinear weights, with the nearest, bilinear and box filters of SpanImageRgba, and bilinear
+ * from an RGB565 image.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchImage_001, TestSize.Level1)
+{
+    const int32_t imageSize = 512;
+    std::vector<Color32> pixels(imageSize * imageSize);
+    for (uint32_t i = 0; i < pixels.size(); i++) {
+        pixels[i].full = i * 2654435761u; // 2654435761: spread the colors
+    }
+    ImageInfo image = {};
+    image.header.colorMode = ARGB8888;
+    image.header.width = imageSize;
+    image.header.height = imageSize;
+    image.data = reinterpret_cast<const uint8_t*>(pixels.data());
+    ImageInfo image565 = image;
+    image565.header.colorMode = RGB565;
+    TransAffine transform;
+    transform.Rotate(0.5f);       // 0.5: rotate by about 30 degrees
+    transform.Scale(0.8f, 0.8f);  // 0.8: magnify a little
+    /* Transforms every pixel center and weights its 4 pixels with floats. */
+    struct FloatBilinear {
+        const TransAffine* transform;
+        const Color32* pixels;
+        int32_t size;
+        void Prepare() {}
+        void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+        {
+            for (; len; --len, span++, x++) {
+                float sampleX = x + 0.5f; // 0.5: the pixel center
+                float sampleY = y + 0.5f; // 0.5: the pixel center
+                transform->Transform(&sampleX, &sampleY);
+                sampleX -= 0.5f; // 0.5: relative to the image pixel centers
+                sampleY -= 0.5f; // 0.5: relative to the image pixel centers
+                int32_t left = static_cast<int32_t>(floorf(sampleX));
+                int32_t top = static_cast<int32_t>(floorf(sampleY));
+                float weightX = sampleX - left;
+                float weightY = sampleY - top;
+                float channels[4] = {0}; // 4: channels
+                for (int32_t corner = 0; corner < 4; corner++) { // 4: corners
+                    int32_t cornerX = left + (corner & 1);
+                    int32_t cornerY = top + (corner >> 1);
+                    if (cornerX < 0 || cornerY < 0 || cornerX >= size || cornerY >= size) {
+                        continue;
+                    }
+                    float weight = ((corner & 1) ? weightX : 1 - weightX) * ((corner >> 1) ? weightY : 1 - weightY);
+                    const Color32& color = pixels[cornerY * size + cornerX];
+                    channels[0] += color.red * weight;
+                    channels[1] += color.green * weight;
+                    channels[2] += color.blue * weight;  // 2: blue
+                    channels[3] += color.alpha * weight; // 3: alpha
+                }
+                span->red = static_cast<uint8_t>(channels[0] + 0.5f);   // 0.5: round
+                span->green = static_cast<uint8_t>(channels[1] + 0.5f); // 0.5: round
+                span->blue = static_cast<uint8_t>(channels[2] + 0.5f);  // 2: blue, 0.5: round
+                span->alpha = static_cast<uint8_t>(channels[3] + 0.5f); // 3: alpha, 0.5: round
+            }
+        }
+    } floatBilinear = {&transform, pixels.data(), imageSize};
+    FillInterpolator interpolator(transform);
+    SpanImageRgba nearest(interpolator, IMAGE_FILTER_NEAREST);
+    SpanImageRgba bilinear(interpolator, IMAGE_FILTER_BILINEAR);
+    SpanImageRgba box(interpolator, IMAGE_FILTER_BOX);
+    SpanImageRgba bilinear565(interpolator, IMAGE_FILTER_BILINEAR);
+    nearest.Attach(&image);
+    bilinear.Attach(&image);
+    box.Attach(&image);
+    bilinear565.Attach(&image565);
+    std::vector<Rgba8T> colors(PANEL_WIDTH);
+
+    double timeUs[5] = {0}; // 5: float bilinear, nearest, bilinear, box and RGB565 bilinear
+    uint64_t checksum[5] = {0}; // 5: float bilinear, nearest, bilinear, box and RGB565 bilinear
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        timeUs[0] += BenchBackground(floatBilinear, colors, checksum[0]);
+        timeUs[1] += BenchBackground(nearest, colors, checksum[1]);
+        timeUs[2] += BenchBackground(bilinear, colors, checksum[2]); // 2: bilinear
+        timeUs[3] += BenchBackground(box, colors, checksum[3]); // 3: box
+        timeUs[4] += BenchBackground(bilinear565, colors, checksum[4]); // 4: RGB565 bilinear
+    }
+    EXPECT_NE(checksum[2], 0u); // 2: bilinear
+    printf("%-16s %-12s %-13s %-8s %-16s %-8s\n", "floatLinear(us)", "nearest(us)", "bilinear(us)", "box(us)",
+           "bilinear565(us)", "speedup");
+    printf("%-16.1f %-12.1f %-13.1f %-8.1f %-16.1f %-8.2f\n", timeUs[0] / BENCH_ROUNDS, timeUs[1] / BENCH_ROUNDS,
+           timeUs[2] / BENCH_ROUNDS, timeUs[3] / BENCH_ROUNDS, timeUs[4] / BENCH_ROUNDS, // 2, 3, 4: columns
+           timeUs[0] / timeUs[2]); // 2: bilinear
+}
+
+#if defined(GRAPHIC_ENABLE_BLUR_EFFECT_FLAG) && GRAPHIC_ENABLE_BLUR_EFFECT_FLAG
+/**
+ * @tc.name: BenchBoxBlur_001
+ * @tc.desc: Compare a full panel box blur of the former integral image, of (width + 1) * (height + 1)
+ * sums of 4 channels, with the sliding window of Filterblur, for a small, a medium and a radius
+ * beyond the 16 bit column sums.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchBoxBlur_001, TestSize.Level1)
+{
+    const int32_t channels = 4;
+    const int32_t stride = PANEL_WIDTH * channels;
+    std::vector<uint8_t> source(stride * PANEL_HEIGHT);
+    BenchRandom random(stride);
+    for (uint8_t& byte : source) {
+        byte = static_cast<uint8_t>(random.Next(256)); // 256: any byte
+    }
+    const int32_t columns = PANEL_WIDTH + 1;
+    std::vector<int32_t> integral(columns * (PANEL_HEIGHT + 1) * channels);
+    /* The former BoxBlur, which summed the whole image before dividing the box of every pixel. */
+    auto integralBlur = [&](uint8_t* pixels, int32_t radius) {
+        for (int32_t y = 0; y <= PANEL_HEIGHT; y++) {
+            for (int32_t x = 0; x <= PANEL_WIDTH; x++) {
+                for (int32_t c = 0; c < channels; c++) {
+                    int32_t* sum = &integral[(y * columns + x) * channels + c];
+                    *sum = (x == 0 || y == 0) ? 0 : pixels[(y - 1) * stride + (x - 1) * channels + c] +
+                        *(sum - channels) + *(sum - columns * channels) - *(sum - (columns + 1) * channels);
+                }
+            }
+        }
+        for (int32_t y = 0; y < PANEL_HEIGHT; y++) {
+            int32_t y1 = MATH_MAX(y - radius, 0);
+            int32_t y2 = MATH_MIN(y + radius + 1, PANEL_HEIGHT);
+            for (int32_t x = 0; x < PANEL_WIDTH; x++) {
+                int32_t x1 = MATH_MAX(x - radius, 0);
+                int32_t x2 = MATH_MIN(x + radius + 1, PANEL_WIDTH);
+                int32_t count = (x2 - x1) * (y2 - y1);
+                for (int32_t c = 0; c < channels - 1; c++) {
+                    int32_t sum = integral[(y2 * columns + x2) * channels + c] -
+                                  integral[(y1 * columns + x2) * channels + c] -
+                                  integral[(y2 * columns + x1) * channels + c] +
+                                  integral[(y1 * columns + x1) * channels + c];
+                    pixels[y * stride + x * channels + c] = static_cast<uint8_t>((sum + count / 2) / count);
+                }
+            }
+        }
+    };
+    Filterblur blur;
+    std::vector<uint8_t> pixels(source.size());
+    const uint16_t radii[3] = {3, 10, 150}; // 3, 10, 150: small, medium and 32 bit column sums
+    printf("%-8s %-14s %-14s %-8s\n", "radius", "integral(us)", "sliding(us)", "speedup");
+    for (uint16_t radius : radii) {
+        double timeUs[2] = {0}; // 2: integral image and sliding window
+        uint64_t checksum[2] = {0}; // 2: integral image and sliding window
+        for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+            pixels = source;
+            BenchTimer integralTimer;
+            integralBlur(pixels.data(), radius);
+            timeUs[0] += integralTimer.ElapsedUs();
+            checksum[0] += pixels[round * stride + channels];
+            pixels = source;
+            BenchTimer slidingTimer;
+            blur.BoxBlurRgba(pixels.data(), PANEL_WIDTH, PANEL_HEIGHT, stride, radius);
+            timeUs[1] += slidingTimer.ElapsedUs();
+            checksum[1] += pixels[round * stride + channels];
+        }
+        EXPECT_EQ(checksum[0], checksum[1]);
+        printf("%-8u %-14.1f %-14.1f %-8.2f\n", radius, timeUs[0] / BENCH_ROUNDS, timeUs[1] / BENCH_ROUNDS,
+               timeUs[0] / timeUs[1]);
+    }
+}
+
+/**
+ * @tc.name: BenchGaussianBlur_001
+ * @tc.desc: Compare a full panel Gaussian blur of 3 Filterblur box blurs of the box radii, which
+ * is what callers had to do before, with FilterGaussianBlur, for radii from 1 to 64.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchGaussianBlur_001, TestSize.Level1)
+{
+    const int32_t channels = 4;
+    const int32_t stride = PANEL_WIDTH * channels;
+    std::vector<uint8_t> source(stride * PANEL_HEIGHT);
+    BenchRandom random(stride);
+    for (uint8_t& byte : source) {
+        byte = static_cast<uint8_t>(random.Next(256)); // 256: any byte
+    }
+    Filterblur boxBlur;
+    FilterGaussianBlur gaussianBlur;
+    std::vector<uint8_t> pixels(source.size());
+    const uint16_t radii[7] = {1, 2, 4, 8, 16, 32, 64}; // 7: radii from 1 to 64
+    printf("%-8s %-14s %-14s %-8s\n", "radius", "boxBlur3(us)", "gaussian(us)", "speedup");
+    for (uint16_t radius : radii) {
+        uint16_t boxRadii[FilterGaussianBlur::BOX_PASSES];
+        FilterGaussianBlur::GetBoxRadii(radius, boxRadii);
+        double timeUs[2] = {0}; // 2: box blurs and Gaussian blur
+        uint64_t checksum = 0;
+        for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+            pixels = source;
+            BenchTimer boxTimer;
+            for (uint16_t boxRadius : boxRadii) {
+                boxBlur.BoxBlurRgba(pixels.data(), PANEL_WIDTH, PANEL_HEIGHT, stride, boxRadius);
+            }
+            timeUs[0] += boxTimer.ElapsedUs();
+            pixels = source;
+            BenchTimer gaussianTimer;
+            gaussianBlur.BlurRgba(pixels.data(), PANEL_WIDTH, PANEL_HEIGHT, stride, radius);
+            timeUs[1] += gaussianTimer.ElapsedUs();
+            checksum += pixels[round * stride + channels];
+        }
+        EXPECT_NE(checksum, 0u);
+        printf("%-8u %-14.1f %-14.1f %-8.2f\n", radius, timeUs[0] / BENCH_ROUNDS, timeUs[1] / BENCH_ROUNDS,
+               timeUs[0] / timeUs[1]);
+    }
+}
+
+#if defined(GRAPHIC_ENABLE_SHADOW_EFFECT_FLAG) && GRAPHIC_ENABLE_SHADOW_EFFECT_FLAG
+/**
+ * @tc.name: BenchShadow_001
+ * @tc.desc: Compare the shadow of a card drawn into an ARGB8888 layer of the shadow size and
+ * blurred there, with the A8 mask of FilterShadow, and the blend of the A8 shadow into the panel.
+ * @tc.type: PERF
+ */
+HWTEST_F(DiagramBenchmarkTest, BenchShadow_001, TestSize.Level1)
+{
+    const float cardLeft = 212.5f;
+    const float cardTop = 120.25f;
+    const float cardWidth = 600.0f;
+    const float cardHeight = 360.0f;
+    const uint16_t radii[3] = {4, 16, 48}; // 3: a sharp, a soft and a wide shadow
+    const Rgba8T shadowColor(0, 0, 0, 128); // 128: half transparent black
+    auto buildCard = [&](UICanvasVertices& path, float x, float y) {
+        path.MoveTo(x, y);
+        path.LineTo(x + cardWidth, y);
+        path.LineTo(x + cardWidth, y + cardHeight);
+        path.LineTo(x, y + cardHeight);
+        path.EndPoly();
+    };
+    std::vector<uint8_t> panel(PANEL_WIDTH * PANEL_HEIGHT * 4, 0xFF); // 4: ARGB8888, 0xFF: a white panel
+    BufferInfo panelInfo = {};
+    panelInfo.virAddr = panel.data();
+    panelInfo.stride = PANEL_WIDTH * 4; // 4: ARGB8888
+    panelInfo.width = PANEL_WIDTH;
+    panelInfo.height = PANEL_HEIGHT;
+    panelInfo.mode = ARGB8888;
+    FillSolidColor panelFill;
+    EXPECT_TRUE(panelFill.Attach(panelInfo));
+    FilterShadow shadow;
+    FilterGaussianBlur layerBlur;
+    GeometryScanline scanline;
+    printf("%-8s %-12s %-10s %-14s %-12s %-8s\n", "radius", "layer(us)", "a8(us)", "composite(us)", "layer(KB)",
+           "a8(KB)");
+    for (uint16_t radius : radii) {
+        UICanvasVertices card;
+        buildCard(card, cardLeft, cardTop);
+        RasterizerScanlineAntialias rasterizer;
+        rasterizer.AddPath(card);
+        EXPECT_TRUE(shadow.Rasterize(rasterizer, radius));
+        const int32_t width = shadow.GetMask().GetWidth();
+        const int32_t height = shadow.GetMask().GetHeight();
+        UICanvasVertices layerCard;
+        buildCard(layerCard, cardLeft - shadow.GetOriginX(), cardTop - shadow.GetOriginY());
+        RasterizerScanlineAntialias layerRasterizer;
+        layerRasterizer.AddPath(layerCard);
+        std::vector<uint8_t> layer(width * height * 4); // 4: ARGB8888
+        BufferInfo layerInfo = panelInfo;
+        layerInfo.virAddr = layer.data();
+        layerInfo.stride = width * 4; // 4: ARGB8888
+        layerInfo.width = static_cast<uint16_t>(width);
+        layerInfo.height = static_cast<uint16_t>(height);
+        FillSolidColor layerFill;
+        EXPECT_TRUE(layerFill.Attach(layerInfo));
+        layerFill.SetColor(shadowColor);
+
+        double timeUs[3] = {0}; // 3: ARGB8888 layer, A8 mask and composite
+        for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+            BenchTimer layerTimer;
+            if (memset_s(layer.data(), layer.size(), 0, layer.size()) != EOK) {
+                break;
+            }
+            layerFill.RenderScanlines(layerRasterizer, scanline);
+            layerBlur.BlurRgba(layer.data(), width, height, width * 4, radius); // 4: ARGB8888
+            timeUs[0] += layerTimer.ElapsedUs();
+            BenchTimer maskTimer;
+            shadow.Rasterize(rasterizer, radius);
+            shadow.Blur(radius);
+            timeUs[1] += maskTimer.ElapsedUs();
+            BenchTimer compositeTimer;
+            shadow.Composite(panelFill, Color::GetColorFromRGBA(0, 0, 0, 128), 8, 8); // 128: alpha, 8: offset
+            timeUs[2] += compositeTimer.ElapsedUs(); // 2: composite
+        }
+        // 4: ARGB8888, 3: alpha of the layer, the center of the card is covered in both
+        EXPECT_EQ(layer[(height / 2 * width + width / 2) * 4 + 3], shadowColor.alpha);
+        EXPECT_EQ(shadow.GetMask().GetPixel(width / 2, height / 2), 0xFF); // 0xFF: full cover
+        printf("%-8u %-12.1f %-10.1f %-14.1f %-12u %-8u\n", radius, timeUs[0] / BENCH_ROUNDS,
+               timeUs[1] / BENCH_ROUNDS, timeUs[2] / BENCH_ROUNDS, // 2: composite
+               static_cast<uint32_t>(layer.size() / 1024), static_cast<uint32_t>(width * height / 1024)); // 1024: KB
+    }
+}
+#endif
+#endif
+} // namespace OHOS
@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/imagefilter/filter_blur.h"
+#include "gfx_utils/diagram/imagefilter/filter_gaussian_blur.h"
+#include "gfx_utils/diagram/imagefilter/filter_shadow.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/diagram/vertexprimitive/geometry_path_storage.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace testing::ext;
+namespace OHOS {
+#if defined(GRAPHIC_ENABLE_BLUR_EFFECT_FLAG) && GRAPHIC_ENABLE_BLUR_EFFECT_FLAG
+namespace {
+// 4: the bytes of a pixel
+constexpr int32_t PIXEL_BYTES = 4;
+// 3: the blurred channels, the alpha channel is kept
+constexpr int32_t BLUR_CHANNELS = 3;
+
+std::vector<uint8_t> NoiseImage(int32_t stride, int32_t height)
+{
+    std::vector<uint8_t> pixels(static_cast<size_t>(stride) * height);
+    uint32_t seed = 0x2545F491;
+    for (uint8_t& pixel : pixels) {
+        // 1103515245, 12345: the constants of a linear congruential generator, 24: its high byte
+        seed = seed * 1103515245u + 12345u;
+        pixel = static_cast<uint8_t>(seed >> 24);
+    }
+    return pixels;
+}
+
+/* The box mean of every pixel read from an integral image, the box is cut at the image edges. */
+std::vector<uint8_t> ReferenceBlur(const std::vector<uint8_t>& pixels, int32_t width, int32_t height,
+                                   int32_t stride, int32_t radius)
+{
+    const int32_t columns = width + 1;
+    std::vector<uint32_t> integral(static_cast<size_t>(columns) * (height + 1) * BLUR_CHANNELS, 0);
+    for (int32_t y = 0; y < height; y++) {
+        for (int32_t x = 0; x < width; x++) {
+            for (int32_t c = 0; c < BLUR_CHANNELS; c++) {
+                integral[((y + 1) * columns + x + 1) * BLUR_CHANNELS + c] =
+                    pixels[y * stride + x * PIXEL_BYTES + c] + integral[(y * columns + x + 1) * BLUR_CHANNELS + c] +
+                    integral[((y + 1) * columns + x) * BLUR_CHANNELS + c] -
+                    integral[(y * columns + x) * BLUR_CHANNELS + c];
+            }
+        }
+    }
+    std::vector<uint8_t> blurred(pixels);
+    for (int32_t y = 0; y < height; y++) {
+        for (int32_t x = 0; x < width; x++) {
+            int32_t x1 = MATH_MAX(x - radius, 0);
+            int32_t x2 = MATH_MIN(x + radius + 1, width);
+            int32_t y1 = MATH_MAX(y - radius, 0);
+            int32_t y2 = MATH_MIN(y + radius + 1, height);
+            uint32_t count = static_cast<uint32_t>((x2 - x1) * (y2 - y1));
+            for (int32_t c = 0; c < BLUR_CHANNELS; c++) {
+                uint32_t sum = integral[(y2 * columns + x2) * BLUR_CHANNELS + c] -
+                               integral[(y1 * columns + x2) * BLUR_CHANNELS + c] -
+                               integral[(y2 * columns + x1) * BLUR_CHANNELS + c] +
+                               integral[(y1 * columns + x1) * BLUR_CHANNELS + c];
+                blurred[y * stride + x * PIXEL_BYTES + c] = static_cast<uint8_t>((sum + count / 2) / count);
+            }
+        }
+    }
+    return blurred;
+}
+
+bool BlurMatches(Filterblur& blur, int32_t width, int32_t height, int32_t stride, uint16_t radius)
+{
+    std::vector<uint8_t> pixels = NoiseImage(stride, height);
+    std::vector<uint8_t> expected = ReferenceBlur(pixels, width, height, stride, radius);
+    blur.BoxBlurRgba(pixels.data(), width, height, stride, radius);
+    return pixels == expected;
+}
+/* A box blur of one line by summing every box, the steps beyond the line repeat its ends. */
+void ReferenceBoxLine(uint8_t* line, int32_t step, int32_t count, int32_t radius)
+{
+    std::vector<uint8_t> source(count);
+    for (int32_t i = 0; i < count; i++) {
+        source[i] = line[i * step];
+    }
+    const uint32_t size = 2 * radius + 1;
+    for (int32_t i = 0; i < count; i++) {
+        uint32_t sum = 0;
+        for (int32_t j = i - radius; j <= i + radius; j++) {
+            sum += source[MATH_MIN(MATH_MAX(j, 0), count - 1)];
+        }
+        line[i * step] = static_cast<uint8_t>((sum + size / 2) / size);
+    }
+}
+
+/* The box passes of the Gaussian blur over all rows and then over all columns. */
+std::vector<uint8_t> ReferenceGaussian(const std::vector<uint8_t>& pixels, int32_t width, int32_t height,
+                                       int32_t stride, uint16_t radius)
+{
+    uint16_t boxRadii[FilterGaussianBlur::BOX_PASSES];
+    FilterGaussianBlur::GetBoxRadii(radius, boxRadii);
+    std::vector<uint8_t> blurred(pixels);
+    for (uint16_t boxRadius : boxRadii) {
+        for (int32_t y = 0; boxRadius > 0 && y < height; y++) {
+            for (int32_t c = 0; c < PIXEL_BYTES; c++) {
+                ReferenceBoxLine(&blurred[y * stride + c], PIXEL_BYTES, width, boxRadius);
+            }
+        }
+    }
+    for (uint16_t boxRadius : boxRadii) {
+        for (int32_t x = 0; boxRadius > 0 && x < width * PIXEL_BYTES; x++) {
+            ReferenceBoxLine(&blurred[x], stride, height, boxRadius);
+        }
+    }
+    return blurred;
+}
+
+bool GaussianMatches(FilterGaussianBlur& blur, int32_t width, int32_t height, int32_t stride, uint16_t radius)
+{
+    std::vector<uint8_t> pixels = NoiseImage(stride, height);
+    std::vector<uint8_t> expected = ReferenceGaussian(pixels, width, height, stride, radius);
+    blur.BlurRgba(pixels.data(), width, height, stride, radius);
+    return pixels == expected;
+}
+} // namespace
+
+class FilterBlurTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: FilterBlurBoxBlurRgba_001
+ * @tc.desc: Verify the sliding box blur equals the box mean of every pixel, with 16 and 32 bit
+ *           column sums and boxes larger than the image.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FilterBlurTest, FilterBlurBoxBlurRgba_001, TestSize.Level0)
+{
+    Filterblur blur;
+    // 37, 23: sizes which are not a multiple of the vectors
+    EXPECT_TRUE(BlurMatches(blur, 37, 23, 37 * PIXEL_BYTES, 1));
+    EXPECT_TRUE(BlurMatches(blur, 37, 23, 37 * PIXEL_BYTES, 5));
+    // 21: the window covers every row of the image but the last row still leaves the first one
+    EXPECT_TRUE(BlurMatches(blur, 37, 23, 37 * PIXEL_BYTES, 21));
+    // 30: the window never leaves a row, 40: the box is larger than the image in both directions
+    EXPECT_TRUE(BlurMatches(blur, 37, 23, 37 * PIXEL_BYTES, 30));
+    EXPECT_TRUE(BlurMatches(blur, 37, 23, 37 * PIXEL_BYTES, 40));
+    // 300, 260, 129: the largest column sums fit in 16 bits up to a radius of 128 only
+    EXPECT_TRUE(BlurMatches(blur, 300, 260, 300 * PIXEL_BYTES, 128));
+    EXPECT_TRUE(BlurMatches(blur, 300, 260, 300 * PIXEL_BYTES, 129));
+}
+
+/**
+ * @tc.name: FilterBlurBoxBlurRgba_002
+ * @tc.desc: Verify the blur keeps the padding of the rows and the alpha channel, and handles
+ *           a single pixel and an empty radius.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FilterBlurTest, FilterBlurBoxBlurRgba_002, TestSize.Level0)
+{
+    Filterblur blur;
+    // 19, 11, 7: 7 bytes of padding after every row
+    EXPECT_TRUE(BlurMatches(blur, 19, 11, 19 * PIXEL_BYTES + 7, 3));
+    EXPECT_TRUE(BlurMatches(blur, 1, 1, PIXEL_BYTES, 4));
+    EXPECT_TRUE(BlurMatches(blur, 1, 9, PIXEL_BYTES, 2));
+
+    std::vector<uint8_t> pixels = NoiseImage(8 * PIXEL_BYTES, 8);
+    std::vector<uint8_t> original(pixels);
+    blur.BoxBlurRgba(pixels.data(), 8, 8, 8 * PIXEL_BYTES, 0);
+    EXPECT_TRUE(pixels == original);
+
+    // A copy blurs with buffers of its own
+    Filterblur copy(blur);
+    EXPECT_TRUE(BlurMatches(copy, 19, 11, 19 * PIXEL_BYTES, 2));
+}
+
+/**
+ * @tc.name: FilterGaussianBlurGetBoxRadii_001
+ * @tc.desc: Verify the variances of the 3 boxes add up to the variance of the Gaussian.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FilterBlurTest, FilterGaussianBlurGetBoxRadii_001, TestSize.Level0)
+{
+    uint16_t boxRadii[FilterGaussianBlur::BOX_PASSES];
+    FilterGaussianBlur::GetBoxRadii(0, boxRadii);
+    EXPECT_EQ(boxRadii[0] + boxRadii[1] + boxRadii[2], 0); // 2: the third box
+    // 1000: radii up to a wide shadow
+    for (uint16_t radius = 1; radius <= 1000; radius++) {
+        FilterGaussianBlur::GetBoxRadii(radius, boxRadii);
+        // 12: the variance of a box of size n is (n * n - 1) / 12, which is radius * (radius + 1) / 3
+        float variance = 0;
+        for (uint16_t boxRadius : boxRadii) {
+            variance += boxRadius * (boxRadius + 1) / 3.0f; // 3.0: the variance of the box
+        }
+        // 4: the standard deviation is half of the radius, 6: a box size step changes the variance by
+        // radius / 6 or by 0.25 for odd radii
+        EXPECT_LE(MATH_ABS(variance - radius * radius / 4.0f), radius / 6.0f + 0.25f); // 0.25: odd radii
+        EXPECT_LE(boxRadii[0], boxRadii[1]);
+        EXPECT_LE(boxRadii[1], boxRadii[2]); // 2: the third box
+    }
+}
+
+/**
+ * @tc.name: FilterGaussianBlurBlurRgba_001
+ * @tc.desc: Verify the rows and strips of the Gaussian blur equal the box passes over the whole
+ *           image, for vector and wide boxes, strips cut at the row end and boxes beyond the image.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FilterBlurTest, FilterGaussianBlurBlurRgba_001, TestSize.Level0)
+{
+    FilterGaussianBlur blur;
+    // 37, 23: sizes which are not a multiple of the strips, 2: a single box, 3, 8: all 3 boxes
+    EXPECT_TRUE(GaussianMatches(blur, 37, 23, 37 * PIXEL_BYTES, 2));
+    EXPECT_TRUE(GaussianMatches(blur, 37, 23, 37 * PIXEL_BYTES, 3));
+    EXPECT_TRUE(GaussianMatches(blur, 37, 23, 37 * PIXEL_BYTES, 8));
+    // 60: boxes wider than the image
+    EXPECT_TRUE(GaussianMatches(blur, 37, 23, 37 * PIXEL_BYTES, 60));
+    // 19, 11, 7: 7 bytes of padding after every row
+    EXPECT_TRUE(GaussianMatches(blur, 19, 11, 19 * PIXEL_BYTES + 7, 5));
+    EXPECT_TRUE(GaussianMatches(blur, 1, 1, PIXEL_BYTES, 4));
+    // 130: the boxes beyond MAX_VECTOR_RADIUS are summed in 32 bits
+    EXPECT_TRUE(GaussianMatches(blur, 40, 30, 40 * PIXEL_BYTES, 130));
+    EXPECT_TRUE(GaussianMatches(blur, 40, 30, 40 * PIXEL_BYTES, 131));
+}
+
+/**
+ * @tc.name: FilterGaussianBlurBlurRgba_002
+ * @tc.desc: Verify a flat image stays flat and a radius of 1 leaves the image as it is.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FilterBlurTest, FilterGaussianBlurBlurRgba_002, TestSize.Level0)
+{
+    FilterGaussianBlur blur;
+    // 20, 10: the image size, 0x5A: any byte
+    std::vector<uint8_t> pixels(20 * 10 * PIXEL_BYTES, 0x5A);
+    std::vector<uint8_t> original(pixels);
+    blur.BlurRgba(pixels.data(), 20, 10, 20 * PIXEL_BYTES, 9);
+    EXPECT_TRUE(pixels == original);
+
+    pixels = NoiseImage(20 * PIXEL_BYTES, 10);
+    original = pixels;
+    blur.BlurRgba(pixels.data(), 20, 10, 20 * PIXEL_BYTES, 1);
+    EXPECT_TRUE(pixels == original);
+}
+
+/**
+ * @tc.name: FilterGaussianBlurBlurA8_001
+ * @tc.desc: Verify an alpha mask is blurred like every channel of an image of the same bytes.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FilterBlurTest, FilterGaussianBlurBlurA8_001, TestSize.Level0)
+{
+    FilterGaussianBlur blur;
+    // 45, 21: the mask size, 3: padding, 1, 6, 20, 140: a single box, vector boxes and wide boxes
+    const int32_t width = 45;
+    const int32_t height = 21;
+    const int32_t stride = width + 3;
+    for (uint16_t radius : {1, 6, 20, 140}) {
+        std::vector<uint8_t> mask = NoiseImage(stride, height);
+        std::vector<uint8_t> pixels(width * height * PIXEL_BYTES);
+        for (int32_t i = 0; i < width * height; i++) {
+            for (int32_t c = 0; c < PIXEL_BYTES; c++) {
+                pixels[i * PIXEL_BYTES + c] = mask[(i / width) * stride + i % width];
+            }
+        }
+        std::vector<uint8_t> padding(mask);
+        blur.BlurA8(mask.data(), width, height, stride, radius);
+        blur.BlurRgba(pixels.data(), width, height, width * PIXEL_BYTES, radius);
+        uint32_t mismatches = 0;
+        for (int32_t i = 0; i < width * height; i++) {
+            for (int32_t c = 0; c < PIXEL_BYTES; c++) {
+                mismatches += (pixels[i * PIXEL_BYTES + c] != mask[(i / width) * stride + i % width]) ? 1 : 0;
+            }
+        }
+        for (int32_t y = 0; y < height; y++) {
+            for (int32_t x = width; x < stride; x++) {
+                mismatches += (mask[y * stride + x] != padding[y * stride + x]) ? 1 : 0;
+            }
+        }
+        EXPECT_EQ(mismatches, 0u);
+    }
+}
+
+/**
+ * @tc.name: FilterShadowRender_001
+ * @tc.desc: Verify the A8 shadow holds the blurred covers of the shape with a margin wide enough
+ *           for the blur, and blends the shadow color of the paint through them at its offset.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FilterBlurTest, FilterShadowRender_001, TestSize.Level0)
+{
+    const int32_t width = 160;
+    const int32_t height = 120;
+    const uint16_t radius = 12;
+    UICanvasVertices path;
+    path.MoveTo(40.5f, 30.25f);  // 40.5, 30.25: the top left corner between pixels
+    path.LineTo(100.75f, 45.5f); // 100.75, 45.5: a slanted edge
+    path.LineTo(90.25f, 80.5f);  // 90.25, 80.5: the bottom right corner
+    path.LineTo(45.0f, 75.0f);   // 45, 75: the bottom left corner
+    path.EndPoly();
+    RasterizerScanlineAntialias rasterizer;
+    rasterizer.AddPath(path);
+
+    Paint paint;
+    paint.SetShadowBlur(radius);
+    paint.SetShadowOffsetX(6.4f);  // 6.4: rounds to 6
+    paint.SetShadowOffsetY(-3.6f); // -3.6: rounds to -4
+    paint.SetShadowColor(Color::GetColorFromRGBA(20, 40, 60, 200)); // 20, 40, 60, 200: the shadow color
+    std::vector<uint8_t> data(width * height * PIXEL_BYTES, 0);
+    BufferInfo info = {};
+    info.stride = width * PIXEL_BYTES;
+    info.virAddr = data.data();
+    info.width = width;
+    info.height = height;
+    info.mode = ARGB8888;
+    FillSolidColor fill;
+    ASSERT_TRUE(fill.Attach(info));
+    FilterShadow shadow;
+    shadow.Render(rasterizer, paint, fill);
+
+    // The covers of the whole buffer blurred by the box passes, every cover outside the mask is 0
+    AlphaMaskBuffer covers;
+    ASSERT_TRUE(covers.Resize(width, height));
+    covers.AddShape(rasterizer);
+    std::vector<uint8_t> layer(width * height * PIXEL_BYTES);
+    for (int32_t i = 0; i < width * height; i++) {
+        layer[i * PIXEL_BYTES] = covers.GetPixel(i % width, i / width);
+    }
+    layer = ReferenceGaussian(layer, width, height, width * PIXEL_BYTES, radius);
+    const AlphaMaskBuffer& mask = shadow.GetMask();
+    EXPECT_EQ(shadow.GetOriginX(), rasterizer.GetMinX() - FilterShadow::GetMargin(radius));
+    EXPECT_EQ(shadow.GetOriginY(), rasterizer.GetMinY() - FilterShadow::GetMargin(radius));
+    uint32_t mismatches = 0;
+    for (int32_t y = 0; y < height; y++) {
+        for (int32_t x = 0; x < width; x++) {
+            uint8_t cover = mask.GetPixel(x - shadow.GetOriginX(), y - shadow.GetOriginY());
+            mismatches += (layer[(y * width + x) * PIXEL_BYTES] != cover) ? 1 : 0;
+        }
+    }
+    EXPECT_EQ(mismatches, 0u);
+
+    // Blending every row of the mask, the runs of covers 0 leave the pixels as they are
+    std::vector<uint8_t> expected(data.size(), 0);
+    info.virAddr = expected.data();
+    FillSolidColor reference;
+    ASSERT_TRUE(reference.Attach(info));
+    reference.SetColor(Rgba8T(20, 40, 60, 200)); // 20, 40, 60, 200: the shadow color
+    for (int32_t y = 0; y < mask.GetHeight(); y++) {
+        // 6, 4: the rounded offsets
+        reference.BlendSolidHspan(shadow.GetOriginX() + 6, shadow.GetOriginY() - 4 + y, mask.GetWidth(),
+                                  mask.GetRow(y));
+    }
+    EXPECT_TRUE(data == expected);
+    // 70, 55: inside the shape, 6, 4: the rounded offsets, 3: alpha
+    EXPECT_GT(data[((55 - 4) * width + 70 + 6) * PIXEL_BYTES + 3], 0);
+}
+#endif
+} // namespace OHOS
@@ -0,0 +1,1529 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterized_path_cache.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_bands.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline_packed.h"
+#include "gfx_utils/diagram/scanline/scanline_alpha_mask.h"
+#include "gfx_utils/diagram/scanline/scanline_boolean.h"
+#include "gfx_utils/diagram/scanline/scanline_storage.h"
+#include "gfx_utils/diagram/vertexprimitive/geometry_path_storage.h"
+#include "gfx_utils/mem_api.h"
+
+#include <climits>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace {
+    const float STAR_CENTER = 120.0f;
+    const float STAR_OUTER_RADIUS = 100.0f;
+    const float STAR_INNER_RADIUS = 40.0f;
+    const int16_t STAR_POINTS = 7;
+
+    struct SweptSpan {
+        int32_t y;
+        int32_t x;
+        int32_t len;
+        std::vector<uint8_t> covers;
+    };
+
+    void BuildStar(UICanvasVertices& path, float offset, float scale = 1.0f, bool reverse = false)
+    {
+        for (int16_t n = 0; n < STAR_POINTS * TWO_TIMES; n++) {
+            int16_t i = reverse ? (STAR_POINTS * TWO_TIMES - 1 - n) : n;
+            float radius = scale * ((i % TWO_TIMES) ? STAR_INNER_RADIUS : STAR_OUTER_RADIUS);
+            float angle = i * SEMICIRCLE_IN_DEGREE / STAR_POINTS;
+            float x = STAR_CENTER + offset + radius * Sin(angle + QUARTER_IN_DEGREE);
+            float y = STAR_CENTER + offset + radius * Sin(angle);
+            if (n == 0) {
+                path.MoveTo(x, y);
+            } else {
+                path.LineTo(x, y);
+            }
+        }
+        path.EndPoly();
+    }
+
+    template <class Rasterizer>
+    void Sweep(Rasterizer& rasterizer, std::vector<SweptSpan>& spans)
+    {
+        GeometryScanline scanline;
+        if (!rasterizer.RewindScanlines()) {
+            return;
+        }
+        scanline.Reset(rasterizer.GetMinX(), rasterizer.GetMaxX());
+        while (rasterizer.SweepScanline(scanline)) {
+            uint32_t numSpans = scanline.NumSpans();
+            GeometryScanline::ConstIterator span = scanline.Begin();
+            for (; numSpans; --numSpans, ++span) {
+                SweptSpan swept;
+                swept.y = scanline.GetYLevel();
+                swept.x = span->x;
+                swept.len = span->spanLength;
+                swept.covers.assign(span->covers, span->covers + span->spanLength);
+                spans.push_back(swept);
+            }
+        }
+    }
+
+    /* Sweep into a packed scanline and expand the solid runs, adjacent spans are joined like GeometryScanline does. */
+    template <class Rasterizer>
+    void SweepPacked(Rasterizer& rasterizer, std::vector<SweptSpan>& spans, uint32_t& solidRuns,
+                     GeometryScanlinePacked& scanline)
+    {
+        solidRuns = 0;
+        if (!rasterizer.RewindScanlines()) {
+            return;
+        }
+        scanline.Reset(rasterizer.GetMinX(), rasterizer.GetMaxX());
+        while (rasterizer.SweepScanline(scanline)) {
+            uint32_t numSpans = scanline.NumSpans();
+            GeometryScanlinePacked::ConstIterator span = scanline.Begin();
+            bool joinable = false;
+            for (; numSpans; --numSpans, ++span) {
+                int32_t len = span->spanLength;
+                std::vector<uint8_t> covers;
+                if (len < 0) {
+                    len = -len;
+                    covers.assign(len, span->covers[0]);
+                    solidRuns++;
+                } else {
+                    covers.assign(span->covers, span->covers + len);
+                }
+                if (joinable && spans.back().x + spans.back().len == span->x) {
+                    spans.back().len += len;
+                    spans.back().covers.insert(spans.back().covers.end(), covers.begin(), covers.end());
+                } else {
+                    SweptSpan swept;
+                    swept.y = scanline.GetYLevel();
+                    swept.x = span->x;
+                    swept.len = len;
+                    swept.covers = covers;
+                    spans.push_back(swept);
+                }
+                joinable = true;
+            }
+        }
+    }
+
+    template <class Rasterizer>
+    void SweepPacked(Rasterizer& rasterizer, std::vector<SweptSpan>& spans, uint32_t& solidRuns)
+    {
+        GeometryScanlinePacked scanline;
+        SweepPacked(rasterizer, spans, solidRuns, scanline);
+    }
+
+    template <class Cells>
+    void AddPathCells(Cells& cells, UICanvasVertices& path)
+    {
+        RasterizerScanlineClip clipper;
+        float x;
+        float y;
+        int32_t startX = 0;
+        int32_t startY = 0;
+        path.Rewind(0);
+        uint32_t cmd = path.GenerateVertex(&x, &y);
+        for (; !IsStop(cmd); cmd = path.GenerateVertex(&x, &y)) {
+            if (IsMoveTo(cmd)) {
+                startX = RasterDepictInt::UpScale(x);
+                startY = RasterDepictInt::UpScale(y);
+                clipper.MoveTo(startX, startY);
+            } else if (IsVertex(cmd)) {
+                clipper.LineTo(cells, RasterDepictInt::UpScale(x), RasterDepictInt::UpScale(y));
+            } else if (IsClose(cmd)) {
+                clipper.LineTo(cells, startX, startY);
+            }
+        }
+    }
+
+    void ExpectSameCells(RasterizerCellsAntiAlias& cells, RasterizerCellsAntiAliasPacked& packedCells)
+    {
+        ASSERT_TRUE(packedCells.GetSortedByValue());
+        ASSERT_EQ(cells.GetTotalCells(), packedCells.GetTotalCells());
+        EXPECT_EQ(cells.GetMinY(), packedCells.GetMinY());
+        EXPECT_EQ(cells.GetMaxY(), packedCells.GetMaxY());
+        for (int32_t y = cells.GetMinY(); y <= cells.GetMaxY(); y++) {
+            uint32_t numCells = cells.GetScanlineNumCells(y);
+            ASSERT_EQ(numCells, packedCells.GetScanlineNumCells(y));
+            const CellBuildAntiAlias* row = cells.GetScanlineSortedCells(y);
+            const CellPackedAntiAlias* packedRow = packedCells.GetScanlineSortedCells(y);
+            for (uint32_t i = 0; i < numCells; i++) {
+                EXPECT_EQ(row[i].x, packedRow[i].x);
+                EXPECT_EQ(row[i].y, packedRow[i].y);
+                EXPECT_EQ(row[i].cover, packedRow[i].cover);
+                EXPECT_EQ(row[i].area, packedRow[i].area);
+            }
+        }
+    }
+
+    /* The scalar sweep of one row of sorted cells, with the non-zero rule and a linear gamma. */
+    void SweepReference(RasterizerCellsAntiAlias& cells, int32_t y, std::vector<SweptSpan>& spans)
+    {
+        const int32_t coverShift = POLY_SUBPIXEL_SHIFT * 2 + 1 - RasterizerScanlineAntialias::AA_SHIFT;
+        uint32_t numCells = cells.GetScanlineNumCells(y);
+        const CellBuildAntiAlias* const* row = cells.GetScanlineCells(y);
+        int32_t cover = 0;
+        uint32_t i = 0;
+        std::vector<uint8_t> alphas;
+        std::vector<int32_t> xs;
+        while (i < numCells) {
+            int32_t x = row[i]->x;
+            int32_t area = 0;
+            for (; i < numCells && row[i]->x == x; i++) {
+                area += row[i]->area;
+                cover += row[i]->cover;
+            }
+            int32_t cellAlpha = MATH_MIN(MATH_ABS(((cover << (POLY_SUBPIXEL_SHIFT + 1)) - area) >> coverShift),
+                                         RasterizerScanlineAntialias::AA_MASK);
+            int32_t spanAlpha = MATH_MIN(MATH_ABS((cover << (POLY_SUBPIXEL_SHIFT + 1)) >> coverShift),
+                                         RasterizerScanlineAntialias::AA_MASK);
+            if (area != 0) {
+                xs.push_back(x);
+                alphas.push_back(static_cast<uint8_t>(cellAlpha));
+                x++;
+            }
+            for (; i < numCells && x < row[i]->x; x++) {
+                xs.push_back(x);
+                alphas.push_back(static_cast<uint8_t>(spanAlpha));
+            }
+        }
+        for (uint32_t j = 0; j < xs.size(); j++) {
+            if (alphas[j] == 0) {
+                continue;
+            }
+            if (!spans.empty() && spans.back().y == y && spans.back().x + spans.back().len == xs[j]) {
+                spans.back().len++;
+                spans.back().covers.push_back(alphas[j]);
+            } else {
+                SweptSpan span;
+                span.y = y;
+                span.x = xs[j];
+                span.len = 1;
+                span.covers.push_back(alphas[j]);
+                spans.push_back(span);
+            }
+        }
+    }
+
+    void PaintSpans(const std::vector<SweptSpan>& spans, std::vector<uint8_t>& image, int32_t width)
+    {
+        for (const SweptSpan& span : spans) {
+            for (int32_t x = 0; x < span.len; x++) {
+                image[span.y * width + span.x + x] = span.covers[x];
+            }
+        }
+    }
+
+    void ExpectSameSpans(const std::vector<SweptSpan>& expect, const std::vector<SweptSpan>& actual)
+    {
+        ASSERT_EQ(expect.size(), actual.size());
+        for (uint32_t i = 0; i < expect.size(); i++) {
+            EXPECT_EQ(expect[i].y, actual[i].y);
+            EXPECT_EQ(expect[i].x, actual[i].x);
+            EXPECT_EQ(expect[i].len, actual[i].len);
+            EXPECT_EQ(expect[i].covers, actual[i].covers);
+        }
+    }
+
+    bool g_failAllocations = false;
+}
+
+/* UIMalloc is a weak symbol, this one fails while g_failAllocations is set to reach the allocation fallbacks. */
+void* UIMalloc(uint32_t size)
+{
+    return g_failAllocations ? nullptr : malloc(size);
+}
+
+class RasterizerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: RasterizerRadixSort_001
+ * @tc.desc: Verify the radix cell sort sweeps the same scanlines as the quicksort.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerRadixSort_001, TestSize.Level0)
+{
+    UICanvasVertices path;
+    BuildStar(path, 0);
+    BuildStar(path, STAR_INNER_RADIUS);
+
+    RasterizerScanlineAntialias quickRasterizer;
+    quickRasterizer.AddPath(path);
+    std::vector<SweptSpan> quickSpans;
+    Sweep(quickRasterizer, quickSpans);
+
+    RasterizerScanlineAntialias radixRasterizer;
+    radixRasterizer.SetCellSortMode(RasterizerCellsAntiAlias::CELL_SORT_RADIX);
+    radixRasterizer.AddPath(path);
+    std::vector<SweptSpan> radixSpans;
+    Sweep(radixRasterizer, radixSpans);
+
+    EXPECT_FALSE(quickSpans.empty());
+    ExpectSameSpans(quickSpans, radixSpans);
+}
+
+/**
+ * @tc.name: RasterizerRadixSort_002
+ * @tc.desc: Verify a cell one pixel left of minX gets the smallest radix key instead of wrapping around.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerRadixSort_002, TestSize.Level0)
+{
+    const int32_t minX = -3;
+    const int32_t maxX = 300;
+    uint32_t leftKey = RasterizerCellsAntiAlias::GetRadixKey(minX - 1, minX);
+    EXPECT_EQ(leftKey, 0u);
+    EXPECT_LT(leftKey, RasterizerCellsAntiAlias::GetRadixKey(minX, minX));
+    EXPECT_LT(RasterizerCellsAntiAlias::GetRadixKey(minX, minX), RasterizerCellsAntiAlias::GetRadixKey(maxX, minX));
+    // 2: the keys of the cells one pixel left of minX and one pixel right of maxX are the range ends
+    EXPECT_EQ(RasterizerCellsAntiAlias::GetRadixKey(maxX + 1, minX), static_cast<uint32_t>(maxX - minX + 2));
+}
+
+/**
+ * @tc.name: RasterizerRetainCapacity_001
+ * @tc.desc: Verify repeated Reset/Sort cycles reuse the retained buffers and ShrinkToFit releases them.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerRetainCapacity_001, TestSize.Level0)
+{
+    UICanvasVertices path;
+    BuildStar(path, 0);
+
+    RasterizerCellsAntiAlias cells;
+    uint32_t firstFrameMemory = 0;
+    for (int16_t frame = 0; frame < STAR_POINTS; frame++) {
+        cells.Reset();
+        AddPathCells(cells, path);
+        cells.SortAllCells();
+        if (frame == 0) {
+            firstFrameMemory = cells.GetMemoryUsage();
+        }
+        EXPECT_EQ(cells.GetMemoryUsage(), firstFrameMemory);
+    }
+    EXPECT_GT(firstFrameMemory, 0u);
+    EXPECT_EQ(cells.GetPeakMemoryUsage(), firstFrameMemory);
+
+    cells.Reset();
+    cells.ShrinkToFit();
+    EXPECT_EQ(cells.GetMemoryUsage(), 0u);
+    EXPECT_EQ(cells.GetPeakMemoryUsage(), firstFrameMemory);
+}
+
+/**
+ * @tc.name: RasterizerPackedCells_001
+ * @tc.desc: Verify the packed cell layout sorts to the same cells as the default layout in less memory.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerPackedCells_001, TestSize.Level0)
+{
+    EXPECT_EQ(sizeof(CellPackedAntiAlias), sizeof(CellBuildAntiAlias) / TWO_TIMES);
+
+    UICanvasVertices path;
+    BuildStar(path, 0);
+    BuildStar(path, STAR_INNER_RADIUS);
+
+    RasterizerCellsAntiAlias cells;
+    cells.SetSortMode(RasterizerCellsAntiAlias::CELL_SORT_RADIX);
+    AddPathCells(cells, path);
+    cells.SortAllCells();
+
+    RasterizerCellsAntiAliasPacked packedCells;
+    EXPECT_EQ(packedCells.GetSortMode(), RasterizerCellsAntiAliasPacked::CELL_SORT_RADIX);
+    AddPathCells(packedCells, path);
+    packedCells.SortAllCells();
+
+    ExpectSameCells(cells, packedCells);
+    EXPECT_LT(packedCells.GetPeakMemoryUsage(), cells.GetPeakMemoryUsage());
+}
+
+/**
+ * @tc.name: RasterizerPackedCells_002
+ * @tc.desc: Verify the limits of the packed cell layout: a path that zigzags inside one pixel and
+ * 2 subpaths that meet in one cell keep their exact cover, coordinates beyond 16 bits saturate.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerPackedCells_002, TestSize.Level0)
+{
+    const int32_t zigzags = 64;
+    const float pixel = 10.0f;
+    const float subpixel = 1.0f / POLY_SUBPIXEL_SCALE;
+    const float far = 40000.0f; // 40000: beyond INT16_MAX
+    UICanvasVertices path;
+    path.MoveTo(pixel + 0.5f, pixel - 5.0f); // 5.0: the zigzag enters the pixel from above
+    for (int32_t i = 0; i < zigzags; i++) {
+        path.LineTo(pixel + ((i % TWO_TIMES) ? 0.1f : 0.9f), pixel + 0.1f + 0.8f * i / zigzags);
+    }
+    path.LineTo(pixel + 20.0f, pixel + 20.0f); // 20.0: leave the pixel
+    path.EndPoly();
+    // The closing edge of the first square and the first edge of the second one both cross the
+    // cell at pixel, pixel + 20 upwards: the most cover one cell can collect
+    const float top = pixel + 20.0f;
+    path.MoveTo(pixel + 0.5f, top);
+    path.LineTo(pixel + 20.0f, top);
+    path.LineTo(pixel + 20.0f, top + 1.0f);
+    path.LineTo(pixel + 0.5f, top + 1.0f);
+    path.EndPoly();
+    path.MoveTo(pixel + 0.5f, top + 1.0f - subpixel);
+    path.LineTo(pixel + 0.5f, top);
+    path.LineTo(pixel - 5.0f, top); // 5.0: leave the pixel
+    path.LineTo(pixel - 5.0f, top + 1.0f - subpixel); // 5.0: leave the pixel
+    path.EndPoly();
+
+    RasterizerCellsAntiAlias cells;
+    cells.SetSortMode(RasterizerCellsAntiAlias::CELL_SORT_RADIX);
+    AddPathCells(cells, path);
+    cells.SortAllCells();
+    RasterizerCellsAntiAliasPacked packedCells;
+    AddPathCells(packedCells, path);
+    packedCells.SortAllCells();
+    ExpectSameCells(cells, packedCells);
+    int32_t maxCover = 0;
+    for (int32_t y = cells.GetMinY(); y <= cells.GetMaxY(); y++) {
+        const CellBuildAntiAlias* row = cells.GetScanlineSortedCells(y);
+        for (uint32_t i = 0; i < cells.GetScanlineNumCells(y); i++) {
+            maxCover = MATH_MAX(maxCover, MATH_ABS(row[i].cover));
+        }
+    }
+    EXPECT_EQ(maxCover, CellPackedAntiAlias::COVER_LIMIT);
+
+    UICanvasVertices farPath;
+    farPath.MoveTo(far, pixel);
+    farPath.LineTo(far + 1.0f, pixel + 1.0f);
+    farPath.LineTo(far, pixel + 1.0f);
+    farPath.EndPoly();
+    RasterizerCellsAntiAliasPacked farCells;
+    AddPathCells(farCells, farPath);
+    farCells.SortAllCells();
+    ASSERT_GT(farCells.GetTotalCells(), 0u);
+    EXPECT_EQ(farCells.GetScanlineSortedCells(static_cast<int32_t>(pixel))[0].x, INT16_MAX);
+}
+
+/**
+ * @tc.name: RasterizerBands_001
+ * @tc.desc: Verify the band parallel rasterizer sweeps the same scanlines as the serial one.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerBands_001, TestSize.Level0)
+{
+    const uint32_t maxBands = 4;
+    const float clipMin = 50.0f;
+    const float clipMax = 230.0f;
+    UICanvasVertices path;
+    BuildStar(path, 0);
+    BuildStar(path, STAR_INNER_RADIUS);
+
+    RasterizerScanlineAntialias serialRasterizer;
+    serialRasterizer.AddPath(path);
+    std::vector<SweptSpan> serialSpans;
+    Sweep(serialRasterizer, serialSpans);
+
+    RasterizerScanlineBands bandRasterizer(maxBands);
+    bandRasterizer.AddPath(path);
+    std::vector<SweptSpan> bandSpans;
+    Sweep(bandRasterizer, bandSpans);
+    EXPECT_EQ(bandRasterizer.GetNumBands(), maxBands);
+    EXPECT_FALSE(serialSpans.empty());
+    ExpectSameSpans(serialSpans, bandSpans);
+
+    serialRasterizer.ClipBox(clipMin, clipMin, clipMax, clipMax);
+    serialRasterizer.AddPath(path);
+    serialSpans.clear();
+    Sweep(serialRasterizer, serialSpans);
+
+    bandRasterizer.ClipBox(clipMin, clipMin, clipMax, clipMax);
+    bandRasterizer.AddPath(path);
+    bandSpans.clear();
+    Sweep(bandRasterizer, bandSpans);
+    EXPECT_FALSE(serialSpans.empty());
+    ExpectSameSpans(serialSpans, bandSpans);
+}
+
+/**
+ * @tc.name: RasterizerBands_002
+ * @tc.desc: Verify packed band sweeps keep the solid runs and bands that can not be stored are rasterized again.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerBands_002, TestSize.Level0)
+{
+    const uint32_t maxBands = 4;
+    UICanvasVertices path;
+    BuildStar(path, 0);
+    RasterizerScanlineAntialias serialRasterizer;
+    serialRasterizer.AddPath(path);
+    std::vector<SweptSpan> serialSpans;
+    uint32_t serialRuns = 0;
+    SweepPacked(serialRasterizer, serialSpans, serialRuns);
+
+    RasterizerScanlineBands bandRasterizer(maxBands);
+    bandRasterizer.AddPath(path);
+    std::vector<SweptSpan> bandSpans;
+    uint32_t bandRuns = 0;
+    SweepPacked(bandRasterizer, bandSpans, bandRuns);
+    EXPECT_EQ(bandRasterizer.GetNumBands(), maxBands);
+    EXPECT_GT(serialRuns, 0u);
+    EXPECT_GT(bandRuns, 0u);
+    ExpectSameSpans(serialSpans, bandSpans);
+
+    // The star and its reverse leave twice the cells of the star but only the rounding of the covers,
+    // so the star is then rasterized without allocating and only the band storage has to grow
+    UICanvasVertices cancelled;
+    BuildStar(cancelled, 0);
+    BuildStar(cancelled, 0, 1.0f, true);
+    RasterizerScanlineBands failedRasterizer(maxBands);
+    failedRasterizer.AddPath(cancelled);
+    std::vector<SweptSpan> cancelledSpans;
+    Sweep(failedRasterizer, cancelledSpans);
+    EXPECT_LT(cancelledSpans.size(), serialSpans.size());
+    failedRasterizer.AddPath(path);
+    GeometryScanlinePacked scanline;
+    scanline.Reset(serialRasterizer.GetMinX(), serialRasterizer.GetMaxX());
+    bandSpans.clear();
+    g_failAllocations = true;
+    SweepPacked(failedRasterizer, bandSpans, bandRuns, scanline);
+    g_failAllocations = false;
+    EXPECT_EQ(failedRasterizer.GetNumBands(), maxBands);
+    ExpectSameSpans(serialSpans, bandSpans);
+}
+
+/**
+ * @tc.name: RasterizerTiling_001
+ * @tc.desc: Verify a path that overflows the cell block limit is tiled into the same scanlines.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerTiling_001, TestSize.Level0)
+{
+    const uint32_t smallBlockLimit = 8;
+    UICanvasVertices path;
+    BuildStar(path, 0);
+    BuildStar(path, STAR_INNER_RADIUS);
+
+    RasterizerScanlineAntialias fullRasterizer;
+    fullRasterizer.AddPath(path);
+    std::vector<SweptSpan> fullSpans;
+    Sweep(fullRasterizer, fullSpans);
+    EXPECT_FALSE(fullRasterizer.GetAutoTiling());
+    EXPECT_EQ(fullRasterizer.GetTilingStats().tiledPaths, 0u);
+
+    RasterizerScanlineAntialias tiledRasterizer(smallBlockLimit);
+    tiledRasterizer.SetAutoTiling(true);
+    tiledRasterizer.AddPath(path);
+    std::vector<SweptSpan> tiledSpans;
+    Sweep(tiledRasterizer, tiledSpans);
+    EXPECT_FALSE(fullSpans.empty());
+    ExpectSameSpans(fullSpans, tiledSpans);
+    const RasterizerTilingStats& stats = tiledRasterizer.GetTilingStats();
+    EXPECT_EQ(stats.tiledPaths, 1u);
+    EXPECT_GT(stats.tilePasses, 1u);
+    EXPECT_EQ(stats.droppedCells, 0u);
+
+    tiledSpans.clear();
+    Sweep(tiledRasterizer, tiledSpans);
+    ExpectSameSpans(fullSpans, tiledSpans);
+
+    tiledRasterizer.ResetTilingStats();
+    tiledRasterizer.SetAutoTiling(false);
+    tiledRasterizer.AddPath(path);
+    tiledSpans.clear();
+    Sweep(tiledRasterizer, tiledSpans);
+    EXPECT_EQ(tiledRasterizer.GetTilingStats().tiledPaths, 0u);
+    EXPECT_GT(tiledRasterizer.GetTilingStats().droppedCells, 0u);
+}
+
+/**
+ * @tc.name: RasterizerTiling_002
+ * @tc.desc: Verify the tiles sweep the same scanlines on every rewind, and a path recorded beyond
+ * the memory of the cell block limit is rasterized untiled.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerTiling_002, TestSize.Level0)
+{
+    const uint32_t smallBlockLimit = 8;
+    const float scale = 2.0f;
+    UICanvasVertices path;
+    BuildStar(path, 0, scale);
+    BuildStar(path, STAR_INNER_RADIUS, scale);
+
+    RasterizerScanlineAntialias fullRasterizer;
+    fullRasterizer.AddPath(path);
+    std::vector<SweptSpan> fullSpans;
+    Sweep(fullRasterizer, fullSpans);
+
+    RasterizerScanlineAntialias tiledRasterizer(smallBlockLimit);
+    tiledRasterizer.SetAutoTiling(true);
+    tiledRasterizer.AddPath(path);
+    std::vector<SweptSpan> tiledSpans;
+    Sweep(tiledRasterizer, tiledSpans);
+    ExpectSameSpans(fullSpans, tiledSpans);
+    RasterizerTilingStats firstStats = tiledRasterizer.GetTilingStats();
+    EXPECT_EQ(firstStats.droppedCells, 0u);
+
+    // A rewind starts again from the tile height of the path, not from the one a dense tile left
+    tiledRasterizer.ResetTilingStats();
+    tiledSpans.clear();
+    Sweep(tiledRasterizer, tiledSpans);
+    ExpectSameSpans(fullSpans, tiledSpans);
+    EXPECT_EQ(tiledRasterizer.GetTilingStats().tilePasses, firstStats.tilePasses);
+    EXPECT_EQ(tiledRasterizer.GetTilingStats().tileRetries, firstStats.tileRetries);
+
+    // 1: a single block, the record of the many edges of the wavy outline exceeds its memory
+    const uint32_t waves = 64;
+    UICanvasVertices wavyPath;
+    wavyPath.MoveTo(0, 0);
+    for (uint32_t i = 0; i <= waves; i++) {
+        wavyPath.LineTo(i * scale, (i % TWO_TIMES) ? STAR_CENTER : STAR_CENTER - 1.0f);
+    }
+    wavyPath.LineTo(0, STAR_CENTER);
+    wavyPath.EndPoly();
+    RasterizerScanlineAntialias untiledRasterizer(1);
+    untiledRasterizer.SetAutoTiling(true);
+    untiledRasterizer.AddPath(wavyPath);
+    EXPECT_TRUE(untiledRasterizer.RewindScanlines());
+    EXPECT_EQ(untiledRasterizer.GetTilingStats().tiledPaths, 0u);
+    EXPECT_GT(untiledRasterizer.GetTilingStats().droppedCells, 0u);
+}
+
+/**
+ * @tc.name: RasterizerTiling_003
+ * @tc.desc: Verify the memory reserved for the path record is taken from the cell block limit.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerTiling_003, TestSize.Level0)
+{
+    const uint32_t smallBlockLimit = 8;
+    UICanvasVertices path;
+    BuildStar(path, 0);
+    RasterizerCellsAntiAlias cells(smallBlockLimit);
+    uint32_t capacity = cells.GetCellCapacity();
+    EXPECT_EQ(cells.GetCellMemoryLimit(), capacity * sizeof(CellBuildAntiAlias));
+    // 1: one byte takes a whole cell block
+    EXPECT_TRUE(cells.ReserveMemory(1));
+    EXPECT_EQ(cells.GetCellCapacity(), capacity - capacity / smallBlockLimit);
+    AddPathCells(cells, path);
+    EXPECT_LE(cells.GetTotalCells(), cells.GetCellCapacity());
+    // The blocks used by the cells can not be reserved until Reset
+    EXPECT_FALSE(cells.ReserveMemory(cells.GetCellMemoryLimit()));
+    cells.Reset();
+    EXPECT_TRUE(cells.ReserveMemory(cells.GetCellMemoryLimit()));
+    EXPECT_EQ(cells.GetCellCapacity(), 0u);
+    AddPathCells(cells, path);
+    EXPECT_EQ(cells.GetTotalCells(), 0u);
+    EXPECT_GT(cells.GetDroppedCells(), 0u);
+}
+
+/**
+ * @tc.name: RasterizerDense_001
+ * @tc.desc: Verify small paths are accumulated densely into the same scanlines as cells.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerDense_001, TestSize.Level0)
+{
+    const float smallScale = 0.2f;
+    const float fractionOffset = 0.37f;
+    const float clipMin = 110.0f;
+    const float clipMax = 200.0f;
+    UICanvasVertices path;
+    BuildStar(path, fractionOffset, smallScale);
+    BuildStar(path, STAR_INNER_RADIUS * smallScale, smallScale);
+
+    RasterizerScanlineAntialias cellRasterizer;
+    cellRasterizer.SetDenseAreaLimit(0);
+    RasterizerScanlineAntialias denseRasterizer;
+    for (int32_t pass = 0; pass < 3; pass++) { // 3: plain, clipped, not closed
+        if (pass == 1) {
+            cellRasterizer.ClipBox(clipMin, clipMin, clipMax, clipMax);
+            denseRasterizer.ClipBox(clipMin, clipMin, clipMax, clipMax);
+        } else if (pass == 2) { // 2: not closed
+            cellRasterizer.AutoClose(false);
+            denseRasterizer.AutoClose(false);
+        }
+        cellRasterizer.AddPath(path);
+        std::vector<SweptSpan> cellSpans;
+        Sweep(cellRasterizer, cellSpans);
+        EXPECT_FALSE(cellRasterizer.IsDense());
+
+        denseRasterizer.AddPath(path);
+        std::vector<SweptSpan> denseSpans;
+        Sweep(denseRasterizer, denseSpans);
+        EXPECT_TRUE(denseRasterizer.IsDense());
+        EXPECT_FALSE(cellSpans.empty());
+        ExpectSameSpans(cellSpans, denseSpans);
+    }
+
+    UICanvasVertices largePath;
+    BuildStar(largePath, 0);
+    denseRasterizer.ResetClipping();
+    denseRasterizer.AddPath(largePath);
+    std::vector<SweptSpan> largeSpans;
+    Sweep(denseRasterizer, largeSpans);
+    EXPECT_FALSE(denseRasterizer.IsDense());
+}
+
+/**
+ * @tc.name: RasterizerDense_002
+ * @tc.desc: Verify the dense prefix sum matches the scalar one and interior runs are swept as solid spans.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerDense_002, TestSize.Level0)
+{
+    const uint32_t numCells = 23; // 23: vector blocks and a scalar tail
+    RasterizerDenseCoverage::DenseCell cells[numCells];
+    for (uint32_t i = 0; i < numCells; i++) {
+        cells[i].cover = static_cast<int32_t>(i * 37 % 11) - 5; // 37, 11, 5: covers in -5 to 5
+        cells[i].area = static_cast<int32_t>(i * 53 % 97) - 48; // 53, 97, 48: areas in -48 to 48
+    }
+    const int32_t startCover = 7;
+    int32_t cover = startCover;
+    int32_t areas[numCells];
+    RasterizerDenseCoverage::PrefixSum(cells, numCells, cover, areas);
+    int32_t expectCover = startCover;
+    for (uint32_t i = 0; i < numCells; i++) {
+        expectCover += cells[i].cover;
+        EXPECT_EQ(areas[i], (expectCover << (POLY_SUBPIXEL_SHIFT + 1)) - cells[i].area);
+    }
+    EXPECT_EQ(cover, expectCover);
+
+    const float smallScale = 0.3f;
+    UICanvasVertices path;
+    BuildStar(path, 0, smallScale);
+    RasterizerScanlineAntialias cellRasterizer;
+    cellRasterizer.SetDenseAreaLimit(0);
+    cellRasterizer.AddPath(path);
+    std::vector<SweptSpan> cellSpans;
+    uint32_t cellSolidRuns = 0;
+    SweepPacked(cellRasterizer, cellSpans, cellSolidRuns);
+    RasterizerScanlineAntialias denseRasterizer;
+    denseRasterizer.AddPath(path);
+    std::vector<SweptSpan> denseSpans;
+    uint32_t denseSolidRuns = 0;
+    SweepPacked(denseRasterizer, denseSpans, denseSolidRuns);
+    EXPECT_TRUE(denseRasterizer.IsDense());
+    EXPECT_GT(denseSolidRuns, 0u);
+    ExpectSameSpans(cellSpans, denseSpans);
+}
+
+/**
+ * @tc.name: RasterizerSweepAlpha_001
+ * @tc.desc: Verify the vectorized coverage to alpha conversion matches the scalar sweep.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerSweepAlpha_001, TestSize.Level0)
+{
+    const int32_t layers = 3;
+    UICanvasVertices path;
+    for (int32_t layer = 0; layer < layers; layer++) {
+        BuildStar(path, layer * STAR_INNER_RADIUS / layers);
+    }
+
+    RasterizerCellsAntiAlias cells;
+    cells.SetSortMode(RasterizerCellsBase::CELL_SORT_QUICK);
+    AddPathCells(cells, path);
+    cells.SortAllCells();
+    std::vector<SweptSpan> expectSpans;
+    for (int32_t y = cells.GetMinY(); y <= cells.GetMaxY(); y++) {
+        SweepReference(cells, y, expectSpans);
+    }
+
+    RasterizerScanlineAntialias rasterizer;
+    rasterizer.SetDenseAreaLimit(0);
+    rasterizer.AddPath(path);
+    std::vector<SweptSpan> spans;
+    Sweep(rasterizer, spans);
+    EXPECT_FALSE(expectSpans.empty());
+    ExpectSameSpans(expectSpans, spans);
+
+    // Squares wound 130 times have covers above INT16_MAX, the vector paths saturate them to full alpha
+    const int32_t windings = 130;
+    const int32_t numSquares = 5;
+    UICanvasVertices squares;
+    for (int32_t winding = 0; winding < windings; winding++) {
+        for (int32_t square = 0; square < numSquares; square++) {
+            float x = 10.25f + square * 20.0f; // 20: distance of the squares
+            squares.MoveTo(x, 10.5f);
+            squares.LineTo(x + 10.5f, 10.5f);
+            squares.LineTo(x + 10.5f, 30.75f);
+            squares.LineTo(x, 30.75f);
+            squares.EndPoly();
+        }
+    }
+    RasterizerCellsAntiAlias squareCells;
+    squareCells.SetSortMode(RasterizerCellsBase::CELL_SORT_QUICK);
+    AddPathCells(squareCells, squares);
+    squareCells.SortAllCells();
+    std::vector<SweptSpan> expectSquareSpans;
+    for (int32_t y = squareCells.GetMinY(); y <= squareCells.GetMaxY(); y++) {
+        SweepReference(squareCells, y, expectSquareSpans);
+    }
+    rasterizer.AddPath(squares);
+    std::vector<SweptSpan> squareSpans;
+    Sweep(rasterizer, squareSpans);
+    ExpectSameSpans(expectSquareSpans, squareSpans);
+    RasterizerScanlineAntialias denseRasterizer;
+    denseRasterizer.AddPath(squares);
+    std::vector<SweptSpan> denseSpans;
+    Sweep(denseRasterizer, denseSpans);
+    EXPECT_TRUE(denseRasterizer.IsDense());
+    ExpectSameSpans(expectSquareSpans, denseSpans);
+    uint32_t solid = 0;
+    for (const SweptSpan& span : squareSpans) {
+        for (uint8_t cover : span.covers) {
+            solid += (cover == RasterizerScanlineAntialias::AA_MASK) ? 1 : 0;
+        }
+    }
+    EXPECT_GT(solid, 0u);
+}
+
+/**
+ * @tc.name: RasterizerRect_001
+ * @tc.desc: Verify axis-aligned rectangles are swept without cells into the same scanlines as paths.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerRect_001, TestSize.Level0)
+{
+    const int32_t numRects = 5;
+    const float rects[numRects][4] = { // 4: x1, y1, x2, y2
+        {10.0f, 20.0f, 110.0f, 70.0f},
+        {10.37f, 20.61f, 150.25f, 90.8f},
+        {210.9f, 300.2f, 5.5f, 8.75f},
+        {30.2f, 40.1f, 30.7f, 40.9f},
+        {-20.5f, 100.3f, 40.6f, 300.4f}
+    };
+    const float clipMin = 12.5f;
+    const float clipMax = 200.0f;
+    RasterizerScanlineAntialias pathRasterizer;
+    EXPECT_FALSE(pathRasterizer.GetShapeFastPath());
+    RasterizerScanlineAntialias rectRasterizer;
+    rectRasterizer.SetShapeFastPath(true);
+    for (int32_t pass = 0; pass < 2; pass++) { // 2: plain, clipped
+        if (pass == 1) {
+            pathRasterizer.ClipBox(clipMin, clipMin, clipMax, clipMax);
+            rectRasterizer.ClipBox(clipMin, clipMin, clipMax, clipMax);
+        }
+        for (int32_t i = 0; i < numRects; i++) {
+            UICanvasVertices path;
+            path.MoveTo(rects[i][0], rects[i][1]);
+            path.LineTo(rects[i][0], rects[i][3]); // 3: y2
+            path.LineTo(rects[i][2], rects[i][3]); // 2: x2, 3: y2
+            path.LineTo(rects[i][2], rects[i][1]); // 2: x2
+            path.EndPoly();
+
+            pathRasterizer.AddPath(path);
+            std::vector<SweptSpan> pathSpans;
+            Sweep(pathRasterizer, pathSpans);
+            EXPECT_EQ(pathRasterizer.GetShape(), RasterizerShapeFastPath::SHAPE_PATH);
+
+            rectRasterizer.AddPath(path);
+            std::vector<SweptSpan> rectSpans;
+            Sweep(rectRasterizer, rectSpans);
+            EXPECT_EQ(rectRasterizer.GetShape(), RasterizerShapeFastPath::SHAPE_RECT);
+            EXPECT_FALSE(pathSpans.empty());
+            ExpectSameSpans(pathSpans, rectSpans);
+        }
+    }
+
+    UICanvasVertices twoRects;
+    twoRects.MoveTo(rects[0][0], rects[0][1]);
+    twoRects.LineTo(rects[0][2], rects[0][1]); // 2: x2
+    twoRects.LineTo(rects[0][2], rects[0][3]); // 2: x2, 3: y2
+    twoRects.LineTo(rects[0][0], rects[0][3]); // 3: y2
+    twoRects.EndPoly();
+    twoRects.MoveTo(rects[1][0], rects[1][1]);
+    twoRects.LineTo(rects[1][2], rects[1][3]); // 2: x2, 3: y2
+    twoRects.EndPoly();
+    rectRasterizer.AddPath(twoRects);
+    std::vector<SweptSpan> spans;
+    Sweep(rectRasterizer, spans);
+    EXPECT_EQ(rectRasterizer.GetShape(), RasterizerShapeFastPath::SHAPE_PATH);
+}
+
+/**
+ * @tc.name: RasterizerRoundedRect_001
+ * @tc.desc: Verify rounded rectangles filled from the corner masks match their rasterized outline.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerRoundedRect_001, TestSize.Level0)
+{
+    const int32_t numRects = 6;
+    const float rects[numRects][5] = { // 5: x1, y1, x2, y2, radius
+        {10.0f, 20.0f, 110.0f, 70.0f, 8.0f},
+        {10.0f, 20.0f, 110.0f, 70.0f, 8.0f},
+        {5.0f, 5.0f, 45.0f, 205.0f, 20.0f},
+        {100.0f, 30.0f, 250.0f, 200.0f, 64.0f},
+        {30.0f, 40.0f, 40.0f, 60.0f, 30.0f},
+        {10.5f, 20.25f, 110.0f, 70.0f, 12.5f}
+    };
+    const bool masked[numRects] = {true, true, true, true, true, false};
+    RasterizerScanlineAntialias pathRasterizer;
+    RasterizerScanlineAntialias maskRasterizer;
+    maskRasterizer.SetShapeFastPath(true);
+    for (int32_t i = 0; i < numRects; i++) {
+        pathRasterizer.AddRoundedRect(rects[i][0], rects[i][1], rects[i][2], rects[i][3], rects[i][4]); // 2,3,4
+        std::vector<SweptSpan> pathSpans;
+        Sweep(pathRasterizer, pathSpans);
+        EXPECT_EQ(pathRasterizer.GetShape(), RasterizerShapeFastPath::SHAPE_PATH);
+
+        maskRasterizer.AddRoundedRect(rects[i][0], rects[i][1], rects[i][2], rects[i][3], rects[i][4]); // 2,3,4
+        std::vector<SweptSpan> maskSpans;
+        Sweep(maskRasterizer, maskSpans);
+        EXPECT_EQ(maskRasterizer.GetShape() == RasterizerShapeFastPath::SHAPE_ROUNDED_RECT, masked[i]);
+        EXPECT_FALSE(pathSpans.empty());
+        ExpectSameSpans(pathSpans, maskSpans);
+    }
+
+    UICanvasVertices star;
+    BuildStar(star, 0);
+    pathRasterizer.AddRoundedRect(rects[0][0], rects[0][1], rects[0][2], rects[0][3], rects[0][4]); // 2,3,4
+    pathRasterizer.AddPath(star);
+    std::vector<SweptSpan> pathSpans;
+    Sweep(pathRasterizer, pathSpans);
+    maskRasterizer.AddRoundedRect(rects[0][0], rects[0][1], rects[0][2], rects[0][3], rects[0][4]); // 2,3,4
+    maskRasterizer.AddPath(star);
+    std::vector<SweptSpan> maskSpans;
+    Sweep(maskRasterizer, maskSpans);
+    EXPECT_EQ(maskRasterizer.GetShape(), RasterizerShapeFastPath::SHAPE_PATH);
+    ExpectSameSpans(pathSpans, maskSpans);
+}
+
+/**
+ * @tc.name: RasterizedPathCache_001
+ * @tc.desc: Verify cached paths replay the scanlines of the rasterizer and are evicted by the byte budget.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizedPathCache_001, TestSize.Level0)
+{
+    const float rotation = 0.3f;
+    const float scale = 0.8f;
+    const float shift = 12.5f;
+    const float clipMin = 50.0f;
+    const float clipMax = 150.0f;
+    UICanvasVertices path;
+    BuildStar(path, 0);
+    TransAffine transform;
+    transform.Rotate(rotation);
+    transform.Scale(scale);
+    transform.Translate(shift, shift);
+
+    RasterizerScanlineAntialias rasterizer;
+    DepictTransform<UICanvasVertices> transformed(path, transform);
+    rasterizer.AddPath(transformed);
+    std::vector<SweptSpan> expectSpans;
+    Sweep(rasterizer, expectSpans);
+
+    RasterizedPathCache cache;
+    for (int32_t frame = 0; frame < 3; frame++) { // 3: one miss and two hits
+        EXPECT_EQ(cache.AddPath(rasterizer, path, transform), frame > 0);
+        std::vector<SweptSpan> spans;
+        Sweep(cache, spans);
+        EXPECT_FALSE(spans.empty());
+        ExpectSameSpans(expectSpans, spans);
+    }
+    EXPECT_EQ(cache.GetStats().hits, 2u);
+    EXPECT_EQ(cache.GetStats().misses, 1u);
+    EXPECT_EQ(cache.GetStats().entries, 1u);
+
+    // Every part of the key makes a new entry
+    transform.Translate(shift, 0);
+    EXPECT_FALSE(cache.AddPath(rasterizer, path, transform));
+    rasterizer.SetFillingRule(FILL_EVEN_ODD);
+    EXPECT_FALSE(cache.AddPath(rasterizer, path, transform));
+    rasterizer.ClipBox(clipMin, clipMin, clipMax, clipMax);
+    EXPECT_FALSE(cache.AddPath(rasterizer, path, transform));
+    std::vector<SweptSpan> clippedSpans;
+    Sweep(cache, clippedSpans);
+    rasterizer.AddPath(transformed);
+    expectSpans.clear();
+    Sweep(rasterizer, expectSpans);
+    ExpectSameSpans(expectSpans, clippedSpans);
+    EXPECT_EQ(cache.GetStats().entries, 4u);
+
+    // A budget of one entry keeps the most recently used one
+    uint32_t entryBytes = cache.GetStats().bytes / cache.GetStats().entries;
+    cache.SetByteBudget(entryBytes);
+    EXPECT_EQ(cache.GetStats().entries, 1u);
+    EXPECT_EQ(cache.GetStats().evictions, 3u);
+    EXPECT_TRUE(cache.AddPath(rasterizer, path, transform));
+
+    cache.SetByteBudget(0);
+    cache.ResetStats();
+    EXPECT_FALSE(cache.AddPath(rasterizer, path, transform));
+    std::vector<SweptSpan> rejectedSpans;
+    Sweep(cache, rejectedSpans);
+    ExpectSameSpans(expectSpans, rejectedSpans);
+    EXPECT_EQ(cache.GetStats().rejections, 1u);
+    EXPECT_EQ(cache.GetStats().entries, 0u);
+    EXPECT_EQ(cache.GetStats().bytes, 0u);
+}
+
+/**
+ * @tc.name: RasterizedPathCache_002
+ * @tc.desc: Verify a path whose scanlines can not be stored is swept from the rasterizer.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizedPathCache_002, TestSize.Level0)
+{
+    const float shift = 12.0f;
+    UICanvasVertices path;
+    BuildStar(path, 0);
+    TransAffine transform;
+    RasterizerScanlineAntialias rasterizer;
+    RasterizedPathCache cache;
+    // The first path leaves the cell and scratch buffers large enough for the moved one,
+    // so only the entry of the moved path is allocated
+    EXPECT_FALSE(cache.AddPath(rasterizer, path, transform));
+    transform.Translate(shift, shift);
+    g_failAllocations = true;
+    EXPECT_FALSE(cache.AddPath(rasterizer, path, transform));
+    g_failAllocations = false;
+    EXPECT_TRUE(cache.IsPassThrough());
+    EXPECT_EQ(cache.GetStats().entries, 1u);
+    std::vector<SweptSpan> spans;
+    Sweep(cache, spans);
+
+    RasterizerScanlineAntialias expectRasterizer;
+    DepictTransform<UICanvasVertices> transformed(path, transform);
+    expectRasterizer.AddPath(transformed);
+    std::vector<SweptSpan> expectSpans;
+    Sweep(expectRasterizer, expectSpans);
+    EXPECT_FALSE(expectSpans.empty());
+    ExpectSameSpans(expectSpans, spans);
+
+    // The next path is stored again
+    EXPECT_FALSE(cache.AddPath(rasterizer, path, transform));
+    EXPECT_FALSE(cache.IsPassThrough());
+    EXPECT_EQ(cache.GetStats().entries, 2u);
+}
+
+/**
+ * @tc.name: RasterizedPathCache_003
+ * @tc.desc: Verify hits compare the vertices and the clip region of the entries.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizedPathCache_003, TestSize.Level0)
+{
+    const uint32_t numRects = 2;
+    const Rect32 rects[numRects] = {Rect32(10, 10, 90, 60), Rect32(60, 40, 150, 150)};
+    const Rect32 movedRects[numRects] = {Rect32(10, 10, 90, 60), Rect32(60, 40, 150, 151)};
+    UICanvasVertices path;
+    BuildStar(path, 0);
+    UICanvasVertices reversedPath;
+    BuildStar(reversedPath, 0, 1.0f, true);
+    TransAffine transform;
+    RasterizerScanlineAntialias rasterizer;
+    EXPECT_TRUE(rasterizer.ClipRegion(rects, numRects));
+    RasterizedPathCache cache;
+    EXPECT_FALSE(cache.AddPath(rasterizer, path, transform));
+    EXPECT_TRUE(cache.AddPath(rasterizer, path, transform));
+    std::vector<SweptSpan> spans;
+    Sweep(cache, spans);
+    rasterizer.AddPath(path);
+    std::vector<SweptSpan> expectSpans;
+    Sweep(rasterizer, expectSpans);
+    EXPECT_FALSE(expectSpans.empty());
+    ExpectSameSpans(expectSpans, spans);
+
+    // The same vertices in another order and a moved rectangle are other entries
+    EXPECT_FALSE(cache.AddPath(rasterizer, reversedPath, transform));
+    EXPECT_TRUE(rasterizer.ClipRegion(movedRects, numRects));
+    EXPECT_FALSE(cache.AddPath(rasterizer, path, transform));
+    EXPECT_TRUE(cache.AddPath(rasterizer, path, transform));
+    EXPECT_EQ(cache.GetStats().entries, 3u);
+}
+
+/**
+ * @tc.name: RasterizerClipRegion_001
+ * @tc.desc: Verify a clip region of several rectangles covers the same pixels as clipping to each of them.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerClipRegion_001, TestSize.Level0)
+{
+    const int32_t imageSize = 256;
+    const uint32_t numRects = 4;
+    const Rect32 rects[numRects] = {
+        Rect32(100, 130, 230, 180),
+        Rect32(10, 10, 90, 60),
+        Rect32(60, 40, 150, 150),
+        Rect32(200, 5, 200, 250)
+    };
+    UICanvasVertices path;
+    BuildStar(path, 0.0f);
+
+    std::vector<uint8_t> expectImage(imageSize * imageSize, 0);
+    RasterizerScanlineAntialias rasterizer;
+    for (uint32_t i = 0; i < numRects; i++) {
+        rasterizer.Reset();
+        rasterizer.ClipBox(rects[i].GetLeft(), rects[i].GetTop(), rects[i].GetRight() + 1, rects[i].GetBottom() + 1);
+        rasterizer.AddPath(path);
+        std::vector<SweptSpan> spans;
+        Sweep(rasterizer, spans);
+        for (const SweptSpan& span : spans) {
+            for (int32_t x = 0; x < span.len; x++) {
+                expectImage[span.y * imageSize + span.x + x] = span.covers[x];
+            }
+        }
+    }
+
+    EXPECT_TRUE(rasterizer.ClipRegion(rects, numRects));
+    rasterizer.AddPath(path);
+    std::vector<SweptSpan> regionSpans;
+    Sweep(rasterizer, regionSpans);
+    std::vector<uint8_t> regionImage(imageSize * imageSize, 0);
+    for (const SweptSpan& span : regionSpans) {
+        ASSERT_GT(span.len, 0);
+        for (int32_t x = 0; x < span.len; x++) {
+            EXPECT_EQ(regionImage[span.y * imageSize + span.x + x], 0);
+            regionImage[span.y * imageSize + span.x + x] = span.covers[x];
+        }
+    }
+    EXPECT_FALSE(regionSpans.empty());
+    // Lines split at different clip boxes may round their cells one level apart
+    for (int32_t i = 0; i < imageSize * imageSize; i++) {
+        EXPECT_LE(MATH_ABS(regionImage[i] - expectImage[i]), 1);
+        EXPECT_EQ(regionImage[i] == 0, expectImage[i] == 0);
+    }
+
+    // The cache tells regions apart
+    RasterizedPathCache cache;
+    TransAffine transform;
+    EXPECT_FALSE(cache.AddPath(rasterizer, path, transform));
+    std::vector<SweptSpan> cachedSpans;
+    Sweep(cache, cachedSpans);
+    ExpectSameSpans(regionSpans, cachedSpans);
+    EXPECT_TRUE(rasterizer.ClipRegion(rects, numRects - 1));
+    EXPECT_FALSE(cache.AddPath(rasterizer, path, transform));
+    EXPECT_TRUE(rasterizer.ClipRegion(rects, numRects));
+    EXPECT_TRUE(cache.AddPath(rasterizer, path, transform));
+
+    const Rect32* region = nullptr;
+    EXPECT_EQ(rasterizer.GetClipRegion(region), numRects);
+    EXPECT_TRUE(rasterizer.ClipRegion(nullptr, 0));
+    rasterizer.AddPath(path);
+    EXPECT_FALSE(rasterizer.RewindScanlines());
+    rasterizer.ResetClipping();
+    EXPECT_EQ(rasterizer.GetClipRegion(region), 0u);
+}
+
+/**
+ * @tc.name: RasterizerClipRegion_002
+ * @tc.desc: Verify the band parallel rasterizer clips every band to the region, or to its bounds when
+ * the region can not be stored.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerClipRegion_002, TestSize.Level0)
+{
+    const uint32_t maxBands = 4;
+    const uint32_t numRects = 3;
+    const Rect32 rects[numRects] = {
+        Rect32(100, 130, 230, 180),
+        Rect32(10, 10, 90, 60),
+        Rect32(60, 40, 150, 150)
+    };
+    UICanvasVertices path;
+    BuildStar(path, 0.0f);
+
+    RasterizerScanlineAntialias serialRasterizer;
+    EXPECT_TRUE(serialRasterizer.ClipRegion(rects, numRects));
+    serialRasterizer.AddPath(path);
+    std::vector<SweptSpan> serialSpans;
+    Sweep(serialRasterizer, serialSpans);
+    RasterizerScanlineBands bandRasterizer(maxBands);
+    EXPECT_TRUE(bandRasterizer.ClipRegion(rects, numRects));
+    bandRasterizer.AddPath(path);
+    std::vector<SweptSpan> bandSpans;
+    Sweep(bandRasterizer, bandSpans);
+    EXPECT_GT(bandRasterizer.GetNumBands(), 1u);
+    EXPECT_FALSE(serialSpans.empty());
+    ExpectSameSpans(serialSpans, bandSpans);
+
+    // A region that can not be stored clips to its bounding box, like the serial rasterizer
+    const float boundsMin = 10.0f;
+    const float boundsRight = 231.0f; // 231: right of the inclusive right 230
+    const float boundsBottom = 181.0f; // 181: below the inclusive bottom 180
+    serialRasterizer.ClipBox(boundsMin, boundsMin, boundsRight, boundsBottom);
+    serialRasterizer.AddPath(path);
+    serialSpans.clear();
+    Sweep(serialRasterizer, serialSpans);
+    RasterizerScanlineBands failedRasterizer(maxBands);
+    g_failAllocations = true;
+    EXPECT_FALSE(failedRasterizer.ClipRegion(rects, numRects));
+    g_failAllocations = false;
+    failedRasterizer.AddPath(path);
+    bandSpans.clear();
+    Sweep(failedRasterizer, bandSpans);
+    ExpectSameSpans(serialSpans, bandSpans);
+}
+
+/**
+ * @tc.name: RasterizerPackedScanline_001
+ * @tc.desc: Verify a packed scanline carries the covers of GeometryScanline with solid runs kept as one cover.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, RasterizerPackedScanline_001, TestSize.Level0)
+{
+    const float starScale = 2.0f;
+    UICanvasVertices path;
+    BuildStar(path, STAR_OUTER_RADIUS, starScale);
+    UICanvasVertices smallPath;
+    BuildStar(smallPath, 0, STAR_INNER_RADIUS / STAR_OUTER_RADIUS);
+
+    RasterizerScanlineAntialias rasterizer;
+    rasterizer.SetShapeFastPath(true);
+    for (UICanvasVertices* vertices : {&path, &smallPath}) {
+        rasterizer.AddPath(*vertices);
+        std::vector<SweptSpan> expectSpans;
+        Sweep(rasterizer, expectSpans);
+        std::vector<SweptSpan> packedSpans;
+        uint32_t solidRuns = 0;
+        SweepPacked(rasterizer, packedSpans, solidRuns);
+        EXPECT_FALSE(expectSpans.empty());
+        ExpectSameSpans(expectSpans, packedSpans);
+        if (vertices == &path) {
+            EXPECT_GT(solidRuns, 0u);
+        }
+    }
+
+    rasterizer.AddRoundedRect(10.0f, 20.0f, 110.0f, 70.0f, 8.0f); // 8: radius of the corners
+    std::vector<SweptSpan> roundedSpans;
+    Sweep(rasterizer, roundedSpans);
+    std::vector<SweptSpan> packedRoundedSpans;
+    uint32_t roundedRuns = 0;
+    SweepPacked(rasterizer, packedRoundedSpans, roundedRuns);
+    ExpectSameSpans(roundedSpans, packedRoundedSpans);
+    EXPECT_GT(roundedRuns, 0u);
+
+    const uint32_t numRects = 2;
+    const Rect32 rects[numRects] = {Rect32(150, 100, 260, 180), Rect32(220, 170, 400, 330)};
+    EXPECT_TRUE(rasterizer.ClipRegion(rects, numRects));
+    rasterizer.AddPath(path);
+    std::vector<SweptSpan> regionSpans;
+    Sweep(rasterizer, regionSpans);
+    std::vector<SweptSpan> packedRegionSpans;
+    SweepPacked(rasterizer, packedRegionSpans, roundedRuns);
+    EXPECT_FALSE(regionSpans.empty());
+    ExpectSameSpans(regionSpans, packedRegionSpans);
+
+    RasterizedPathCache cache;
+    TransAffine transform;
+    cache.AddPath(rasterizer, path, transform);
+    std::vector<SweptSpan> cachedSpans;
+    SweepPacked(cache, cachedSpans, roundedRuns);
+    ExpectSameSpans(regionSpans, cachedSpans);
+}
+
+/**
+ * @tc.name: ScanlineStorage_001
+ * @tc.desc: Verify recorded scanlines replay moved by the offset, answer cover queries and survive serialization.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, ScanlineStorage_001, TestSize.Level0)
+{
+    const int32_t dx = 7;
+    const int32_t dy = -3;
+    UICanvasVertices path;
+    BuildStar(path, 0);
+    BuildStar(path, STAR_INNER_RADIUS);
+    RasterizerScanlineAntialias rasterizer;
+    rasterizer.AddPath(path);
+    std::vector<SweptSpan> expectSpans;
+    Sweep(rasterizer, expectSpans);
+    ASSERT_FALSE(expectSpans.empty());
+
+    ScanlineStorage storage;
+    EXPECT_TRUE(storage.Record(rasterizer));
+    std::vector<SweptSpan> storedSpans;
+    Sweep(storage, storedSpans);
+    ExpectSameSpans(expectSpans, storedSpans);
+    int32_t minX = INT_MAX;
+    int32_t maxX = INT_MIN;
+    for (const SweptSpan& span : expectSpans) {
+        minX = MATH_MIN(minX, span.x);
+        maxX = MATH_MAX(maxX, span.x + span.len - 1);
+    }
+    EXPECT_EQ(storage.GetMinX(), minX);
+    EXPECT_EQ(storage.GetMaxX(), maxX);
+    EXPECT_EQ(storage.GetMinY(), expectSpans.front().y);
+    EXPECT_EQ(storage.GetMaxY(), expectSpans.back().y);
+
+    storage.SetOffset(dx, dy);
+    std::vector<SweptSpan> movedSpans;
+    uint32_t solidRuns = 0;
+    SweepPacked(storage, movedSpans, solidRuns);
+    ASSERT_EQ(movedSpans.size(), expectSpans.size());
+    for (uint32_t i = 0; i < expectSpans.size(); i++) {
+        EXPECT_EQ(movedSpans[i].x, expectSpans[i].x + dx);
+        EXPECT_EQ(movedSpans[i].y, expectSpans[i].y + dy);
+        EXPECT_EQ(movedSpans[i].covers, expectSpans[i].covers);
+    }
+    EXPECT_EQ(storage.GetMinY(), expectSpans.front().y + dy);
+    for (const SweptSpan& span : expectSpans) {
+        for (int32_t x = 0; x < span.len; x++) {
+            EXPECT_EQ(storage.GetCover(span.x + x + dx, span.y + dy), span.covers[x]);
+        }
+        EXPECT_EQ(storage.GetCover(span.x + dx - 1, span.y + dy), 0);
+        EXPECT_EQ(storage.GetCover(span.x + span.len + dx, span.y + dy), 0);
+    }
+    EXPECT_EQ(storage.GetCover(minX + dx, storage.GetMaxY() + 1), 0);
+
+    std::vector<uint8_t> data(storage.GetSerializedSize());
+    EXPECT_FALSE(storage.Serialize(data.data(), data.size() - 1));
+    EXPECT_TRUE(storage.Serialize(data.data(), data.size()));
+    ScanlineStorage loaded;
+    EXPECT_TRUE(loaded.Deserialize(data.data(), data.size()));
+    std::vector<SweptSpan> loadedSpans;
+    Sweep(loaded, loadedSpans);
+    ExpectSameSpans(expectSpans, loadedSpans);
+    ScanlineStorage copied;
+    EXPECT_TRUE(copied.CopyFrom(storage));
+    EXPECT_EQ(copied.GetOffsetX(), dx);
+    EXPECT_EQ(copied.GetSerializedSize(), storage.GetSerializedSize());
+    std::vector<SweptSpan> copiedSpans;
+    Sweep(copied, copiedSpans);
+    std::vector<SweptSpan> offsetSpans;
+    Sweep(storage, offsetSpans);
+    ExpectSameSpans(offsetSpans, copiedSpans);
+    EXPECT_FALSE(loaded.Deserialize(data.data(), data.size() - 1));
+    EXPECT_TRUE(loaded.IsEmpty());
+    // Spans that point past the covers are rejected, numCovers follows magic, numRows and numSpans
+    std::vector<uint8_t> corrupt(data);
+    const uint32_t numCoversAt = 3 * sizeof(uint32_t); // 3: magic, numRows, numSpans
+    const uint32_t fewCovers = 1;
+    ASSERT_EQ(memcpy_s(corrupt.data() + numCoversAt, sizeof(fewCovers), &fewCovers, sizeof(fewCovers)), EOK);
+    EXPECT_FALSE(loaded.Deserialize(corrupt.data(), corrupt.size()));
+    // Bounds around the spans that do not fit the 16 bit scanlines are rejected, minX and maxX follow numCovers
+    const uint32_t minXAt = numCoversAt + sizeof(uint32_t);
+    const int32_t bounds[][2] = {{INT16_MIN - 1, maxX}, {minX, INT16_MAX + 1}, {INT16_MIN, INT16_MAX}};
+    for (const int32_t* bound : bounds) {
+        corrupt = data;
+        const uint32_t boundSize = sizeof(int32_t) * 2; // 2: minX, maxX
+        ASSERT_EQ(memcpy_s(corrupt.data() + minXAt, boundSize, bound, boundSize), EOK);
+        EXPECT_FALSE(loaded.Deserialize(corrupt.data(), corrupt.size()));
+    }
+
+    GeometryScanline scanline;
+    scanline.Reset(0, 1);
+    scanline.AddCell(0, RasterizerScanlineAntialias::AA_MASK);
+    scanline.Finalize(0);
+    EXPECT_FALSE(storage.AddScanline(scanline));
+    storage.Reset();
+    EXPECT_TRUE(storage.AddScanline(scanline));
+    EXPECT_FALSE(storage.AddScanline(scanline));
+    EXPECT_EQ(storage.GetNumRows(), 1u);
+}
+
+/**
+ * @tc.name: ScanlineBoolean_001
+ * @tc.desc: Verify the boolean operations combine the covers of two shapes pixel by pixel.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, ScanlineBoolean_001, TestSize.Level0)
+{
+    const int32_t imageSize = 320;
+    UICanvasVertices path1;
+    BuildStar(path1, 0);
+    UICanvasVertices path2;
+    BuildStar(path2, STAR_INNER_RADIUS);
+    path2.MoveTo(200.0f, 10.0f);
+    path2.LineTo(300.0f, 10.0f);
+    path2.LineTo(300.0f, 60.0f);
+    path2.LineTo(200.0f, 60.0f);
+    path2.EndPoly();
+
+    RasterizerScanlineAntialias rasterizer1;
+    rasterizer1.AddPath(path1);
+    std::vector<SweptSpan> spans1;
+    Sweep(rasterizer1, spans1);
+    std::vector<uint8_t> image1(imageSize * imageSize, 0);
+    PaintSpans(spans1, image1, imageSize);
+    RasterizerScanlineAntialias rasterizer2;
+    rasterizer2.AddPath(path2);
+    ScanlineStorage storage2;
+    EXPECT_TRUE(storage2.Record(rasterizer2));
+    std::vector<SweptSpan> spans2;
+    Sweep(storage2, spans2);
+    std::vector<uint8_t> image2(imageSize * imageSize, 0);
+    PaintSpans(spans2, image2, imageSize);
+
+    const ScanlineBooleanOp ops[] = {BOOL_INTERSECT, BOOL_UNION, BOOL_XOR, BOOL_DIFFERENCE};
+    ScanlineBoolean<RasterizerScanlineAntialias, ScanlineStorage> combined(rasterizer1, storage2, BOOL_INTERSECT);
+    for (ScanlineBooleanOp op : ops) {
+        combined.SetOperation(op);
+        std::vector<SweptSpan> spans;
+        Sweep(combined, spans);
+        std::vector<SweptSpan> packedSpans;
+        uint32_t solidRuns = 0;
+        SweepPacked(combined, packedSpans, solidRuns);
+        ExpectSameSpans(spans, packedSpans);
+        EXPECT_GT(solidRuns, 0u);
+        std::vector<uint8_t> image(imageSize * imageSize, 0);
+        PaintSpans(spans, image, imageSize);
+        // A pixel of only one shape keeps its cover where the operation keeps that shape
+        bool keep1 = (op != BOOL_INTERSECT);
+        bool keep2 = (op == BOOL_UNION || op == BOOL_XOR);
+        uint32_t mismatches = 0;
+        for (int32_t i = 0; i < imageSize * imageSize; i++) {
+            uint32_t expect = 0;
+            if (image1[i] && image2[i]) {
+                expect = ScanlineBooleanBase::CombineCovers(op, image1[i], image2[i]);
+            } else if (image1[i]) {
+                expect = keep1 ? image1[i] : 0;
+            } else if (image2[i]) {
+                expect = keep2 ? image2[i] : 0;
+            }
+            mismatches += (image[i] != expect) ? 1 : 0;
+        }
+        EXPECT_EQ(mismatches, 0u);
+        EXPECT_FALSE(spans.empty());
+    }
+
+    EXPECT_EQ(ScanlineBooleanBase::CombineCovers(BOOL_INTERSECT, 255, 255), 255u); // 255: full cover
+    EXPECT_EQ(ScanlineBooleanBase::CombineCovers(BOOL_UNION, 255, 0), 255u); // 255: full cover
+    EXPECT_EQ(ScanlineBooleanBase::CombineCovers(BOOL_XOR, 255, 255), 0u); // 255: full cover
+    EXPECT_EQ(ScanlineBooleanBase::CombineCovers(BOOL_DIFFERENCE, 255, 255), 0u); // 255: full cover
+
+    // The combined shape can be recorded and combined again, B minus a copy of B keeps only its edges
+    combined.SetOperation(BOOL_INTERSECT);
+    ScanlineStorage intersection;
+    EXPECT_TRUE(intersection.Record(combined));
+    EXPECT_FALSE(intersection.IsEmpty());
+    ScanlineStorage copy2;
+    EXPECT_TRUE(copy2.Record(storage2));
+    ScanlineBoolean<ScanlineStorage, ScanlineStorage> edges(storage2, copy2, BOOL_DIFFERENCE);
+    std::vector<SweptSpan> edgeSpans;
+    Sweep(edges, edgeSpans);
+    EXPECT_FALSE(edgeSpans.empty());
+    for (const SweptSpan& span : edgeSpans) {
+        for (int32_t x = 0; x < span.len; x++) {
+            EXPECT_LT(image2[span.y * imageSize + span.x + x], RasterizerScanlineAntialias::AA_MASK);
+        }
+    }
+}
+
+/**
+ * @tc.name: ScanlineAlphaMask_001
+ * @tc.desc: Verify the alpha mask multiplies the covers of a shape with the mask pixel by pixel.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerTest, ScanlineAlphaMask_001, TestSize.Level0)
+{
+    // The vector kernel and its scalar tail round cover * mask / 255 to nearest
+    const uint32_t maxLen = 67;
+    const uint32_t maxAlign = 4;
+    std::vector<uint8_t> covers(maxLen + maxAlign);
+    std::vector<uint8_t> mask(maxLen + maxAlign);
+    for (uint32_t align = 0; align < maxAlign; align++) {
+        for (uint32_t len = 0; len <= maxLen; len++) {
+            for (uint32_t i = 0; i < covers.size(); i++) {
+                covers[i] = static_cast<uint8_t>(i * 37 + len); // 37: spread the covers
+                mask[i] = static_cast<uint8_t>(i * 91 + align); // 91: spread the mask
+            }
+            std::vector<uint8_t> expect = covers;
+            for (uint32_t i = align; i < align + len; i++) {
+                expect[i] = static_cast<uint8_t>((covers[i] * mask[i] * 2 + 255) / 510); // 2: round to nearest
+            }
+            AlphaMaskBuffer::MultiplyCovers(covers.data() + align, mask.data() + align, len);
+            EXPECT_EQ(covers, expect);
+        }
+    }
+
+    const int32_t imageSize = 320;
+    const int32_t maskWidth = 200;
+    UICanvasVertices starPath;
+    BuildStar(starPath, 0);
+    RasterizerScanlineAntialias starRasterizer;
+    starRasterizer.AddPath(starPath);
+    AlphaMaskBuffer alphaMask;
+    EXPECT_TRUE(alphaMask.Resize(maskWidth, imageSize));
+    alphaMask.AddShape(starRasterizer);
+    std::vector<SweptSpan> starSpans;
+    Sweep(starRasterizer, starSpans);
+    std::vector<uint8_t> starImage(imageSize * imageSize, 0);
+    PaintSpans(starSpans, starImage, imageSize);
+
+    UICanvasVertices rectPath;
+    rectPath.MoveTo(10.5f, 20.25f);
+    rectPath.LineTo(310.5f, 20.25f);
+    rectPath.LineTo(310.5f, 300.75f);
+    rectPath.LineTo(10.5f, 300.75f);
+    rectPath.EndPoly();
+    RasterizerScanlineAntialias rectRasterizer;
+    rectRasterizer.AddPath(rectPath);
+    std::vector<SweptSpan> rectSpans;
+    Sweep(rectRasterizer, rectSpans);
+    std::vector<uint8_t> rectImage(imageSize * imageSize, 0);
+    PaintSpans(rectSpans, rectImage, imageSize);
+
+    ScanlineAlphaMask<RasterizerScanlineAntialias> masked(rectRasterizer, alphaMask);
+    std::vector<SweptSpan> spans;
+    Sweep(masked, spans);
+    std::vector<uint8_t> image(imageSize * imageSize, 0);
+    PaintSpans(spans, image, imageSize);
+    std::vector<SweptSpan> packedSpans;
+    uint32_t solidRuns = 0;
+    SweepPacked(masked, packedSpans, solidRuns);
+    std::vector<uint8_t> packedImage(imageSize * imageSize, 0);
+    PaintSpans(packedSpans, packedImage, imageSize);
+    for (const SweptSpan& span : packedSpans) {
+        for (uint8_t cover : span.covers) {
+            EXPECT_NE(cover, 0);
+        }
+    }
+
+    // The mask holds the star where it is inside the mask, the masked rect is the product of both
+    uint32_t mismatches = 0;
+    uint32_t covered = 0;
+    for (int32_t y = 0; y < imageSize; y++) {
+        for (int32_t x = 0; x < imageSize; x++) {
+            int32_t i = y * imageSize + x;
+            uint8_t maskPixel = (x < maskWidth) ? starImage[i] : 0;
+            mismatches += (alphaMask.GetPixel(x, y) != maskPixel) ? 1 : 0;
+            uint8_t expect = static_cast<uint8_t>((rectImage[i] * maskPixel * 2 + 255) / 510); // 2: round to nearest
+            mismatches += (image[i] != expect || packedImage[i] != expect) ? 1 : 0;
+            covered += expect ? 1 : 0;
+        }
+    }
+    EXPECT_EQ(mismatches, 0u);
+    EXPECT_GT(covered, 0u);
+
+    // 65536 * 65537 pixels wrap to 65536 in 32 bits, the mask is rejected and left empty
+    AlphaMaskBuffer hugeMask;
+    EXPECT_FALSE(hugeMask.Resize(65536, 65537)); // 65536, 65537: width, height
+    EXPECT_EQ(hugeMask.GetWidth(), 0);
+    EXPECT_EQ(hugeMask.GetHeight(), 0);
+
+    // An attached mask keeps its stride, rows outside the mask hide the shape
+    const int32_t stride = 8;
+    uint8_t pixels[stride * 2] = {0};
+    alphaMask.Attach(pixels, 4, 2, stride); // 4: width, 2: height
+    alphaMask.Clear(RasterizerScanlineAntialias::AA_MASK);
+    EXPECT_EQ(pixels[3], RasterizerScanlineAntialias::AA_MASK);
+    EXPECT_EQ(pixels[4], 0);
+    EXPECT_EQ(pixels[stride + 3], RasterizerScanlineAntialias::AA_MASK);
+    uint8_t rowCovers[6] = {255, 255, 255, 255, 255, 255};
+    alphaMask.MaskCovers(-1, 1, rowCovers, 6); // 6: one pixel left and right of the mask
+    EXPECT_EQ(rowCovers[0], 0);
+    EXPECT_EQ(rowCovers[1], 255);
+    EXPECT_EQ(rowCovers[4], 255);
+    EXPECT_EQ(rowCovers[5], 0);
+    alphaMask.MaskCovers(0, 2, rowCovers, 6); // 2: the row below the mask
+    EXPECT_EQ(rowCovers[1], 0);
+}
+} // namespace OHOS
@@ -0,0 +1,894 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline_packed.h"
+#include "gfx_utils/diagram/spancolorfill/fill_base.h"
+#include "gfx_utils/diagram/spancolorfill/fill_gradient.h"
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_linear.h"
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_lut.h"
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_lut_cache.h"
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_radial.h"
+#include "gfx_utils/diagram/spancolorfill/fill_image_rgba.h"
+#include "gfx_utils/diagram/spancolorfill/fill_interpolator.h"
+#include "gfx_utils/diagram/spancolorfill/fill_pattern_rgba.h"
+#include "gfx_utils/diagram/spancolorfill/fill_solid_color.h"
+#include "gfx_utils/diagram/spancolorfill/fill_span_generator.h"
+#include "gfx_utils/diagram/vertexprimitive/geometry_path_storage.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+    const uint32_t SPAN_LENGTH = 300;
+    const int32_t SPAN_ROWS = 40;
+    const float GRADIENT_ANGLE = 0.5f;
+
+    void BuildLut(FillGradientLut& lut)
+    {
+        lut.RemoveAll();
+        lut.AddColor(0.0f, Rgba8T(255, 0, 0, 255));     // 255: red
+        lut.AddColor(0.4f, Rgba8T(0, 255, 0, 128));     // 0.4: stop, 255: green, 128: half alpha
+        lut.AddColor(1.0f, Rgba8T(0, 0, 255, 255));     // 255: blue
+        lut.BuildLut();
+    }
+
+    /* Generate SPAN_ROWS spans starting left of the origin with both generators and compare them. */
+    template <class Generator1, class Generator2>
+    void ExpectSameColors(Generator1& generator1, Generator2& generator2)
+    {
+        std::vector<Rgba8T> colors1(SPAN_LENGTH);
+        std::vector<Rgba8T> colors2(SPAN_LENGTH);
+        generator1.Prepare();
+        generator2.Prepare();
+        uint32_t mismatches = 0;
+        for (int32_t y = -SPAN_ROWS / 2; y < SPAN_ROWS / 2; y++) { // 2: rows around the origin
+            uint32_t len = SPAN_LENGTH - static_cast<uint32_t>(y + SPAN_ROWS / 2); // 2: vary the length
+            generator1.Generate(colors1.data(), y - 7, y * 5, len); // 7, 5: spread the spans
+            generator2.Generate(colors2.data(), y - 7, y * 5, len); // 7, 5: spread the spans
+            for (uint32_t i = 0; i < len; i++) {
+                mismatches += (colors1[i].red != colors2[i].red || colors1[i].green != colors2[i].green ||
+                               colors1[i].blue != colors2[i].blue || colors1[i].alpha != colors2[i].alpha) ? 1 : 0;
+            }
+        }
+        EXPECT_EQ(mismatches, 0u);
+    }
+
+    const int32_t BUFFER_WIDTH = 70;
+    const int32_t BUFFER_HEIGHT = 3;
+    const uint32_t MAX_SPAN = 40;
+
+    uint32_t PixelBytes(ColorMode mode)
+    {
+        return (mode == RGB565) ? 2 : ((mode == RGB888) ? 3 : 4); // 2, 3, 4: bytes per pixel
+    }
+
+    /* The blend of one pixel as a blender consumes the span of SpanSoildColor. */
+    void BlendPixel(uint8_t* pixel, ColorMode mode, const Rgba8T& color, uint8_t cover)
+    {
+        uint8_t alpha = Rgba8T::Multiply(color.alpha, cover);
+        if (mode == RGB565) {
+            uint32_t value = pixel[0] | (pixel[1] << 8);              // 8: high byte
+            uint8_t red = static_cast<uint8_t>((value >> 11) << 3);   // 11, 3: red bits
+            uint8_t green = static_cast<uint8_t>(((value >> 5) & 0x3F) << 2); // 5, 2: green bits
+            uint8_t blue = static_cast<uint8_t>((value & 0x1F) << 3); // 3: blue bits
+            red = Rgba8T::Lerp(red, color.red, alpha);
+            green = Rgba8T::Lerp(green, color.green, alpha);
+            blue = Rgba8T::Lerp(blue, color.blue, alpha);
+            value = ((red >> 3) << 11) | ((green >> 2) << 5) | (blue >> 3); // 3, 11, 2, 5: bits of the channels
+            pixel[0] = static_cast<uint8_t>(value);
+            pixel[1] = static_cast<uint8_t>(value >> 8); // 8: high byte
+            return;
+        }
+        pixel[0] = Rgba8T::Lerp(pixel[0], color.blue, alpha);
+        pixel[1] = Rgba8T::Lerp(pixel[1], color.green, alpha);
+        pixel[2] = Rgba8T::Lerp(pixel[2], color.red, alpha); // 2: red byte
+        if (mode != RGB888) {
+            pixel[3] = Rgba8T::Prelerp(pixel[3], alpha, alpha); // 3: alpha byte
+        }
+    }
+
+    BufferInfo MakeBuffer(std::vector<uint8_t>& data, ColorMode mode, int32_t width, int32_t height)
+    {
+        BufferInfo info = {};
+        info.stride = width * PixelBytes(mode);
+        data.resize(info.stride * height);
+        for (uint32_t i = 0; i < data.size(); i++) {
+            data[i] = static_cast<uint8_t>(i * 37 + (i >> 3)); // 37, 3: spread the bytes
+        }
+        info.virAddr = data.data();
+        info.width = width;
+        info.height = height;
+        info.mode = mode;
+        return info;
+    }
+
+    /* The lut of sorted stops as FillGradientLut built it with the float ColorInterpolator. */
+    void BuildFloatLut(const GradientColorStop* stops, uint32_t numStops, std::vector<Rgba8T>& colors)
+    {
+        uint32_t size = static_cast<uint32_t>(colors.size());
+        uint32_t start = static_cast<uint32_t>(stops[0].offset * size);
+        uint32_t end = start;
+        for (uint32_t index = 0; index < start; index++) {
+            colors[index] = stops[0].color;
+        }
+        for (uint32_t index = 1; index < numStops; index++) {
+            end = static_cast<uint32_t>(stops[index].offset * size);
+            ColorInterpolator ci(stops[index - 1].color, stops[index].color, end - start + 1);
+            for (; start < end; ++ci, ++start) {
+                colors[start] = ci.GetColor();
+            }
+        }
+        for (; end < size; end++) {
+            colors[end] = stops[numStops - 1].color;
+        }
+    }
+
+    /* The color of an image pixel, transparent outside of the image unless it repeats. */
+    Rgba8T ImagePixel(const ImageInfo& image, int32_t x, int32_t y, bool repeat)
+    {
+        int32_t width = image.header.width;
+        int32_t height = image.header.height;
+        if (repeat) {
+            x = ((x % width) + width) % width;
+            y = ((y % height) + height) % height;
+        } else if (x < 0 || x >= width || y < 0 || y >= height) {
+            return Rgba8T(0, 0, 0, 0);
+        }
+        ColorMode mode = static_cast<ColorMode>(image.header.colorMode);
+        const uint8_t* pixel = image.data + (y * width + x) * PixelBytes(mode);
+        if (mode == RGB565) {
+            uint32_t value = pixel[0] | (pixel[1] << 8); // 8: high byte
+            uint32_t red = value >> 11;                  // 11: red bits
+            uint32_t green = (value >> 5) & 0x3F;        // 5: green bits
+            uint32_t blue = value & 0x1F;
+            return Rgba8T((red << 3) | (red >> 2), (green << 2) | (green >> 4), // 3, 2, 4: widen to 8 bits
+                          (blue << 3) | (blue >> 2));                         // 3, 2: widen to 8 bits
+        }
+        return Rgba8T(pixel[2], pixel[1], pixel[0], (mode == ARGB8888) ? pixel[3] : 255); // 2, 3: red, alpha bytes
+    }
+
+    uint32_t Lerp7(uint32_t p, uint32_t q, uint32_t weight)
+    {
+        return (p * (128 - weight) + q * weight + 64) >> 7; // 128, 64, 7: weights of 1 / 128
+    }
+
+    /* The sample of SpanImageRgba at x, y in 1 / 256 pixels. */
+    Rgba8T SampleImage(const ImageInfo& image, ImageFilterMode filter, int32_t x, int32_t y, bool repeat)
+    {
+        if (filter == IMAGE_FILTER_NEAREST) {
+            return ImagePixel(image, x >> 8, y >> 8, repeat); // 8: subpixel bits
+        }
+        x -= 128; // 128: half a pixel
+        y -= 128; // 128: half a pixel
+        Rgba8T corners[4] = { // 4: pixels around the sample
+            ImagePixel(image, x >> 8, y >> 8, repeat), ImagePixel(image, (x >> 8) + 1, y >> 8, repeat), // 8: bits
+            ImagePixel(image, x >> 8, (y >> 8) + 1, repeat), ImagePixel(image, (x >> 8) + 1, (y >> 8) + 1, repeat)
+        };
+        uint32_t weightX = (x & 0xFF) >> 1;
+        uint32_t weightY = (y & 0xFF) >> 1;
+        uint8_t channels[4][4]; // 4: corners and channels
+        for (uint32_t i = 0; i < 4; i++) { // 4: corners
+            channels[i][0] = corners[i].red;
+            channels[i][1] = corners[i].green;
+            channels[i][2] = corners[i].blue;  // 2: blue
+            channels[i][3] = corners[i].alpha; // 3: alpha
+        }
+        uint32_t result[4]; // 4: channels
+        for (uint32_t c = 0; c < 4; c++) { // 4: channels
+            if (filter == IMAGE_FILTER_BOX) {
+                result[c] = (channels[0][c] + channels[1][c] + channels[2][c] + channels[3][c] + 2) >> 2; // 2: average
+            } else {
+                result[c] = Lerp7(Lerp7(channels[0][c], channels[1][c], weightX),
+                                  Lerp7(channels[2][c], channels[3][c], weightX), weightY); // 2, 3: bottom corners
+            }
+        }
+        return Rgba8T(result[0], result[1], result[2], result[3]); // 2, 3: blue, alpha
+    }
+}
+
+class SpanFillTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: SpanGradient_001
+ * @tc.desc: Verify the statically dispatched gradient and blend generators fill the colors of
+ * FillGradient and SpanBlendColor, directly and through SpanGeneratorAdaptor.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SpanFillTest, SpanGradient_001, TestSize.Level0)
+{
+    FillGradientLut lut;
+    BuildLut(lut);
+    TransAffine transform;
+    transform.Translate(-20.0f, 10.0f); // -20, 10: move the start of the gradient
+    transform.Rotate(GRADIENT_ANGLE);
+    FillInterpolator interpolator(transform);
+
+    GradientLinearCalculate linear;
+    FillGradient virtualLinear(interpolator, linear, lut, 0, 200.0f); // 200: distance of the gradient
+    SpanGradient<FillInterpolator, GradientLinearCalculate, FillGradientLut> staticLinear(interpolator, linear, lut,
+                                                                                          0, 200.0f);
+    ExpectSameColors(virtualLinear, staticLinear);
+
+    GradientRadialCalculate radial(120.0f, 15.0f, -10.0f); // 120: end radius, 15, -10: focal offset
+    FillGradient virtualRadial(interpolator, radial, lut, 10.0f, 120.0f); // 10: start radius, 120: end radius
+    SpanGradient<FillInterpolator, GradientRadialCalculate, FillGradientLut> staticRadial(interpolator, radial, lut,
+                                                                                          10.0f, 120.0f);
+    ExpectSameColors(virtualRadial, staticRadial);
+
+    SpanGeneratorAdaptor<SpanGradient<FillInterpolator, GradientRadialCalculate, FillGradientLut>> adaptor(
+        staticRadial);
+    SpanBase& erased = adaptor;
+    ExpectSameColors(virtualRadial, erased);
+
+    SpanSoildColor solid(Rgba8T(100, 200, 30, 40)); // 100, 200, 30, 40: a color that saturates some channels
+    SpanBlendColor virtualBlend(virtualLinear, solid);
+    SpanBlend<FillGradient, SpanSoildColor> staticBlend(virtualLinear, solid);
+    ExpectSameColors(virtualBlend, staticBlend);
+}
+
+/**
+ * @tc.name: SpanBlendColor_001
+ * @tc.desc: Verify the blend generators add saturated colors and share the scratch buffers of one arena.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SpanFillTest, SpanBlendColor_001, TestSize.Level0)
+{
+    const uint32_t maxLen = 37;
+    std::vector<Rgba8T> colors1(maxLen + 1);
+    std::vector<Rgba8T> colors2(maxLen + 1);
+    std::vector<Rgba8T> sum(maxLen + 1);
+    for (uint32_t len = 0; len <= maxLen; len++) {
+        for (uint32_t i = 0; i <= maxLen; i++) {
+            colors1[i] = Rgba8T(i * 7, i * 13 + len, 255 - i, i * 29); // 7, 13, 29: spread the channels
+            colors2[i] = Rgba8T(len * 11, 200, i * 3, 255 - len); // 11, 200, 3: spread the channels
+            sum[i] = Rgba8T(1, 2, 3, 4); // 1, 2, 3, 4: marks the colors behind the span
+        }
+        SpanBlendColor::AddColors(sum.data(), colors1.data(), colors2.data(), len);
+        for (uint32_t i = 0; i < len; i++) {
+            EXPECT_EQ(sum[i].red, MATH_MIN(colors1[i].red + colors2[i].red, 255));
+            EXPECT_EQ(sum[i].green, MATH_MIN(colors1[i].green + colors2[i].green, 255));
+            EXPECT_EQ(sum[i].blue, MATH_MIN(colors1[i].blue + colors2[i].blue, 255));
+            EXPECT_EQ(sum[i].alpha, MATH_MIN(colors1[i].alpha + colors2[i].alpha, 255));
+        }
+        EXPECT_EQ(sum[len].red, 1);
+        EXPECT_EQ(sum[len].alpha, 4); // 4: the mark is kept
+    }
+
+    // Nested blends borrow from one arena and give everything back
+    SpanScratchArena arena;
+    SpanSoildColor red(Rgba8T(120, 0, 0, 100));
+    SpanSoildColor green(Rgba8T(150, 60, 0, 200));
+    SpanSoildColor blue(Rgba8T(0, 0, 90, 10));
+    SpanBlendColor inner(red, green, arena);
+    SpanBlendColor outer(inner, blue, arena);
+    std::vector<Rgba8T> span(SPAN_LENGTH);
+    outer.Prepare();
+    outer.Generate(span.data(), 0, 0, SPAN_LENGTH);
+    EXPECT_EQ(arena.GetNumBorrowed(), 0u);
+    EXPECT_EQ(span[SPAN_LENGTH - 1].red, 255);
+    EXPECT_EQ(span[SPAN_LENGTH - 1].green, 60);
+    EXPECT_EQ(span[SPAN_LENGTH - 1].blue, 90);
+    EXPECT_EQ(span[SPAN_LENGTH - 1].alpha, 255);
+    SpanBlend<SpanBlendColor, SpanSoildColor> staticOuter(inner, blue, arena);
+    ExpectSameColors(outer, staticOuter);
+
+    // The buffers are kept, a shorter span borrows the same memory
+    Rgba8T* first = arena.Borrow(SPAN_LENGTH);
+    arena.Release(1);
+    EXPECT_EQ(arena.Borrow(SPAN_LENGTH / 2), first); // 2: a shorter span
+    arena.Reset();
+    for (uint32_t i = 0; i < SpanScratchArena::MAX_SCRATCH_BUFFERS; i++) {
+        EXPECT_NE(arena.Borrow(1), nullptr);
+    }
+    EXPECT_EQ(arena.Borrow(1), nullptr);
+    arena.Release(SpanScratchArena::MAX_SCRATCH_BUFFERS);
+    EXPECT_EQ(arena.GetNumBorrowed(), 0u);
+}
+
+/**
+ * @tc.name: SpanBlendColor_002
+ * @tc.desc: Verify a copied blend generator keeps its colors, and a blend blends pixel by pixel
+ * when every buffer of its arena is borrowed.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SpanFillTest, SpanBlendColor_002, TestSize.Level0)
+{
+    FillGradientLut lut;
+    BuildLut(lut);
+    TransAffine transform;
+    transform.Translate(-20.0f, 0); // -20: an axis aligned gradient steps exactly pixel by pixel
+    FillInterpolator interpolator(transform);
+    GradientLinearCalculate calculate;
+    FillGradient linear(interpolator, calculate, lut, 0, 200.0f); // 200: distance of the gradient
+    SpanSoildColor solid(Rgba8T(100, 200, 30, 40)); // 100, 200, 30, 40: a color that saturates some channels
+    SpanBlendColor blend(linear, solid);
+    SpanBlendColor copy(blend);
+    ExpectSameColors(blend, copy);
+
+    SpanScratchArena arena;
+    SpanBlendColor borrowing(linear, solid, arena);
+    SpanBlend<FillGradient, SpanSoildColor> staticBorrowing(linear, solid, arena);
+    for (uint32_t i = 0; i < SpanScratchArena::MAX_SCRATCH_BUFFERS; i++) {
+        EXPECT_NE(arena.Borrow(1), nullptr);
+    }
+    ExpectSameColors(blend, borrowing);
+    ExpectSameColors(blend, staticBorrowing);
+    EXPECT_EQ(arena.GetNumBorrowed(), static_cast<uint32_t>(SpanScratchArena::MAX_SCRATCH_BUFFERS));
+}
+/**
+ * @tc.name: FillSolidColor_001
+ * @tc.desc: Verify the solid color kernels of every color mode blend the pixels like a blender
+ * consuming the span of SpanSoildColor, and the spans are clipped to the buffer.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SpanFillTest, FillSolidColor_001, TestSize.Level0)
+{
+    const ColorMode modes[] = {ARGB8888, XRGB8888, RGB888, RGB565};
+    const Rgba8T colors[] = {Rgba8T(200, 100, 50, 255), Rgba8T(30, 220, 140, 90)}; // 2 colors, opaque and not
+    std::vector<uint8_t> covers(MAX_SPAN);
+    for (uint32_t i = 0; i < MAX_SPAN; i++) {
+        covers[i] = (i % 9 < 3) ? 255 : static_cast<uint8_t>(i * 29); // 9, 3: runs of full covers, 29: spread
+    }
+    for (ColorMode mode : modes) {
+        for (const Rgba8T& color : colors) {
+            std::vector<uint8_t> data;
+            std::vector<uint8_t> expected;
+            BufferInfo info = MakeBuffer(data, mode, BUFFER_WIDTH, BUFFER_HEIGHT);
+            MakeBuffer(expected, mode, BUFFER_WIDTH, BUFFER_HEIGHT);
+            FillSolidColor fill;
+            ASSERT_TRUE(fill.Attach(info));
+            fill.SetColor(color);
+            uint32_t bytes = PixelBytes(mode);
+            for (uint32_t len = 0; len <= MAX_SPAN; len++) {
+                int32_t x = static_cast<int32_t>(len * 3) - 10; // 3, 10: some spans start left of the buffer
+                fill.BlendSolidHspan(x, 1, len, covers.data());
+                fill.BlendHline(x + 5, 0, len, (len % 2) ? 255 : 77); // 5: shift, 2: alternate, 77: a partial cover
+                for (int32_t i = MATH_MAX(x, 0); i < MATH_MIN(x + static_cast<int32_t>(len), BUFFER_WIDTH); i++) {
+                    BlendPixel(&expected[info.stride + i * bytes], mode, color, covers[i - x]);
+                }
+                for (int32_t i = MATH_MAX(x + 5, 0); i < MATH_MIN(x + 5 + static_cast<int32_t>(len), BUFFER_WIDTH);
+                     i++) { // 5: shift
+                    BlendPixel(&expected[i * bytes], mode, color, (len % 2) ? 255 : 77); // 2, 77: as above
+                }
+                ASSERT_EQ(data, expected);
+            }
+            fill.BlendSolidHspan(0, -1, MAX_SPAN, covers.data());
+            fill.BlendHline(0, BUFFER_HEIGHT, MAX_SPAN, 255); // 255: full cover
+            EXPECT_EQ(data, expected);
+        }
+    }
+    BufferInfo unsupported = {};
+    std::vector<uint8_t> data(16); // 16: any buffer
+    unsupported.virAddr = data.data();
+    unsupported.mode = ARGB1555;
+    FillSolidColor fill;
+    EXPECT_FALSE(fill.Attach(unsupported));
+}
+
+/**
+ * @tc.name: FillSolidColor_002
+ * @tc.desc: Verify rendering the scanlines of a shape with one color gives the pixels of the span
+ * of SpanSoildColor blended through the covers, with both scanline types.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SpanFillTest, FillSolidColor_002, TestSize.Level0)
+{
+    const int32_t width = 120;
+    const int32_t height = 90;
+    UICanvasVertices path;
+    path.MoveTo(-10.3f, 20.5f);  // -10.3, 20.5: left of the buffer
+    path.LineTo(70.2f, -15.7f);  // 70.2, -15.7: above the buffer
+    path.LineTo(140.6f, 60.1f);  // 140.6, 60.1: right of the buffer
+    path.LineTo(50.4f, 100.9f);  // 50.4, 100.9: below the buffer
+    path.LineTo(60.0f, 45.25f);  // 60, 45.25: a concave corner
+    path.EndPoly();
+    RasterizerScanlineAntialias rasterizer;
+    rasterizer.AddPath(path);
+    Rgba8T color(40, 180, 220, 160); // 40, 180, 220, 160: a translucent color
+
+    std::vector<uint8_t> expected;
+    BufferInfo expectedInfo = MakeBuffer(expected, ARGB8888, width, height);
+    SpanSoildColor solid(color);
+    std::vector<Rgba8T> span(width + 64); // 64: the spans reach out of the buffer
+    GeometryScanline scanline;
+    ASSERT_TRUE(rasterizer.RewindScanlines());
+    scanline.Reset(rasterizer.GetMinX(), rasterizer.GetMaxX());
+    while (rasterizer.SweepScanline(scanline)) {
+        int32_t y = scanline.GetYLevel();
+        uint32_t numSpans = scanline.NumSpans();
+        GeometryScanline::ConstIterator it = scanline.Begin();
+        for (; numSpans; --numSpans, ++it) {
+            solid.Generate(span.data(), it->x, y, it->spanLength);
+            for (int32_t i = 0; i < it->spanLength; i++) {
+                int32_t x = it->x + i;
+                if (x >= 0 && x < width && y >= 0 && y < height) {
+                    uint8_t* pixel = &expected[y * expectedInfo.stride + x * 4]; // 4: bytes of ARGB8888
+                    BlendPixel(pixel, ARGB8888, span[i], it->covers[i]);
+                }
+            }
+        }
+    }
+
+    std::vector<uint8_t> data;
+    FillSolidColor fill;
+    ASSERT_TRUE(fill.Attach(MakeBuffer(data, ARGB8888, width, height)));
+    fill.SetColor(color);
+    fill.RenderScanlines(rasterizer, scanline);
+    EXPECT_EQ(data, expected);
+
+    std::vector<uint8_t> packedData;
+    ASSERT_TRUE(fill.Attach(MakeBuffer(packedData, ARGB8888, width, height)));
+    GeometryScanlinePacked packed;
+    fill.RenderScanlines(rasterizer, packed);
+    EXPECT_EQ(packedData, expected);
+}
+
+/**
+ * @tc.name: SpanLinearGradient_001
+ * @tc.desc: Verify the stepped linear gradient pads like FillGradient with GradientLinearCalculate,
+ * and repeats and reflects the lut beyond the ends of the gradient.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SpanFillTest, SpanLinearGradient_001, TestSize.Level0)
+{
+    FillGradientLut lut;
+    BuildLut(lut);
+    TransAffine transform;
+    transform.Translate(-20.0f, 10.0f); // -20, 10: move the start of the gradient
+    transform.Rotate(GRADIENT_ANGLE);
+    FillInterpolator interpolator(transform);
+    GradientLinearCalculate linear;
+    FillGradient virtualLinear(interpolator, linear, lut, 0, 200.0f); // 200: distance of the gradient
+    SpanLinearGradient stepped(interpolator, lut, 200.0f);            // 200: distance of the gradient
+    std::vector<Rgba8T> expected(SPAN_LENGTH);
+    std::vector<Rgba8T> colors(SPAN_LENGTH);
+    int32_t maxDifference = 0;
+    for (int32_t y = -SPAN_ROWS / 2; y < SPAN_ROWS / 2; y++) { // 2: rows around the origin
+        virtualLinear.Generate(expected.data(), y - 7, y * 5, SPAN_LENGTH); // 7, 5: spread the spans
+        stepped.Generate(colors.data(), y - 7, y * 5, SPAN_LENGTH);         // 7, 5: spread the spans
+        for (uint32_t i = 0; i < SPAN_LENGTH; i++) {
+            maxDifference = MATH_MAX(maxDifference, MATH_ABS(expected[i].red - colors[i].red));
+            maxDifference = MATH_MAX(maxDifference, MATH_ABS(expected[i].green - colors[i].green));
+            maxDifference = MATH_MAX(maxDifference, MATH_ABS(expected[i].blue - colors[i].blue));
+            maxDifference = MATH_MAX(maxDifference, MATH_ABS(expected[i].alpha - colors[i].alpha));
+        }
+    }
+    // The positions are rounded differently, at most a neighbouring lut color is taken
+    EXPECT_LE(maxDifference, 3); // 3: the largest step between neighbouring lut colors
+
+    // Position 2 * x with 512 colors over 256 pixels, all positions are whole numbers
+    const int32_t size = static_cast<int32_t>(lut.GetSize());
+    const int32_t first = -1100;
+    const uint32_t len = 2200;
+    std::vector<int32_t> indices(len);
+    SpanLinearGradient::CalculateIndices(indices.data(), 2.0f * first, 2.0f, len, size, GRADIENT_SPREAD_PAD);
+    for (uint32_t i = 0; i < len; i++) {
+        int32_t position = 2 * (first + static_cast<int32_t>(i)); // 2: the step
+        ASSERT_EQ(indices[i], MATH_MIN(MATH_MAX(position, 0), size - 1));
+    }
+    SpanLinearGradient::CalculateIndices(indices.data(), 2.0f * first, 2.0f, len, size, GRADIENT_SPREAD_REPEAT);
+    for (uint32_t i = 0; i < len; i++) {
+        int32_t position = 2 * (first + static_cast<int32_t>(i)); // 2: the step
+        ASSERT_EQ(indices[i], ((position % size) + size) % size);
+    }
+    SpanLinearGradient::CalculateIndices(indices.data(), 2.0f * first, 2.0f, len, size, GRADIENT_SPREAD_REFLECT);
+    for (uint32_t i = 0; i < len; i++) {
+        int32_t position = 2 * (first + static_cast<int32_t>(i)); // 2: the step
+        int32_t offset = ((position % (2 * size)) + 2 * size) % (2 * size); // 2: the period of a reflection
+        ASSERT_EQ(indices[i], (offset < size) ? offset : 2 * size - 1 - offset); // 2: the mirrored half
+    }
+
+    TransAffine identity;
+    FillInterpolator identityInterpolator(identity);
+    SpanLinearGradient reflected(identityInterpolator, lut, 256.0f, GRADIENT_SPREAD_REFLECT); // 256: pixels
+    reflected.Generate(colors.data(), 200, 3, SPAN_LENGTH); // 200, 3: the span crosses the end of the gradient
+    for (uint32_t i = 0; i < SPAN_LENGTH; i++) {
+        int32_t position = 2 * (200 + static_cast<int32_t>(i)); // 2: the step, 200: the start of the span
+        int32_t index = (position < size) ? position : 2 * size - 1 - position; // 2: the mirrored half
+        EXPECT_EQ(colors[i].red, lut[index].red);
+        EXPECT_EQ(colors[i].alpha, lut[index].alpha);
+    }
+}
+
+/**
+ * @tc.name: SpanRadialGradient_001
+ * @tc.desc: Verify the vector and the fixed point radial gradients take the lut index of
+ * FillGradient with GradientRadialCalculate or a neighbouring one, with and without a focal point.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SpanFillTest, SpanRadialGradient_001, TestSize.Level0)
+{
+    struct RadialCase {
+        float startRadius;
+        float endRadius;
+        float focalX;
+        float focalY;
+        float angle;
+        float scale;
+    };
+    /* Today's gradient takes coordinates in 1/16 pixels, so one lut entry spans more than that. */
+    const RadialCase cases[] = {
+        {0.0f, 120.0f, 0.0f, 0.0f, 0.0f, 1.0f},               // 120: a centered gradient
+        {10.0f, 120.0f, 15.0f, -10.0f, 0.0f, 1.0f},           // 10: start radius, 15, -10: focal point
+        {0.0f, 90.0f, -50.0f, 30.0f, GRADIENT_ANGLE, 1.5f},   // 90: end radius, -50, 30: focal point, 1.5: scale
+        {20.0f, 60.0f, 10.0f, 5.0f, 0.0f, 0.5f},              // 20, 60: radii, 10, 5: focal point, 0.5: scale
+        {0.0f, 150.0f, 0.0f, 140.0f, GRADIENT_ANGLE, 1.0f},   // 150: end radius, 140: focal point near the circle
+    };
+    FillGradientLut lut;
+    BuildLut(lut);
+    const int32_t size = static_cast<int32_t>(lut.GetSize());
+    const int32_t downscaleShift = FillInterpolator::SUBPIXEL_SHIFT - GRADIENT_SUBPIXEL_SHIFT;
+    std::vector<Rgba8T> vectorColors(SPAN_LENGTH);
+    std::vector<Rgba8T> fixedColors(SPAN_LENGTH);
+    for (const RadialCase& radialCase : cases) {
+        TransAffine transform;
+        transform.Translate(-150.0f, -20.0f); // -150, -20: the center is inside the spans
+        transform.Rotate(radialCase.angle);
+        transform.Scale(radialCase.scale);
+        FillInterpolator interpolator(transform);
+        GradientRadialCalculate radial(radialCase.endRadius, radialCase.focalX, radialCase.focalY);
+        int32_t startRadius = static_cast<int32_t>(radialCase.startRadius * GRADIENT_SUBPIXEL_SCALE);
+        int32_t endRadius = static_cast<int32_t>(radialCase.endRadius * GRADIENT_SUBPIXEL_SCALE);
+        SpanRadialGradient stepped(interpolator, lut, radialCase.startRadius, radialCase.endRadius,
+                                   radialCase.focalX, radialCase.focalY);
+        uint32_t mismatches = 0;
+        for (int32_t y = -SPAN_ROWS / 2; y < SPAN_ROWS / 2; y++) { // 2: rows around the origin
+            int32_t spanX = y - 7; // 7: spread the spans
+            int32_t spanY = y * 5; // 5: spread the spans
+            stepped.GenerateFloat(vectorColors.data(), spanX, spanY, SPAN_LENGTH);
+            stepped.GenerateFixedPoint(fixedColors.data(), spanX, spanY, SPAN_LENGTH);
+            interpolator.Begin(spanX, spanY, SPAN_LENGTH);
+            for (uint32_t i = 0; i < SPAN_LENGTH; i++, ++interpolator) {
+                int32_t x;
+                int32_t pixelY;
+                interpolator.Coordinates(&x, &pixelY);
+                int32_t index = radial.Calculate(x >> downscaleShift, pixelY >> downscaleShift, startRadius,
+                                                 endRadius, size);
+                bool vectorMatch = false;
+                bool fixedMatch = false;
+                for (int32_t k = MATH_MAX(index - 1, 0); k <= MATH_MIN(index + 1, size - 1); k++) {
+                    vectorMatch = vectorMatch || (vectorColors[i].red == lut[k].red &&
+                        vectorColors[i].green == lut[k].green && vectorColors[i].blue == lut[k].blue &&
+                        vectorColors[i].alpha == lut[k].alpha);
+                    fixedMatch = fixedMatch || (fixedColors[i].red == lut[k].red &&
+                        fixedColors[i].green == lut[k].green && fixedColors[i].blue == lut[k].blue &&
+                        fixedColors[i].alpha == lut[k].alpha);
+                }
+                mismatches += vectorMatch ? 0 : 1;
+                mismatches += fixedMatch ? 0 : 1;
+            }
+        }
+        EXPECT_EQ(mismatches, 0u);
+    }
+}
+
+/**
+ * @tc.name: SpanRadialGradient_002
+ * @tc.desc: Verify the fixed point radial gradient takes the last lut entry far outside the end circle,
+ * and a focal point outside the end circle takes the colors of the vector path.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SpanFillTest, SpanRadialGradient_002, TestSize.Level0)
+{
+    FillGradientLut lut;
+    BuildLut(lut);
+    const Rgba8T& last = lut[lut.GetSize() - 1];
+    TransAffine transform;
+    transform.Rotate(GRADIENT_ANGLE);
+    transform.Scale(40.0f); // 40: the positions of far spans do not fit into 62 bits without the box
+    FillInterpolator interpolator(transform);
+    SpanRadialGradient inside(interpolator, lut, 0, 120.0f, 30.0f, -20.0f); // 120: end radius, 30, -20: focal point
+    std::vector<Rgba8T> fixedColors(SPAN_LENGTH);
+    std::vector<Rgba8T> vectorColors(SPAN_LENGTH);
+    const int32_t farPositions[] = {INT16_MAX, -INT16_MAX, 1 << 24}; // 24: beyond the scanlines
+    uint32_t mismatches = 0;
+    for (int32_t position : farPositions) {
+        inside.GenerateFixedPoint(fixedColors.data(), position, position / 2, SPAN_LENGTH); // 2: another row
+        for (uint32_t i = 0; i < SPAN_LENGTH; i++) {
+            mismatches += (fixedColors[i].red == last.red && fixedColors[i].green == last.green &&
+                           fixedColors[i].blue == last.blue && fixedColors[i].alpha == last.alpha) ? 0 : 1;
+        }
+    }
+    EXPECT_EQ(mismatches, 0u);
+
+    SpanRadialGradient outside(interpolator, lut, 0, 120.0f, 150.0f, 0); // 150: a focal point outside
+    for (int32_t y = -SPAN_ROWS / 2; y < SPAN_ROWS / 2; y++) { // 2: rows around the origin
+        outside.GenerateFixedPoint(fixedColors.data(), y - 7, y * 5, SPAN_LENGTH); // 7, 5: spread the spans
+        outside.GenerateFloat(vectorColors.data(), y - 7, y * 5, SPAN_LENGTH);     // 7, 5: spread the spans
+        for (uint32_t i = 0; i < SPAN_LENGTH; i++) {
+            mismatches += (fixedColors[i].red == vectorColors[i].red && fixedColors[i].green == vectorColors[i].green &&
+                           fixedColors[i].blue == vectorColors[i].blue &&
+                           fixedColors[i].alpha == vectorColors[i].alpha) ? 0 : 1;
+        }
+    }
+    EXPECT_EQ(mismatches, 0u);
+}
+
+/**
+ * @tc.name: FillGradientLutCache_001
+ * @tc.desc: Verify the integer lut has the colors of the float ColorInterpolator.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SpanFillTest, FillGradientLutCache_001, TestSize.Level0)
+{
+    const GradientColorStop twoStops[] = {
+        GradientColorStop(0.0f, Rgba8T(255, 0, 0, 255)), // 255: red
+        GradientColorStop(1.0f, Rgba8T(0, 0, 255, 255)), // 255: blue
+    };
+    const GradientColorStop manyStops[] = {
+        GradientColorStop(0.1f, Rgba8T(10, 200, 30, 0)),       // 0.1: stop, 10, 200, 30: color
+        GradientColorStop(0.25f, Rgba8T(250, 20, 130, 255)),   // 0.25: stop, 250, 20, 130, 255: color
+        GradientColorStop(0.2502f, Rgba8T(0, 255, 0, 128)),    // 0.2502: a stop in the same lut entry
+        GradientColorStop(0.7f, Rgba8T(3, 7, 251, 77)),        // 0.7: stop, 3, 7, 251, 77: color
+        GradientColorStop(0.93f, Rgba8T(128, 128, 128, 255)),  // 0.93: stop, 128: gray
+    };
+    const struct {
+        const GradientColorStop* stops;
+        uint32_t numStops;
+        uint16_t size;
+    } cases[] = {
+        {twoStops, 2, COLOR_LUT_SIZE},  // 2: stops
+        {manyStops, 5, COLOR_LUT_SIZE}, // 5: stops
+        {manyStops, 5, 100},            // 5: stops, 100: a lut shorter than the color ranges
+        {manyStops, 5, 2000},           // 5: stops, 2000: a lut longer than the color ranges
+    };
+    for (const auto& lutCase : cases) {
+        std::vector<Rgba8T> expected(lutCase.size);
+        std::vector<Rgba8T> colors(lutCase.size);
+        BuildFloatLut(lutCase.stops, lutCase.numStops, expected);
+        FillGradientLutCache::BuildLut(lutCase.stops, lutCase.numStops, colors.data(), lutCase.size);
+        int32_t maxDifference = 0;
+        for (uint32_t i = 0; i < lutCase.size; i++) {
+            maxDifference = MATH_MAX(maxDifference, MATH_ABS(expected[i].red - colors[i].red));
+            maxDifference = MATH_MAX(maxDifference, MATH_ABS(expected[i].green - colors[i].green));
+            maxDifference = MATH_MAX(maxDifference, MATH_ABS(expected[i].blue - colors[i].blue));
+            maxDifference = MATH_MAX(maxDifference, MATH_ABS(expected[i].alpha - colors[i].alpha));
+        }
+        EXPECT_EQ(maxDifference, 0);
+    }
+}
+
+/**
+ * @tc.name: FillGradientLutCache_002
+ * @tc.desc: Verify gradients of the same colors share one lut, copies share it too, and the
+ * least recently used lut is dropped from a full cache but kept while it is in use.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SpanFillTest, FillGradientLutCache_002, TestSize.Level0)
+{
+    FillGradientLutCache& shared = FillGradientLutCache::GetInstance();
+    shared.Clear();
+    shared.ResetStats();
+    FillGradientLut lut1;
+    BuildLut(lut1);
+    FillGradientLut lut2;
+    BuildLut(lut2);
+    EXPECT_EQ(&lut1[0], &lut2[0]);
+    FillGradientLut copy(lut1);
+    EXPECT_EQ(&copy[0], &lut1[0]);
+    lut2.AddColor(0.7f, Rgba8T(9, 9, 9, 9)); // 0.7: another stop, 9: color
+    lut2.BuildLut();
+    EXPECT_NE(&lut2[0], &lut1[0]);
+    EXPECT_EQ(shared.GetStats().misses, 2u); // 2: two stop lists
+    EXPECT_EQ(shared.GetStats().hits, 1u);
+    EXPECT_EQ(shared.GetStats().entries, 2u); // 2: two stop lists
+
+    FillGradientLutCache cache(2); // 2: luts kept
+    const GradientColorStop stops[] = {
+        GradientColorStop(0.0f, Rgba8T(0, 0, 0, 255)),
+        GradientColorStop(1.0f, Rgba8T(255, 255, 255, 255)), // 255: white
+    };
+    FillGradientLutCache::CacheEntry* first = cache.Acquire(stops, 2, 16);  // 2: stops, 16: colors
+    FillGradientLutCache::CacheEntry* second = cache.Acquire(stops, 2, 32); // 2: stops, 32: colors
+    cache.Release(second);
+    EXPECT_EQ(cache.Acquire(stops, 2, 16), first); // 2: stops, 16: colors
+    cache.Release(first);
+    FillGradientLutCache::CacheEntry* third = cache.Acquire(stops, 2, 64); // 2: stops, 64: colors
+    // The lut of 32 colors was the least recently used one
+    EXPECT_EQ(cache.GetStats().evictions, 1u);
+    EXPECT_EQ(cache.Acquire(stops, 2, 16), first); // 2: stops, 16: colors
+    cache.Release(first);
+    cache.Clear();
+    EXPECT_EQ(cache.GetStats().entries, 0u);
+    // Still in use after the cache dropped them
+    EXPECT_EQ(FillGradientLutCache::GetColors(first)[15].alpha, 255); // 15: the last color, 255: opaque
+    EXPECT_EQ(FillGradientLutCache::GetColors(third)[63].alpha, 255); // 63: the last color, 255: opaque
+    cache.Release(first);
+    cache.Release(third);
+}
+
+/**
+ * @tc.name: FillGradientLutCache_003
+ * @tc.desc: Verify a FillGradientLut of static storage shares the lut of the cache instance, it is
+ * released after the end of main, when the cache must still be usable.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SpanFillTest, FillGradientLutCache_003, TestSize.Level0)
+{
+    static FillGradientLut staticLut;
+    BuildLut(staticLut);
+    FillGradientLut lut;
+    BuildLut(lut);
+    EXPECT_EQ(&staticLut[0], &lut[0]);
+    FillGradientLutCache::GetInstance().Clear();
+    FillGradientLut copy(staticLut);
+    EXPECT_EQ(&copy[0], &staticLut[0]);
+}
+
+/**
+ * @tc.name: FillPatternRgba_001
+ * @tc.desc: Verify the pattern generator of each repeat mode takes the pattern colors at the
+ * wrapped coordinates and black outside of the pattern, also left of and above it.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SpanFillTest, FillPatternRgba_001, TestSize.Level0)
+{
+    const int32_t width = 5;
+    const int32_t height = 3;
+    std::vector<uint8_t> pixels(width * height * 4); // 4: bytes of ARGB8888
+    for (uint32_t i = 0; i < pixels.size(); i++) {
+        pixels[i] = static_cast<uint8_t>(i * 29 + 3); // 29, 3: spread the bytes
+    }
+    ImageInfo image = {};
+    image.header.colorMode = ARGB8888;
+    image.header.width = width;
+    image.header.height = height;
+    image.data = pixels.data();
+    const float startX = 2.0f;
+    const float startY = -4.0f;
+    const PatternRepeatMode modes[] = {REPEAT, REPEAT_X, REPEAT_Y, NO_REPEAT};
+    std::vector<Rgba8T> colors(SPAN_LENGTH);
+    for (PatternRepeatMode mode : modes) {
+        FillPatternRgba pattern(&image, mode, startX, startY);
+        uint32_t mismatches = 0;
+        for (int32_t y = -12; y < 12; y++) { // 12: rows above, on and below the pattern
+            int32_t x = y * 3 - 20;          // 3, 20: spans starting left and right of the pattern
+            uint32_t len = static_cast<uint32_t>(y + 12) * 7 + 1; // 12, 7: lengths up to many tiles
+            pattern.Generate(colors.data(), x, y, len);
+            for (uint32_t i = 0; i < len; i++) {
+                int32_t patternX = x + static_cast<int32_t>(i) - static_cast<int32_t>(startX);
+                int32_t patternY = y - static_cast<int32_t>(startY);
+                if (mode == REPEAT || mode == REPEAT_X) {
+                    patternX = ((patternX % width) + width) % width;
+                }
+                if (mode == REPEAT || mode == REPEAT_Y) {
+                    patternY = ((patternY % height) + height) % height;
+                }
+                Rgba8T expected(0, 0, 0, MAX_COLOR_NUM);
+                if (patternX >= 0 && patternX < width && patternY >= 0 && patternY < height) {
+                    const uint8_t* pixel = &pixels[(patternY * width + patternX) * 4]; // 4: bytes of ARGB8888
+                    expected = Rgba8T(pixel[2], pixel[1], pixel[0], pixel[3]); // 2, 3: red and alpha bytes
+                }
+                mismatches += (colors[i].red != expected.red || colors[i].green != expected.green ||
+                               colors[i].blue != expected.blue || colors[i].alpha != expected.alpha) ? 1 : 0;
+            }
+        }
+        EXPECT_EQ(mismatches, 0u);
+    }
+}
+
+/**
+ * @tc.name: SpanImageRgba_001
+ * @tc.desc: Verify the image generator samples ARGB8888, RGB888 and RGB565 images with each
+ * filter under a rotation and a scale, transparent outside of the image or repeated.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SpanFillTest, SpanImageRgba_001, TestSize.Level0)
+{
+    const int32_t width = 23;
+    const int32_t height = 17;
+    const ColorMode modes[] = {ARGB8888, RGB888, RGB565};
+    const ImageFilterMode filters[] = {IMAGE_FILTER_NEAREST, IMAGE_FILTER_BILINEAR, IMAGE_FILTER_BOX};
+    TransAffine transform;
+    transform.Rotate(GRADIENT_ANGLE);
+    transform.Scale(0.7f, 0.45f); // 0.7, 0.45: magnify unevenly
+    transform.Translate(-4.0f, 9.0f); // -4, 9: move the image partly off the spans
+    std::vector<Rgba8T> colors(SPAN_LENGTH);
+    for (ColorMode mode : modes) {
+        std::vector<uint8_t> pixels(width * height * PixelBytes(mode));
+        for (uint32_t i = 0; i < pixels.size(); i++) {
+            pixels[i] = static_cast<uint8_t>(i * 53 + (i >> 2)); // 53, 2: spread the bytes
+        }
+        ImageInfo image = {};
+        image.header.colorMode = mode;
+        image.header.width = width;
+        image.header.height = height;
+        image.data = pixels.data();
+        for (ImageFilterMode filter : filters) {
+            for (bool repeat : {false, true}) {
+                FillInterpolator interpolator(transform);
+                SpanImageRgba generator(interpolator, filter, repeat ? REPEAT : NO_REPEAT);
+                ASSERT_TRUE(generator.Attach(&image));
+                FillInterpolator reference(transform);
+                uint32_t mismatches = 0;
+                for (int32_t y = -SPAN_ROWS / 2; y < SPAN_ROWS; y++) { // 2: rows above the image
+                    int32_t x = -y * 3;                                  // 3: spans starting left and right
+                    uint32_t len = SPAN_LENGTH - static_cast<uint32_t>(y + SPAN_ROWS / 2) * 5; // 2, 5: vary length
+                    generator.Generate(colors.data(), x, y, len);
+                    reference.Begin(x + 0.5f, y + 0.5f, len); // 0.5: the pixel centers
+                    for (uint32_t i = 0; i < len; i++, ++reference) {
+                        int32_t sampleX;
+                        int32_t sampleY;
+                        reference.Coordinates(&sampleX, &sampleY);
+                        Rgba8T expected = SampleImage(image, filter, sampleX, sampleY, repeat);
+                        mismatches += (colors[i].red != expected.red || colors[i].green != expected.green ||
+                                       colors[i].blue != expected.blue || colors[i].alpha != expected.alpha) ? 1 : 0;
+                    }
+                }
+                EXPECT_EQ(mismatches, 0u);
+            }
+        }
+    }
+}
+
+/**
+ * @tc.name: SpanImageRgba_002
+ * @tc.desc: Verify an untransformed image is copied by the nearest and bilinear filters, and
+ * that the box filter averages the 2x2 blocks of an image scaled by half.
+ * @tc.type: FUNC
+ */
+HWTEST_F(SpanFillTest, SpanImageRgba_002, TestSize.Level0)
+{
+    const int32_t width = 40;
+    const int32_t height = 6;
+    std::vector<uint8_t> pixels(width * height * 4); // 4: bytes of ARGB8888
+    for (uint32_t i = 0; i < pixels.size(); i++) {
+        pixels[i] = static_cast<uint8_t>(i * 71 + 5); // 71, 5: spread the bytes
+    }
+    ImageInfo image = {};
+    image.header.colorMode = ARGB8888;
+    image.header.width = width;
+    image.header.height = height;
+    image.data = pixels.data();
+    std::vector<Rgba8T> colors(width);
+    TransAffine identity;
+    FillInterpolator interpolator(identity);
+    uint32_t mismatches = 0;
+    for (ImageFilterMode filter : {IMAGE_FILTER_NEAREST, IMAGE_FILTER_BILINEAR}) {
+        SpanImageRgba generator(interpolator, filter);
+        ASSERT_TRUE(generator.Attach(&image));
+        for (int32_t y = 0; y < height; y++) {
+            generator.Generate(colors.data(), 0, y, width);
+            for (int32_t x = 0; x < width; x++) {
+                Rgba8T expected = ImagePixel(image, x, y, false);
+                mismatches += (colors[x].red != expected.red || colors[x].green != expected.green ||
+                               colors[x].blue != expected.blue || colors[x].alpha != expected.alpha) ? 1 : 0;
+            }
+        }
+    }
+    TransAffine half;
+    half.Scale(2.0f, 2.0f); // 2: each span pixel covers 2x2 image pixels
+    FillInterpolator halfInterpolator(half);
+    SpanImageRgba box(halfInterpolator, IMAGE_FILTER_BOX);
+    ASSERT_TRUE(box.Attach(&image));
+    for (int32_t y = 0; y < height / 2; y++) { // 2: half the rows
+        box.Generate(colors.data(), 0, y, width / 2); // 2: half the columns
+        for (int32_t x = 0; x < width / 2; x++) { // 2: half the columns
+            const uint8_t* pixel = &pixels[(y * 2 * width + x * 2) * 4]; // 2, 4: the block and its bytes
+            uint32_t alpha = pixel[3] + pixel[7] + pixel[width * 4 + 3] + pixel[width * 4 + 7]; // 3, 4, 7: alphas
+            mismatches += (colors[x].alpha != ((alpha + 2) >> 2)) ? 1 : 0; // 2: average of 4
+        }
+    }
+    EXPECT_EQ(mismatches, 0u);
+}
+} // namespace OHOS
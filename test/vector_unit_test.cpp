@@ -210,6 +210,35 @@ HWTEST_F(VectorTest, VectorCapacity_001, TestSize.Level0)
     EXPECT_EQ(vector_->ReSize(size), size);
 }
 
+/**
+ * @tc.name: VectorCapacity_002
+ * @tc.desc: Verify an empty vector grows on PushBack, and a full vector of UINT16_MAX elements drops the value.
+ * @tc.type: FUNC
+ */
+HWTEST_F(VectorTest, VectorCapacity_002, TestSize.Level0)
+{
+    Vector<uint16_t> empty(0);
+    empty.PushBack(FIRST_VALUE);
+    EXPECT_EQ(empty.Capacity(), 1);
+    EXPECT_EQ(empty.Front(), FIRST_VALUE);
+
+    Vector<uint8_t> full(UINT16_MAX);
+    for (uint32_t i = 0; i < UINT16_MAX; i++) {
+        full.PushBack(static_cast<uint8_t>(i));
+    }
+    full.PushBack(0);
+    EXPECT_EQ(full.Size(), UINT16_MAX);
+    EXPECT_EQ(full.Capacity(), UINT16_MAX);
+    EXPECT_EQ(full.Back(), static_cast<uint8_t>(UINT16_MAX - 1));
+
+    Vector<uint8_t> half(INT16_MAX + 1);
+    for (uint32_t i = 0; i <= INT16_MAX + 1; i++) {
+        half.PushBack(static_cast<uint8_t>(i));
+    }
+    EXPECT_EQ(half.Size(), INT16_MAX + 2); // 2: one more than the first capacity
+    EXPECT_EQ(half.Capacity(), UINT16_MAX);
+}
+
 /**
  * @tc.name: VectorErase_001
  * @tc.desc: Verify Erase function, equal.